@@ -174,7 +174,8 @@ TStdFieldCmdTar::eDoCmd(const   TCQCCmdCfg&             ccfgToDo
                 TModule::LogEventObj(errToCatch);
             }
 
-            // If not accessible, assume no
+            // If not accessible, assume no, and make sure we look it up again next time
+            facCQCKit().DropCQCSrvAdminProxy(strMoniker);
             bResult = kCIDLib::False;
         }
     }
@@ -195,6 +196,7 @@ TStdFieldCmdTar::eDoCmd(const   TCQCCmdCfg&             ccfgToDo
         catch(TError& errToCatch)
         {
             errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            facCQCKit().DropCQCSrvAdminProxy(m_strTmp1);
 
             //
             //  If we were told to fail on error, then throw. Else just return
@@ -290,6 +292,9 @@ TStdFieldCmdTar::eDoCmd(const   TCQCCmdCfg&             ccfgToDo
 
         catch(TError& errToCatch)
         {
+            // Make sure we do a new lookup next time
+            facCQCKit().DropCQCSrvAdminProxy(strMoniker);
+
             if (!errToCatch.bLogged())
             {
                 errToCatch.AddStackLevel(CID_FILE, CID_LINE);
@@ -334,6 +339,9 @@ TStdFieldCmdTar::eDoCmd(const   TCQCCmdCfg&             ccfgToDo
 
         catch(TError& errToCatch)
         {
+            // Make sure we do a new lookup next time
+            facCQCKit().DropCQCSrvAdminProxy(strDrv);
+
             if (!errToCatch.bLogged())
             {
                 errToCatch.AddStackLevel(CID_FILE, CID_LINE);
@@ -47,6 +47,7 @@
 #include    "CQCClService_ClSrvServerBase.hpp"
 #include    "CQCClService_ClSrvImpl.hpp"
 #include    "CQCClService_ServiceHandler.hpp"
+#include    "CQCClService_ArtFetcher.hpp"
 #include    "CQCClService_ThisFacility.hpp"
 
 
@@ -0,0 +1,689 @@
+//
+// FILE NAME: CQCClService_ArtFetcher.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the cover art fetcher that the repo cache threads use
+//  to download missing art.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+
+
+// ---------------------------------------------------------------------------
+//  Includes
+// ---------------------------------------------------------------------------
+#include    "CQCClService.hpp"
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TCQCArtFetcher
+//  PREFIX: artf
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TCQCArtFetcher: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TCQCArtFetcher::TCQCArtFetcher(const TString& strRepoMoniker) :
+
+    m_bBatchOK(kCIDLib::True)
+    , m_c4FailCnt(0)
+    , m_colBatchQ(tCIDLib::EAdoptOpts::Adopt, tCIDLib::EMTStates::Safe)
+    , m_colManifest(1109, TStringKeyOps(kCIDLib::False), tCIDLib::EMTStates::Safe)
+    , m_colPending(256)
+    , m_strRepoMoniker(strRepoMoniker)
+{
+    facCQCMedia().QueryRepoCachePath(m_strRepoMoniker, m_strOutPath);
+}
+
+TCQCArtFetcher::~TCQCArtFetcher()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TCQCArtFetcher: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  The cache thread calls this after queuing up any images it needs. We break
+//  them into batches, start up the workers, and wait for them to finish. We
+//  watch the calling thread for shutdown requests and pass them on to the
+//  workers.
+//
+//  We return true if we got everything. If not, the caller should come back
+//  later and queue up whatever is still missing.
+//
+tCIDLib::TBoolean TCQCArtFetcher::bFetchAll(TThread& thrCaller)
+{
+    {
+        TLocker lockrSync(&m_mtxSync);
+        m_c4FailCnt = 0;
+    }
+
+    if (m_colPending.bIsEmpty())
+        return kCIDLib::True;
+
+    //
+    //  Break them into batches. They were queued in order by media type,
+    //  so we just start a new batch when the type changes or we fill one.
+    //
+    TImgBatch* pibatCur = nullptr;
+    const tCIDLib::TCard4 c4PendCnt = m_colPending.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4PendCnt; c4Index++)
+    {
+        const TImgReq& ireqCur = m_colPending[c4Index];
+        if (pibatCur && (pibatCur->m_eMType != ireqCur.m_eMType))
+        {
+            m_colBatchQ.Put(pibatCur);
+            pibatCur = nullptr;
+        }
+
+        if (!pibatCur)
+            pibatCur = new TImgBatch(ireqCur.m_eMType);
+        pibatCur->m_colReqs.objAdd(ireqCur);
+
+        if (pibatCur->m_colReqs.c4ElemCount() >= kCQCMedia::c4MaxImgBatchCnt)
+        {
+            m_colBatchQ.Put(pibatCur);
+            pibatCur = nullptr;
+        }
+    }
+    if (pibatCur)
+        m_colBatchQ.Put(pibatCur);
+    m_colPending.RemoveAll();
+
+    // Start up workers, but no more than we have batches for
+    const tCIDLib::TCard4 c4WorkerCnt = tCIDLib::MinVal
+    (
+        c4MaxWorkers, m_colBatchQ.c4ElemCount()
+    );
+
+    TWorkerList colWorkers(tCIDLib::EAdoptOpts::Adopt, c4WorkerCnt);
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4WorkerCnt; c4Index++)
+    {
+        TThread* pthrNew = new TThread
+        (
+            facCIDLib().strNextThreadName(TString(L"ArtFetch_") + m_strRepoMoniker)
+            , TMemberFunc<TCQCArtFetcher>(this, &TCQCArtFetcher::eWorkerThread)
+        );
+        colWorkers.Add(pthrNew);
+        pthrNew->Start();
+    }
+
+    //
+    //  And wait for them to finish. If we are asked to shut down, ask them
+    //  all to stop, and we still wait for them to die since they reference
+    //  us.
+    //
+    tCIDLib::TBoolean bShutdown = kCIDLib::False;
+    tCIDLib::EExitCodes eExit;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4WorkerCnt; c4Index++)
+    {
+        TThread& thrCur = *colWorkers[c4Index];
+        while (!thrCur.bWaitForDeath(eExit, 250))
+        {
+            if (!bShutdown && thrCaller.bCheckShutdownRequest())
+            {
+                bShutdown = kCIDLib::True;
+                for (tCIDLib::TCard4 c4SDInd = 0; c4SDInd < c4WorkerCnt; c4SDInd++)
+                    colWorkers[c4SDInd]->ReqShutdownNoSync();
+            }
+        }
+    }
+
+    //
+    //  If anything is left in the queue (shutdown or the workers couldn't get
+    //  a proxy) then we didn't get everything.
+    //
+    tCIDLib::TBoolean bRet = m_colBatchQ.bIsEmpty();
+    m_colBatchQ.RemoveAll();
+
+    if (bRet)
+    {
+        TLocker lockrSync(&m_mtxSync);
+        bRet = (m_c4FailCnt == 0);
+    }
+    return bRet;
+}
+
+
+// The cache thread checks this to see if it already has an art file
+tCIDLib::TBoolean TCQCArtFetcher::bHaveFile(const TString& strFileName) const
+{
+    return m_colManifest.bHasElement(strFileName);
+}
+
+
+//
+//  Scan our output directory and load up the names of any art files that are
+//  already there. This is done once when the cache thread starts, so that it
+//  doesn't have to check for every file individually.
+//
+tCIDLib::TVoid TCQCArtFetcher::LoadManifest()
+{
+    m_colManifest.RemoveAll();
+
+    TDirIter diterArt;
+    TFindBuf fndbCur;
+    TString  strName;
+    if (diterArt.bFindFirst(m_strOutPath
+                            , kCIDLib::pszAllFilesSpec
+                            , fndbCur
+                            , tCIDLib::EDirSearchFlags::NormalFiles))
+    {
+        tCIDLib::TBoolean bAdded;
+        do
+        {
+            // Skip any empty ones, probably from an interrupted write
+            if (!fndbCur.c8Size())
+                continue;
+
+            fndbCur.pathFileName().bQueryNameExt(strName);
+            m_colManifest.objAddIfNew(strName, bAdded);
+
+        }   while (diterArt.bFindNext(fndbCur));
+    }
+}
+
+
+//
+//  Build up the paths to the large and thumb images. We force the thumb to
+//  bitmap for maximum load speed. We force the large to jpeg, which most of them
+//  are anyway (i.e. we just write them out as is.)
+//
+tCIDLib::TVoid
+TCQCArtFetcher::MakeArtPaths(const  TString&    strPerIdLrg
+                            , const TString&    strPerIdSml
+                            ,       TPathStr&   pathLrg
+                            ,       TPathStr&   pathThumb) const
+{
+    pathThumb = m_strOutPath;
+    pathThumb.AddLevel(strPerIdSml);
+    pathThumb.Append(L"_Thumb");
+    pathThumb.AppendExt(L"bmp");
+
+    pathLrg = m_strOutPath;
+    pathLrg.AddLevel(strPerIdLrg);
+    pathLrg.Append(L"_Lrg");
+    pathLrg.AppendExt(L"jpg");
+}
+
+
+// The cache thread calls this to queue up images that it needs
+tCIDLib::TVoid
+TCQCArtFetcher::QueueImg(const  tCQCMedia::EMediaTypes  eMType
+                        , const tCIDLib::TCard2         c2Id
+                        , const TString&                strPerIdLrg
+                        , const TString&                strPerIdSml)
+{
+    TImgReq& ireqNew = m_colPending.objAdd(TImgReq());
+    ireqNew.m_c2Id = c2Id;
+    ireqNew.m_eMType = eMType;
+    ireqNew.m_strPerIdLrg = strPerIdLrg;
+    ireqNew.m_strPerIdSml = strPerIdSml;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TCQCArtFetcher: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  The worker threads run here. They just pull batches off the queue until
+//  it's empty. Any partial batches get put back by bFetchBatch, so another
+//  worker (or this one) will pick that up.
+//
+tCIDLib::EExitCodes
+TCQCArtFetcher::eWorkerThread(TThread& thrThis, tCIDLib::TVoid*)
+{
+    thrThis.Sync();
+
+    THeapBuf mbufData(kCIDLib::c4Sz_64K, kCQCMedia::c4MaxImgBatchBytes * 2);
+    THeapBuf mbufImg(100 * 1024, 4 * (1024 * 1024));
+
+    tCQCKit::TCQCSrvProxy orbcSrv;
+    try
+    {
+        orbcSrv = facCQCKit().orbcCQCSrvAdminProxy(m_strRepoMoniker);
+    }
+
+    catch(TError& errToCatch)
+    {
+        if (facCQCClService().bShouldLog(errToCatch))
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+        }
+        return tCIDLib::EExitCodes::InitFailed;
+    }
+
+    tCIDLib::TBoolean bShutdown = kCIDLib::False;
+    tCIDLib::TCard4 c4SingleCnt = 0;
+    while (!bShutdown && !thrThis.bCheckShutdownRequest())
+    {
+        TImgBatch* pibatCur = m_colBatchQ.pobjGetNext(50, kCIDLib::False);
+        if (!pibatCur)
+            break;
+        TJanitor<TImgBatch> janBatch(pibatCur);
+
+        try
+        {
+            if (m_bBatchOK && bFetchBatch(orbcSrv, *pibatCur, mbufData, mbufImg))
+            {
+                // Pause after each batch so we don't kill the repo
+                bShutdown = !thrThis.bSleep(c4PaceMSs);
+            }
+             else
+            {
+                const tCIDLib::TCard4 c4Count = pibatCur->m_colReqs.c4ElemCount();
+                tCIDLib::TCard4 c4Index = 0;
+                for (; c4Index < c4Count; c4Index++)
+                {
+                    if (bShutdown || thrThis.bCheckShutdownRequest())
+                    {
+                        bShutdown = kCIDLib::True;
+                        break;
+                    }
+                    FetchSingle(orbcSrv, pibatCur->m_colReqs[c4Index], mbufData, mbufImg);
+
+                    // Every so many downloads, pause a bit
+                    c4SingleCnt++;
+                    if (!(c4SingleCnt % c4PaceCnt))
+                        bShutdown = !thrThis.bSleep(c4PaceMSs);
+                }
+
+                //
+                //  If we got interrupted, count the ones we didn't get to as
+                //  failures, so the cache thread knows to come back for them.
+                //
+                if (c4Index < c4Count)
+                {
+                    TLocker lockrSync(&m_mtxSync);
+                    m_c4FailCnt += c4Count - c4Index;
+                }
+            }
+        }
+
+        catch(TError& errToCatch)
+        {
+            {
+                TLocker lockrSync(&m_mtxSync);
+                m_c4FailCnt += pibatCur->m_colReqs.c4ElemCount();
+            }
+
+            if (facCQCClService().bShouldLog(errToCatch))
+            {
+                errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+                TModule::LogEventObj(errToCatch);
+
+                facCQCClService().LogMsg
+                (
+                    CID_FILE
+                    , CID_LINE
+                    , kClSrvErrs::errcData_Except
+                    , tCIDLib::ESeverities::Failed
+                    , tCIDLib::EErrClasses::Format
+                    , m_strRepoMoniker
+                );
+            }
+        }
+    }
+    return tCIDLib::EExitCodes::Normal;
+}
+
+
+//
+//  Do a batch query. If it fails, we return false and the worker falls back to
+//  single image queries for this batch. Only if the driver tells us it doesn't
+//  know the query do we remember not to try batches again, so a batch that just
+//  failed for some other reason doesn't turn off batching for good.
+//
+tCIDLib::TBoolean
+TCQCArtFetcher::bFetchBatch(tCQCKit::TCQCSrvProxy&  orbcSrv
+                            , TImgBatch&            ibatToDo
+                            , THeapBuf&             mbufData
+                            , THeapBuf&             mbufImg)
+{
+    TString strQData;
+    if (ibatToDo.m_eMType == tCQCMedia::EMediaTypes::Music)
+        strQData = L"Music";
+    else
+        strQData = L"Movie";
+
+    const tCIDLib::TCard4 c4ReqCnt = ibatToDo.m_colReqs.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ReqCnt; c4Index++)
+    {
+        strQData.Append(kCIDLib::chSpace);
+        strQData.AppendFormatted(ibatToDo.m_colReqs[c4Index].m_c2Id);
+    }
+
+    tCIDLib::TBoolean bRes = kCIDLib::False;
+    tCIDLib::TCard4 c4DataSz = 0;
+    try
+    {
+        bRes = orbcSrv->bQueryData
+        (
+            m_strRepoMoniker
+            , kCQCMedia::strQuery_QueryImgBatch
+            , strQData
+            , c4DataSz
+            , mbufData
+        );
+    }
+
+    catch(TError& errToCatch)
+    {
+        if (!errToCatch.bCheckEvent(facCQCMedia().strName()
+                                    , kMedErrs::errcDrv_UnknownDataQuery))
+        {
+            throw;
+        }
+
+        // The driver doesn't support it, so don't try it again
+        m_bBatchOK = kCIDLib::False;
+        return kCIDLib::False;
+    }
+
+    if (!bRes)
+        return kCIDLib::False;
+
+    //
+    //  We get back the number of ids the driver processed and the number of
+    //  images returned. Then each image is its id and the image data.
+    //
+    const tCIDLib::TCard4 c4DoneCnt = mbufData.c4At(0);
+    const tCIDLib::TCard4 c4ImgCnt = mbufData.c4At(4);
+    tCIDLib::TCard4 c4BufInd = 8;
+    tCIDLib::TCard4 c4ReqInd = 0;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4ImgCnt; c4Index++)
+    {
+        const tCIDLib::TCard2 c2Id = tCIDLib::TCard2(mbufData.c4At(c4BufInd));
+        c4BufInd += 4;
+
+        // They come back in order, so find the request it goes with
+        while ((c4ReqInd < c4ReqCnt) && (ibatToDo.m_colReqs[c4ReqInd].m_c2Id != c2Id))
+            c4ReqInd++;
+
+        if (c4ReqInd == c4ReqCnt)
+        {
+            facCQCClService().ThrowErr
+            (
+                CID_FILE
+                , CID_LINE
+                , kClSrvErrs::errcData_BadBatchId
+                , tCIDLib::ESeverities::Failed
+                , tCIDLib::EErrClasses::Format
+                , TCardinal(c2Id)
+                , m_strRepoMoniker
+            );
+        }
+        c4BufInd += c4StoreImg(ibatToDo.m_colReqs[c4ReqInd], mbufData, c4BufInd, mbufImg);
+    }
+
+    //
+    //  If the driver didn't get to all of them, put the rest back into the
+    //  queue for the next round.
+    //
+    if (c4DoneCnt < c4ReqCnt)
+    {
+        TImgBatch* pibatRest = new TImgBatch(ibatToDo.m_eMType);
+        for (tCIDLib::TCard4 c4Index = c4DoneCnt; c4Index < c4ReqCnt; c4Index++)
+            pibatRest->m_colReqs.objAdd(ibatToDo.m_colReqs[c4Index]);
+        m_colBatchQ.Put(pibatRest);
+    }
+    return kCIDLib::True;
+}
+
+
+// Fallback for drivers that don't support the batch query
+tCIDLib::TVoid
+TCQCArtFetcher::FetchSingle(tCQCKit::TCQCSrvProxy&  orbcSrv
+                            , const TImgReq&        ireqToDo
+                            , THeapBuf&             mbufData
+                            , THeapBuf&             mbufImg)
+{
+    TString strQData;
+    if (ireqToDo.m_eMType == tCQCMedia::EMediaTypes::Music)
+        strQData = L"Music ";
+    else
+        strQData = L"Movie ";
+    strQData.AppendFormatted(ireqToDo.m_c2Id);
+
+    try
+    {
+        tCIDLib::TCard4 c4DataSz = 0;
+        const tCIDLib::TBoolean bRes = orbcSrv->bQueryData
+        (
+            m_strRepoMoniker
+            , kCQCMedia::strQuery_QueryImgById
+            , strQData
+            , c4DataSz
+            , mbufData
+        );
+
+        if (bRes)
+            c4StoreImg(ireqToDo, mbufData, 0, mbufImg);
+    }
+
+    catch(TError& errToCatch)
+    {
+        {
+            TLocker lockrSync(&m_mtxSync);
+            m_c4FailCnt++;
+        }
+
+        if (facCQCClService().bShouldLog(errToCatch))
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+
+            facCQCClService().LogMsg
+            (
+                CID_FILE
+                , CID_LINE
+                , kClSrvErrs::errcData_Except
+                , tCIDLib::ESeverities::Failed
+                , tCIDLib::EErrClasses::Format
+                , m_strRepoMoniker
+            );
+        }
+    }
+}
+
+
+//
+//  Breaks out the large and thumb images for one image from the returned data,
+//  starting at the indicated index, and writes them out. We return the number
+//  of bytes we ate.
+//
+//  The large one is written out as is if it's a JPEG, else we convert it. The
+//  thumb is always converted to a bitmap for fast loading. Each one is prefixed
+//  by an L or T marker and the size, and followed by the size again as a sanity
+//  check.
+//
+tCIDLib::TCard4
+TCQCArtFetcher::c4StoreImg( const   TImgReq&            ireqSrc
+                            , const THeapBuf&           mbufData
+                            , const tCIDLib::TCard4     c4StartInd
+                            ,       THeapBuf&           mbufImg)
+{
+    TPathStr pathLrg;
+    TPathStr pathThumb;
+    MakeArtPaths(ireqSrc.m_strPerIdLrg, ireqSrc.m_strPerIdSml, pathLrg, pathThumb);
+
+    tCIDLib::TCard4 c4BufInd = c4StartInd;
+
+    // It should start with an 'L' for large in the first TCard4
+    if (tCIDLib::TCh(mbufData.c4At(c4BufInd)) != kCIDLib::chLatin_L)
+    {
+        facCQCClService().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kClSrvErrs::errcData_DataMarker
+            , pathLrg
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Format
+            , TString(L"Large")
+            , m_strRepoMoniker
+        );
+    }
+    c4BufInd += 4;
+
+    // Next should be the size
+    const tCIDLib::TCard4 c4LargeSz = mbufData.c4At(c4BufInd);
+    c4BufInd += 4;
+
+    //
+    //  As a sanity check, there should be the same size value just past the
+    //  image data.
+    //
+    if (mbufData.c4At(c4BufInd + c4LargeSz) != c4LargeSz)
+    {
+        facCQCClService().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kClSrvErrs::errcData_SizeInfo
+            , pathLrg
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Format
+            , TString(L"Large")
+            , m_strRepoMoniker
+        );
+    }
+
+    //
+    //  Copy out the bytes to the other buffer and move forward. We have to
+    //  skip the redundant size at the end as well.
+    //
+    mbufData.CopyOut(mbufImg, c4LargeSz, c4BufInd);
+    c4BufInd += c4LargeSz + 4;
+
+    tCIDLib::TBoolean bAdded;
+    TString strName;
+    if (c4LargeSz && !ireqSrc.m_strPerIdLrg.bIsEmpty())
+    {
+        if (facCIDImgFact().eProbeImg(mbufImg, c4LargeSz) == tCIDImage::EImgTypes::JPEG)
+        {
+            TBinaryFile flOut(pathLrg);
+            flOut.Open
+            (
+                tCIDLib::EAccessModes::Write
+                , tCIDLib::ECreateActs::CreateAlways
+                , tCIDLib::EFilePerms::Default
+                , tCIDLib::EFileFlags::SequentialScan
+            );
+            flOut.c4WriteBuffer(mbufImg, c4LargeSz);
+        }
+         else
+        {
+            // Not a JPEG, so force it to be
+            TCIDImage* pimgJPEG = nullptr;
+            facCIDImgFact().bDecodeImgTo
+            (
+                mbufImg
+                , c4LargeSz
+                , tCIDImage::EImgTypes::JPEG
+                , pimgJPEG
+                , kCIDLib::True
+            );
+            TJanitor<TCIDImage> janImg(pimgJPEG);
+
+            TBinFileOutStream strmTar
+            (
+                pathLrg
+                , tCIDLib::ECreateActs::CreateAlways
+                , tCIDLib::EFilePerms::Default
+                , tCIDLib::EFileFlags::SequentialScan
+            );
+            strmTar << *pimgJPEG << kCIDLib::FlushIt;
+        }
+
+        pathLrg.bQueryNameExt(strName);
+        m_colManifest.objAddIfNew(strName, bAdded);
+    }
+
+    // Next should be a T for thumb
+    if (tCIDLib::TCh(mbufData.c4At(c4BufInd)) != kCIDLib::chLatin_T)
+    {
+        facCQCClService().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kClSrvErrs::errcData_DataMarker
+            , pathThumb
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Format
+            , TString(L"Small")
+            , m_strRepoMoniker
+        );
+    }
+    c4BufInd += 4;
+
+    // Next should be the thumb size
+    const tCIDLib::TCard4 c4ThumbSz = mbufData.c4At(c4BufInd);
+    c4BufInd += 4;
+
+    if (mbufData.c4At(c4BufInd + c4ThumbSz) != c4ThumbSz)
+    {
+        facCQCClService().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kClSrvErrs::errcData_SizeInfo
+            , pathThumb
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Format
+            , TString(L"Thumb")
+            , m_strRepoMoniker
+        );
+    }
+
+    mbufData.CopyOut(mbufImg, c4ThumbSz, c4BufInd);
+    c4BufInd += c4ThumbSz + 4;
+
+    // Load the data as a bitmap
+    if (c4ThumbSz && !ireqSrc.m_strPerIdSml.bIsEmpty())
+    {
+        TCIDImage* pimgBmp = nullptr;
+        facCIDImgFact().bDecodeImgTo
+        (
+            mbufImg
+            , c4ThumbSz
+            , tCIDImage::EImgTypes::Bitmap
+            , pimgBmp
+            , kCIDLib::True
+        );
+        TJanitor<TCIDImage> janImg(pimgBmp);
+
+        TBinFileOutStream strmTar
+        (
+            pathThumb
+            , tCIDLib::ECreateActs::CreateAlways
+            , tCIDLib::EFilePerms::Default
+            , tCIDLib::EFileFlags::SequentialScan
+        );
+        strmTar << *pimgBmp << kCIDLib::FlushIt;
+
+        pathThumb.bQueryNameExt(strName);
+        m_colManifest.objAddIfNew(strName, bAdded);
+    }
+    return c4BufInd - c4StartInd;
+}
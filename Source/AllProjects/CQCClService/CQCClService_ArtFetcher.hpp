@@ -0,0 +1,245 @@
+//
+// FILE NAME: CQCClService_ArtFetcher.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header for the cover art fetcher used by the repo cache threads.
+//  Originally each cache thread downloaded images one at a time, and checked for
+//  each large and thumb file on disk per image. For a large repository the
+//  initial sync was dominated by per-image round trip latency.
+//
+//  So now the cache thread just tells us which images it needs (after checking
+//  our manifest of what is already on disk), and we break them into batches and
+//  let a small, fixed set of worker threads pull them from a queue. Each batch
+//  is one QImgBatch query to the repo driver. If the driver doesn't support the
+//  batch query, we fall back to the old QImgById query one image at a time, but
+//  still spread across the workers.
+//
+//  Each worker paces itself, as the old loader did, so that we don't kill the
+//  repo. It pauses after each batch query, and after every so many single image
+//  queries. Since each worker only has one query outstanding at a time, the
+//  worker count caps the outstanding requests.
+//
+//  The manifest is loaded once by scanning the output directory, and then kept
+//  up to date as we write out new files. Since anything we've written is in the
+//  manifest, if we get interrupted we just pick up with what is still missing
+//  the next time around.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1.  The cache thread waits for us to complete, so it can only be doing one
+//      fetch operation at a time. The manifest is thread safe, since the workers
+//      update it while the cache thread may be checking it.
+//
+// LOG:
+//
+#pragma once
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TCQCArtFetcher
+//  PREFIX: artf
+// ---------------------------------------------------------------------------
+class TCQCArtFetcher
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Public, static data
+        //
+        //  c4MaxWorkers
+        //      The maximum number of worker threads we'll start up to download
+        //      images in parallel. This keeps us from hammering the repo.
+        //
+        //  c4PaceCnt
+        //  c4PaceMSs
+        //      Each worker pauses for the pace millis after each batch query,
+        //      or after every pace count single image queries.
+        // -------------------------------------------------------------------
+        static constexpr tCIDLib::TCard4    c4MaxWorkers = 4;
+        static constexpr tCIDLib::TCard4    c4PaceCnt = 10;
+        static constexpr tCIDLib::TCard4    c4PaceMSs = 100;
+
+
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TCQCArtFetcher() = delete;
+
+        TCQCArtFetcher
+        (
+            const   TString&                strRepoMoniker
+        );
+
+        TCQCArtFetcher(const TCQCArtFetcher&) = delete;
+        TCQCArtFetcher(TCQCArtFetcher&&) = delete;
+
+        ~TCQCArtFetcher();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TCQCArtFetcher& operator=(const TCQCArtFetcher&) = delete;
+        TCQCArtFetcher& operator=(TCQCArtFetcher&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bFetchAll
+        (
+                    TThread&                thrCaller
+        );
+
+        tCIDLib::TBoolean bHaveFile
+        (
+            const   TString&                strFileName
+        )   const;
+
+        tCIDLib::TVoid LoadManifest();
+
+        tCIDLib::TVoid MakeArtPaths
+        (
+            const   TString&                strPerIdLrg
+            , const TString&                strPerIdSml
+            ,       TPathStr&               pathLrg
+            ,       TPathStr&               pathThumb
+        )   const;
+
+        tCIDLib::TVoid QueueImg
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const tCIDLib::TCard2         c2Id
+            , const TString&                strPerIdLrg
+            , const TString&                strPerIdSml
+        );
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private class types
+        //
+        //  We queue up requests per image until we start fetching, then they
+        //  get broken up into batches of the same media type and queued for
+        //  the workers.
+        // -------------------------------------------------------------------
+        class TImgReq
+        {
+            public :
+                tCIDLib::TCard2         m_c2Id;
+                tCQCMedia::EMediaTypes  m_eMType;
+                TString                 m_strPerIdLrg;
+                TString                 m_strPerIdSml;
+        };
+        using TReqList = TVector<TImgReq>;
+
+        class TImgBatch
+        {
+            public :
+                TImgBatch(const tCQCMedia::EMediaTypes eMType) :
+
+                    m_colReqs(kCQCMedia::c4MaxImgBatchCnt)
+                    , m_eMType(eMType)
+                {
+                }
+
+                TReqList                m_colReqs;
+                tCQCMedia::EMediaTypes  m_eMType;
+        };
+        using TBatchQ = TRefQueue<TImgBatch>;
+        using TWorkerList = TRefVector<TThread>;
+
+
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bFetchBatch
+        (
+                    tCQCKit::TCQCSrvProxy&  orbcSrv
+            ,       TImgBatch&              ibatToDo
+            ,       THeapBuf&               mbufData
+            ,       THeapBuf&               mbufImg
+        );
+
+        tCIDLib::EExitCodes eWorkerThread
+        (
+                    TThread&                thrThis
+            ,       tCIDLib::TVoid*         pData
+        );
+
+        tCIDLib::TVoid FetchSingle
+        (
+                    tCQCKit::TCQCSrvProxy&  orbcSrv
+            , const TImgReq&                ireqToDo
+            ,       THeapBuf&               mbufData
+            ,       THeapBuf&               mbufImg
+        );
+
+        tCIDLib::TCard4 c4StoreImg
+        (
+            const   TImgReq&                ireqSrc
+            , const THeapBuf&               mbufData
+            , const tCIDLib::TCard4         c4StartInd
+            ,       THeapBuf&               mbufImg
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_bBatchOK
+        //      We assume the repo supports the batch query until the driver
+        //      tells us it doesn't know the query, then fall back to single
+        //      image queries. Any other failed batch just falls back for that
+        //      batch. This is just a hint, so it's not a big deal if workers
+        //      race on it.
+        //
+        //  m_c4FailCnt
+        //      The workers bump this for any image they failed to get. The cache
+        //      thread uses it to know if it needs to come back around later.
+        //
+        //  m_colBatchQ
+        //      The queue of batches that the workers pull from. It's thread
+        //      safe. Workers put back any part of a batch that the driver didn't
+        //      get to, if the reply got too big.
+        //
+        //  m_colManifest
+        //      The names (name and extension) of the art files we have on disk.
+        //      It's loaded by scanning the output directory once, and updated as
+        //      we write new ones. It's thread safe.
+        //
+        //  m_colPending
+        //      Images queued by the cache thread that haven't been handed off to
+        //      the workers yet.
+        //
+        //  m_mtxSync
+        //      Protects the fail count, which the workers update.
+        //
+        //  m_strOutPath
+        //      The repo's cache output path, where we write the art. It's the
+        //      same path the owning cache thread uses.
+        //
+        //  m_strRepoMoniker
+        //      The repo we get the art from, used to get proxies and in msgs.
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean       m_bBatchOK;
+        tCIDLib::TCard4         m_c4FailCnt;
+        TBatchQ                 m_colBatchQ;
+        tCIDLib::TStrHashSet    m_colManifest;
+        TReqList                m_colPending;
+        TMutex                  m_mtxSync;
+        TString                 m_strOutPath;
+        TString                 m_strRepoMoniker;
+};
@@ -57,9 +57,15 @@ const TString& TCacheThread::strKey(const TCacheThread& thrSrc)
 TCacheThread::TCacheThread(const TString& strRepo) :
 
     TThread(TString::strConcat(L"RepoCacher_", strRepo))
+    , m_artfImgs(strRepo)
+    , m_bArtPending(kCIDLib::False)
     , m_c4CurDataSz(0)
     , m_c4FailCnt(0)
+    , m_c4ImgGen(0)
     , m_mbufCurData(8, kCIDLib::c4Sz_32M, kCIDLib::c4Sz_64K)
+    , m_mbufImage(8, kCIDLib::c4Sz_32M * 2, kCIDLib::c4Sz_64K)
+    , m_pmbufImgCtrl(nullptr)
+    , m_pmbufImgData(nullptr)
     , m_strRepoMoniker(strRepo)
 {
     // Build the path where we'll put our output
@@ -68,6 +74,8 @@ TCacheThread::TCacheThread(const TString& strRepo) :
 
 TCacheThread::~TCacheThread()
 {
+    delete m_pmbufImgData;
+    delete m_pmbufImgCtrl;
 }
 
 
@@ -153,6 +161,21 @@ tCIDLib::EExitCodes TCacheThread::eProcess()
             return tCIDLib::EExitCodes::Normal;
     }
 
+    //
+    //  Load up the manifest of art files we already have, so that we only have
+    //  to go get what's missing.
+    //
+    try
+    {
+        m_artfImgs.LoadManifest();
+    }
+
+    catch(TError& errToCatch)
+    {
+        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+        TModule::LogEventObj(errToCatch);
+    }
+
     //
     //  This is our data file that we store our metadata DB to. And it's where
     //  we look first for data when we first come up.
@@ -161,6 +184,14 @@ tCIDLib::EExitCodes TCacheThread::eProcess()
     pathMeta.AddLevel(L"MetaData");
     pathMeta.AppendExt(L"CQCRepoDB");
 
+    //
+    //  And this is the flat image of the same data that we share with local
+    //  clients. It's stored so that we can publish it immediately on startup.
+    //
+    TPathStr pathImage = m_strOutPath;
+    pathImage.AddLevel(L"MetaData");
+    pathImage.AppendExt(L"CQCRepoImg");
+
     //
     //  Since we can repeatedly fail to connect to our repo, us a log limited to prevent
     //  endless logging of the same msg overly quick. LImit it to once every 20 minutes.
@@ -209,6 +240,13 @@ tCIDLib::EExitCodes TCacheThread::eProcess()
                 // Make sure this gets cleared before anything can go wrong
                 bFirstTime = kCIDLib::False;
 
+                //
+                //  If we have a stored image, publish it right away so that local
+                //  clients have data while we get ourself going.
+                //
+                if (TFileSys::bExists(pathImage, tCIDLib::EDirSearchFlags::NormalFiles))
+                    LoadImageFile(pathImage);
+
                 if (TFileSys::bExists(pathMeta, tCIDLib::EDirSearchFlags::NormalFiles))
                 {
                     try
@@ -319,10 +357,10 @@ tCIDLib::EExitCodes TCacheThread::eProcess()
                 );
 
                 //
-                //  Let's do an image download scan. Let him use the raw buffer
-                //  as a temp.
+                //  Let's do an image download scan. If we don't get them all,
+                //  remember that so we come back for the rest.
                 //
-                DownloadImgs(orbcSrv, mdbCurrent, mbufRaw);
+                m_bArtPending = !bDownloadImgs(mdbCurrent);
 
                 //
                 //  It worked, so write out the data. We don't write the original
@@ -354,6 +392,41 @@ tCIDLib::EExitCodes TCacheThread::eProcess()
                     flTar.c4WriteBuffer(mbufRaw, c4RawBytes);
                 }
 
+                //
+                //  Build the flat image for local clients, store it, and publish
+                //  it. If this fails, clients will just fall back to getting the
+                //  data via our ORB interface, so we don't treat it as a failure.
+                //
+                try
+                {
+                    const tCIDLib::TCard4 c4ImageSz = TMediaDBImage::c4BuildImage
+                    (
+                        mdbCurrent, strNewSerNum, eMTFlags, mbufRaw, c4RawBytes, m_mbufImage
+                    );
+
+                    TBinaryFile flTar(pathImage);
+                    flTar.Open
+                    (
+                        tCIDLib::EAccessModes::Write
+                        , tCIDLib::ECreateActs::CreateAlways
+                        , tCIDLib::EFilePerms::Default
+                        , tCIDLib::EFileFlags::SequentialScan
+                    );
+                    flTar.c4WriteBuffer(m_mbufImage, c4ImageSz);
+                    flTar.Close();
+
+                    PublishImage(m_mbufImage, c4ImageSz, strNewSerNum);
+                }
+
+                catch(TError& errToCatch)
+                {
+                    if (facCQCClService().bLogWarnings())
+                    {
+                        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+                        TModule::LogEventObj(errToCatch);
+                    }
+                }
+
                 //
                 //  Sync and update our current data stuff. We have to to compress
                 //  the data into our buffer since we cache the compressed stuff in
@@ -390,6 +463,40 @@ tCIDLib::EExitCodes TCacheThread::eProcess()
                     , m_strRepoMoniker
                 );
             }
+             else if (m_bArtPending)
+            {
+                //
+                //  No new data, but we didn't get all of the art last time. So
+                //  reload what we stored and go back for whatever is missing.
+                //  The art paths are already set in the stored data, so there's
+                //  nothing to write back out.
+                //
+                TBinaryFile flSrc(pathMeta);
+                flSrc.Open
+                (
+                    tCIDLib::EAccessModes::Read
+                    , tCIDLib::ECreateActs::OpenIfExists
+                    , tCIDLib::EFilePerms::Default
+                    , tCIDLib::EFileFlags::SequentialScan
+                );
+
+                c4RawBytes = tCIDLib::TCard4(flSrc.c8CurSize());
+                flSrc.c4ReadBuffer(mbufRaw, c4RawBytes, tCIDLib::EAllData::FailIfNotAll);
+                flSrc.Close();
+
+                TMediaDB mdbCurrent;
+                tCQCMedia::EMTFlags eMTFlags;
+                TMediaDB::ParseBinDump
+                (
+                    mbufRaw
+                    , c4RawBytes
+                    , eMTFlags
+                    , strNewSerNum
+                    , mdbCurrent
+                    , kCIDLib::False
+                );
+                m_bArtPending = !bDownloadImgs(mdbCurrent);
+            }
         }
 
         catch(TError& errToCatch)
@@ -463,40 +570,25 @@ tCIDLib::EExitCodes TCacheThread::eProcess()
 //  After getting a new database down, before we write it out, we hvae to
 //  check for any images that need to be downloaded.
 //
-//  We have to go through all of the titles, collections, and items and
-//  build up a list of unique persistent image ids, i.e. all of the referenced
-//  images. We can then use that to see if we find the images and download
-//  them by persistent id if now.
+//  We go through all of the images of each media type and set the art paths to
+//  our local paths. For any whose files aren't in the art fetcher's manifest, we
+//  queue them up on the fetcher. Then we let it go get them all. It will use
+//  multiple threads and batch requests to the repo.
 //
-tCIDLib::TVoid
-TCacheThread::DownloadImgs( tCQCKit::TCQCSrvProxy&  orbcSrv
-                            , TMediaDB&             mdbTest
-                            , THeapBuf&             mbufTmp)
+//  We return true if we got all the art we needed.
+//
+tCIDLib::TBoolean TCacheThread::bDownloadImgs(TMediaDB& mdbTest)
 {
-    //
-    //  Let's iterate the images and see if we have each one. If not, then
-    //  download the ones we are missing. We have to do each media type
-    //  separately.
-    //
-    tCIDLib::TCard4         c4RoundInd = 0;
     tCQCMedia::EMediaTypes  eType = tCQCMedia::EMediaTypes::Min;
-    THeapBuf                mbufTmp2(100 * 1024, 4 * (1024 * 1024));
     TPathStr                pathThumb;
     TPathStr                pathLrg;
-    TString                 strQData;
+    TString                 strName;
 
     while (eType <= tCQCMedia::EMediaTypes::Max)
     {
         const tCIDLib::TCard4 c4Count = mdbTest.c4ImageCnt(eType);
         for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
         {
-            //
-            //  Watch for shutdown requests in this inner loop, so we
-            //  can react quickly.
-            //
-            if (bCheckShutdownRequest())
-                return;
-
             // Get the current image we want to process
             const TMediaImg& mimgCur = mdbTest.mimgAt(eType, c4Index);
 
@@ -512,267 +604,139 @@ TCacheThread::DownloadImgs( tCQCKit::TCQCSrvProxy&  orbcSrv
                 continue;
             }
 
-            //
-            //  Build up the paths to the large and thumb images. We force the thumb
-            //  to bitmap for maximum load speed. We force the large to jpeg, which
-            //  most of them are anyway (i.e. we just write them out as is.)
-            //
-            pathThumb = m_strOutPath;
-            pathThumb.AddLevel(strPerIdSml);
-            pathThumb.Append(L"_Thumb");
-            pathThumb.AppendExt(L"bmp");
-
-            pathLrg= m_strOutPath;
-            pathLrg.AddLevel(strPerIdLrg);
-            pathLrg.Append(L"_Lrg");
-            pathLrg.AppendExt(L"jpg");
-
             //
             //  Update the image object to point to our paths, so that clients will
             //  see our local paths.
             //
+            m_artfImgs.MakeArtPaths(strPerIdLrg, strPerIdSml, pathLrg, pathThumb);
             mdbTest.SetArtPath(mimgCur.c2Id(), eType, tCQCMedia::ERArtTypes::LrgCover, pathLrg);
             mdbTest.SetArtPath(mimgCur.c2Id(), eType, tCQCMedia::ERArtTypes::SmlCover, pathThumb);
 
             // If we have the ones we can get, then skip this one
-            if ((strPerIdLrg.bIsEmpty() || TFileSys::bExists(pathLrg, tCIDLib::EDirSearchFlags::NormalFiles))
-            &&  (strPerIdSml.bIsEmpty() || TFileSys::bExists(pathThumb, tCIDLib::EDirSearchFlags::NormalFiles)))
+            tCIDLib::TBoolean bHaveAll = kCIDLib::True;
+            if (!strPerIdLrg.bIsEmpty())
             {
-                continue;
+                pathLrg.bQueryNameExt(strName);
+                bHaveAll = m_artfImgs.bHaveFile(strName);
             }
-
-            // we don't have it, so let's try to download it
-            if (eType == tCQCMedia::EMediaTypes::Music)
-                strQData = L"Music ";
-            else
-                strQData = L"Movie ";
-            strQData.AppendFormatted(mimgCur.c2Id());
-
-            try
+            if (bHaveAll && !strPerIdSml.bIsEmpty())
             {
-                tCIDLib::TCard4 c4DataSz = 0;
-                tCIDLib::TBoolean bRes = orbcSrv->bQueryData
-                (
-                    m_strRepoMoniker
-                    , kCQCMedia::strQuery_QueryImgById
-                    , strQData
-                    , c4DataSz
-                    , mbufTmp
-                );
-
-                // If we got it, then break out the two parts
-                tCIDLib::TCard4 c4ThumbSz;
-                tCIDLib::TCard4 c4LargeSz;
-
-                // It should start with an 'L' for large in the first TCard4
-                tCIDLib::TCard4 c4BufInd = 0;
-                if (tCIDLib::TCh(mbufTmp.c4At(c4BufInd)) != kCIDLib::chLatin_L)
-                {
-                    facCQCClService().ThrowErr
-                    (
-                        CID_FILE
-                        , CID_LINE
-                        , kClSrvErrs::errcData_DataMarker
-                        , pathLrg
-                        , tCIDLib::ESeverities::Failed
-                        , tCIDLib::EErrClasses::Format
-                        , TString(L"Large")
-                        , m_strRepoMoniker
-                    );
-                }
-                c4BufInd += 4;
-
-                // Next should be the size
-                c4LargeSz = mbufTmp.c4At(c4BufInd);
-                c4BufInd += 4;
-
-                //
-                //  As a sanity check, there should be the same size value
-                //  just past the image data.
-                //
-                if (mbufTmp.c4At(c4BufInd + c4LargeSz) != c4LargeSz)
-                {
-                    facCQCClService().ThrowErr
-                    (
-                        CID_FILE
-                        , CID_LINE
-                        , kClSrvErrs::errcData_SizeInfo
-                        , pathLrg
-                        , tCIDLib::ESeverities::Failed
-                        , tCIDLib::EErrClasses::Format
-                        , TString(L"Large")
-                        , m_strRepoMoniker
-                    );
-                }
-
-                //
-                //  Copy out the bytes to the other buffer and move forward.
-                //  We have to skip the redundant size at the end as well.
-                //
-                mbufTmp.CopyOut(mbufTmp2, c4LargeSz, c4BufInd);
-                c4BufInd += c4LargeSz + 4;
-
-                //
-                //  If it's a JPEG, we just write it out as is. Else, we force it
-                //  to JPEG and write that out.
-                //
-                if (c4LargeSz && !strPerIdLrg.bIsEmpty())
-                {
-                    if (facCIDImgFact().eProbeImg(mbufTmp2, c4LargeSz) == tCIDImage::EImgTypes::JPEG)
-                    {
-                        TBinaryFile flOut(pathLrg);
-                        flOut.Open
-                        (
-                            tCIDLib::EAccessModes::Write
-                            , tCIDLib::ECreateActs::CreateAlways
-                            , tCIDLib::EFilePerms::Default
-                            , tCIDLib::EFileFlags::SequentialScan
-                        );
-                        flOut.c4WriteBuffer(mbufTmp2, c4LargeSz);
-                    }
-                     else
-                    {
-                        // Not a JPEG, so force it to be
-                        TCIDImage* pimgJPEG = 0;
-                        facCIDImgFact().bDecodeImgTo
-                        (
-                            mbufTmp2
-                            , c4LargeSz
-                            , tCIDImage::EImgTypes::JPEG
-                            , pimgJPEG
-                            , kCIDLib::True
-                        );
-                        TJanitor<TCIDImage> janImg(pimgJPEG);
+                pathThumb.bQueryNameExt(strName);
+                bHaveAll = m_artfImgs.bHaveFile(strName);
+            }
 
-                        // Now let's write it out to the file
-                        TBinFileOutStream strmTar
-                        (
-                            pathLrg
-                            , tCIDLib::ECreateActs::CreateAlways
-                            , tCIDLib::EFilePerms::Default
-                            , tCIDLib::EFileFlags::SequentialScan
-                        );
-                        strmTar << *pimgJPEG << kCIDLib::FlushIt;
-                    }
-                }
+            if (!bHaveAll)
+                m_artfImgs.QueueImg(eType, mimgCur.c2Id(), strPerIdLrg, strPerIdSml);
+        }
+        eType++;
+    }
 
+    // And let the fetcher go get them. It watches us for shutdown requests
+    return m_artfImgs.bFetchAll(*this);
+}
 
-                // Next should be a T for thumb
-                if (tCIDLib::TCh(mbufTmp.c4At(c4BufInd)) != kCIDLib::chLatin_T)
-                {
-                    facCQCClService().ThrowErr
-                    (
-                        CID_FILE
-                        , CID_LINE
-                        , kClSrvErrs::errcData_DataMarker
-                        , pathThumb
-                        , tCIDLib::ESeverities::Failed
-                        , tCIDLib::EErrClasses::Format
-                        , TString(L"Small")
-                        , m_strRepoMoniker
-                    );
-                }
-                c4BufInd += 4;
 
-                // Next should be the thumb size
-                c4ThumbSz = mbufTmp.c4At(c4BufInd);
-                c4BufInd += 4;
+//
+//  On startup, if we have a stored database image, we load it and publish it, so
+//  that local clients can get going without waiting for us. We validate it first
+//  by creating a view on it. If anything goes wrong, we just log and move on. We'll
+//  build a new one once we have data.
+//
+tCIDLib::TVoid TCacheThread::LoadImageFile(const TString& strImgFile)
+{
+    try
+    {
+        TBinaryFile flSrc(strImgFile);
+        flSrc.Open
+        (
+            tCIDLib::EAccessModes::Read
+            , tCIDLib::ECreateActs::OpenIfExists
+            , tCIDLib::EFilePerms::Default
+            , tCIDLib::EFileFlags::SequentialScan
+        );
 
-                //
-                //  As a sanity check, there should be the same size value
-                //  just past the image data.
-                //
-                if (mbufTmp.c4At(c4BufInd + c4ThumbSz) != c4ThumbSz)
-                {
-                    facCQCClService().ThrowErr
-                    (
-                        CID_FILE
-                        , CID_LINE
-                        , kClSrvErrs::errcData_SizeInfo
-                        , pathThumb
-                        , tCIDLib::ESeverities::Failed
-                        , tCIDLib::EErrClasses::Format
-                        , TString(L"Thumb")
-                        , m_strRepoMoniker
-                    );
-                }
+        const tCIDLib::TCard4 c4ImageSz = tCIDLib::TCard4(flSrc.c8CurSize());
+        flSrc.c4ReadBuffer(m_mbufImage, c4ImageSz, tCIDLib::EAllData::FailIfNotAll);
+        flSrc.Close();
 
-                // Copy out the bytes to the other buffer
-                mbufTmp.CopyOut(mbufTmp2, c4ThumbSz, c4BufInd);
-                c4BufInd += c4ThumbSz + 4;
+        TMediaDBImage mdbiTest(m_mbufImage.pc1Data(), c4ImageSz);
+        PublishImage(m_mbufImage, c4ImageSz, TString(mdbiTest.pszSerialNum()));
+    }
 
-                // Load the data as a bitmap
-                if (c4ThumbSz && !strPerIdSml.bIsEmpty())
-                {
-                    TCIDImage* pimgBmp = 0;
-                    facCIDImgFact().bDecodeImgTo
-                    (
-                        mbufTmp2
-                        , c4ThumbSz
-                        , tCIDImage::EImgTypes::Bitmap
-                        , pimgBmp
-                        , kCIDLib::True
-                    );
-                    TJanitor<TCIDImage> janImg(pimgBmp);
+    catch(TError& errToCatch)
+    {
+        if (facCQCClService().bLogWarnings())
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+        }
+    }
+}
 
-                    // Now let's write it out to the file
-                    TBinFileOutStream strmTar
-                    (
-                        pathThumb
-                        , tCIDLib::ECreateActs::CreateAlways
-                        , tCIDLib::EFilePerms::Default
-                        , tCIDLib::EFileFlags::SequentialScan
-                    );
 
-                    strmTar << *pimgBmp << kCIDLib::FlushIt;
-                }
-            }
+//
+//  Publish a new database image to local clients. We copy it into a new shared
+//  memory buffer named for the next generation, then update the control buffer.
+//  The image class handles the control buffer update, so that clients never see
+//  the new size with the old generation or vice versa.
+//
+//  We fault in the control buffer the first time. If it's already there, some
+//  clients still have it open from a previous run of the service, so we continue
+//  on from the generation it has. That way we never try to reuse an image name
+//  that a client might still have open.
+//
+tCIDLib::TVoid
+TCacheThread::PublishImage( const   TMemBuf&            mbufImage
+                            , const tCIDLib::TCard4     c4ImageSz
+                            , const TString&            strSerialNum)
+{
+    // If we've already published this one, nothing to do
+    if (m_pmbufImgData && (strSerialNum == m_strImgSerialNum))
+        return;
+
+    TResourceName       rsnCtrl;
+    TResourceName       rsnImage;
+    tCIDLib::TBoolean   bCreated;
+    if (!m_pmbufImgCtrl)
+    {
+        TMediaDBImage::BuildResNames(m_strRepoMoniker, 0, rsnCtrl, rsnImage);
+        m_pmbufImgCtrl = new TSharedMemBuf
+        (
+            kCQCMedia::c4MDBImgCtrlSz
+            , kCQCMedia::c4MDBImgCtrlSz
+            , rsnCtrl
+            , bCreated
+            , tCIDLib::EMemAccFlags::ReadWrite
+            , tCIDLib::ECreateActs::OpenOrCreate
+        );
 
-            catch(TError& errToCatch)
-            {
-                if (facCQCClService().bShouldLog(errToCatch))
-                {
-                    errToCatch.AddStackLevel(CID_FILE, CID_LINE);
-                    TModule::LogEventObj(errToCatch);
+        m_c4ImgGen = TMediaDBImage::c4InitCtrl(*m_pmbufImgCtrl, bCreated);
+    }
 
-                    facCQCClService().LogMsg
-                    (
-                        CID_FILE
-                        , CID_LINE
-                        , kClSrvErrs::errcData_Except
-                        , pathLrg
-                        , tCIDLib::ESeverities::Failed
-                        , tCIDLib::EErrClasses::Format
-                        , m_strRepoMoniker
-                    );
-                }
-            }
+    // Move to the next generation. They are always even, and zero means none
+    m_c4ImgGen += 2;
+    if (!m_c4ImgGen)
+        m_c4ImgGen = 2;
 
-            catch(...)
-            {
-                facCQCClService().LogMsg
-                (
-                    CID_FILE
-                    , CID_LINE
-                    , kClSrvErrs::errcData_Except
-                    , pathLrg
-                    , tCIDLib::ESeverities::Failed
-                    , tCIDLib::EErrClasses::Format
-                    , m_strRepoMoniker
-                );
-            }
+    TMediaDBImage::BuildResNames(m_strRepoMoniker, m_c4ImgGen, rsnCtrl, rsnImage);
+    TSharedMemBuf* pmbufNew = new TSharedMemBuf
+    (
+        c4ImageSz
+        , c4ImageSz
+        , rsnImage
+        , bCreated
+        , tCIDLib::EMemAccFlags::ReadWrite
+        , tCIDLib::ECreateActs::CreateIfNew
+    );
+    TJanitor<TSharedMemBuf> janNew(pmbufNew);
+    pmbufNew->CopyIn(mbufImage, c4ImageSz, 0);
 
-            //
-            //  Every so many downloads, pause a bit so we don't kill the
-            //  repo.
-            //
-            c4RoundInd++;
-            if (!(c4RoundInd % 10))
-                TThread::Sleep(100);
-        }
+    TMediaDBImage::WriteCtrl(*m_pmbufImgCtrl, m_c4ImgGen, c4ImageSz);
 
-        eType++;
-    }
+    // And now we can drop the previous one and keep the new one
+    delete m_pmbufImgData;
+    m_pmbufImgData = janNew.pobjOrphan();
+    m_strImgSerialNum = strSerialNum;
 }
 
 
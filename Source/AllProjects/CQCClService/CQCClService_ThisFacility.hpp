@@ -105,17 +105,38 @@ class TCacheThread : public TThread
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
-        tCIDLib::TVoid DownloadImgs
+        tCIDLib::TBoolean bDownloadImgs
         (
-                    tCQCKit::TCQCSrvProxy&  orbcSrv
-            ,       TMediaDB&               mdbTest
-            ,       THeapBuf&               mbufTmp
+                    TMediaDB&               mdbTest
+        );
+
+        tCIDLib::TVoid LoadImageFile
+        (
+            const   TString&                strImgFile
+        );
+
+        tCIDLib::TVoid PublishImage
+        (
+            const   TMemBuf&                mbufImage
+            , const tCIDLib::TCard4         c4ImageSz
+            , const TString&                strSerialNum
         );
 
 
         // -------------------------------------------------------------------
         //  Private data members
         //
+        //  m_artfImgs
+        //      Handles downloading any cover art we don't have yet. It keeps a
+        //      manifest of the art files we have, so we don't have to check for
+        //      each one on disk.
+        //
+        //  m_bArtPending
+        //      If we didn't get all of the art we needed on the last round (we
+        //      were interrupted or some failed), this is set so that we will go
+        //      back and try again for whatever is missing, even if there is no
+        //      new data from the repo.
+        //
         //  m_c4CurDataSz
         //      The latest database info we've downloaded is stored in the
         //      m_mbufCurData member, and this is the size of that data. This
@@ -127,11 +148,22 @@ class TCacheThread : public TThread
         //      of times in a raw, we stop our thread. The master thread will
         //      see that we aren't running and remove us from the list.
         //
+        //  m_c4ImgGen
+        //      The generation of the last database image we published to local
+        //      clients. We pick up from the value in the control buffer if it is
+        //      already there, so that names never get reused while a client may
+        //      still have an old image open.
+        //
         //  m_mbufCurData
         //      The latest downloaded data is stored here. This is the zlib
         //      compressed version to speed downloads by the clients who are
         //      coming to get the data, and to reduce memory usage.
         //
+        //  m_mbufImage
+        //      A buffer we build the flat database image into, so that we can
+        //      write it to disk and publish it. We keep it around since it can
+        //      be sizeable.
+        //
         //  m_mtxSync
         //      This is used to sync updates to the current data members,
         //      since both this thread and the incoming remote client ORB
@@ -140,12 +172,23 @@ class TCacheThread : public TThread
         //      client. It's mutable since it has to lock during const method
         //      calls.
         //
+        //  m_pmbufImgCtrl
+        //  m_pmbufImgData
+        //      The shared memory buffers we publish the flat database image in
+        //      to local clients. The control buffer has the generation and size
+        //      of the current image. We keep the image open until we publish a
+        //      new one. Clients that have it open keep it alive beyond that.
+        //
         //  m_strCurSerialNum
         //      The last serial number we got. We have to pass it back in to
         //      the repo driver to see if new data is available. We start it
         //      at zero, which insures we get initial data. We also return
         //      to clients on our end when they ask for the current data.
         //
+        //  m_strImgSerialNum
+        //      The serial number of the last image we published, so that we don't
+        //      republish the same database.
+        //
         //  m_strOutPath
         //      The path that we output our information to. The clients will
         //      look here to find the info.
@@ -153,11 +196,18 @@ class TCacheThread : public TThread
         //  m_strRepoMoniker
         //      The repo for which we are set up to get data from.
         // -------------------------------------------------------------------
+        TCQCArtFetcher      m_artfImgs;
+        tCIDLib::TBoolean   m_bArtPending;
         tCIDLib::TCard4     m_c4CurDataSz;
         tCIDLib::TCard4     m_c4FailCnt;
+        tCIDLib::TCard4     m_c4ImgGen;
         THeapBuf            m_mbufCurData;
+        THeapBuf            m_mbufImage;
         mutable TMutex      m_mtxSync;
+        TSharedMemBuf*      m_pmbufImgCtrl;
+        TSharedMemBuf*      m_pmbufImgData;
         TString             m_strCurSerialNum;
+        TString             m_strImgSerialNum;
         TString             m_strOutPath;
         TString             m_strRepoMoniker;
 };
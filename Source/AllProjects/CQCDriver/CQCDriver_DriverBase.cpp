@@ -45,6 +45,76 @@ namespace
     {
         // The max sies on the cmd queues
         constexpr tCIDLib::TCard4 c4MaxQSz = 64;
+
+        //
+        //  The simple forms of field name regular expressions that we can handle
+        //  without a regular expression. See bQueryFldsByPattern().
+        //
+        enum class ENamePats
+        {
+            Exact
+            , Prefix
+            , Suffix
+            , Contains
+            , All
+            , Complex
+        };
+
+        // Any of these in the literal part makes it a real regular expression
+        const TString strRegExChars(L".*+?[](){}|\\^$");
+    }
+
+
+    //
+    //  Looks at a field name regular expression and sees if it's one of the simple
+    //  forms, i.e. a literal optionally with a leading and/or trailing .*, which is
+    //  what the vast majority of them are (LGHT#.* and such.) If so, we return the
+    //  form and the literal part.
+    //
+    CQCDriver_DriverBase::ENamePats
+    eParseNamePat(const TString& strPat, TString& strLiteral)
+    {
+        const tCIDLib::TCard4 c4Len = strPat.c4Length();
+        if (!c4Len)
+            return CQCDriver_DriverBase::ENamePats::Complex;
+
+        tCIDLib::TCard4 c4Start = 0;
+        tCIDLib::TCard4 c4End = c4Len;
+        tCIDLib::TBoolean bLead = kCIDLib::False;
+        tCIDLib::TBoolean bTrail = kCIDLib::False;
+        if ((c4Len >= 2) && (strPat[0] == kCIDLib::chPeriod) && (strPat[1] == kCIDLib::chAsterisk))
+        {
+            bLead = kCIDLib::True;
+            c4Start = 2;
+        }
+
+        if ((c4End >= c4Start + 2)
+        &&  (strPat[c4End - 2] == kCIDLib::chPeriod)
+        &&  (strPat[c4End - 1] == kCIDLib::chAsterisk))
+        {
+            bTrail = kCIDLib::True;
+            c4End -= 2;
+        }
+
+        strLiteral.Clear();
+        for (tCIDLib::TCard4 c4Index = c4Start; c4Index < c4End; c4Index++)
+        {
+            const tCIDLib::TCh chCur = strPat[c4Index];
+            if (CQCDriver_DriverBase::strRegExChars.bContainsChar(chCur))
+                return CQCDriver_DriverBase::ENamePats::Complex;
+            strLiteral.Append(chCur);
+        }
+
+        if (strLiteral.bIsEmpty())
+            return CQCDriver_DriverBase::ENamePats::All;
+
+        if (bLead && bTrail)
+            return CQCDriver_DriverBase::ENamePats::Contains;
+        else if (bLead)
+            return CQCDriver_DriverBase::ENamePats::Suffix;
+        else if (bTrail)
+            return CQCDriver_DriverBase::ENamePats::Prefix;
+        return CQCDriver_DriverBase::ENamePats::Exact;
     }
 }
 
@@ -541,6 +611,7 @@ TCQCServerBase::~TCQCServerBase()
     //
     m_colFldIdList.RemoveAll();
     m_colFldNameList.RemoveAll();
+    RebuildFldIndices();
 
     //
     //  There shouldn't be any commands in the command queue, but release
@@ -3106,7 +3177,8 @@ TCQCServerBase::c4QueryFields(  TQueryFieldList&    colToFill
 //
 //  Allows CQCServer to ask us for a list of the names of any of our fields
 //  that have the requested access types. And another that uses a regular
-//  expression to filter field names.
+//  expression to filter field names. That one first checks for the common
+//  simple patterns, which we can handle much more cheaply.
 //
 tCIDLib::TCard4
 TCQCServerBase::c4QueryFieldNames(          TVector<TString>&   colToFill
@@ -3130,10 +3202,18 @@ TCQCServerBase::c4QueryFieldNamesRX(        TVector<TCQCFldDef>&    colToFill
                                     , const TString&                strNameRegEx
                                     , const tCQCKit::EReqAccess     eAccess)
 {
-    // Set up the regular expression
-    TRegEx regxName(strNameRegEx);
     colToFill.RemoveAll();
 
+    // Most are simple patterns we can handle without a regular expression
+    {
+        TLocker lockrSync(&m_mtxSync);
+        if (bQueryFldsByPattern(colToFill, strNameRegEx, eAccess))
+            return colToFill.c4ElemCount();
+    }
+
+    // Set up the regular expression. Field names are not case sensitive
+    TRegEx regxName(strNameRegEx);
+
     TLocker lockrSync(&m_mtxSync);
     const tCIDLib::TCard4 c4Count = m_colFldIdList.c4ElemCount();
     for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
@@ -3141,7 +3221,7 @@ TCQCServerBase::c4QueryFieldNamesRX(        TVector<TCQCFldDef>&    colToFill
         const TCQCFldDef& flddCur = m_colFldIdList[c4Index]->flddInfo();
         if (facCQCKit().bCheckFldAccess(eAccess, flddCur.eAccess()))
         {
-            if (regxName.bFullyMatches(flddCur.strName()))
+            if (regxName.bFullyMatches(flddCur.strName(), kCIDLib::False))
                 colToFill.objAdd(flddCur);
         }
     }
@@ -3156,6 +3236,10 @@ TCQCServerBase::c4QueryFieldNamesRX(        TVector<TCQCFldDef>&    colToFill
 //  at least the indicated access. This is a new V2 architecture thing,
 //  starting with version 4.0.
 //
+//  We keep an index of field ids by semantic type, so we only have to look
+//  at the fields of the requested types, not all of them. The results are
+//  grouped by type, in the order of the types passed.
+//
 tCIDLib::TCard4 TCQCServerBase::
 c4QuerySemFields(const  TFundVector<tCQCKit::EFldSTypes>&   fcolTypes
                 , const tCQCKit::EReqAccess                 eReqAccess
@@ -3172,24 +3256,26 @@ c4QuerySemFields(const  TFundVector<tCQCKit::EFldSTypes>&   fcolTypes
     // Lock while we do this
     TLocker lockrSync(&m_mtxSync);
 
-    // If only one we can do a more efficient check
-    const tCQCKit::EFldSTypes eOneType = fcolTypes[0];
-
-    const tCIDLib::TCard4 c4Count = m_colFldIdList.c4ElemCount();
-    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    for (tCIDLib::TCard4 c4TInd = 0; c4TInd < c4STCnt; c4TInd++)
     {
-        const TCQCFldDef& flddCur = m_colFldIdList[c4Index]->flddInfo();
+        // Skip bad types, or ones we've already done if they pass any twice
+        const tCQCKit::EFldSTypes eCurType = fcolTypes[c4TInd];
+        if (eCurType >= tCQCKit::EFldSTypes::Count)
+            continue;
 
-        // Take it if it has the right access
-        if (facCQCKit().bCheckFldAccess(eReqAccess, flddCur.eAccess()))
+        tCIDLib::TCard4 c4PrevInd = 0;
+        while ((c4PrevInd < c4TInd) && (fcolTypes[c4PrevInd] != eCurType))
+            c4PrevInd++;
+        if (c4PrevInd < c4TInd)
+            continue;
+
+        // Take any of the fields of this type that have the right access
+        const TSemIdList& fcolIds = m_colSemIndex[tCIDLib::c4EnumOrd(eCurType)];
+        const tCIDLib::TCard4 c4Count = fcolIds.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
         {
-            //
-            //  If only one type and it matches take it. Else search the types
-            //  list for the type of the current field.
-            //
-            if ((c4STCnt == 1) && (flddCur.eSemType() == eOneType))
-                colToFill.objAdd(flddCur);
-            else if (fcolTypes.bElementPresent(flddCur.eSemType()))
+            const TCQCFldDef& flddCur = m_colFldIdList[fcolIds[c4Index]]->flddInfo();
+            if (facCQCKit().bCheckFldAccess(eReqAccess, flddCur.eAccess()))
                 colToFill.objAdd(flddCur);
         }
     }
@@ -5604,8 +5690,13 @@ tCIDLib::TVoid TCQCServerBase::StartShutdown()
     //  driver.
     //
     if (m_pthrDevPoll)
+    {
         m_pthrDevPoll->ReqShutdownNoSync();
-    else
+
+        // Wake it up if it's waiting for commands, so it sees the request now
+        m_evCmdQ.Trigger();
+    }
+     else
         m_eState = tCQCKit::EDrvStates::Terminated;
 }
 
@@ -5707,6 +5798,18 @@ tCIDLib::TVoid TCQCServerBase::UseDefFldValue(const tCIDLib::TCard4 c4FldId)
 }
 
 
+//
+//  Drivers whose device reports data asynchronously (via their own I/O thread or
+//  a socket or whatever) can call this to make the driver thread stop waiting for
+//  commands and go back and call ePollDevice() immediately, instead of waiting for
+//  the poll time to run out. It can be called from any thread.
+//
+tCIDLib::TVoid TCQCServerBase::WakeForPoll()
+{
+    m_evPollWake.Trigger();
+}
+
+
 // ---------------------------------------------------------------------------
 //  TCQCServerBase: Hidden constructor
 // ---------------------------------------------------------------------------
@@ -5737,8 +5840,11 @@ TCQCServerBase::TCQCServerBase() :
       (
         tCIDLib::EAdoptOpts::Adopt, 109, TStringKeyOps(), &TCQCFldStore::strKey
       )
+    , m_colSemIndex(tCIDLib::c4EnumOrd(tCQCKit::EFldSTypes::Count))
     , m_colTmp(32)
     , m_mbufTmp(4096)
+    , m_evCmdQ(tCIDLib::EEventStates::Reset)
+    , m_evPollWake(tCIDLib::EEventStates::Reset)
     , m_strmFmt(1024UL)
 {
     CommonInit(kCIDLib::True);
@@ -5755,9 +5861,12 @@ TCQCServerBase::TCQCServerBase(const TCQCDriverObjCfg& cqcdcInfo) :
       (
         tCIDLib::EAdoptOpts::Adopt, 109, TStringKeyOps(), &TCQCFldStore::strKey
       )
+    , m_colSemIndex(tCIDLib::c4EnumOrd(tCQCKit::EFldSTypes::Count))
     , m_colTmp(32)
     , m_mbufTmp(4096UL)
     , m_cqcdcThis(cqcdcInfo)
+    , m_evCmdQ(tCIDLib::EEventStates::Reset)
+    , m_evPollWake(tCIDLib::EEventStates::Reset)
     , m_strmFmt(1024UL)
 {
     CommonInit(kCIDLib::False);
@@ -5920,6 +6029,18 @@ tCIDLib::TVoid TCQCServerBase::VerboseModeChanged(const tCQCKit::EVerboseLvls)
 //  TCQCServerBase: Protected, non-virtual methods
 // ---------------------------------------------------------------------------
 
+//
+//  Drivers that talk to a socket (or other data source) can associate it with our
+//  poll wake event, so that the driver thread is woken up for a poll as soon as
+//  there's data to read. We don't expose the event itself, since only we should
+//  ever reset it. Anything else can just call WakeForPoll().
+//
+tCIDLib::TVoid TCQCServerBase::AssociatePollWake(TCIDDataSrc& cdsToAssoc)
+{
+    cdsToAssoc.AssociateReadEvent(m_evPollWake);
+}
+
+
 // Return the value of a boolean field by id
 tCIDLib::TBoolean TCQCServerBase::bFldValue(const tCIDLib::TCard4 c4Id) const
 {
@@ -6368,7 +6489,10 @@ TCQCServerBase::SetFields(          TSetFieldList&      colList
 
     // If no fields passed in, then we are done now
     if (!c4Count)
+    {
+        RebuildFldIndices();
         return;
+    }
 
     //
     //  We'll use this to assign field ids as we go, bumping it for each one.
@@ -6601,12 +6725,16 @@ TCQCServerBase::SetFields(          TSetFieldList&      colList
         m_c4FieldListId++;
         m_colFldNameList.RemoveAll();
         m_colFldIdList.RemoveAll();
+        RebuildFldIndices();
         RegDefFields();
 
         // And now rethrow
         throw;
     }
 
+    // Update the semantic type index for the new fields
+    RebuildFldIndices();
+
     // Bump the field list id, to invalidate any current field info in clients
     m_c4FieldListId++;
 }
@@ -7004,6 +7132,113 @@ TCQCServerBase::bFldWriteChecks(const   TCQCFldStore&           cfsCheck
 }
 
 
+//
+//  Called by c4QueryFieldNamesRX with the lock held. If the pattern is one of the
+//  simple forms (see eParseNamePat above), we do the query without a regular
+//  expression and return true. Else we return false and the caller does it the
+//  regular way. Literal prefixes, which are by far the most common, are looked up
+//  in the sorted name list. The results are the same as a full match against the
+//  pattern would give, and in the same (field id) order, since callers display
+//  them in the order returned. Like the regular expression path, and like field
+//  name lookups in general, the matching is not case sensitive.
+//
+tCIDLib::TBoolean
+TCQCServerBase::bQueryFldsByPattern(        TVector<TCQCFldDef>&    colToFill
+                                    , const TString&                strNameRegEx
+                                    , const tCQCKit::EReqAccess     eAccess)
+{
+    TString strLit;
+    const CQCDriver_DriverBase::ENamePats ePat = eParseNamePat(strNameRegEx, strLit);
+    if (ePat == CQCDriver_DriverBase::ENamePats::Complex)
+        return kCIDLib::False;
+
+    if (ePat == CQCDriver_DriverBase::ENamePats::Prefix)
+    {
+        // Find the first name that is not less than the prefix
+        tCIDLib::TCard4 c4Low = 0;
+        tCIDLib::TCard4 c4High = m_colFldSorted.c4ElemCount();
+        while (c4Low < c4High)
+        {
+            const tCIDLib::TCard4 c4Mid = c4Low + ((c4High - c4Low) / 2);
+            if (m_colFldSorted[c4Mid].m_strName.eCompareI(strLit) == tCIDLib::ESortComps::FirstLess)
+                c4Low = c4Mid + 1;
+            else
+                c4High = c4Mid;
+        }
+
+        //
+        //  And take them until we get to one that doesn't start with the prefix.
+        //  They are in name order, so we collect the ids and sort them back into
+        //  id order before adding them.
+        //
+        tCIDLib::TCardList fcolIds;
+        const tCIDLib::TCard4 c4Count = m_colFldSorted.c4ElemCount();
+        while (c4Low < c4Count)
+        {
+            const TSortedFld& sfldCur = m_colFldSorted[c4Low++];
+            if (!sfldCur.m_strName.bStartsWithI(strLit))
+                break;
+            fcolIds.c4AddElement(sfldCur.m_c4Id);
+        }
+        fcolIds.Sort(tCIDLib::eComp<tCIDLib::TCard4>);
+
+        const tCIDLib::TCard4 c4IdCount = fcolIds.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4IdCount; c4Index++)
+        {
+            const TCQCFldDef& flddCur = m_colFldIdList[fcolIds[c4Index]]->flddInfo();
+            if (facCQCKit().bCheckFldAccess(eAccess, flddCur.eAccess()))
+                colToFill.objAdd(flddCur);
+        }
+        return kCIDLib::True;
+    }
+
+    if (ePat == CQCDriver_DriverBase::ENamePats::Exact)
+    {
+        // The name list isn't case sensitive either, so just look it up
+        const TCQCFldStore* pcfsFld = m_colFldNameList.pobjFindByKey(strLit, kCIDLib::False);
+        if (pcfsFld
+        &&  facCQCKit().bCheckFldAccess(eAccess, pcfsFld->flddInfo().eAccess()))
+        {
+            colToFill.objAdd(pcfsFld->flddInfo());
+        }
+        return kCIDLib::True;
+    }
+
+    //
+    //  For the others we still have to check them all, but it's a lot cheaper. For
+    //  contains we compare upper cased copies.
+    //
+    if (ePat == CQCDriver_DriverBase::ENamePats::Contains)
+        strLit.ToUpper();
+
+    tCIDLib::TCard4 c4At;
+    TString strName;
+    const tCIDLib::TCard4 c4Count = m_colFldIdList.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        const TCQCFldDef& flddCur = m_colFldIdList[c4Index]->flddInfo();
+        if (!facCQCKit().bCheckFldAccess(eAccess, flddCur.eAccess()))
+            continue;
+
+        tCIDLib::TBoolean bMatch = kCIDLib::True;
+        if (ePat == CQCDriver_DriverBase::ENamePats::Suffix)
+        {
+            bMatch = flddCur.strName().bEndsWithI(strLit);
+        }
+         else if (ePat == CQCDriver_DriverBase::ENamePats::Contains)
+        {
+            strName = flddCur.strName();
+            strName.ToUpper();
+            bMatch = strName.bFirstOccurrence(strLit, c4At);
+        }
+
+        if (bMatch)
+            colToFill.objAdd(flddCur);
+    }
+    return kCIDLib::True;
+}
+
+
 //
 //  Our field read methods call this to make sure the indicated field is readable
 //  or not. It might be called from other things if needed to check for read or write
@@ -8317,6 +8552,11 @@ tCIDLib::TVoid TCQCServerBase::NSRegistration()
 //  soon as possible when it's seen. We go back and the main thread loop
 //  will see it and shut us down.
 //
+//  We don't poll the queue. QueueCmd() and StartShutdown() trigger the
+//  command event, so we block on that and the poll wakeup event, and react
+//  as soon as either is triggered. If the driver wakes us for a poll, we
+//  return early so that the main loop will call ePollDevice() now.
+//
 tCIDLib::TVoid TCQCServerBase::ProcessCmds(const tCIDLib::TCard4 c4WaitMSs)
 {
     //
@@ -8361,8 +8601,9 @@ tCIDLib::TVoid TCQCServerBase::ProcessCmds(const tCIDLib::TCard4 c4WaitMSs)
 
         //
         //  Wait a bit for a command to show up. If a shutdown request
-        //  happens, we'll wake up with no command. Wait up to 250ms for
-        //  something to show up.
+        //  happens, we'll wake up with no command. We still wait no more
+        //  than 250ms at a time, so that Idle() gets called regularly, but
+        //  commands no longer wait for that to run out.
         //
         tCIDLib::TCard4 c4WaitCur = tCIDLib::TCard4
         (
@@ -8377,11 +8618,37 @@ tCIDLib::TVoid TCQCServerBase::ProcessCmds(const tCIDLib::TCard4 c4WaitMSs)
         if (c4WaitCur > 250)
             c4WaitCur = 250;
 
-        // And now wait that long for the new command
+        //
+        //  If there's nothing already queued, block until a command is queued,
+        //  the driver asks to be polled, or we time out. We reset the command
+        //  event before checking again, so a command queued in between will
+        //  just trigger it again and we'll see it next time around.
+        //
         TCQCServerBase::TDrvCmd* pdcmdNew = m_colCmdQ.pobjGetNext
         (
-            c4WaitCur, kCIDLib::False
+            0, kCIDLib::False
         );
+        if (!pdcmdNew)
+        {
+            const tCIDLib::TCard4 c4Which = TEvent::c4WaitMultiple
+            (
+                m_evCmdQ, m_evPollWake, c4WaitCur
+            );
+
+            if (c4Which == 1)
+            {
+                m_evPollWake.Reset();
+                break;
+            }
+
+            if (c4Which == 0)
+            {
+                m_evCmdQ.Reset();
+                if (!m_colCmdQSpec.bIsEmpty())
+                    break;
+                pdcmdNew = m_colCmdQ.pobjGetNext(0, kCIDLib::False);
+            }
+        }
 
         //
         //  If no command this time, go back to the top and try again. We
@@ -8777,12 +9044,42 @@ TCQCServerBase::QueueCmd(TCmdQ& colTarQ, TDrvCmd* const pdcmdToAdopt)
         return;
     }
 
-    // Looks like we want to keep it, so queue it up
+    //
+    //  Looks like we want to keep it, so queue it up, and wake up the driver
+    //  thread if it's waiting in ProcessCmds().
+    //
     colTarQ.Add(pdcmdToAdopt);
+    m_evCmdQ.Trigger();
 }
 
 
 
+//
+//  Rebuilds the sorted field name list and the index of field ids by semantic
+//  type, after the field list has changed. The caller must have the lock, if
+//  required.
+//
+tCIDLib::TVoid TCQCServerBase::RebuildFldIndices()
+{
+    const tCIDLib::TCard4 c4TypeCnt = tCIDLib::c4EnumOrd(tCQCKit::EFldSTypes::Count);
+    for (tCIDLib::TCard4 c4TInd = 0; c4TInd < c4TypeCnt; c4TInd++)
+        m_colSemIndex[c4TInd].RemoveAll();
+    m_colFldSorted.RemoveAll();
+
+    const tCIDLib::TCard4 c4Count = m_colFldIdList.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        const TCQCFldDef& flddCur = m_colFldIdList[c4Index]->flddInfo();
+        m_colFldSorted.objAdd(TSortedFld(c4Index, flddCur.strName()));
+
+        const tCQCKit::EFldSTypes eType = flddCur.eSemType();
+        if (eType < tCQCKit::EFldSTypes::Count)
+            m_colSemIndex[tCIDLib::c4EnumOrd(eType)].c4AddElement(c4Index);
+    }
+    m_colFldSorted.Sort(&TSortedFld::eComp);
+}
+
+
 //
 //  We add magic fields that all drivers will have, without having to
 //  register them. These are 'instrumentation data' fields, which are
@@ -1402,6 +1402,8 @@ class CQCDRIVEREXPORT TCQCServerBase : public TObject
             const   tCIDLib::TCard4         c4FldId
         );
 
+        tCIDLib::TVoid WakeForPoll();
+
 
     protected :
         // -------------------------------------------------------------------
@@ -1532,6 +1534,11 @@ class CQCDRIVEREXPORT TCQCServerBase : public TObject
         //  These are just helper methods for all of the drivers derived from
         //  this class.
         // -------------------------------------------------------------------
+        tCIDLib::TVoid AssociatePollWake
+        (
+                    TCIDDataSrc&            cdsToAssoc
+        );
+
         tCIDLib::TBoolean bAutoLock() const;
 
         tCIDLib::TBoolean bAutoLock
@@ -1682,6 +1689,34 @@ class CQCDRIVEREXPORT TCQCServerBase : public TObject
         //  Private data types
         // -------------------------------------------------------------------
         using TStTimesArray = TEArray<tCIDLib::TCard4, tCQCKit::EDrvStates, tCQCKit::EDrvStates::Count> ;
+        using TSemIdList = TFundVector<tCIDLib::TCard4>;
+        using TSemIndex = TObjArray<TSemIdList>;
+
+        // An entry in the sorted field name list, used for name pattern queries
+        class TSortedFld
+        {
+            public :
+                static tCIDLib::ESortComps eComp
+                (
+                    const   TSortedFld&     sfld1
+                    , const TSortedFld&     sfld2
+                )
+                {
+                    return sfld1.m_strName.eCompareI(sfld2.m_strName);
+                }
+
+                TSortedFld() : m_c4Id(0) {}
+                TSortedFld(const tCIDLib::TCard4 c4Id, const TString& strName) :
+
+                    m_c4Id(c4Id)
+                    , m_strName(strName)
+                {
+                }
+
+                tCIDLib::TCard4 m_c4Id;
+                TString         m_strName;
+        };
+        using TSortedFldList = TVector<TSortedFld>;
 
 
         // -------------------------------------------------------------------
@@ -1707,6 +1742,13 @@ class CQCDRIVEREXPORT TCQCServerBase : public TObject
             , const TString&                strName
         );
 
+        tCIDLib::TBoolean bQueryFldsByPattern
+        (
+                    TVector<TCQCFldDef>&    colToFill
+            , const TString&                strNameRegEx
+            , const tCQCKit::EReqAccess     eAccess
+        );
+
         tCIDLib::TVoid CheckAccess
         (
             const   TCQCFldStore&           cfsToCheck
@@ -1997,6 +2039,8 @@ class CQCDRIVEREXPORT TCQCServerBase : public TObject
             const   tCIDLib::TCard4         c4WaitMSs
         );
 
+        tCIDLib::TVoid RebuildFldIndices();
+
         tCIDLib::TVoid RegDefFields();
 
         tCIDLib::TVoid NSRegistration();
@@ -2096,6 +2140,20 @@ class CQCDRIVEREXPORT TCQCServerBase : public TObject
         //      by name list is a ref hash set, and it owns the objects. The by
         //      id list is a ref vector that just references the fields.
         //
+        //  m_colFldSorted
+        //      The names and ids of our fields, sorted by name, case insensitively
+        //      since field names are matched that way. This lets name
+        //      pattern queries that are just a literal prefix do a binary search
+        //      for the range of matching fields, instead of running a regular
+        //      expression on every field. It's rebuilt any time the field list
+        //      is changed, under the same lock.
+        //
+        //  m_colSemIndex
+        //      An index of our fields by semantic type, so that semantic field
+        //      queries only have to look at the fields of the requested types. It
+        //      is indexed by the semantic type and holds the ids of the fields of
+        //      that type, in id order. It's rebuilt along with m_colFldSorted.
+        //
         //  m_colTimedChanges
         //      This is where we store any pending timed field changes. This
         //      is treated like field data, and the field lock is used to
@@ -2136,6 +2194,17 @@ class CQCDRIVEREXPORT TCQCServerBase : public TObject
         //      updates the new one. If the driver thread sees they are
         //      different, it stores the ne one and calls the driver callback.
         //
+        //  m_evCmdQ
+        //      Triggered by QueueCmd() when a command is queued (and by
+        //      StartShutdown()), so that ProcessCmds() can block until there's
+        //      something to do instead of checking the queue periodically.
+        //
+        //  m_evPollWake
+        //      Triggered by WakeForPoll(), or by a data source the driver has
+        //      associated with it via AssociatePollWake(), to make ProcessCmds()
+        //      return early so that the device gets polled now. Only we reset
+        //      it, so it's not exposed directly.
+        //
         //  m_mtxSync
         //      This is used to synchronize all reads and updates of the
         //      driver state and field values and such. It is never locked
@@ -2208,6 +2277,8 @@ class CQCDRIVEREXPORT TCQCServerBase : public TObject
         TCmdQ                   m_colCmdQSpec;
         TFieldIdList            m_colFldIdList;
         TFieldNameList          m_colFldNameList;
+        TSortedFldList          m_colFldSorted;
+        TSemIndex               m_colSemIndex;
         TTimedChgList           m_colTimedChanges;
         TCQCDriverObjCfg        m_cqcdcThis;
         TCQCUserCtx             m_cuctxDrv;
@@ -2217,6 +2288,8 @@ class CQCDRIVEREXPORT TCQCServerBase : public TObject
         tCQCKit::EDrvStates     m_eState;
         tCQCKit::EVerboseLvls   m_eVerboseLevel;
         tCQCKit::EVerboseLvls   m_eVerboseNew;
+        TEvent                  m_evCmdQ;
+        TEvent                  m_evPollWake;
         TMutex                  m_mtxSync;
         TOrbObjId               m_ooidSrvAdmin;
         TThread*                m_pthrDevPoll;
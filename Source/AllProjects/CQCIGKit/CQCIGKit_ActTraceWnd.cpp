@@ -199,7 +199,8 @@ tCIDLib::TVoid TActTraceWnd::ActStartNew(const TStdVarsTar& ctarGlobals)
     QueueLine(L"\n");
     QueueLine(L"Global Vars=\n");
 
-    // Dump out all the global variables
+    // Dump out all the global variables, locking them while we do it
+    TStdVarTarLockJan janVars(&ctarGlobals);
     tCQCKit::TVarList::TCursor cursDump(ctarGlobals.cursVars());
     if (cursDump.bReset())
     {
@@ -89,6 +89,7 @@ class TCQCUserAccount;
 #include    "CQCKit_Type.hpp"
 #include    "CQCKit_Constant.hpp"
 
+#include    "CQCKit_TokenPattern.hpp"
 #include    "CQCKit_CmdIntf.hpp"
 
 #include    "CQCKit_Expression.hpp"
@@ -195,6 +196,14 @@ namespace tCQCKit
     using TFldValList       = TRefVector<TCQCFldValue>;
 
 
+    // -----------------------------------------------------------------------
+    //  A counted pointer to a field value. The polling engine hands out
+    //  immutable snapshots of field values via these, so that many clients
+    //  can share one copy of a value.
+    // -----------------------------------------------------------------------
+    using TFldValPtr        = TCntPtr<const TCQCFldValue>;
+
+
     // -----------------------------------------------------------------------
     //  A counted pointer to an event object. We use this during handling of
     //  trigged events so as to avoid undue replication of the event data.
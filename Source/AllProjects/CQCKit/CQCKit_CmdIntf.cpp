@@ -199,6 +199,36 @@ namespace
         };
         TAtomicFlag          atomRTValsLoaded;
         TVector<TRTValItem>  colRTVs(32);
+
+
+        // -----------------------------------------------------------------------
+        //  The command id atoms handed out by TCQCCmdCfg::c4MapCmdAtom(). Zero is
+        //  never used, so it means no command id.
+        // -----------------------------------------------------------------------
+        class TCmdAtomItem
+        {
+            public :
+                static const TString& strKey(const TCmdAtomItem& itemSrc)
+                {
+                    return itemSrc.m_strId;
+                }
+
+                TCmdAtomItem(const TString& strId, const tCIDLib::TCard4 c4Atom) :
+
+                    m_c4Atom(c4Atom)
+                    , m_strId(strId)
+                {
+                }
+
+                tCIDLib::TCard4 m_c4Atom;
+                TString         m_strId;
+        };
+        using TCmdAtomMap = TKeyedHashSet<TCmdAtomItem, TString, TStringKeyOps>;
+
+        TCmdAtomMap colCmdAtoms
+        (
+            109, TStringKeyOps(), &TCmdAtomItem::strKey, tCIDLib::EMTStates::Safe
+        );
     }
 }
 
@@ -1114,6 +1144,7 @@ TCQCCmdCfg::TParmInfo::TParmInfo(const  tCQCKit::ECmdPTypes eType
     m_eType(eType)
     , m_strValue(strValue)
 {
+    ParseTokens();
 }
 
 TCQCCmdCfg::TParmInfo::~TParmInfo()
@@ -1145,10 +1176,76 @@ TCQCCmdCfg::TParmInfo::i4Val(const tCIDLib::ERadices eRadix) const
 }
 
 
+//
+//  Pre-parse our value for token replacement, so that action engines don't have
+//  to parse it every time the command is run. Expressions aren't expanded, so we
+//  skip those. If it has no tokens or escapes, or has errors, we don't keep a
+//  pattern and the error will be reported when it's expanded.
+//
+tCIDLib::TVoid TCQCCmdCfg::TParmInfo::ParseTokens()
+{
+    m_cptrTokens.DropRef();
+    if ((m_eType == tCQCKit::ECmdPTypes::Expression)
+    ||  !TCQCTokenPattern::bHasSpecialChars(m_strValue, kCIDLib::True))
+    {
+        return;
+    }
+
+    TCQCTokenPattern* pctpNew = new TCQCTokenPattern();
+    TJanitor<TCQCTokenPattern> janPat(pctpNew);
+    TString strErr;
+    if (pctpNew->bParse(m_strValue, kCIDLib::True, strErr))
+        m_cptrTokens.SetPointer(janPat.pobjOrphan());
+}
+
+
+//
+//  Return the pre-parsed pattern if we have one and it's still for the current
+//  value, else null.
+//
+const TCQCTokenPattern* TCQCCmdCfg::TParmInfo::pctpTokens() const
+{
+    const TCQCTokenPattern* pctpRet = m_cptrTokens.pobjData();
+    if (pctpRet && (pctpRet->strSource() != m_strValue))
+        pctpRet = nullptr;
+    return pctpRet;
+}
+
+
 tCIDLib::TVoid TCQCCmdCfg::TParmInfo::Reset()
 {
     m_eType = tCQCKit::ECmdPTypes::None;
     m_strValue.Clear();
+    m_cptrTokens.DropRef();
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TCQCCmdCfg: Public, static methods
+// ---------------------------------------------------------------------------
+
+//
+//  Map a command id to a small process-wide number, adding it if not seen yet.
+//  We store this on each command config when its id is set or streamed in, so
+//  that targets can map commands at runtime without any string work.
+//
+tCIDLib::TCard4 TCQCCmdCfg::c4MapCmdAtom(const TString& strCmdId)
+{
+    if (strCmdId.bIsEmpty())
+        return 0;
+
+    TLocker lockrAtoms(&CQCKit_CmdIntf::colCmdAtoms);
+    const CQCKit_CmdIntf::TCmdAtomItem* pitemAtom
+    (
+        CQCKit_CmdIntf::colCmdAtoms.pobjFindByKey(strCmdId, kCIDLib::False)
+    );
+    if (pitemAtom)
+        return pitemAtom->m_c4Atom;
+
+    const tCIDLib::TCard4 c4Atom = CQCKit_CmdIntf::colCmdAtoms.c4ElemCount() + 1;
+    CQCKit_CmdIntf::colCmdAtoms.objAdd(CQCKit_CmdIntf::TCmdAtomItem(strCmdId, c4Atom));
+    return c4Atom;
 }
 
 
@@ -1158,7 +1255,8 @@ tCIDLib::TVoid TCQCCmdCfg::TParmInfo::Reset()
 // ---------------------------------------------------------------------------
 TCQCCmdCfg::TCQCCmdCfg() :
 
-    m_c4ParmCnt(0)
+    m_c4CmdAtom(0)
+    , m_c4ParmCnt(0)
     , m_c4TargetId(0)
     , m_colParms(kCQCKit::c4MaxCmdParms)
 {
@@ -1173,7 +1271,8 @@ TCQCCmdCfg::TCQCCmdCfg( const   TString&            strCmdId
                         , const TString&            strTargetId
                         , const TString&            strTargetName) :
 
-    m_c4ParmCnt(0)
+    m_c4CmdAtom(c4MapCmdAtom(strCmdId))
+    , m_c4ParmCnt(0)
     , m_c4TargetId(0)
     , m_colParms(kCQCKit::c4MaxCmdParms)
     , m_strCmdId(strCmdId)
@@ -1185,7 +1284,8 @@ TCQCCmdCfg::TCQCCmdCfg( const   TString&            strCmdId
 
 TCQCCmdCfg::TCQCCmdCfg(const TCQCCmd& cmdSrc) :
 
-    m_c4ParmCnt(cmdSrc.c4ParmCnt())
+    m_c4CmdAtom(c4MapCmdAtom(cmdSrc.strId()))
+    , m_c4ParmCnt(cmdSrc.c4ParmCnt())
     , m_c4TargetId(0)
     , m_colParms(kCQCKit::c4MaxCmdParms)
     , m_strCmdId(cmdSrc.strId())
@@ -1268,6 +1368,13 @@ TCQCCmdCfg::bSearchNReplace(const   TString&            strFind
 }
 
 
+// Get the command id atom that was mapped when the command id was set
+tCIDLib::TCard4 TCQCCmdCfg::c4CmdAtom() const
+{
+    return m_c4CmdAtom;
+}
+
+
 // Get or set the parameter count
 tCIDLib::TCard4 TCQCCmdCfg::c4ParmCnt() const
 {
@@ -1402,6 +1509,7 @@ TCQCCmdCfg::TParmInfo& TCQCCmdCfg::piAt(const tCIDLib::TCard4 c4At)
 // Just resets this guy back to a non-configured state
 tCIDLib::TVoid TCQCCmdCfg::Reset()
 {
+    m_c4CmdAtom  = 0;
     m_c4ParmCnt  = 0;
     m_strCmdId.Clear();
     m_strName.Clear();
@@ -1419,6 +1527,7 @@ const TString& TCQCCmdCfg::strCmdId() const
 const TString& TCQCCmdCfg::strCmdId(const TString& strToSet)
 {
     m_strCmdId = strToSet;
+    m_c4CmdAtom = c4MapCmdAtom(m_strCmdId);
     return m_strCmdId;
 }
 
@@ -1470,6 +1579,7 @@ tCIDLib::TVoid TCQCCmdCfg::SetFrom( const   TCQCCmd&                cmdSrc
     m_c4ParmCnt = cmdSrc.c4ParmCnt();
     m_strCmdId  = cmdSrc.strId();
     m_strName   = cmdSrc.strName();
+    m_c4CmdAtom = c4MapCmdAtom(m_strCmdId);
 
     //
     //  For any parms that are defined, provide defaults for those that
@@ -1639,6 +1749,7 @@ tCIDLib::TVoid TCQCCmdCfg::StreamFrom(TBinInStream& strmToReadFrom)
                     >> m_strName
                     >> m_strTargetId
                     >> m_strTargetName;
+    m_c4CmdAtom = c4MapCmdAtom(m_strCmdId);
 
     // Stream the parameters in
     TString strVal;
@@ -1652,6 +1763,7 @@ tCIDLib::TVoid TCQCCmdCfg::StreamFrom(TBinInStream& strmToReadFrom)
         TParmInfo& piNew = m_colParms[c4Index];
         piNew.m_eType = eType;
         piNew.m_strValue = strVal;
+        piNew.ParseTokens();
     }
 
     // Reset the rest to defaults
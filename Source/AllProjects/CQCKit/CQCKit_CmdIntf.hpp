@@ -702,6 +702,10 @@ class CQCKITEXPORT TCQCCmdCfg : public TObject, public MStreamable
                     const   tCIDLib::ERadices   eRadix = tCIDLib::ERadices::Auto
                 )   const;
 
+                tCIDLib::TVoid ParseTokens();
+
+                [[nodiscard]] const TCQCTokenPattern* pctpTokens() const;
+
                 tCIDLib::TVoid Reset();
 
 
@@ -716,9 +720,31 @@ class CQCKITEXPORT TCQCCmdCfg : public TObject, public MStreamable
                 // -----------------------------------------------------------
                 tCQCKit::ECmdPTypes m_eType;
                 TString             m_strValue;
+
+
+            private :
+                // -----------------------------------------------------------
+                //  Private data members
+                //
+                //  m_cptrTokens
+                //      The value pre-parsed for token replacement, if it has
+                //      any tokens or escapes. It's set when the value is loaded.
+                //      Since the value is public, pctpTokens() makes sure it
+                //      still matches before returning it.
+                // -----------------------------------------------------------
+                tCQCKit::TTokPatPtr m_cptrTokens;
         };
 
 
+        // -------------------------------------------------------------------
+        //  Public, static methods
+        // -------------------------------------------------------------------
+        static tCIDLib::TCard4 c4MapCmdAtom
+        (
+            const   TString&                strCmdId
+        );
+
+
         // -------------------------------------------------------------------
         //  Constructors and Destructor
         // -------------------------------------------------------------------
@@ -766,6 +792,8 @@ class CQCKITEXPORT TCQCCmdCfg : public TObject, public MStreamable
             ,       TRegEx&                 regxFind
         );
 
+        [[nodiscard]] tCIDLib::TCard4 c4CmdAtom() const;
+
         [[nodiscard]] tCIDLib::TCard4 c4ParmCnt() const;
 
         tCIDLib::TCard4 c4ParmCnt
@@ -898,6 +926,12 @@ class CQCKITEXPORT TCQCCmdCfg : public TObject, public MStreamable
         // -------------------------------------------------------------------
         //  Private data members
         //
+        //  m_c4CmdAtom
+        //      The process-wide atom for m_strCmdId, see c4MapCmdAtom(). It is
+        //      updated whenever the command id is set or streamed in, and is
+        //      not persisted, so targets can map the command without doing any
+        //      string lookups per execution.
+        //
         //  m_c4ParmCnt
         //      Indicates the number of runtime parameters that the command
         //      we were configured for indicated it needed.
@@ -932,6 +966,7 @@ class CQCKITEXPORT TCQCCmdCfg : public TObject, public MStreamable
         //      identify it within the list of possible targets offered to
         //      the user. The name is for human readable identification.
         // -------------------------------------------------------------------
+        tCIDLib::TCard4         m_c4CmdAtom;
         tCIDLib::TCard4         m_c4ParmCnt;
         tCIDLib::TCard4         m_c4TargetId;
         TObjArray<TParmInfo>    m_colParms;
@@ -213,6 +213,15 @@ namespace
         constexpr tCIDLib::TFloat8  f8LocNotSet(-1000.0);
 
 
+        // -----------------------------------------------------------------------
+        //  The modulus for the CQCServer admin proxy cache, and how long we'll use
+        //  a cached proxy before we go back to the name server to make sure that the
+        //  driver hasn't moved.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4       c4SrvProxyModulus(109);
+        constexpr tCIDLib::TEncodedTime enctSrvProxyTTL(kCIDLib::enctOneSecond * 30);
+
+
         // -----------------------------------------------------------------------
         //  The list of executed applications that are currently active
         // -----------------------------------------------------------------------
@@ -271,6 +280,12 @@ TFacCQCKit::TFacCQCKit() :
     , m_colEvList(CQCKit_ThisFacility::c4EvInQSize, TMD5KeyOps())
     , m_colEvLIFO()
     , m_colEvSQ(tCIDLib::EAdoptOpts::Adopt, tCIDLib::EMTStates::Safe)
+    , m_colSrvProxies
+      (
+        CQCKit_ThisFacility::c4SrvProxyModulus
+        , TStringKeyOps(kCIDLib::False)
+        , &TSrvProxyItem::strKey
+      )
     , m_eEvProcType(tCQCKit::EEvProcTypes::None)
     , m_f8ClientLat(CQCKit_ThisFacility::f8LocNotSet)
     , m_f8ClientLong(CQCKit_ThisFacility::f8LocNotSet)
@@ -424,7 +439,8 @@ TFacCQCKit::bCheckFldExists(const TString& strMoniker, const TString& strField)
 
     catch(...)
     {
-        // Just fall through with the default false return
+        // Just fall through with the default false return, but do a new lookup next time
+        DropCQCSrvAdminProxy(strMoniker);
     }
     return bRet;
 }
@@ -625,15 +641,36 @@ TFacCQCKit::bDoCmdPrep(         TCQCCmdCfg&         ccfgPrep
         if (ccfgPrep.piAt(c4PInd).m_eType == tCQCKit::ECmdPTypes::Expression)
             continue;
 
-        const tCQCKit::ECmdPrepRes eRes = eStdTokenReplace
-        (
-            ccfgPrep.piAt(c4PInd).m_strValue
-            , &crtsVals
-            , pctarGVars
-            , pctarLVars
-            , strPVal
-            , tCQCKit::ETokRepFlags::None
-        );
+        //
+        //  If the parameter was pre-parsed when it was loaded, use that. Else
+        //  we do the full parse and replace.
+        //
+        tCQCKit::ECmdPrepRes eRes;
+        const TCQCTokenPattern* pctpParm = ccfgPrep.piAt(c4PInd).pctpTokens();
+        if (pctpParm)
+        {
+            eRes = eStdTokenReplace
+            (
+                *pctpParm
+                , &crtsVals
+                , pctarGVars
+                , pctarLVars
+                , strPVal
+                , tCQCKit::ETokRepFlags::None
+            );
+        }
+         else
+        {
+            eRes = eStdTokenReplace
+            (
+                ccfgPrep.piAt(c4PInd).m_strValue
+                , &crtsVals
+                , pctarGVars
+                , pctarLVars
+                , strPVal
+                , tCQCKit::ETokRepFlags::None
+            );
+        }
 
         if (eRes == tCQCKit::ECmdPrepRes::Changed)
         {
@@ -2796,6 +2833,7 @@ TFacCQCKit::bQueryFldDef(const  TString&            strMoniker
 
     catch(TError& errToCatch)
     {
+        DropCQCSrvAdminProxy(strMoniker);
         if (bShouldLog(errToCatch))
         {
             errToCatch.AddStackLevel(CID_FILE, CID_LINE);
@@ -2806,6 +2844,7 @@ TFacCQCKit::bQueryFldDef(const  TString&            strMoniker
 
     catch(...)
     {
+        DropCQCSrvAdminProxy(strMoniker);
         return kCIDLib::False;
     }
 
@@ -2894,6 +2933,21 @@ TFacCQCKit::c8MakeVersion(  const   tCIDLib::TCard4 c4Major
 }
 
 
+//
+//  Removes any cached CQCServer admin proxy for the indicated driver. Callers
+//  should call this if a call on a proxy they got from orbcCQCSrvAdminProxy()
+//  fails in a way that indicates the driver is no longer where we think it is,
+//  so that the next call will do a new name server lookup. Anyone already
+//  holding the old proxy keeps it until they drop it.
+//
+tCIDLib::TVoid
+TFacCQCKit::DropCQCSrvAdminProxy(const TString& strDriverMoniker) const
+{
+    TLocker lockrSync(&m_mtxSrvProxies);
+    m_colSrvProxies.bRemoveKeyIfExists(strDriverMoniker);
+}
+
+
 
 //
 //  There are some places where we take a string that has replacement tokens
@@ -2977,6 +3031,30 @@ TFacCQCKit::eStdTokenReplace(const  TString&                strPattern
     );
 }
 
+//
+//  This one takes a pre-parsed pattern, so that callers who expand the same
+//  pattern over and over don't have to pay to parse it each time. The pattern
+//  must have been parsed with the same escape setting as the flags indicate.
+//
+tCQCKit::ECmdPrepRes
+TFacCQCKit::eStdTokenReplace(const  TCQCTokenPattern&       ctpSrc
+                            , const TCQCCmdRTVSrc* const    pmcrtvToUse
+                            , const TStdVarsTar* const      pctarGVars
+                            , const TStdVarsTar* const      pctarLVars
+                            ,       TString&                strResult
+                            , const tCQCKit::ETokRepFlags   eFlags)
+{
+    CIDAssert
+    (
+        ctpSrc.bDoEscapes() == !tCIDLib::bAllBitsOn(eFlags, tCQCKit::ETokRepFlags::NoEscape)
+        , L"The token pattern was parsed with a different escape setting"
+    );
+    return eExpandTokens
+    (
+        ctpSrc, pmcrtvToUse, pctarGVars, pctarLVars, strResult, eFlags, 0
+    );
+}
+
 
 //
 //  Exectute an external application. We provide replacement parameters
@@ -3204,11 +3282,39 @@ TFacCQCKit::orbcInstSrvProxy(const  tCIDLib::TCard4     c4WaitUpTo
 //  Note that it's returning a reference counted admin proxy wrapper here not the
 //  raw proxy object pointer. This lets us use by-value semantics on these.
 //
+//  We cache the proxies by moniker, and hand out shared copies of the counted
+//  pointer, since this gets called constantly and most callers only make a call
+//  or two on it. A cached one is only used if its connection hasn't been lost and
+//  it's not older than the TTL. Otherwise we drop it and do a new lookup, so that
+//  we'll see the driver if it has been moved to another server. Callers can also
+//  call DropCQCSrvAdminProxy() if they get an error that indicates it's bad.
+//
 tCQCKit::TCQCSrvProxy
 TFacCQCKit::orbcCQCSrvAdminProxy(const  TString&            strDriverMoniker
                                 , const tCIDLib::TCard4     c4WaitFor
                                 , const tCIDLib::TBoolean   bQuickTest) const
 {
+    // See if we have a cached one we can use
+    {
+        TLocker lockrSync(&m_mtxSrvProxies);
+        TSrvProxyItem* pspiCur = m_colSrvProxies.pobjFindByKey
+        (
+            strDriverMoniker, kCIDLib::False
+        );
+
+        if (pspiCur)
+        {
+            if (!pspiCur->m_orbcProxy->bCheckForLostConnection()
+            &&  (TTime::enctNow() < pspiCur->m_enctStamp + CQCKit_ThisFacility::enctSrvProxyTTL))
+            {
+                return pspiCur->m_orbcProxy;
+            }
+
+            // It's no good anymore, so get rid of it and fall through to a new lookup
+            m_colSrvProxies.bRemoveKeyIfExists(strDriverMoniker);
+        }
+    }
+
     // If they pass zero time, choose a default
     const tCIDLib::TCard4 c4WaitMS = c4WaitFor ? c4WaitFor : 5000;
 
@@ -3219,9 +3325,6 @@ TFacCQCKit::orbcCQCSrvAdminProxy(const  TString&            strDriverMoniker
     //  Build up the name server binding path for this driver. It contains an 'alias'
     //  OOID for the CQCServer that hosts it.
     //
-    TString strName;
-    TString strDescr;
-
     TString strPath(TCQCSrvAdminClientProxy::strDrvScope);
     strPath.Append(kCIDLib::pszTreeSepChar);
     strPath.Append(strDriverMoniker);
@@ -3245,9 +3348,30 @@ TFacCQCKit::orbcCQCSrvAdminProxy(const  TString&            strDriverMoniker
         );
     }
 
-    // Gen up the client proxy based on the object id we got, and return in a cptr
-    TCQCSrvAdminClientProxy* porbcRet = new TCQCSrvAdminClientProxy(ooidDrv, strPath);
-    return tCQCKit::TCQCSrvProxy(porbcRet);
+    // Gen up the client proxy based on the object id we got, and put it in a cptr
+    tCQCKit::TCQCSrvProxy orbcRet(new TCQCSrvAdminClientProxy(ooidDrv, strPath));
+
+    //
+    //  And cache it. Someone else may have beaten us to it while we were unlocked,
+    //  in which case we just replace theirs with ours, which is the newer of the two.
+    //
+    {
+        TLocker lockrSync(&m_mtxSrvProxies);
+        TSrvProxyItem* pspiCur = m_colSrvProxies.pobjFindByKey
+        (
+            strDriverMoniker, kCIDLib::False
+        );
+        if (pspiCur)
+        {
+            pspiCur->m_enctStamp = TTime::enctNow();
+            pspiCur->m_orbcProxy = orbcRet;
+        }
+         else
+        {
+            m_colSrvProxies.objAdd(TSrvProxyItem(strDriverMoniker, orbcRet));
+        }
+    }
+    return orbcRet;
 }
 
 
@@ -4846,10 +4970,9 @@ TFacCQCKit::eEvSendThread(TThread& thrThis, tCIDLib::TVoid* pData)
 
 
 //
-//  This is called by the public eStdTokenReplace() method. This operation
-//  needs to be recursive, so that guy just calls us with an initial depth
-//  of zero. We recursively expand the pattern. See the public method for
-//  comments on the token scheme.
+//  This is called by eStdTokenReplace() and eStdTokenRepHelper() to expand a
+//  parsed token pattern. We go through the segments, appending literals and
+//  getting the values for tokens and formatting them.
 //
 //  Note that our recursion doesn't handle nested tokens, i.e. something like
 //  $(%(LVar:DevName), %(LVar:FldName)). We are recursing to handle a token
@@ -4860,390 +4983,64 @@ TFacCQCKit::eEvSendThread(TThread& thrThis, tCIDLib::TVoid* pData)
 //  will error out if we end up more than 8 recursive calls in depth.
 //
 tCQCKit::ECmdPrepRes
-TFacCQCKit::eStdTokenRepHelper( const   TString&                strPattern
-                                , const TCQCCmdRTVSrc* const    pmcrtvToUse
-                                , const TStdVarsTar* const      pctarGVars
-                                , const TStdVarsTar* const      pctarLVars
-                                ,       TString&                strResult
-                                , const tCQCKit::ETokRepFlags   eFlags
-                                , const tCIDLib::TCard4         c4Depth)
+TFacCQCKit::eExpandTokens(  const   TCQCTokenPattern&       ctpSrc
+                            , const TCQCCmdRTVSrc* const    pmcrtvToUse
+                            , const TStdVarsTar* const      pctarGVars
+                            , const TStdVarsTar* const      pctarLVars
+                            ,       TString&                strResult
+                            , const tCQCKit::ETokRepFlags   eFlags
+                            , const tCIDLib::TCard4         c4Depth)
 {
-    enum EStates
-    {
-        EState_WaitToken
-        , EState_WaitOpen
-        , EState_WaitName
-        , EState_WaitTPatStart
-        , EState_WaitTPat
-        , EState_WaitTPatEnd
-        , EState_WaitSepStart
-        , EState_WaitSep
-        , EState_WaitSepEnd
-        , EState_WaitClose
-        , EState_GotToken
-    };
-
-    // Assume unchanged unless proven otherwise
-    tCQCKit::ECmdPrepRes eRes = tCQCKit::ECmdPrepRes::Unchanged;
-
     // Clear the output so we can start appending
     strResult.Clear();
 
-    // Get some short cuts for the flags
-    const tCIDLib::TBoolean bTestOnly(tCIDLib::bAllBitsOn(eFlags, tCQCKit::ETokRepFlags::TestOnly));
-    const tCIDLib::TBoolean bDoEscapes(!tCIDLib::bAllBitsOn(eFlags, tCQCKit::ETokRepFlags::NoEscape));
-    const tCIDLib::TBoolean bGVarsOnly(tCIDLib::bAllBitsOn(eFlags, tCQCKit::ETokRepFlags::GVarsOnly));
-
     //
-    //  Since most will not have any tokens, we can optimize by doing
-    //  a tight initial loop where we just copy characters until we see
-    //  a dollar/percent or escape char. If we don't, then we just return
-    //  immediately with unchanged. Then we won't have to construct all
-    //  the temp strings, or copy any chars.
+    //  If there were any escapes or $/% chars, it's changed, even if there
+    //  are no actual tokens. Any tokens will also set it.
     //
-    tCIDLib::TCard4     c4Index = 0;
-    tCIDLib::TCard4 c4PatLen = strPattern.c4Length();
-    while (c4Index < c4PatLen)
-    {
-        //
-        //  Don't increment till the end, so that, if we break out, we
-        //  will pick up on the character that broke us out.
-        //
-        const tCIDLib::TCh chCur = strPattern[c4Index];
-        if ((chCur == L'%') || (chCur == L'$'))
-            break;
+    tCQCKit::ECmdPrepRes eRes = ctpSrc.bChanged() ? tCQCKit::ECmdPrepRes::Changed
+                                                  : tCQCKit::ECmdPrepRes::Unchanged;
 
-        // Only do this one if we are doing escapes
-        if (bDoEscapes && (chCur == L'\\'))
-            break;
-
-        c4Index++;
-    }
-
-    // If we got to the end, then just return unchanged
-    if (c4Index == c4PatLen)
-        return eRes;
-
-    //
-    //  Copy over the chars we got done in the loop above, and then we can
-    //  fall through and do the hard work.
-    //
-    if (c4Index)
-        strResult.CopyInSubStr(strPattern, 0, c4Index);
+    // Get some short cuts for the flags
+    const tCIDLib::TBoolean bTestOnly(tCIDLib::bAllBitsOn(eFlags, tCQCKit::ETokRepFlags::TestOnly));
+    const tCIDLib::TBoolean bGVarsOnly(tCIDLib::bAllBitsOn(eFlags, tCQCKit::ETokRepFlags::GVarsOnly));
 
-    //
-    //  Now we do a little state machine to parse the input. We basically
-    //  just copy over characters from the source to the target until we
-    //  hit a token, then we get the value of that token and append it to
-    //  the target.
-    //
-    tCIDLib::TBoolean   bFldToken = kCIDLib::False;
-    EStates             eCurState = EState_WaitToken;
-    TString             strFld;
-    TString             strMon;
-    TString             strName;
-    TString             strRepVal;
-    TString             strSep;
-    TString             strTPat;
-    TString             strVal;
-    while (c4Index < c4PatLen)
+    TString strExp;
+    TString strRepVal;
+    const tCIDLib::TCard4 c4SegCnt = ctpSrc.c4SegCount();
+    for (tCIDLib::TCard4 c4SegInd = 0; c4SegInd < c4SegCnt; c4SegInd++)
     {
-        // Get the current character out of the pattern
-        const tCIDLib::TCh chCur = strPattern[c4Index++];
+        const TCQCTokenPattern::TSegment& segCur = ctpSrc.segAt(c4SegInd);
 
-        //
-        //  If we get a backslash, and it's not the last character in the
-        //  input pattern, then it could be an escape.
-        //
-        tCIDLib::TBoolean bEscaped = kCIDLib::False;
-        if ((chCur == L'\\') && (c4Index < c4PatLen))
+        // Literals just get appended
+        if (segCur.m_eType == TCQCTokenPattern::ESegTypes::Literal)
         {
-            if (eCurState == EState_WaitOpen)
-            {
-                //
-                //  We saw a percent or dollar, but now we've seen a slash. So
-                //  we want to pay back that character, since it can't be a
-                //  token. We put us back to wait token, and then fall through
-                //  for regular processing.
-                //
-                if (bFldToken)
-                    strResult.Append(kCIDLib::chDollarSign);
-                else
-                    strResult.Append(kCIDLib::chPercentSign);
-                eCurState = EState_WaitToken;
-            }
-
-            //
-            //  Get the next char. According to where we are in the
-            //  pattern, different things are escaped.
-            //
-            const tCIDLib::TCh chNext = strPattern[c4Index];
-            if (eCurState == EState_WaitTPat)
-            {
-                if ((chNext == L'"') || (chNext == L'\\'))
-                {
-                    strTPat.Append(chNext);
-                    c4Index++;
-                    bEscaped = kCIDLib::True;
-                }
-            }
-             else if (eCurState == EState_WaitSep)
-            {
-                if ((chNext == L'"') || (chNext == L'\\'))
-                {
-                    strTPat.Append(chNext);
-                    c4Index++;
-                    bEscaped = kCIDLib::True;
-                }
-            }
-             else if (eCurState == EState_WaitToken)
-            {
-                //
-                //  Outside of any token, we allow escaping of percent
-                //  and dollar signs, as well as quotes and escape
-                //  chars.
-                //
-                if ((chNext == L'%') || (chNext == L'$')
-                ||  (chNext == L'"') || (chNext == L'\\'))
-                {
-                    strResult.Append(chNext);
-                    c4Index++;
-                    bEscaped = kCIDLib::True;
-                }
-            }
-
-            //
-            //  If we escaped, then just go back and start at the top. Else,
-            //  fall through with the char we have. And set the return value
-            //  to changed, since we have changed it.
-            //
-            if (bEscaped)
-            {
-                eRes = tCQCKit::ECmdPrepRes::Changed;
-                continue;
-            }
-        }
-
-        //
-        //  Process the character based on our state machine state. We don't
-        //  have to deal with escapes here since they are all handled above.
-        //
-        switch(eCurState)
-        {
-            case EState_WaitToken :
-            {
-                if (chCur == L'$')
-                {
-                    eCurState = EState_WaitOpen;
-                    bFldToken = kCIDLib::True;
-                    eRes = tCQCKit::ECmdPrepRes::Changed;
-                }
-                 else if (chCur == L'%')
-                {
-                    eCurState = EState_WaitOpen;
-                    bFldToken = kCIDLib::False;
-                    eRes = tCQCKit::ECmdPrepRes::Changed;
-                }
-                 else
-                {
-                    // Nothing special, so just append to result
-                    strResult.Append(chCur);
-                }
-                break;
-            }
-
-            case EState_WaitOpen :
-            {
-                if (chCur == kCIDLib::chOpenParen)
-                {
-                    // Ok, let's start waiting for the name of a new token
-                    strName.Clear();
-                    strTPat.Clear();
-                    strSep.Clear();
-                    eCurState = EState_WaitName;
-                }
-                 else
-                {
-                    //
-                    //  It was just a raw $ or %, so 'pay back' the owed
-                    //  original character and then append the current char,
-                    //  then go back to base state.
-                    //
-                    if (bFldToken)
-                        strResult.Append(kCIDLib::chDollarSign);
-                    else
-                        strResult.Append(kCIDLib::chPercentSign);
-                    strResult.Append(chCur);
-                    eCurState = EState_WaitToken;
-                }
-                break;
-            }
-
-            case EState_WaitName :
-            {
-                //
-                //  Store name chars till we hit the close paren, or a comma
-                //  before the token pattern.
-                //
-                if (chCur == kCIDLib::chCloseParen)
-                    eCurState = EState_GotToken;
-                else if (chCur == kCIDLib::chComma)
-                    eCurState = EState_WaitTPatStart;
-                else
-                    strName.Append(chCur);
-                break;
-            }
-
-            case EState_WaitTPatStart :
-            {
-                //
-                //  Eat whitespace till we hit the start quote. If we hit a
-                //  close paren, then we have a token.
-                //
-                if (chCur == kCIDLib::chQuotation)
-                    eCurState = EState_WaitTPat;
-                else if (chCur == kCIDLib::chCloseParen)
-                    eCurState = EState_GotToken;
-                else if (!TRawStr::bIsSpace(chCur))
-                {
-                    strResult.LoadFromMsg
-                    (
-                        kKitErrs::errcTokR_ExpectWS2
-                        , facCQCKit()
-                        , TCardinal(c4Index)
-                    );
-                    return tCQCKit::ECmdPrepRes::Failed;
-                }
-                break;
-            }
-
-            case EState_WaitTPat :
-            {
-                //
-                //  Store token pattern chars till we hit the closing
-                //  quote.
-                //
-                if (chCur == kCIDLib::chQuotation)
-                    eCurState = EState_WaitTPatEnd;
-                else
-                    strTPat.Append(chCur);
-                break;
-            }
-
-            case EState_WaitTPatEnd :
-            {
-                //
-                //  We can see whitespace or close paren. If a comma, move
-                //  to the separator.
-                //
-                if (chCur == kCIDLib::chComma)
-                    eCurState = EState_WaitSepStart;
-                else if (chCur == kCIDLib::chCloseParen)
-                    eCurState = EState_GotToken;
-                else if (!TRawStr::bIsSpace(chCur))
-                {
-                    strResult.LoadFromMsg
-                    (
-                        kKitErrs::errcTokR_ExpectWS2
-                        , facCQCKit()
-                        , TCardinal(c4Index)
-                    );
-                    return tCQCKit::ECmdPrepRes::Failed;
-                }
-                break;
-            }
-
-            case EState_WaitSepStart :
-            {
-                //
-                //  Eat whitespace till we hit the start quote. If we hit a
-                //  close paren, then we have a token.
-                //
-                if (chCur == kCIDLib::chQuotation)
-                    eCurState = EState_WaitSep;
-                else if (chCur == kCIDLib::chCloseParen)
-                    eCurState = EState_GotToken;
-                else if (!TRawStr::bIsSpace(chCur))
-                {
-                    strResult.LoadFromMsg
-                    (
-                        kKitErrs::errcTokR_ExpectWS2
-                        , facCQCKit()
-                        , TCardinal(c4Index)
-                    );
-                    return tCQCKit::ECmdPrepRes::Failed;
-                }
-                break;
-            }
-
-            case EState_WaitSep :
-            {
-                //
-                //  Store separator chars until we hit the close quote. When
-                //  we hit the close quote, we are now looking for the close
-                //  paren.
-                //
-                if (chCur == kCIDLib::chQuotation)
-                    eCurState = EState_WaitClose;
-                else
-                    strSep.Append(chCur);
-                break;
-            }
-
-            case EState_WaitClose :
-            {
-                if (chCur == kCIDLib::chCloseParen)
-                    eCurState = EState_GotToken;
-                else if (!TRawStr::bIsSpace(chCur))
-                {
-                    strResult.LoadFromMsg
-                    (
-                        kKitErrs::errcTokR_ExpectWS1
-                        , facCQCKit()
-                        , TCardinal(c4Index)
-                    );
-                    return tCQCKit::ECmdPrepRes::Failed;
-                }
-                break;
-            }
-        };
-
-        // If no token yet, then go back to the top and keep going.
-        if (eCurState != EState_GotToken)
+            strResult.Append(segCur.m_strText);
             continue;
+        }
 
-        // Go back to initial state now now matter what
-        eCurState = EState_WaitToken;
-
-        //
-        //  If we get here, then we are going to either change the value
-        //  or get an error.
-        //
+        // It's a token, so we are going to either change the value or fail
         eRes = tCQCKit::ECmdPrepRes::Changed;
 
         //
-        //  Strip whitspace from the name part, since it is not a quoted value
-        //  and therefore could have had leading/trailing whitespace.
+        //  If only allowing global vars, then anything but a global var
+        //  token fails.
         //
-        strName.StripWhitespace();
-
-        if (bFldToken)
+        if (bGVarsOnly && (segCur.m_eType != TCQCTokenPattern::ESegTypes::GVar))
         {
-            // If only allowing global vars, then we failed
-            if (bGVarsOnly)
-            {
-                strResult.LoadFromMsg(kKitErrs::errcTokR_OnlyGVars, facCQCKit());
-                return tCQCKit::ECmdPrepRes::Failed;
-            }
+            strResult.LoadFromMsg(kKitErrs::errcTokR_OnlyGVars, facCQCKit());
+            return tCQCKit::ECmdPrepRes::Failed;
+        }
 
-            // Break the remaining token into moniker/field names
-            if (!bParseFldName(strName, strMon, strFld))
+        if (segCur.m_eType == TCQCTokenPattern::ESegTypes::Field)
+        {
+            if (segCur.m_bBadFld)
             {
                 strResult.LoadFromMsg
                 (
                     kKitErrs::errcTokR_BadField
                     , facCQCKit()
-                    , TCardinal(c4Index)
+                    , TCardinal(segCur.m_c4Index)
                 );
                 return tCQCKit::ECmdPrepRes::Failed;
             }
@@ -5256,20 +5053,24 @@ TFacCQCKit::eStdTokenRepHelper( const   TString&                strPattern
                     // Get a proxy for the CQCServer that owns this moniker
                     tCQCKit::TCQCSrvProxy  orbcSrv
                     (
-                        orbcCQCSrvAdminProxy(strMon, 2500, kCIDLib::True)
+                        orbcCQCSrvAdminProxy(segCur.m_strMon, 2500, kCIDLib::True)
                     );
 
                     // Try to get the value for this field
                     tCIDLib::TCard4 c4SerNum = 0;
                     tCQCKit::EFldTypes eType;
-                    if (!orbcSrv->bReadFieldByName(c4SerNum, strMon, strFld, strRepVal, eType))
+                    if (!orbcSrv->bReadFieldByName(c4SerNum
+                                                  , segCur.m_strMon
+                                                  , segCur.m_strFld
+                                                  , strRepVal
+                                                  , eType))
                     {
                         strResult.LoadFromMsg
                         (
                             kKitErrs::errcTokR_GetFldVal
                             , facCQCKit()
-                            , strMon
-                            , strFld
+                            , segCur.m_strMon
+                            , segCur.m_strFld
                         );
                         return tCQCKit::ECmdPrepRes::Failed;
                     }
@@ -5277,6 +5078,9 @@ TFacCQCKit::eStdTokenRepHelper( const   TString&                strPattern
 
                 catch(const TError& errToCatch)
                 {
+                    // Make sure we do a new lookup next time
+                    DropCQCSrvAdminProxy(segCur.m_strMon);
+
                     if (bShouldLog(errToCatch))
                         LogEventObj(errToCatch);
 
@@ -5284,98 +5088,71 @@ TFacCQCKit::eStdTokenRepHelper( const   TString&                strPattern
                     (
                         kKitErrs::errcTokR_Except
                         , facCQCKit()
-                        , TCardinal(c4Index)
+                        , TCardinal(segCur.m_c4Index)
                     );
                     return tCQCKit::ECmdPrepRes::Failed;
                 }
 
                 catch(...)
                 {
+                    DropCQCSrvAdminProxy(segCur.m_strMon);
                     strResult.LoadFromMsg
                     (
                         kKitErrs::errcTokR_Except
                         , facCQCKit()
-                        , TCardinal(c4Index)
+                        , TCardinal(segCur.m_c4Index)
                     );
                     return tCQCKit::ECmdPrepRes::Failed;
                 }
             }
-             else
-            {
-                // Make the replacement value the token itself
-                strRepVal = L"$(";
-                strRepVal.Append(strName);
-                strRepVal.Append(L")");
-            }
         }
-         else
+         else if (segCur.m_eType == TCQCTokenPattern::ESegTypes::GVar)
         {
-            //
-            //  See if we have this token. It's got to be a variable, or
-            //  or some runtime value.
-            //
-            if (strName.bStartsWith(kCQCKit::strActVarPref_GVar))
+            if (!bTestOnly)
             {
-                if (!bTestOnly)
+                if (!pctarGVars || !pctarGVars->bVarValue(segCur.m_strText, strRepVal))
                 {
-                    if (!pctarGVars || !pctarGVars->bVarValue(strName, strRepVal))
-                    {
-                        strResult.LoadFromMsg
-                        (
-                            kKitErrs::errcTokR_VarNotFound, facCQCKit(), strName
-                        );
-                        return tCQCKit::ECmdPrepRes::Failed;
-                    }
+                    strResult.LoadFromMsg
+                    (
+                        kKitErrs::errcTokR_VarNotFound, facCQCKit(), segCur.m_strText
+                    );
+                    return tCQCKit::ECmdPrepRes::Failed;
                 }
             }
-             else if (strName.bStartsWith(kCQCKit::strActVarPref_LVar))
+        }
+         else if (segCur.m_eType == TCQCTokenPattern::ESegTypes::LVar)
+        {
+            if (!bTestOnly)
             {
-                // If only allowing global vars, then we failed
-                if (bGVarsOnly)
+                if (!pctarLVars || !pctarLVars->bVarValue(segCur.m_strText, strRepVal))
                 {
-                    strResult.LoadFromMsg(kKitErrs::errcTokR_OnlyGVars, facCQCKit());
+                    strResult.LoadFromMsg
+                    (
+                        kKitErrs::errcTokR_VarNotFound, facCQCKit(), segCur.m_strText
+                    );
                     return tCQCKit::ECmdPrepRes::Failed;
                 }
-
-                if (!bTestOnly)
-                {
-                    if (!pctarLVars || !pctarLVars->bVarValue(strName, strRepVal))
-                    {
-                        strResult.LoadFromMsg
-                        (
-                            kKitErrs::errcTokR_VarNotFound, facCQCKit(), strName
-                        );
-                        return tCQCKit::ECmdPrepRes::Failed;
-                    }
-                }
             }
-             else
+        }
+         else
+        {
+            if (!bTestOnly)
             {
-                // If only allowing global vars, then we failed
-                if (bGVarsOnly)
+                if (!pmcrtvToUse || !pmcrtvToUse->bRTValue(segCur.m_strText, strRepVal))
                 {
-                    strResult.LoadFromMsg(kKitErrs::errcTokR_OnlyGVars, facCQCKit());
+                    strResult.LoadFromMsg
+                    (
+                        kKitErrs::errcTokR_RTVNotFound
+                        , facCQCKit()
+                        , segCur.m_strText
+                    );
                     return tCQCKit::ECmdPrepRes::Failed;
                 }
-
-                if (!bTestOnly)
-                {
-                    if (!pmcrtvToUse || !pmcrtvToUse->bRTValue(strName, strRepVal))
-                    {
-                        strResult.LoadFromMsg
-                        (
-                            kKitErrs::errcTokR_RTVNotFound
-                            , facCQCKit()
-                            , strName
-                        );
-                        return tCQCKit::ECmdPrepRes::Failed;
-                    }
-                }
             }
         }
 
         //
-        //  If just testing, we jump back to the top again, since we don't
+        //  If just testing, we go back to the top again, since we don't
         //  have any replacement value and don't want to try to expand
         //  anything.
         //
@@ -5384,60 +5161,43 @@ TFacCQCKit::eStdTokenRepHelper( const   TString&                strPattern
 
         //
         //  Ok, if we got here, then we have a replacement value in strRepVal,
-        //  and we have the token pattern and separator info. So we need to
-        //  process the value and append the results onto the result string.
-        //
-        //  If we didn't get a token pattern or separator, then default them.
-        //  If the pattern isn't empty, it must have one and only one '%1'
-        //  replacement token in it, or it must be the '%*' pattern which
-        //  indicates a literal taking of the replacement value without
-        //  processing. Or ^1, which is the same, with no recursion on the
-        //  replacement value.
-        //
-        //  We'll use strName as a temp here to expand the token out into.
+        //  so format it via the token pattern. The pattern was already checked
+        //  and defaulted if needed. It must have one '%1' replacement token in
+        //  it, or it must be the '%*' pattern which indicates a literal taking
+        //  of the replacement value without processing. Or ^1, which is the
+        //  same, with no recursion on the replacement value.
         //
         tCIDLib::TBoolean bNoRecurse = kCIDLib::False;
-        tCIDLib::TCard4 c4TPatOfs = 0;
-        if (strTPat.bIsEmpty())
-            strTPat = L"%1";
-        if (strSep.bIsEmpty())
-            strSep = L" ";
-
-        strName.Clear();
-        if (strTPat.bFirstOccurrence(L"%1", c4TPatOfs))
-        {
-            FormatTokenVals(strName, strRepVal, strTPat, c4TPatOfs, strSep);
-        }
-         else if (strTPat.bFirstOccurrence(L"%*", c4TPatOfs))
-        {
-            // Cut out the pattern and put the replacement value in literally
-            strName = strTPat;
-            strName.Cut(c4TPatOfs, 2);
-            strName.Insert(strRepVal, c4TPatOfs);
-        }
-         else if (strTPat.bFirstOccurrence(L"^1", c4TPatOfs))
+        strExp.Clear();
+        switch(segCur.m_eTPatType)
         {
-            strName = strTPat;
-            strName.Cut(c4TPatOfs, 2);
-            strName.Insert(strRepVal, c4TPatOfs);
-            bNoRecurse = kCIDLib::True;
-        }
-         else
-        {
-            strResult.LoadFromMsg(kKitErrs::errcTokR_BadTPattern, facCQCKit());
-            return tCQCKit::ECmdPrepRes::Failed;
-        }
+            case TCQCTokenPattern::ETPatTypes::Format :
+                FormatTokenVals
+                (
+                    strExp, strRepVal, segCur.m_strTPat, segCur.m_c4TPatOfs, segCur.m_strSep
+                );
+                break;
+
+            case TCQCTokenPattern::ETPatTypes::NoRecurse :
+                bNoRecurse = kCIDLib::True;
+                // Fall through
+
+            case TCQCTokenPattern::ETPatTypes::Literal :
+                // Cut out the pattern and put the replacement value in literally
+                strExp = segCur.m_strTPat;
+                strExp.Cut(segCur.m_c4TPatOfs, 2);
+                strExp.Insert(strRepVal, segCur.m_c4TPatOfs);
+                break;
+
+            default :
+                strResult.LoadFromMsg(kKitErrs::errcTokR_BadTPattern, facCQCKit());
+                return tCQCKit::ECmdPrepRes::Failed;
+        };
 
         //
-        //  Now, we have to deal with possible token recursion. So let's
-        //  call ourself on on the expanded token, and let it fill in the
-        //  rep val string with any next level expansion.
-        //
-        //  If we've already hit a depth of 8, then assume we are in a
-        //  recursive expansion and fail it.
-        //
-        //  If the replacement token was ^1, then we don't recurse and just
-        //  take the value as is.
+        //  Now, we have to deal with possible token recursion. If we've already
+        //  hit a depth of 8, then assume we are in a recursive expansion and
+        //  fail it.
         //
         if (c4Depth >= 8)
         {
@@ -5454,7 +5214,7 @@ TFacCQCKit::eStdTokenRepHelper( const   TString&                strPattern
         {
             eNestedRes = eStdTokenRepHelper
             (
-                strName
+                strExp
                 , pmcrtvToUse
                 , pctarGVars
                 , pctarLVars
@@ -5466,8 +5226,8 @@ TFacCQCKit::eStdTokenRepHelper( const   TString&                strPattern
 
         //
         //  If it was expanded further, then append the rep val to our result,
-        //  else the name string with the original content. If it failed, then
-        //  we failed.
+        //  else the expanded string with the original content. If it failed,
+        //  then we failed.
         //
         if (eNestedRes == tCQCKit::ECmdPrepRes::Failed)
             return tCQCKit::ECmdPrepRes::Failed;
@@ -5475,27 +5235,44 @@ TFacCQCKit::eStdTokenRepHelper( const   TString&                strPattern
         if (eNestedRes == tCQCKit::ECmdPrepRes::Changed)
             strResult.Append(strRepVal);
         else
-            strResult.Append(strName);
+            strResult.Append(strExp);
     }
+    return eRes;
+}
 
-    //
-    //  If we aren't on WaitToken state, then there was an unterminated
-    //  token. But, if we are in WaitOpen state, it was just a trailing $ or
-    //  % char, so just put append the owed character.
-    //
-    if (eCurState == EState_WaitOpen)
-    {
-        if (bFldToken)
-            strResult.Append(kCIDLib::chDollarSign);
-        else
-            strResult.Append(kCIDLib::chPercentSign);
-    }
-     else if (eCurState != EState_WaitToken)
-    {
-        strResult.LoadFromMsg(kKitErrs::errcTokR_Unterminated, facCQCKit());
+
+//
+//  This is called by the public eStdTokenReplace() method. This operation
+//  needs to be recursive, so that guy just calls us with an initial depth
+//  of zero. See the public method for comments on the token scheme.
+//
+//  Since most will not have any tokens, we first just check for any special
+//  characters and return immediately with unchanged if none. Else we parse
+//  the pattern and expand it.
+//
+tCQCKit::ECmdPrepRes
+TFacCQCKit::eStdTokenRepHelper( const   TString&                strPattern
+                                , const TCQCCmdRTVSrc* const    pmcrtvToUse
+                                , const TStdVarsTar* const      pctarGVars
+                                , const TStdVarsTar* const      pctarLVars
+                                ,       TString&                strResult
+                                , const tCQCKit::ETokRepFlags   eFlags
+                                , const tCIDLib::TCard4         c4Depth)
+{
+    strResult.Clear();
+
+    const tCIDLib::TBoolean bDoEscapes(!tCIDLib::bAllBitsOn(eFlags, tCQCKit::ETokRepFlags::NoEscape));
+    if (!TCQCTokenPattern::bHasSpecialChars(strPattern, bDoEscapes))
+        return tCQCKit::ECmdPrepRes::Unchanged;
+
+    TCQCTokenPattern ctpParse;
+    if (!ctpParse.bParse(strPattern, bDoEscapes, strResult))
         return tCQCKit::ECmdPrepRes::Failed;
-    }
-    return eRes;
+
+    return eExpandTokens
+    (
+        ctpParse, pmcrtvToUse, pctarGVars, pctarLVars, strResult, eFlags, c4Depth
+    );
 }
 
 
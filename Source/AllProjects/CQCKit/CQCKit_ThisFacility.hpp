@@ -22,6 +22,12 @@
 //
 // CAVEATS/GOTCHAS:
 //
+//  1.  CQCServer admin proxies are cached and shared process wide, keyed by driver
+//      moniker, since lots of code just gets one, does a call or two, and drops it.
+//      So the lookup and proxy creation were a significant part of the overhead of
+//      things like field reads and writes from actions. See orbcCQCSrvAdminProxy()
+//      for how they are kept fresh.
+//
 // LOG:
 //
 #pragma once
@@ -362,6 +368,11 @@ class CQCKITEXPORT TFacCQCKit : public TFacility
             , const tCIDLib::TCard4         c4Revision
         );
 
+        tCIDLib::TVoid DropCQCSrvAdminProxy
+        (
+            const   TString&                strDriverMoniker
+        )   const;
+
         tCQCKit::ECmdPrepRes eStdTokenReplace
         (
             const   TString&                strPattern
@@ -372,6 +383,16 @@ class CQCKITEXPORT TFacCQCKit : public TFacility
             , const tCQCKit::ETokRepFlags   eFlags
         );
 
+        tCQCKit::ECmdPrepRes eStdTokenReplace
+        (
+            const   TCQCTokenPattern&       ctpSrc
+            , const TCQCCmdRTVSrc* const    pcrtsToUse
+            , const TStdVarsTar* const      pctarGVars
+            , const TStdVarsTar* const      pctarLVars
+            ,       TString&                strResult
+            , const tCQCKit::ETokRepFlags   eFlags
+        );
+
         tCIDLib::TVoid ExecApp
         (
             const   TString&                strApp
@@ -703,6 +724,42 @@ class CQCKITEXPORT TFacCQCKit : public TFacility
 
 
     private :
+        // -------------------------------------------------------------------
+        //  Private types
+        //
+        //  TSrvProxyItem is used to cache CQCServer admin proxies, keyed by the
+        //  moniker of the driver that they were looked up for.
+        // -------------------------------------------------------------------
+        class TSrvProxyItem
+        {
+            public :
+                static const TString& strKey(const TSrvProxyItem& spiSrc)
+                {
+                    return spiSrc.m_strMoniker;
+                }
+
+                TSrvProxyItem(  const   TString&                strMoniker
+                                , const tCQCKit::TCQCSrvProxy&  orbcProxy) :
+
+                    m_enctStamp(TTime::enctNow())
+                    , m_orbcProxy(orbcProxy)
+                    , m_strMoniker(strMoniker)
+                {
+                }
+
+                TSrvProxyItem(const TSrvProxyItem&) = default;
+                TSrvProxyItem(TSrvProxyItem&&) = default;
+                ~TSrvProxyItem() = default;
+                TSrvProxyItem& operator=(const TSrvProxyItem&) = default;
+                TSrvProxyItem& operator=(TSrvProxyItem&&) = default;
+
+                tCIDLib::TEncodedTime   m_enctStamp;
+                tCQCKit::TCQCSrvProxy   m_orbcProxy;
+                TString                 m_strMoniker;
+        };
+        using TSrvProxyCache = TKeyedHashSet<TSrvProxyItem, TString, TStringKeyOps>;
+
+
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
@@ -733,6 +790,17 @@ class CQCKITEXPORT TFacCQCKit : public TFacility
             ,       tCIDLib::TVoid*         pData
         );
 
+        tCQCKit::ECmdPrepRes eExpandTokens
+        (
+            const   TCQCTokenPattern&       ctpSrc
+            , const TCQCCmdRTVSrc* const    pcrtsToUse
+            , const TStdVarsTar* const      pctarGVars
+            , const TStdVarsTar* const      pctarLVars
+            ,       TString&                strResult
+            , const tCQCKit::ETokRepFlags   eFlags
+            , const tCIDLib::TCard4         c4Depth
+        );
+
         tCQCKit::ECmdPrepRes eStdTokenRepHelper
         (
             const   TString&                strPattern
@@ -803,6 +871,12 @@ class CQCKITEXPORT TFacCQCKit : public TFacility
         //      by sending threads and read by the our transmission thread, there's no
         //      need for any explicit sync.
         //
+        //  m_colSrvProxies
+        //      A cache of CQCServer admin proxies, keyed by driver moniker, so that
+        //      they can be shared instead of being created on every call. It is
+        //      mutable since the proxy getting methods are const. m_mtxSrvProxies
+        //      protects it.
+        //
         //  m_eEvProcType
         //      When the event processing engine is started up they tell us what types
         //      of event processing they want, either sending or receiving or both.
@@ -834,6 +908,10 @@ class CQCKITEXPORT TFacCQCKit : public TFacility
         //      generating hashes. 64K variations is vastly larger than the duplicate
         //      rejection lists above.
         //
+        //  m_mtxSrvProxies
+        //      The proxy cache has its own mutex, so that it isn't blocked by the
+        //      other stuff that m_mtxSync is used for.
+        //
         //  m_mtxSync
         //      We have to do a little locking in here
         //
@@ -940,12 +1018,14 @@ class CQCKITEXPORT TFacCQCKit : public TFacility
         TEvDupKeyed             m_colEvList;
         TEvDupLIFO              m_colEvLIFO;
         TEventQ                 m_colEvSQ;
+        mutable TSrvProxyCache  m_colSrvProxies;
         tCQCKit::EEvProcTypes   m_eEvProcType;
         tCIDLib::TFloat8        m_f8ClientLat;
         tCIDLib::TFloat8        m_f8ClientLong;
         tCIDLib::TIPPortNum     m_ippnEvents;
         tCIDLib::TIPPortNum     m_ippnMasterWS;
         TMD5Hash                m_mhashEvId;
+        mutable TMutex          m_mtxSrvProxies;
         TMutex                  m_mtxSync;
         TPubSubTopic            m_pstopEvTrigs;
         TString                 m_strBinDir;
@@ -0,0 +1,511 @@
+//
+// FILE NAME: CQCKit_TokenPattern.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the implementation file for the pre-parsed token pattern class.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+
+
+// ---------------------------------------------------------------------------
+//  Includes
+// ---------------------------------------------------------------------------
+#include    "CQCKit_.hpp"
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TCQCTokenPattern
+//  PREFIX: ctp
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TCQCTokenPattern: Public, static methods
+// ---------------------------------------------------------------------------
+
+//
+//  Most values don't have any tokens or escapes, so this lets callers quickly
+//  check whether it's worth parsing a value at all.
+//
+tCIDLib::TBoolean
+TCQCTokenPattern::bHasSpecialChars( const   TString&            strToCheck
+                                    , const tCIDLib::TBoolean   bDoEscapes)
+{
+    const tCIDLib::TCard4 c4Len = strToCheck.c4Length();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Len; c4Index++)
+    {
+        const tCIDLib::TCh chCur = strToCheck[c4Index];
+        if ((chCur == L'%') || (chCur == L'$'))
+            return kCIDLib::True;
+
+        if (bDoEscapes && (chCur == L'\\'))
+            return kCIDLib::True;
+    }
+    return kCIDLib::False;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TCQCTokenPattern: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TCQCTokenPattern::TCQCTokenPattern() :
+
+    m_bChanged(kCIDLib::False)
+    , m_bDoEscapes(kCIDLib::True)
+    , m_colSegs(4)
+{
+}
+
+TCQCTokenPattern::~TCQCTokenPattern()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TCQCTokenPattern: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+tCIDLib::TBoolean TCQCTokenPattern::bChanged() const
+{
+    return m_bChanged;
+}
+
+
+tCIDLib::TBoolean TCQCTokenPattern::bDoEscapes() const
+{
+    return m_bDoEscapes;
+}
+
+
+//
+//  We parse the pattern into our segment list. This is the same state machine
+//  that the facility's token replacement code always used, but it just stores
+//  the parts instead of expanding them as it goes.
+//
+//  Note that escapes are always processed once there's any special character,
+//  the escapes flag only matters for the initial check. That's how it always
+//  worked, so we keep it.
+//
+//  If there's a syntax error, we return false with the message in the caller's
+//  string.
+//
+tCIDLib::TBoolean
+TCQCTokenPattern::bParse(const  TString&            strPattern
+                        , const tCIDLib::TBoolean   bDoEscapes
+                        ,       TString&            strErrMsg)
+{
+    enum EStates
+    {
+        EState_WaitToken
+        , EState_WaitOpen
+        , EState_WaitName
+        , EState_WaitTPatStart
+        , EState_WaitTPat
+        , EState_WaitTPatEnd
+        , EState_WaitSepStart
+        , EState_WaitSep
+        , EState_WaitSepEnd
+        , EState_WaitClose
+        , EState_GotToken
+    };
+
+    m_bChanged = kCIDLib::False;
+    m_bDoEscapes = bDoEscapes;
+    m_colSegs.RemoveAll();
+    m_strSource = strPattern;
+
+    //
+    //  Do a tight initial loop where we just look for a dollar/percent or
+    //  escape char. If we don't see one, then there's nothing to do and we
+    //  have no segments.
+    //
+    tCIDLib::TCard4 c4Index = 0;
+    const tCIDLib::TCard4 c4PatLen = strPattern.c4Length();
+    while (c4Index < c4PatLen)
+    {
+        const tCIDLib::TCh chCur = strPattern[c4Index];
+        if ((chCur == L'%') || (chCur == L'$'))
+            break;
+
+        if (bDoEscapes && (chCur == L'\\'))
+            break;
+
+        c4Index++;
+    }
+
+    if (c4Index == c4PatLen)
+        return kCIDLib::True;
+
+    // Start the literal with the chars we got done in the loop above
+    TString strLiteral;
+    if (c4Index)
+        strLiteral.CopyInSubStr(strPattern, 0, c4Index);
+
+    tCIDLib::TBoolean   bFldToken = kCIDLib::False;
+    EStates             eCurState = EState_WaitToken;
+    TString             strName;
+    TString             strSep;
+    TString             strTPat;
+    while (c4Index < c4PatLen)
+    {
+        // Get the current character out of the pattern
+        const tCIDLib::TCh chCur = strPattern[c4Index++];
+
+        //
+        //  If we get a backslash, and it's not the last character in the
+        //  input pattern, then it could be an escape.
+        //
+        tCIDLib::TBoolean bEscaped = kCIDLib::False;
+        if ((chCur == L'\\') && (c4Index < c4PatLen))
+        {
+            if (eCurState == EState_WaitOpen)
+            {
+                //
+                //  We saw a percent or dollar, but now we've seen a slash. So
+                //  we want to pay back that character, since it can't be a
+                //  token. We put us back to wait token, and then fall through
+                //  for regular processing.
+                //
+                if (bFldToken)
+                    strLiteral.Append(kCIDLib::chDollarSign);
+                else
+                    strLiteral.Append(kCIDLib::chPercentSign);
+                eCurState = EState_WaitToken;
+            }
+
+            //
+            //  Get the next char. According to where we are in the
+            //  pattern, different things are escaped.
+            //
+            const tCIDLib::TCh chNext = strPattern[c4Index];
+            if (eCurState == EState_WaitTPat)
+            {
+                if ((chNext == L'"') || (chNext == L'\\'))
+                {
+                    strTPat.Append(chNext);
+                    c4Index++;
+                    bEscaped = kCIDLib::True;
+                }
+            }
+             else if (eCurState == EState_WaitSep)
+            {
+                if ((chNext == L'"') || (chNext == L'\\'))
+                {
+                    strTPat.Append(chNext);
+                    c4Index++;
+                    bEscaped = kCIDLib::True;
+                }
+            }
+             else if (eCurState == EState_WaitToken)
+            {
+                //
+                //  Outside of any token, we allow escaping of percent
+                //  and dollar signs, as well as quotes and escape
+                //  chars.
+                //
+                if ((chNext == L'%') || (chNext == L'$')
+                ||  (chNext == L'"') || (chNext == L'\\'))
+                {
+                    strLiteral.Append(chNext);
+                    c4Index++;
+                    bEscaped = kCIDLib::True;
+                }
+            }
+
+            // If we escaped, then the output is changed. Go back to the top
+            if (bEscaped)
+            {
+                m_bChanged = kCIDLib::True;
+                continue;
+            }
+        }
+
+        switch(eCurState)
+        {
+            case EState_WaitToken :
+            {
+                if (chCur == L'$')
+                {
+                    eCurState = EState_WaitOpen;
+                    bFldToken = kCIDLib::True;
+                    m_bChanged = kCIDLib::True;
+                }
+                 else if (chCur == L'%')
+                {
+                    eCurState = EState_WaitOpen;
+                    bFldToken = kCIDLib::False;
+                    m_bChanged = kCIDLib::True;
+                }
+                 else
+                {
+                    strLiteral.Append(chCur);
+                }
+                break;
+            }
+
+            case EState_WaitOpen :
+            {
+                if (chCur == kCIDLib::chOpenParen)
+                {
+                    // Ok, let's start waiting for the name of a new token
+                    strName.Clear();
+                    strTPat.Clear();
+                    strSep.Clear();
+                    eCurState = EState_WaitName;
+                }
+                 else
+                {
+                    //
+                    //  It was just a raw $ or %, so 'pay back' the owed
+                    //  original character and then append the current char,
+                    //  then go back to base state.
+                    //
+                    if (bFldToken)
+                        strLiteral.Append(kCIDLib::chDollarSign);
+                    else
+                        strLiteral.Append(kCIDLib::chPercentSign);
+                    strLiteral.Append(chCur);
+                    eCurState = EState_WaitToken;
+                }
+                break;
+            }
+
+            case EState_WaitName :
+            {
+                if (chCur == kCIDLib::chCloseParen)
+                    eCurState = EState_GotToken;
+                else if (chCur == kCIDLib::chComma)
+                    eCurState = EState_WaitTPatStart;
+                else
+                    strName.Append(chCur);
+                break;
+            }
+
+            case EState_WaitTPatStart :
+            case EState_WaitSepStart :
+            {
+                //
+                //  Eat whitespace till we hit the start quote. If we hit a
+                //  close paren, then we have a token.
+                //
+                if (chCur == kCIDLib::chQuotation)
+                {
+                    eCurState = (eCurState == EState_WaitTPatStart) ? EState_WaitTPat
+                                                                    : EState_WaitSep;
+                }
+                 else if (chCur == kCIDLib::chCloseParen)
+                {
+                    eCurState = EState_GotToken;
+                }
+                 else if (!TRawStr::bIsSpace(chCur))
+                {
+                    strErrMsg.LoadFromMsg
+                    (
+                        kKitErrs::errcTokR_ExpectWS2, facCQCKit(), TCardinal(c4Index)
+                    );
+                    return kCIDLib::False;
+                }
+                break;
+            }
+
+            case EState_WaitTPat :
+            {
+                if (chCur == kCIDLib::chQuotation)
+                    eCurState = EState_WaitTPatEnd;
+                else
+                    strTPat.Append(chCur);
+                break;
+            }
+
+            case EState_WaitTPatEnd :
+            {
+                if (chCur == kCIDLib::chComma)
+                    eCurState = EState_WaitSepStart;
+                else if (chCur == kCIDLib::chCloseParen)
+                    eCurState = EState_GotToken;
+                else if (!TRawStr::bIsSpace(chCur))
+                {
+                    strErrMsg.LoadFromMsg
+                    (
+                        kKitErrs::errcTokR_ExpectWS2, facCQCKit(), TCardinal(c4Index)
+                    );
+                    return kCIDLib::False;
+                }
+                break;
+            }
+
+            case EState_WaitSep :
+            {
+                if (chCur == kCIDLib::chQuotation)
+                    eCurState = EState_WaitClose;
+                else
+                    strSep.Append(chCur);
+                break;
+            }
+
+            case EState_WaitClose :
+            {
+                if (chCur == kCIDLib::chCloseParen)
+                    eCurState = EState_GotToken;
+                else if (!TRawStr::bIsSpace(chCur))
+                {
+                    strErrMsg.LoadFromMsg
+                    (
+                        kKitErrs::errcTokR_ExpectWS1, facCQCKit(), TCardinal(c4Index)
+                    );
+                    return kCIDLib::False;
+                }
+                break;
+            }
+
+            default :
+                break;
+        };
+
+        if (eCurState == EState_GotToken)
+        {
+            // Store any literal text before it, then the token
+            FlushLiteral(strLiteral);
+            AddToken(bFldToken, c4Index, strName, strTPat, strSep);
+
+            m_bChanged = kCIDLib::True;
+            eCurState = EState_WaitToken;
+        }
+    }
+
+    //
+    //  If we aren't on WaitToken state, then there was an unterminated
+    //  token. But, if we are in WaitOpen state, it was just a trailing $ or
+    //  % char, so just put append the owed character.
+    //
+    if (eCurState == EState_WaitOpen)
+    {
+        if (bFldToken)
+            strLiteral.Append(kCIDLib::chDollarSign);
+        else
+            strLiteral.Append(kCIDLib::chPercentSign);
+    }
+     else if (eCurState != EState_WaitToken)
+    {
+        strErrMsg.LoadFromMsg(kKitErrs::errcTokR_Unterminated, facCQCKit());
+        return kCIDLib::False;
+    }
+
+    FlushLiteral(strLiteral);
+    return kCIDLib::True;
+}
+
+
+tCIDLib::TCard4 TCQCTokenPattern::c4SegCount() const
+{
+    return m_colSegs.c4ElemCount();
+}
+
+
+const TCQCTokenPattern::TSegment&
+TCQCTokenPattern::segAt(const tCIDLib::TCard4 c4At) const
+{
+    return m_colSegs[c4At];
+}
+
+
+const TString& TCQCTokenPattern::strSource() const
+{
+    return m_strSource;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TCQCTokenPattern: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Add a token segment. We figure out the type from the name and split out
+//  the field parts. The token pattern and separator are defaulted if not set,
+//  and we find the replacement token in the pattern.
+//
+tCIDLib::TVoid
+TCQCTokenPattern::AddToken( const   tCIDLib::TBoolean   bFldToken
+                            , const tCIDLib::TCard4     c4Index
+                            ,       TString&            strName
+                            ,       TString&            strTPat
+                            ,       TString&            strSep)
+{
+    TSegment& segNew = m_colSegs.objAdd(TSegment());
+    segNew.m_c4Index = c4Index;
+
+    //
+    //  Strip whitspace from the name part, since it is not a quoted value
+    //  and therefore could have had leading/trailing whitespace.
+    //
+    strName.StripWhitespace();
+    segNew.m_strText = strName;
+
+    if (bFldToken)
+    {
+        segNew.m_eType = ESegTypes::Field;
+        segNew.m_bBadFld = !facCQCKit().bParseFldName
+        (
+            strName, segNew.m_strMon, segNew.m_strFld
+        );
+    }
+     else if (strName.bStartsWith(kCQCKit::strActVarPref_GVar))
+    {
+        segNew.m_eType = ESegTypes::GVar;
+    }
+     else if (strName.bStartsWith(kCQCKit::strActVarPref_LVar))
+    {
+        segNew.m_eType = ESegTypes::LVar;
+    }
+     else
+    {
+        segNew.m_eType = ESegTypes::RTV;
+    }
+
+    if (strTPat.bIsEmpty())
+        strTPat = L"%1";
+    if (strSep.bIsEmpty())
+        strSep = L" ";
+    segNew.m_strTPat = strTPat;
+    segNew.m_strSep = strSep;
+
+    tCIDLib::TCard4 c4TPatOfs = 0;
+    if (strTPat.bFirstOccurrence(L"%1", c4TPatOfs))
+        segNew.m_eTPatType = ETPatTypes::Format;
+    else if (strTPat.bFirstOccurrence(L"%*", c4TPatOfs))
+        segNew.m_eTPatType = ETPatTypes::Literal;
+    else if (strTPat.bFirstOccurrence(L"^1", c4TPatOfs))
+        segNew.m_eTPatType = ETPatTypes::NoRecurse;
+    else
+        segNew.m_eTPatType = ETPatTypes::Bad;
+    segNew.m_c4TPatOfs = c4TPatOfs;
+}
+
+
+// If there's any literal text accumulated, store it as a segment and clear it
+tCIDLib::TVoid TCQCTokenPattern::FlushLiteral(TString& strLiteral)
+{
+    if (strLiteral.bIsEmpty())
+        return;
+
+    TSegment& segNew = m_colSegs.objAdd(TSegment());
+    segNew.m_eType = ESegTypes::Literal;
+    segNew.m_strText = strLiteral;
+    strLiteral.Clear();
+}
@@ -0,0 +1,229 @@
+//
+// FILE NAME: CQCKit_TokenPattern.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This class holds the parsed form of a string that contains standard
+//  replacement tokens, i.e. $(fld), %(var), %(rtv) and so forth, plus any
+//  escaped characters. See TFacCQCKit::eStdTokenReplace() for the syntax.
+//
+//  The pattern is broken up into a list of segments, each of which is either
+//  some literal text (with any escapes already processed) or a token. Tokens
+//  have all of their parts already split out, and the token pattern already
+//  checked to see what type it is. So expanding the pattern just requires
+//  getting the values for the tokens and appending stuff to the output.
+//
+//  Action command parameters are parsed into one of these when they are
+//  loaded, so that the action engines don't have to scan them again every
+//  time the action is run. The facility's token replacement code also uses
+//  these internally.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1.  Some errors, such as a bad field name or bad token pattern, aren't
+//      reported until the pattern is expanded, since that is when they were
+//      reported before we pre-parsed them, and the order of errors depends on
+//      the expansion flags.
+//
+//  2.  We remember the original text, so that users of a pre-parsed pattern
+//      can make sure the source it was parsed from hasn't since been changed.
+//
+// LOG:
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TCQCTokenPattern
+//  PREFIX: ctp
+// ---------------------------------------------------------------------------
+class CQCKITEXPORT TCQCTokenPattern
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Public types
+        //
+        //  The types of segments and the types of token patterns. The token
+        //  pattern is the optional "%1" type thing used to format the token
+        //  value.
+        // -------------------------------------------------------------------
+        enum class ESegTypes
+        {
+            Literal
+            , Field
+            , GVar
+            , LVar
+            , RTV
+        };
+
+        enum class ETPatTypes
+        {
+            Format
+            , Literal
+            , NoRecurse
+            , Bad
+        };
+
+        class CQCKITEXPORT TSegment
+        {
+            public :
+                TSegment() :
+
+                    m_bBadFld(kCIDLib::False)
+                    , m_c4Index(0)
+                    , m_c4TPatOfs(0)
+                    , m_eTPatType(ETPatTypes::Format)
+                    , m_eType(ESegTypes::Literal)
+                {
+                }
+
+                TSegment(const TSegment&) = default;
+                TSegment(TSegment&&) = default;
+                ~TSegment() = default;
+                TSegment& operator=(const TSegment&) = default;
+                TSegment& operator=(TSegment&&) = default;
+
+                //
+                //  For literals m_strText is the text. For tokens it is the
+                //  name, and for fields it is also split into moniker and field
+                //  (unless m_bBadFld is set.) The index is the offset in the
+                //  pattern where the token ended, for error messages.
+                //
+                tCIDLib::TBoolean   m_bBadFld;
+                tCIDLib::TCard4     m_c4Index;
+                tCIDLib::TCard4     m_c4TPatOfs;
+                ETPatTypes          m_eTPatType;
+                ESegTypes           m_eType;
+                TString             m_strFld;
+                TString             m_strMon;
+                TString             m_strSep;
+                TString             m_strText;
+                TString             m_strTPat;
+        };
+
+
+        // -------------------------------------------------------------------
+        //  Public, static methods
+        // -------------------------------------------------------------------
+        static tCIDLib::TBoolean bHasSpecialChars
+        (
+            const   TString&                strToCheck
+            , const tCIDLib::TBoolean       bDoEscapes
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TCQCTokenPattern();
+
+        TCQCTokenPattern(const TCQCTokenPattern&) = delete;
+        TCQCTokenPattern(TCQCTokenPattern&&) = delete;
+
+        ~TCQCTokenPattern();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TCQCTokenPattern& operator=(const TCQCTokenPattern&) = delete;
+        TCQCTokenPattern& operator=(TCQCTokenPattern&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bChanged() const;
+
+        tCIDLib::TBoolean bDoEscapes() const;
+
+        tCIDLib::TBoolean bParse
+        (
+            const   TString&                strPattern
+            , const tCIDLib::TBoolean       bDoEscapes
+            ,       TString&                strErrMsg
+        );
+
+        tCIDLib::TCard4 c4SegCount() const;
+
+        const TSegment& segAt
+        (
+            const   tCIDLib::TCard4         c4At
+        )   const;
+
+        const TString& strSource() const;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private types
+        // -------------------------------------------------------------------
+        using TSegList = TVector<TSegment>;
+
+
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid AddToken
+        (
+            const   tCIDLib::TBoolean       bFldToken
+            , const tCIDLib::TCard4         c4Index
+            ,       TString&                strName
+            ,       TString&                strTPat
+            ,       TString&                strSep
+        );
+
+        tCIDLib::TVoid FlushLiteral
+        (
+                    TString&                strLiteral
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_bChanged
+        //      Indicates whether the expanded text will be different from the
+        //      source even if there are no tokens, i.e. there were escapes or
+        //      lone $ or % characters.
+        //
+        //  m_bDoEscapes
+        //      Whether we were parsed with escapes enabled or not.
+        //
+        //  m_colSegs
+        //      The list of literal and token segments, in order.
+        //
+        //  m_strSource
+        //      The text we were parsed from.
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean       m_bChanged;
+        tCIDLib::TBoolean       m_bDoEscapes;
+        TSegList                m_colSegs;
+        TString                 m_strSource;
+};
+
+#pragma CIDLIB_POPPACK
+
+
+namespace tCQCKit
+{
+    // -----------------------------------------------------------------------
+    //  Pre-parsed patterns are shared via counted pointer, so that copying the
+    //  command configurations that hold them stays cheap.
+    // -----------------------------------------------------------------------
+    using TTokPatPtr = TCntPtr<const TCQCTokenPattern>;
+}
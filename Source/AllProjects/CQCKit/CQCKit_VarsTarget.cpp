@@ -40,6 +40,160 @@ RTTIDecls(TStdVarsTar,TObject)
 
 
 
+// ---------------------------------------------------------------------------
+//  Local types and data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CQCKit_VarsTarget
+    {
+        // -------------------------------------------------------------------
+        //  We map the incoming command ids to this enum so that we don't have
+        //  to do a long series of string compares for every command we process.
+        //  The command configs map their ids to atoms when loaded, so the map
+        //  is just a vector indexed by atom, faulted in upon first use.
+        // -------------------------------------------------------------------
+        enum class ECmds
+        {
+            AdjustEnumValue
+            , Add
+            , AddQListValue
+            , AND
+            , Append
+            , CapAt
+            , CreateVariable
+            , SafeCreateVariable
+            , CreateVarFromField
+            , DelSubStr
+            , DelVariable
+            , Divide
+            , ElapsedSince
+            , Exists
+            , Find
+            , GetEnumOrdinal
+            , GetLength
+            , GetText
+            , GetNthEnumVal
+            , GetNumericRange
+            , GetSubStr
+            , Insert
+            , IsCharAt
+            , Multiply
+            , Negate
+            , OR
+            , PutCharAt
+            , Replace
+            , ReplaceSubStr
+            , ReplaceToken
+            , SetNowPlus
+            , SetTimeVar
+            , SetVariable
+            , SetValueFrom
+            , SetVarFmt
+            , SplitAt
+            , Strip
+            , Subtract
+            , TestAndSet
+            , ToLower
+            , ToUpper
+            , TrySetVariable
+            , Unknown
+        };
+
+        TAtomicFlag         atomCmdMapLoaded;
+        TFundVector<ECmds>  fcolCmdMap(128);
+
+
+        // -------------------------------------------------------------------
+        //  The number of lock shards a thread safe target spreads its variables
+        //  over. It can't be more than the bits in a shard mask.
+        // -------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4ShardCnt = 16;
+    }
+}
+
+using CQCKit_VarsTarget::ECmds;
+
+
+
+// ---------------------------------------------------------------------------
+//  Local helper functions
+// ---------------------------------------------------------------------------
+
+static tCIDLib::TVoid AddCmd(const TString& strId, const ECmds eCmd)
+{
+    const tCIDLib::TCard4 c4Atom = TCQCCmdCfg::c4MapCmdAtom(strId);
+    while (CQCKit_VarsTarget::fcolCmdMap.c4ElemCount() <= c4Atom)
+        CQCKit_VarsTarget::fcolCmdMap.c4AddElement(ECmds::Unknown);
+    CQCKit_VarsTarget::fcolCmdMap[c4Atom] = eCmd;
+}
+
+//
+//  Fault in the command map if needed, then map the passed command's id atom. If
+//  not one of ours, we return Unknown. Any atoms handed out after the map was
+//  loaded are beyond the end of it and so can't be ours.
+//
+static ECmds eMapCmdId(const TCQCCmdCfg& ccfgSrc)
+{
+    if (!CQCKit_VarsTarget::atomCmdMapLoaded)
+    {
+        TBaseLock lockInit;
+        if (!CQCKit_VarsTarget::atomCmdMapLoaded)
+        {
+            AddCmd(kCQCKit::strCmdId_AdjustEnumValue, ECmds::AdjustEnumValue);
+            AddCmd(kCQCKit::strCmdId_Add, ECmds::Add);
+            AddCmd(kCQCKit::strCmdId_AddQListValue, ECmds::AddQListValue);
+            AddCmd(kCQCKit::strCmdId_AND, ECmds::AND);
+            AddCmd(kCQCKit::strCmdId_Append, ECmds::Append);
+            AddCmd(kCQCKit::strCmdId_CapAt, ECmds::CapAt);
+            AddCmd(kCQCKit::strCmdId_CreateVariable, ECmds::CreateVariable);
+            AddCmd(kCQCKit::strCmdId_SafeCreateVariable, ECmds::SafeCreateVariable);
+            AddCmd(kCQCKit::strCmdId_CreateVarFromField, ECmds::CreateVarFromField);
+            AddCmd(kCQCKit::strCmdId_DelSubStr, ECmds::DelSubStr);
+            AddCmd(kCQCKit::strCmdId_DelVariable, ECmds::DelVariable);
+            AddCmd(kCQCKit::strCmdId_Divide, ECmds::Divide);
+            AddCmd(kCQCKit::strCmdId_ElapsedSince, ECmds::ElapsedSince);
+            AddCmd(kCQCKit::strCmdId_Exists, ECmds::Exists);
+            AddCmd(kCQCKit::strCmdId_Find, ECmds::Find);
+            AddCmd(kCQCKit::strCmdId_GetEnumOrdinal, ECmds::GetEnumOrdinal);
+            AddCmd(kCQCKit::strCmdId_GetLength, ECmds::GetLength);
+            AddCmd(kCQCKit::strCmdId_GetText, ECmds::GetText);
+            AddCmd(kCQCKit::strCmdId_GetNthEnumVal, ECmds::GetNthEnumVal);
+            AddCmd(kCQCKit::strCmdId_GetNumericRange, ECmds::GetNumericRange);
+            AddCmd(kCQCKit::strCmdId_GetSubStr, ECmds::GetSubStr);
+            AddCmd(kCQCKit::strCmdId_Insert, ECmds::Insert);
+            AddCmd(kCQCKit::strCmdId_IsCharAt, ECmds::IsCharAt);
+            AddCmd(kCQCKit::strCmdId_Multiply, ECmds::Multiply);
+            AddCmd(kCQCKit::strCmdId_Negate, ECmds::Negate);
+            AddCmd(kCQCKit::strCmdId_OR, ECmds::OR);
+            AddCmd(kCQCKit::strCmdId_PutCharAt, ECmds::PutCharAt);
+            AddCmd(kCQCKit::strCmdId_Replace, ECmds::Replace);
+            AddCmd(kCQCKit::strCmdId_ReplaceSubStr, ECmds::ReplaceSubStr);
+            AddCmd(kCQCKit::strCmdId_ReplaceToken, ECmds::ReplaceToken);
+            AddCmd(kCQCKit::strCmdId_SetNowPlus, ECmds::SetNowPlus);
+            AddCmd(kCQCKit::strCmdId_SetTimeVar, ECmds::SetTimeVar);
+            AddCmd(kCQCKit::strCmdId_SetVariable, ECmds::SetVariable);
+            AddCmd(kCQCKit::strCmdId_SetValueFrom, ECmds::SetValueFrom);
+            AddCmd(kCQCKit::strCmdId_SetVarFmt, ECmds::SetVarFmt);
+            AddCmd(kCQCKit::strCmdId_SplitAt, ECmds::SplitAt);
+            AddCmd(kCQCKit::strCmdId_Strip, ECmds::Strip);
+            AddCmd(kCQCKit::strCmdId_Subtract, ECmds::Subtract);
+            AddCmd(kCQCKit::strCmdId_TestAndSet, ECmds::TestAndSet);
+            AddCmd(kCQCKit::strCmdId_ToLower, ECmds::ToLower);
+            AddCmd(kCQCKit::strCmdId_ToUpper, ECmds::ToUpper);
+            AddCmd(kCQCKit::strCmdId_TrySetVariable, ECmds::TrySetVariable);
+            CQCKit_VarsTarget::atomCmdMapLoaded.Set();
+        }
+    }
+
+    const tCIDLib::TCard4 c4Atom = ccfgSrc.c4CmdAtom();
+    if (c4Atom >= CQCKit_VarsTarget::fcolCmdMap.c4ElemCount())
+        return ECmds::Unknown;
+    return CQCKit_VarsTarget::fcolCmdMap[c4Atom];
+}
+
+
+
 // ---------------------------------------------------------------------------
 //  CLASS: TStdVarsTar
 // PREFIX: ctar
@@ -448,14 +602,20 @@ TStdVarsTar::TStdVarsTar(const tCIDLib::EMTStates eMTSafe, const tCIDLib::TBoole
         tCIDLib::EAdoptOpts::Adopt, 67, TStringKeyOps(), &TCQCActVar::strKey, eMTSafe
       )
     , m_c4NextId(1)
+    , m_pmtxShards(nullptr)
     , m_strPrefix(bLocal ? kCQCKit::strActVarPref_LVar : kCQCKit::strActVarPref_GVar)
 {
     // Set the 'special' flag on us
     bIsSpecialCmdTar(kCIDLib::True);
+
+    // If we have to be thread safe, then set up our variable lock shards
+    if (eMTSafe == tCIDLib::EMTStates::Safe)
+        m_pmtxShards = new TMutex[CQCKit_VarsTarget::c4ShardCnt];
 }
 
 TStdVarsTar::~TStdVarsTar()
 {
+    delete [] m_pmtxShards;
 }
 
 
@@ -476,8 +636,8 @@ TStdVarsTar::bValidateParm( const   TCQCCmd&        cmdSrc
         return kCIDLib::False;
 
     // That's ok, so do our own stuff
-    if ((ccfgTar.strCmdId() == kCQCKit::strCmdId_IsCharAt)
-    ||  (ccfgTar.strCmdId() == kCQCKit::strCmdId_PutCharAt))
+    const ECmds eCmd = eMapCmdId(ccfgTar);
+    if ((eCmd == ECmds::IsCharAt) || (eCmd == ECmds::PutCharAt))
     {
         // Has to be a single character, can't be empty
         if (c4Index == 2)
@@ -489,7 +649,7 @@ TStdVarsTar::bValidateParm( const   TCQCCmd&        cmdSrc
             }
         }
     }
-     else if (ccfgTar.strCmdId() == kCQCKit::strCmdId_Replace)
+     else if (eCmd == ECmds::Replace)
     {
         if ((c4Index == 1) || (c4Index == 2))
         {
@@ -501,7 +661,7 @@ TStdVarsTar::bValidateParm( const   TCQCCmd&        cmdSrc
             }
         }
     }
-     else if (ccfgTar.strCmdId() == kCQCKit::strCmdId_SetVarFmt)
+     else if (eCmd == ECmds::SetVarFmt)
     {
         if (c4Index == 2)
         {
@@ -514,7 +674,7 @@ TStdVarsTar::bValidateParm( const   TCQCCmd&        cmdSrc
             }
         }
     }
-     else if (ccfgTar.strCmdId() == kCQCKit::strCmdId_TestAndSet)
+     else if (eCmd == ECmds::TestAndSet)
     {
         if (c4Index == 1)
         {
@@ -578,10 +738,16 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
 {
     static const tCIDLib::TCh* pszFile = CID_FILE;
 
-    // Lock our global variables while we do this
-    TLocker lockrVars(&ctarGlobalVars.m_colVars);
+    // Map the command id to our internal enum
+    const ECmds eCmd = eMapCmdId(ccfgToDo);
 
-    if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_AdjustEnumValue)
+    //
+    //  Lock the shards of any global variables this command refers to. Other
+    //  commands can work on globals in other shards at the same time.
+    //
+    TStdVarTarLockJan janVars(&ctarGlobalVars, ctarGlobalVars.c4ShardMask(ccfgToDo));
+
+    if (eCmd == ECmds::AdjustEnumValue)
     {
         //
         //  We'll move an enumerated variable to the next or previous value. Actually
@@ -618,7 +784,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
                 acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
         }
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_Add)
+     else if (eCmd == ECmds::Add)
     {
         // Get the target variable
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
@@ -626,7 +792,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varLHS.bAdd(ccfgToDo.piAt(1).m_strValue) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_AddQListValue)
+     else if (eCmd == ECmds::AddQListValue)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFind
@@ -634,30 +800,30 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
             strLHSKey, acteTar.ctarLocals(), ctarGlobalVars, pszFile, CID_LINE, kCIDLib::True
         );
 
-        m_strTmp = varLHS.strValue();
+        TString strNewVal = varLHS.strValue();
         TStringTokenizer::BuildQuotedCommaList
         (
-            ccfgToDo.piAt(1).m_strValue, m_strTmp
+            ccfgToDo.piAt(1).m_strValue, strNewVal
         );
 
-        if (varLHS.bSetValue(m_strTmp) && acteTar.pcmdtDebug())
-            acteTar.pcmdtDebug()->ActVarSet(strLHSKey, m_strTmp);
+        if (varLHS.bSetValue(strNewVal) && acteTar.pcmdtDebug())
+            acteTar.pcmdtDebug()->ActVarSet(strLHSKey, strNewVal);
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_AND)
+     else if (eCmd == ECmds::AND)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFindIt(strLHSKey, CID_LINE);
         if (varLHS.bBooleanOp(ccfgToDo.piAt(1).m_strValue, tCQCKit::ELogOps::AND) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_Append)
+     else if (eCmd == ECmds::Append)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFindIt(strLHSKey, CID_LINE);
         if (varLHS.bAppendValue(ccfgToDo.piAt(1).m_strValue) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_CapAt)
+     else if (eCmd == ECmds::CapAt)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFindIt(strLHSKey, CID_LINE);
@@ -666,8 +832,8 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varLHS.bCapAt(c4At) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
     }
-     else if ((ccfgToDo.strCmdId() == kCQCKit::strCmdId_CreateVariable)
-          ||  (ccfgToDo.strCmdId() == kCQCKit::strCmdId_SafeCreateVariable))
+     else if ((eCmd == ECmds::CreateVariable)
+          ||  (eCmd == ECmds::SafeCreateVariable))
     {
         // We get a name, a data type, a limit string, and initial value
         const TString& strName = ccfgToDo.piAt(0).m_strValue;
@@ -692,7 +858,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
 
         // If creating one, then it cannot already exist
         if (bVarExists(strName, acteTar.ctarLocals(), ctarGlobalVars)
-        &&  (ccfgToDo.strCmdId() == kCQCKit::strCmdId_CreateVariable))
+        &&  (eCmd == ECmds::CreateVariable))
         {
             facCQCKit().ThrowErr
             (
@@ -708,7 +874,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         // We can create it or add it
         bAddOrUpdateVar(strName, strInitVal, eType, strLimits);
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_CreateVarFromField)
+     else if (eCmd == ECmds::CreateVarFromField)
     {
         // Find the server hosting the indicated field
         const TString& strTarFld = ccfgToDo.piAt(1).m_strValue;
@@ -734,7 +900,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         // And now create the variable
         bAddOrUpdateVar(ccfgToDo.piAt(0).m_strValue, strInitVal, eType, flddTmp.strLimits());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_DelSubStr)
+     else if (eCmd == ECmds::DelSubStr)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFindIt(strLHSKey, CID_LINE);
@@ -745,7 +911,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varLHS.bDelSubStr(c4Start, c4Count) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_DelVariable)
+     else if (eCmd == ECmds::DelVariable)
     {
         // Remove this key if it exists. Return true if removed
         const TString& strKey = ccfgToDo.piAt(0).m_strValue;
@@ -753,7 +919,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (bResult && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarRemoved(strKey);
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_Divide)
+     else if (eCmd == ECmds::Divide)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFindIt(strLHSKey, CID_LINE);
@@ -761,7 +927,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varLHS.bDivide(ccfgToDo.piAt(1).m_strValue) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_ElapsedSince)
+     else if (eCmd == ECmds::ElapsedSince)
     {
         // The two last parms must be time based variables
         TCQCActVar& varFirst = varFind
@@ -848,14 +1014,14 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varTar.bSetValue(c4Elapsed) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(varTar.strName(), varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_Exists)
+     else if (eCmd == ECmds::Exists)
     {
         bResult = bVarExists
         (
             ccfgToDo.piAt(0).m_strValue, acteTar.ctarLocals(), ctarGlobalVars
         );
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_Find)
+     else if (eCmd == ECmds::Find)
     {
         //
         //  Get the source var (to search), the pattern to find, and the
@@ -889,11 +1055,12 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
             , kCIDLib::True
         );
 
-        m_strTmp.SetFormatted(c4At);
-        if (varTar.bSetValue(m_strTmp) && acteTar.pcmdtDebug())
+        TString strNewVal;
+        strNewVal.SetFormatted(c4At);
+        if (varTar.bSetValue(strNewVal) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(varTar.strName(), varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_GetEnumOrdinal)
+     else if (eCmd == ECmds::GetEnumOrdinal)
     {
         // Get the source variable
         const TString& strSrcKey = ccfgToDo.piAt(0).m_strValue;
@@ -935,8 +1102,8 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
                 acteTar.pcmdtDebug()->ActVarSet(strTarKey, varTar.strValue());
         }
     }
-     else if ((ccfgToDo.strCmdId() == kCQCKit::strCmdId_GetLength)
-          ||  (ccfgToDo.strCmdId() == kCQCKit::strCmdId_GetText))
+     else if ((eCmd == ECmds::GetLength)
+          ||  (eCmd == ECmds::GetText))
     {
         // Find the source variable
         const TString& strSrcKey = ccfgToDo.piAt(0).m_strValue;
@@ -956,7 +1123,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
             , kCIDLib::True
         );
 
-        if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_GetLength)
+        if (eCmd == ECmds::GetLength)
         {
             // In this case we put the length of the source into the target
             bResult = varTar.bSetValue(varSrc.strValue().c4Length());
@@ -970,7 +1137,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (acteTar.pcmdtDebug() && bResult)
             acteTar.pcmdtDebug()->ActVarSet(varTar.strName(), varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_GetNthEnumVal)
+     else if (eCmd == ECmds::GetNthEnumVal)
     {
         // Look up the referenced variable
         TCQCActVar& varSrc = varFindIt(ccfgToDo.piAt(0).m_strValue, CID_LINE);
@@ -992,11 +1159,13 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varTar.bSetValue(strVal) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(varTar.strName(), varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_GetNumericRange)
+     else if (eCmd == ECmds::GetNumericRange)
     {
         // Look up the referenced variable
         TCQCActVar& varSrc = varFindIt(ccfgToDo.piAt(0).m_strValue, CID_LINE);
-        varSrc.QueryNumericLimits(m_strTmp, m_strTmp2);
+        TString strMinVal;
+        TString strMaxVal;
+        varSrc.QueryNumericLimits(strMinVal, strMaxVal);
 
         // And store the values away
         TCQCActVar& varMinVal = varFind
@@ -1008,7 +1177,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
             , CID_LINE
             , kCIDLib::True
         );
-        if (varMinVal.bSetValue(m_strTmp) && acteTar.pcmdtDebug())
+        if (varMinVal.bSetValue(strMinVal) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(varMinVal.strName(), varMinVal.strValue());
 
         TCQCActVar& varMaxVal = varFind
@@ -1020,10 +1189,10 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
             , CID_LINE
             , kCIDLib::True
         );
-        if (varMaxVal.bSetValue(m_strTmp) && acteTar.pcmdtDebug())
+        if (varMaxVal.bSetValue(strMaxVal) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(varMaxVal.strName(), varMaxVal.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_GetSubStr)
+     else if (eCmd == ECmds::GetSubStr)
     {
         TCQCActVar& varSrc = varFindIt(ccfgToDo.piAt(0).m_strValue, CID_LINE);
         const tCIDLib::TCard4 c4Start = ccfgToDo.piAt(1).m_strValue.c4Val();
@@ -1042,11 +1211,12 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (!c4Count)
             c4Count = kCIDLib::c4MaxCard;
 
-        varSrc.strValue().CopyOutSubStr(m_strTmp, c4Start, c4Count);
-        if (varTar.bSetValue(m_strTmp) && acteTar.pcmdtDebug())
+        TString strNewVal;
+        varSrc.strValue().CopyOutSubStr(strNewVal, c4Start, c4Count);
+        if (varTar.bSetValue(strNewVal) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(varTar.strName(), varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_Insert)
+     else if (eCmd == ECmds::Insert)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varTar = varFindIt(strLHSKey, CID_LINE);
@@ -1054,7 +1224,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varTar.bInsertValue(ccfgToDo.piAt(1).m_strValue, c4At) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_IsCharAt)
+     else if (eCmd == ECmds::IsCharAt)
     {
         const TString& strVal = ccfgToDo.piAt(0).m_strValue;
         const tCIDLib::TCard4 c4Index = ccfgToDo.piAt(1).m_strValue.c4Val();
@@ -1066,7 +1236,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
          else
             bResult = (strVal[c4Index] == chChar);
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_Multiply)
+     else if (eCmd == ECmds::Multiply)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFindIt(strLHSKey, CID_LINE);
@@ -1074,21 +1244,21 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varLHS.bMultiply(ccfgToDo.piAt(1).m_strValue) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_Negate)
+     else if (eCmd == ECmds::Negate)
     {
         const TString& strKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varVal = varFindIt(strKey, CID_LINE);
         if (varVal.bNegate() && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strKey, varVal.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_OR)
+     else if (eCmd == ECmds::OR)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFindIt(strLHSKey, CID_LINE);
         if (varLHS.bBooleanOp(ccfgToDo.piAt(1).m_strValue, tCQCKit::ELogOps::OR) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_PutCharAt)
+     else if (eCmd == ECmds::PutCharAt)
     {
         const TString& strVar = ccfgToDo.piAt(0).m_strValue;
         const tCIDLib::TCard4 c4Index = ccfgToDo.piAt(1).m_strValue.c4Val();
@@ -1109,7 +1279,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
                 acteTar.pcmdtDebug()->ActDebug(L"Invalid PutCharAt index");
         }
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_Replace)
+     else if (eCmd == ECmds::Replace)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFindIt(strLHSKey, CID_LINE);
@@ -1119,7 +1289,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varLHS.bReplaceChars(strToReplace[0], strRepWith[0]) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_ReplaceSubStr)
+     else if (eCmd == ECmds::ReplaceSubStr)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFindIt(strLHSKey, CID_LINE);
@@ -1135,7 +1305,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
             strToReplace, strRepWith, bCaseSensitive
         );
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_ReplaceToken)
+     else if (eCmd == ECmds::ReplaceToken)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFindIt(strLHSKey, CID_LINE);
@@ -1144,7 +1314,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varLHS.bReplaceToken(strToken[0], strRepWith) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_SetNowPlus)
+     else if (eCmd == ECmds::SetNowPlus)
     {
         // Look up the variable, which must exist
         TCQCActVar& varTar = varFind
@@ -1190,7 +1360,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (bChanged && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(varTar.strName(), varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_SetTimeVar)
+     else if (eCmd == ECmds::SetTimeVar)
     {
         // Look up the variable, which must exist
         TCQCActVar& varTar = varFind
@@ -1240,7 +1410,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varTar.bSetValue(tmNew.enctTime()) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(varTar.strName(), varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_SetVariable)
+     else if (eCmd == ECmds::SetVariable)
     {
         // Create or update this key. Return true if added
         SetVar
@@ -1251,7 +1421,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
             , bResult
         );
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_SetValueFrom)
+     else if (eCmd == ECmds::SetValueFrom)
     {
         //
         //  This is kind of a special one, which allows the value to be set
@@ -1284,7 +1454,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (bResult && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strTarKey, varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_SetVarFmt)
+     else if (eCmd == ECmds::SetVarFmt)
     {
         //
         //  Handle old style enum prefix, which might still be around. Bu tour
@@ -1309,7 +1479,7 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         );
         varTar.SetFormat(eRad, c4Digits);
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_SplitAt)
+     else if (eCmd == ECmds::SplitAt)
     {
         const TString& strSrcKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varSrc = varFindIt(strSrcKey, CID_LINE);
@@ -1317,13 +1487,14 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
 
         // The target may not exist
         const TString& strTarName = ccfgToDo.piAt(1).m_strValue;
-        varSrc.strValue().CopyOutSubStr(m_strTmp, c4At);
-        SetVar(strTarName, m_strTmp, acteTar.pcmdtDebug(), bResult);
+        TString strNewVal;
+        varSrc.strValue().CopyOutSubStr(strNewVal, c4At);
+        SetVar(strTarName, strNewVal, acteTar.pcmdtDebug(), bResult);
 
         if (varSrc.bCapAt(c4At) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strSrcKey, varSrc.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_Strip)
+     else if (eCmd == ECmds::Strip)
     {
         // Find the variable we will strip
         const TString& strTarKey = ccfgToDo.piAt(0).m_strValue;
@@ -1363,14 +1534,14 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
         if (varTar.bStrip(strToStrip, eMode) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strTarKey, varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_Subtract)
+     else if (eCmd == ECmds::Subtract)
     {
         const TString& strLHSKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varLHS = varFindIt(strLHSKey, CID_LINE);
         if (varLHS.bSubtract(ccfgToDo.piAt(1).m_strValue) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strLHSKey, varLHS.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_TestAndSet)
+     else if (eCmd == ECmds::TestAndSet)
     {
         //
         //  In this case, we have to be prepared to create, test, and set
@@ -1421,35 +1592,35 @@ TStdVarsTar::eDoCmd(const   TCQCCmdCfg&         ccfgToDo
             }
 
             //
-            //  Pause a bit, after releasing the mutex else we'd deadlock.
+            //  Pause a bit, after releasing the shards else we'd deadlock.
             //  If we are asked to shut down, then give up with a failure.
             //  We don't need to get the lock back if we are giving up.
             //
-            lockrVars.Release();
+            janVars.Release();
             if (!pthrMe->bSleep(100))
                 break;
 
             // Get the lock again before we do another round
-            lockrVars.Lock();
+            janVars.Lock();
 
             enctCur = TTime::enctNow();
         }   while (enctCur < enctEnd);
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_ToLower)
+     else if (eCmd == ECmds::ToLower)
     {
         const TString& strTarKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varTar = varFindIt(strTarKey, CID_LINE);
         if (varTar.bUpLow(kCIDLib::False) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strTarKey, varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_ToUpper)
+     else if (eCmd == ECmds::ToUpper)
     {
         const TString& strTarKey = ccfgToDo.piAt(0).m_strValue;
         TCQCActVar& varTar = varFindIt(strTarKey, CID_LINE);
         if (varTar.bUpLow(kCIDLib::True) && acteTar.pcmdtDebug())
             acteTar.pcmdtDebug()->ActVarSet(strTarKey, varTar.strValue());
     }
-     else if (ccfgToDo.strCmdId() == kCQCKit::strCmdId_TrySetVariable)
+     else if (eCmd == ECmds::TrySetVariable)
     {
         try
         {
@@ -2544,7 +2715,11 @@ TStdVarsTar::bAddOrUpdateVar(const  TString&            strName
     tCIDLib::TBoolean bRet = kCIDLib::False;
     TCQCActVar* pvarTar = 0;
 
-    // We have to lock here since it's not a single atomic op
+    //
+    //  We have to lock here since it's not a single atomic op. The variable's
+    //  shard always goes first, then the list.
+    //
+    TStdVarTarLockJan janVars(this, c4ShardMask(strName));
     TLocker lockrVars(&m_colVars);
 
     // See if it currently exists
@@ -2597,6 +2772,7 @@ TStdVarsTar::bVarValue( const   TString&    strKey
                         ,       TString&    strToFill) const
 {
     // This one isn't one atomic op, so we have to lock
+    TStdVarTarLockJan janVars(this, c4ShardMask(strKey));
     TLocker lockrVars(&m_colVars);
     const TCQCActVar* pvarRet = m_colVars.pobjFindByKey(strKey, kCIDLib::False);
     if (!pvarRet)
@@ -2606,7 +2782,10 @@ TStdVarsTar::bVarValue( const   TString&    strKey
 }
 
 
-// Let the outside world have a const cursor to the variables
+//
+//  Let the outside world have a const cursor to the variables. If we are thread
+//  safe, they should hold a TStdVarTarLockJan on us while they use it.
+//
 TStdVarsTar::TCursor TStdVarsTar::cursVars() const
 {
     return TCursor(&m_colVars);
@@ -2622,6 +2801,7 @@ TStdVarsTar::TCursor TStdVarsTar::cursVars() const
 //
 tCIDLib::TVoid TStdVarsTar::DeleteAllVars()
 {
+    TStdVarTarLockJan janVars(this);
     m_colVars.RemoveAll();
 }
 
@@ -2646,6 +2826,7 @@ TStdVarsTar::eVarValue( const   TString&            strKey
                         ,       tCIDLib::TCard4&    c4VarId) const
 {
     // This isn't a single atomic op, so we have to lock
+    TStdVarTarLockJan janVars(this, c4ShardMask(strKey));
     TLocker lockrVars(&m_colVars);
     const TCQCActVar* pvarRet = m_colVars.pobjFindByKey(strKey, kCIDLib::False);
     if (pvarRet)
@@ -2685,6 +2866,7 @@ TStdVarsTar::eVarValue( const   TString&            strKey
                         ,       tCIDLib::TCard4&    c4SerialNum) const
 {
     // This isn't a single atomic op, so we have to lock
+    TStdVarTarLockJan janVars(this, c4ShardMask(strKey));
     TLocker lockrVars(&m_colVars);
     const TCQCActVar* pvarRet = m_colVars.pobjFindByKey(strKey, kCIDLib::False);
     if (pvarRet)
@@ -2726,6 +2908,7 @@ TStdVarsTar::UpdateVar( const   TString&    strKey
                         , const TString&    strValue)
 {
     // This isn't a single atomic op, so we have to lock
+    TStdVarTarLockJan janVars(this, c4ShardMask(strKey));
     TLocker lockrVars(&m_colVars);
     TCQCActVar* pvarRet = m_colVars.pobjFindByKey(strKey, kCIDLib::False);
     if (!pvarRet)
@@ -2766,6 +2949,35 @@ const TCQCActVar& TStdVarsTar::varFindByName(const TString& strName) const
 //  TStdVarsTar: Private, non-virtual methods
 // ---------------------------------------------------------------------------
 
+//
+//  Return the mask of lock shards that the passed variable, or the variables of
+//  ours named in the passed command's parameters, fall into. If we are not thread
+//  safe, it's always zero, so nothing gets locked.
+//
+tCIDLib::TCard4 TStdVarsTar::c4ShardMask(const TString& strName) const
+{
+    if (!m_pmtxShards)
+        return 0;
+    return 0x1UL << strName.hshCalcHash(CQCKit_VarsTarget::c4ShardCnt);
+}
+
+tCIDLib::TCard4 TStdVarsTar::c4ShardMask(const TCQCCmdCfg& ccfgSrc) const
+{
+    if (!m_pmtxShards)
+        return 0;
+
+    tCIDLib::TCard4 c4Ret = 0;
+    const tCIDLib::TCard4 c4PCount = ccfgSrc.c4ParmCnt();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4PCount; c4Index++)
+    {
+        const TString& strCur = ccfgSrc.piAt(c4Index).m_strValue;
+        if (strCur.bStartsWith(m_strPrefix))
+            c4Ret |= c4ShardMask(strCur);
+    }
+    return c4Ret;
+}
+
+
 // Checks the passed variable and throws if not of the indicated type
 tCIDLib::TVoid
 TStdVarsTar::CheckVarType(  const   TCQCActVar&         varTar
@@ -2813,6 +3025,7 @@ TStdVarsTar::SetVar(const   TString&                strKey
     }
 
     // This isn't a single atomic op, so we have to lock
+    TStdVarTarLockJan janVars(this, c4ShardMask(strKey));
     TLocker lockrVars(&m_colVars);
 
     TCQCActVar* pvarRet = m_colVars.pobjFindByKey(strKey, kCIDLib::False);
@@ -2885,3 +3098,85 @@ TStdVarsTar::ThrowNotFound( const   TString&            strName
 
 
 
+// ---------------------------------------------------------------------------
+//  CLASS: TStdVarTarLockJan
+// PREFIX: jan
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TStdVarTarLockJan: Constructors and Destructor
+// ---------------------------------------------------------------------------
+
+// Lock all of the shards and the variable list, for iteration or bulk changes
+TStdVarTarLockJan::TStdVarTarLockJan(const TStdVarsTar* const pctarToLock) :
+
+    m_bListLock(kCIDLib::True)
+    , m_bLocked(kCIDLib::False)
+    , m_c4ShardMask(0)
+    , m_pctarToLock(pctarToLock)
+{
+    if (m_pctarToLock->m_pmtxShards)
+        m_c4ShardMask = 0xFFFFFFFF >> (32 - CQCKit_VarsTarget::c4ShardCnt);
+    Lock();
+}
+
+// Lock just the indicated shards
+TStdVarTarLockJan::TStdVarTarLockJan(const  TStdVarsTar* const  pctarToLock
+                                    , const tCIDLib::TCard4     c4ShardMask) :
+
+    m_bListLock(kCIDLib::False)
+    , m_bLocked(kCIDLib::False)
+    , m_c4ShardMask(c4ShardMask)
+    , m_pctarToLock(pctarToLock)
+{
+    Lock();
+}
+
+TStdVarTarLockJan::~TStdVarTarLockJan()
+{
+    Release();
+}
+
+
+// ---------------------------------------------------------------------------
+//  TStdVarTarLockJan: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  The shards are always locked in ascending order, and the list after them, so
+//  that two janitors can never deadlock each other.
+//
+tCIDLib::TVoid TStdVarTarLockJan::Lock()
+{
+    if (m_bLocked)
+        return;
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < CQCKit_VarsTarget::c4ShardCnt; c4Index++)
+    {
+        if (m_c4ShardMask & (0x1UL << c4Index))
+            m_pctarToLock->m_pmtxShards[c4Index].Lock();
+    }
+
+    if (m_bListLock)
+        m_pctarToLock->m_colVars.Lock();
+    m_bLocked = kCIDLib::True;
+}
+
+
+tCIDLib::TVoid TStdVarTarLockJan::Release()
+{
+    if (!m_bLocked)
+        return;
+
+    if (m_bListLock)
+        m_pctarToLock->m_colVars.Unlock();
+
+    tCIDLib::TCard4 c4Index = CQCKit_VarsTarget::c4ShardCnt;
+    while (c4Index)
+    {
+        c4Index--;
+        if (m_c4ShardMask & (0x1UL << c4Index))
+            m_pctarToLock->m_pmtxShards[c4Index].Unlock();
+    }
+    m_bLocked = kCIDLib::False;
+}
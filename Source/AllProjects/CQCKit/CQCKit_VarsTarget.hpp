@@ -250,6 +250,16 @@ class CQCKITEXPORT TStdVarsTar : public TObject, public MCQCCmdTarIntf
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TCard4 c4ShardMask
+        (
+            const   TString&                strName
+        )   const;
+
+        tCIDLib::TCard4 c4ShardMask
+        (
+            const   TCQCCmdCfg&             ccfgSrc
+        )   const;
+
         tCIDLib::TVoid CheckVarType
         (
             const   TCQCActVar&             varTar
@@ -297,11 +307,16 @@ class CQCKITEXPORT TStdVarsTar : public TObject, public MCQCCmdTarIntf
         //  m_colVars
         //      Storage for the variable objects that define our vars. If this
         //      object instance needs to be thread safe, then we make this
-        //      collection threadsafe, and use it to lock during command processing.
+        //      collection threadsafe, which protects adds and removes. Values
+        //      are protected by the m_pmtxShards locks.
         //
-        //  m_strTmp
-        //      We do a lot of string swizzling, so to avoid creating tmp
-        //      strings, we keep one around for temp use.
+        //  m_pmtxShards
+        //      If we are thread safe, an array of mutexes that the variables
+        //      are spread over by name hash. Commands only lock the shards of
+        //      the global variables named in their parameters, so commands on
+        //      unrelated globals don't serialize. Anything that affects all of
+        //      the variables locks every shard. See TStdVarTarLockJan, which
+        //      also defines the lock order. Null if not thread safe.
         //
         //  m_strPrefix
         //      The variable name prefix for our variables. We store it during
@@ -311,8 +326,7 @@ class CQCKITEXPORT TStdVarsTar : public TObject, public MCQCCmdTarIntf
         tCIDLib::TBoolean       m_bIsLocal;
         tCIDLib::TCard4         m_c4NextId;
         tCQCKit::TVarList       m_colVars;
-        TString                 m_strTmp;
-        TString                 m_strTmp2;
+        TMutex*                 m_pmtxShards;
         TString                 m_strPrefix;
 
 
@@ -323,6 +337,80 @@ class CQCKITEXPORT TStdVarsTar : public TObject, public MCQCCmdTarIntf
 };
 
 
+
+// ---------------------------------------------------------------------------
+//  CLASS: TStdVarTarLockJan
+// PREFIX: jan
+//
+//  Locks a variables target. One version locks just the passed shards, which is
+//  what commands do. The other locks all of the shards and the variable list,
+//  which is what anyone iterating the variables via cursVars() should use. The
+//  shards are locked in ascending order, then the list.
+// ---------------------------------------------------------------------------
+class CQCKITEXPORT TStdVarTarLockJan
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TStdVarTarLockJan() = delete;
+
+        TStdVarTarLockJan
+        (
+            const   TStdVarsTar* const      pctarToLock
+        );
+
+        TStdVarTarLockJan
+        (
+            const   TStdVarsTar* const      pctarToLock
+            , const tCIDLib::TCard4         c4ShardMask
+        );
+
+        TStdVarTarLockJan(const TStdVarTarLockJan&) = delete;
+        TStdVarTarLockJan(TStdVarTarLockJan&&) = delete;
+
+        ~TStdVarTarLockJan();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TStdVarTarLockJan& operator=(const TStdVarTarLockJan&) = delete;
+        TStdVarTarLockJan& operator=(TStdVarTarLockJan&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid Lock();
+
+        tCIDLib::TVoid Release();
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_bListLock
+        //      Whether we lock the variable list after the shards.
+        //
+        //  m_bLocked
+        //      Whether we currently hold our locks, so that Release() and
+        //      Lock() can be called around a wait.
+        //
+        //  m_c4ShardMask
+        //      The shards we lock, one bit per shard.
+        //
+        //  m_pctarToLock
+        //      The target we are locking.
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean       m_bListLock;
+        tCIDLib::TBoolean       m_bLocked;
+        tCIDLib::TCard4         m_c4ShardMask;
+        const TStdVarsTar*      m_pctarToLock;
+};
+
+
 #pragma CIDLIB_POPPACK
 
 
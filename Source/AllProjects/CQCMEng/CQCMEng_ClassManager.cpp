@@ -150,41 +150,19 @@ TTextInStream*
 TCQCMEngClassMgr::pstrmDoLoad(  const   TString&                strClassPath
                                 , const tCIDMacroEng::EResModes    )
 {
-    // Convert the class path
-    TString strRelPath;
-    facCQCRemBrws().CMLClassPathToRelPath(strClassPath, strRelPath);
-
-
     //
     //  Try to load this guy up. We'll need a string to use. If it works,
     //  we give the string to the stream we return. Put a janitor on it for
-    //  the meantime. Here, since we are always used just to load classes
-    //  for invocation, we say we want to get either encrypted or non-encrypted
-    //  macros.
+    //  the meantime.
+    //
+    //  We get it via the facility's class cache, which is shared by all of the
+    //  class managers in this process, so that we don't download the same
+    //  classes over and over. It gets either encrypted or non-encrypted macros,
+    //  since we are always used just to load classes for invocation.
     //
     TString* pstrLoad = new TString;
     TJanitor<TString> janLoad(pstrLoad);
-    {
-        //
-        //  We use a data server client object to get the file. We just pass zero
-        //  as the serial number since aren't doing any local caching here, not
-        //  yet anyway. So we don't care about the return value.
-        //
-        TDataSrvClient          dsclRead;
-        tCIDLib::TCard4         c4SerNum = 0;
-        tCIDLib::TEncodedTime   enctLastChange;
-        tCIDLib::TKVPFList      colMeta;
-        dsclRead.bReadMacro
-        (
-            strRelPath
-            , c4SerNum
-            , enctLastChange
-            , *pstrLoad
-            , kCIDLib::True
-            , colMeta
-            , m_sectUser
-        );
-    }
+    facCQCMEng().LoadClassText(strClassPath, m_sectUser, *pstrLoad);
 
     //
     //  Ok, we got it, so create a string based text input stream and give
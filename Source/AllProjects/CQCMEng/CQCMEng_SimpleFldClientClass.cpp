@@ -1405,6 +1405,9 @@ TSimpleFldInfo::bInvokeMethod(          TCIDMacroEngine&    meOwner
 
         catch(const TError& errToCatch)
         {
+            // Make sure we do a new lookup next time
+            facCQCKit().DropCQCSrvAdminProxy(strMoniker);
+
             // Throw a generic read or write failed error
             ThrowAnErr
             (
@@ -1454,6 +1457,7 @@ TSimpleFldInfo::bInvokeMethod(          TCIDMacroEngine&    meOwner
 
         catch(const TError& errToCatch)
         {
+            facCQCKit().DropCQCSrvAdminProxy(strMoniker);
             ThrowAnErr(meOwner, m_c4ErrReadFailed, errToCatch);
         }
     }
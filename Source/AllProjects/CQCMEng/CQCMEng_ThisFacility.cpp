@@ -36,6 +36,50 @@ RTTIDecls(TFacCQCMEng,TFacility)
 
 
 
+// ---------------------------------------------------------------------------
+//  Local types and constants
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CQCMEng_ThisFacility
+    {
+        //
+        //  How long we trust a user token that the data server accepted for a
+        //  class before we check with the server again, and the most tokens we
+        //  remember per class.
+        //
+        constexpr tCIDLib::TEncodedTime enctRecheck = kCIDLib::enctOneSecond * 5;
+        constexpr tCIDLib::TCard4       c4MaxUsers = 8;
+
+        //
+        //  The most classes we cache, and how long one can go unused before we
+        //  drop it.
+        //
+        constexpr tCIDLib::TCard4       c4MaxClasses = 256;
+        constexpr tCIDLib::TEncodedTime enctMaxIdle = kCIDLib::enctOneMinute * 30;
+
+
+        // Tokens are opaque, so we just compare the bytes
+        tCIDLib::TBoolean bSameToken(const TCQCSecToken& sect1, const TCQCSecToken& sect2)
+        {
+            const tCIDLib::TCard4 c4Bytes = sect1.c4Bytes();
+            if (c4Bytes != sect2.c4Bytes())
+                return kCIDLib::False;
+
+            const THeapBuf& mbuf1 = sect1.mbufData();
+            const THeapBuf& mbuf2 = sect2.mbufData();
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Bytes; c4Index++)
+            {
+                if (mbuf1[c4Index] != mbuf2[c4Index])
+                    return kCIDLib::False;
+            }
+            return kCIDLib::True;
+        }
+    }
+}
+
+
+
 // ---------------------------------------------------------------------------
 //   CLASS: TFacCQCMEng
 //  PREFIX: fac
@@ -55,6 +99,13 @@ TFacCQCMEng::TFacCQCMEng() :
         , kCQCKit::c4Revision
         , tCIDLib::EModFlags::HasMsgFile
     )
+    , m_colClassCache
+      (
+        tCIDLib::EAdoptOpts::Adopt
+        , 109
+        , TStringKeyOps(kCIDLib::False)
+        , &TClassItem::strKey
+      )
 {
 }
 
@@ -82,3 +133,198 @@ tCIDLib::TVoid TFacCQCMEng::InitCMLRuntime(const TCQCSecToken& sectUser)
 }
 
 
+//
+//  Our class manager calls this to get the text of a class. If we have it cached
+//  and the data server recently accepted this user's token for it, we just return
+//  the cached text. Otherwise we ask the server, since the cache is shared by all
+//  users and the server has to check that this user can access the class. We pass
+//  our cached serial number, so that it only sends the text if it changed. If the
+//  class doesn't exist, or the user can't access it, the data server client throws
+//  and we let that go back to the caller.
+//
+tCIDLib::TVoid
+TFacCQCMEng::LoadClassText( const   TString&        strClassPath
+                            , const TCQCSecToken&   sectUser
+                            ,       TString&        strToFill)
+{
+    tCIDLib::TCard4 c4SerialNum = 0;
+    {
+        TLocker lockrSync(&m_mtxSync);
+        TClassItem* pitemCur = m_colClassCache.pobjFindByKey(strClassPath);
+        if (pitemCur)
+        {
+            const tCIDLib::TEncodedTime enctNow = TTime::enctNow();
+            pitemCur->m_enctLastUsed = enctNow;
+            if (bUserChecked(*pitemCur, sectUser, enctNow))
+            {
+                strToFill = pitemCur->m_strText;
+                return;
+            }
+            c4SerialNum = pitemCur->m_c4SerialNum;
+        }
+    }
+
+    //
+    //  We have to go to the server. Don't hold the lock while we do this, so that
+    //  we don't hold up other threads loading other classes.
+    //
+    TString strRelPath;
+    facCQCRemBrws().CMLClassPathToRelPath(strClassPath, strRelPath);
+
+    TDataSrvClient          dsclRead;
+    tCIDLib::TEncodedTime   enctLastChange;
+    tCIDLib::TKVPFList      colMeta;
+    const tCIDLib::TBoolean bNewData = dsclRead.bReadMacro
+    (
+        strRelPath
+        , c4SerialNum
+        , enctLastChange
+        , strToFill
+        , kCIDLib::True
+        , colMeta
+        , sectUser
+    );
+
+    {
+        TLocker lockrSync(&m_mtxSync);
+        const tCIDLib::TEncodedTime enctNow = TTime::enctNow();
+        TClassItem* pitemCur = m_colClassCache.pobjFindByKey(strClassPath);
+        if (bNewData)
+        {
+            //
+            //  Add it if not already cached, making room if needed, then store the
+            //  new info. Any tokens accepted for the old text are dropped.
+            //
+            if (!pitemCur)
+            {
+                TrimClassCache(enctNow);
+                pitemCur = new TClassItem(strClassPath);
+                m_colClassCache.Add(pitemCur);
+            }
+            pitemCur->m_c4SerialNum = c4SerialNum;
+            pitemCur->m_strText = strToFill;
+            pitemCur->m_colUsers.RemoveAll();
+            pitemCur->m_enctLastUsed = enctNow;
+            SetUserChecked(*pitemCur, sectUser, enctNow);
+            return;
+        }
+
+        // Our cached copy is still current, if it wasn't dropped in the meantime
+        if (pitemCur)
+        {
+            strToFill = pitemCur->m_strText;
+            SetUserChecked(*pitemCur, sectUser, enctNow);
+            return;
+        }
+    }
+
+    //
+    //  Another thread dropped it from the cache while we were checking, so we have
+    //  no text to return. Try again, which will get the full text this time since
+    //  it's not cached.
+    //
+    LoadClassText(strClassPath, sectUser, strToFill);
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TFacCQCMEng: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Returns true if the data server has accepted this user's token for the class
+//  recently enough that we can trust it. The caller must lock.
+//
+tCIDLib::TBoolean
+TFacCQCMEng::bUserChecked(  const   TClassItem&             itemSrc
+                            , const TCQCSecToken&           sectUser
+                            , const tCIDLib::TEncodedTime   enctNow) const
+{
+    const tCIDLib::TCard4 c4Count = itemSrc.m_colUsers.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        const TUserCheck& uchkCur = itemSrc.m_colUsers[c4Index];
+        if (CQCMEng_ThisFacility::bSameToken(uchkCur.m_sectUser, sectUser))
+            return (enctNow < uchkCur.m_enctValidTill);
+    }
+    return kCIDLib::False;
+}
+
+
+//
+//  The data server just accepted this user's token for the class, so remember it.
+//  If it's already in the list we just update the time, else we add it, replacing
+//  the one that expires soonest if the list is full. The caller must lock.
+//
+tCIDLib::TVoid
+TFacCQCMEng::SetUserChecked(        TClassItem&             itemTar
+                            , const TCQCSecToken&           sectUser
+                            , const tCIDLib::TEncodedTime   enctNow)
+{
+    const tCIDLib::TEncodedTime enctValidTill = enctNow + CQCMEng_ThisFacility::enctRecheck;
+
+    tCIDLib::TCard4 c4Oldest = 0;
+    const tCIDLib::TCard4 c4Count = itemTar.m_colUsers.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        TUserCheck& uchkCur = itemTar.m_colUsers[c4Index];
+        if (CQCMEng_ThisFacility::bSameToken(uchkCur.m_sectUser, sectUser))
+        {
+            uchkCur.m_enctValidTill = enctValidTill;
+            return;
+        }
+
+        if (uchkCur.m_enctValidTill < itemTar.m_colUsers[c4Oldest].m_enctValidTill)
+            c4Oldest = c4Index;
+    }
+
+    if (c4Count < CQCMEng_ThisFacility::c4MaxUsers)
+    {
+        TUserCheck uchkNew;
+        uchkNew.m_enctValidTill = enctValidTill;
+        uchkNew.m_sectUser = sectUser;
+        itemTar.m_colUsers.objAdd(uchkNew);
+    }
+     else
+    {
+        TUserCheck& uchkOld = itemTar.m_colUsers[c4Oldest];
+        uchkOld.m_enctValidTill = enctValidTill;
+        uchkOld.m_sectUser = sectUser;
+    }
+}
+
+
+//
+//  Called before we add a new class to the cache. We drop any that haven't been
+//  used for a while. If we are still full, we drop the least recently used one.
+//  The caller must lock.
+//
+tCIDLib::TVoid TFacCQCMEng::TrimClassCache(const tCIDLib::TEncodedTime enctNow)
+{
+    tCIDLib::TStrList colDrop;
+    const TClassItem* pitemLRU = nullptr;
+
+    TClassCache::TCursor cursItems(&m_colClassCache);
+    if (cursItems.bReset())
+    {
+        do
+        {
+            const TClassItem& itemCur = cursItems.objRCur();
+            if (itemCur.m_enctLastUsed + CQCMEng_ThisFacility::enctMaxIdle < enctNow)
+                colDrop.objAdd(itemCur.m_strClassPath);
+             else if (!pitemLRU || (itemCur.m_enctLastUsed < pitemLRU->m_enctLastUsed))
+                pitemLRU = &itemCur;
+        }   while (cursItems.bNext());
+    }
+
+    if (pitemLRU
+    &&  (m_colClassCache.c4ElemCount() - colDrop.c4ElemCount() >= CQCMEng_ThisFacility::c4MaxClasses))
+    {
+        colDrop.objAdd(pitemLRU->m_strClassPath);
+    }
+
+    const tCIDLib::TCard4 c4Count = colDrop.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        m_colClassCache.bRemoveKey(colDrop[c4Index]);
+}
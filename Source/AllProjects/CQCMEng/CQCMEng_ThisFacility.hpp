@@ -17,8 +17,34 @@
 //
 //  This file defines facility class for this facility.
 //
+//  We also provide a process wide cache of CML class source, which our class
+//  manager uses when loading classes. Every place that runs CML creates its own
+//  engine and class manager, and parsing a class pulls in all of the classes it
+//  references. Without the cache, every run of every action, event, or web
+//  handler downloaded the whole set of classes again from the data server.
+//
+//  The cache is keyed by class path and holds the data server's serial number
+//  for each one. Since the cache is shared by all users, the data server has to
+//  check the caller's access to the class. So each item also remembers the
+//  security tokens that the server has recently accepted for it. If the caller's
+//  token is one of those, we just return the cached text with no round trip.
+//  Otherwise we go to the server, passing the cached serial number in, so if the
+//  class hasn't changed the server just tells us it's still current and nothing
+//  is transferred.
+//
+//  The cache is bounded. Classes not used for a while are dropped, and if it is
+//  still full, the least recently used one is dropped to make room.
+//
 // CAVEATS/GOTCHAS:
 //
+//  1.  We cannot cache the parsed classes themselves, since the macro engine
+//      binds class info to the engine that parsed it. So this only removes
+//      the download, each engine still parses the text.
+//
+//  2.  A token is trusted for a class for a few seconds after the server last
+//      accepted it, so changes to a class, or to a user's access to it, can
+//      take that long to be seen.
+//
 // LOG:
 //
 #pragma once
@@ -59,8 +85,100 @@ class CQCMENGEXPORT TFacCQCMEng : public TFacility
             const   TCQCSecToken&           sectUser
         );
 
+        tCIDLib::TVoid LoadClassText
+        (
+            const   TString&                strClassPath
+            , const TCQCSecToken&           sectUser
+            ,       TString&                strToFill
+        );
+
 
     private :
+        // -------------------------------------------------------------------
+        //  Private types
+        //
+        //  Cache items for the class source cache, keyed by the class path.
+        //  Each one has a small list of the user tokens the data server has
+        //  recently accepted for it, and until when we trust them.
+        // -------------------------------------------------------------------
+        class TUserCheck
+        {
+            public :
+                tCIDLib::TEncodedTime   m_enctValidTill;
+                TCQCSecToken            m_sectUser;
+        };
+        using TUserChecks = TVector<TUserCheck>;
+
+        class TClassItem
+        {
+            public :
+                static const TString& strKey(const TClassItem& itemSrc)
+                {
+                    return itemSrc.m_strClassPath;
+                }
+
+                TClassItem(const TString& strClassPath) :
+
+                    m_c4SerialNum(0)
+                    , m_colUsers(4)
+                    , m_enctLastUsed(0)
+                    , m_strClassPath(strClassPath)
+                {
+                }
+
+                TClassItem(const TClassItem&) = delete;
+                TClassItem(TClassItem&&) = delete;
+                TClassItem& operator=(const TClassItem&) = delete;
+                TClassItem& operator=(TClassItem&&) = delete;
+
+                tCIDLib::TCard4         m_c4SerialNum;
+                TUserChecks             m_colUsers;
+                tCIDLib::TEncodedTime   m_enctLastUsed;
+                TString                 m_strClassPath;
+                TString                 m_strText;
+        };
+        using TClassCache = TRefKeyedHashSet<TClassItem, TString, TStringKeyOps>;
+
+
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bUserChecked
+        (
+            const   TClassItem&             itemSrc
+            , const TCQCSecToken&           sectUser
+            , const tCIDLib::TEncodedTime   enctNow
+        )   const;
+
+        tCIDLib::TVoid SetUserChecked
+        (
+                    TClassItem&             itemTar
+            , const TCQCSecToken&           sectUser
+            , const tCIDLib::TEncodedTime   enctNow
+        );
+
+        tCIDLib::TVoid TrimClassCache
+        (
+            const   tCIDLib::TEncodedTime   enctNow
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_colClassCache
+        //      The class source cache, keyed by class path. Items are updated
+        //      if the serial number changes, and dropped by TrimClassCache()
+        //      when they go unused or to make room for new ones.
+        //
+        //  m_mtxSync
+        //      Protects the class cache, since we can be called from any thread
+        //      that runs CML. It's not held while we talk to the data server.
+        // -------------------------------------------------------------------
+        TClassCache             m_colClassCache;
+        TMutex                  m_mtxSync;
+
+
         // -------------------------------------------------------------------
         //  Magic macros
         // -------------------------------------------------------------------
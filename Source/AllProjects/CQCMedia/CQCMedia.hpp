@@ -105,6 +105,7 @@ namespace tCQCMedia
 }
 
 #include    "CQCMedia_Database.hpp"
+#include    "CQCMedia_DBImage.hpp"
 #include    "CQCMedia_CookieFldFilter.hpp"
 #include    "CQCMedia_StdRendDrv.hpp"
 #include    "CQCMedia_StdRepoDrvEng.hpp"
@@ -64,6 +64,19 @@ namespace kCQCMedia
     constexpr tCIDLib::TCard2   c2XMLMDBDumpFmtVer  = 1;
 
 
+    // -----------------------------------------------------------------------
+    //  The magic value and format version at the start of the flat media DB
+    //  images the client service shares with local clients, and the name parts
+    //  of the shared memory buffers the images and their control info are
+    //  published in.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard4   c4MDBImgMagic       = 0xCAB4D1B5;
+    constexpr tCIDLib::TCard4   c4MDBImgFmtVer      = 2;
+    constexpr tCIDLib::TCard4   c4MDBImgCtrlSz      = 64;
+    constexpr const tCIDLib::TCh* const pszMDBImgResCtrl = L"CQCMDBImgCtrl";
+    constexpr const tCIDLib::TCh* const pszMDBImgResData = L"CQCMDBImg";
+
+
     // -----------------------------------------------------------------------
     //  The standard size that we drivers can use to create automatically scaled
     //  cover art thumbs, by scaling down the large art.
@@ -78,5 +91,15 @@ namespace kCQCMedia
     //  that next time, to avoid the overhead.
     // -----------------------------------------------------------------------
     constexpr tCIDLib::TCard4   c4MaxLrgArtSz = 480;
+
+
+    // -----------------------------------------------------------------------
+    //  Limits for the batched image by id query used by the client service.
+    //  The client asks for up to the max count per round, and the driver will
+    //  stop adding images once the reply buffer passes the byte threshold. The
+    //  client just asks again for any it didn't get back.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard4   c4MaxImgBatchCnt    = 16;
+    constexpr tCIDLib::TCard4   c4MaxImgBatchBytes  = kCIDLib::c4Sz_4M;
 };
 
@@ -0,0 +1,895 @@
+//
+// FILE NAME: CQCMedia_DBImage.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the implementation file for the flat media database image class.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+
+
+// ---------------------------------------------------------------------------
+//  Includes
+// ---------------------------------------------------------------------------
+#include    "CQCMedia_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Local types and constants
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CQCMedia_DBImage
+    {
+        // -----------------------------------------------------------------------
+        //  The string table starts with an empty string, so that a zero offset
+        //  is always an empty string. We don't need to store anything for empty
+        //  strings beyond that.
+        // -----------------------------------------------------------------------
+        class TStrTable
+        {
+            public :
+                TStrTable() :
+
+                    m_c4CharCnt(1)
+                    , m_mbufChars(kCIDLib::c4Sz_64K, kCIDLib::c4Sz_32M, kCIDLib::c4Sz_64K)
+                {
+                    const tCIDLib::TCh chNul = kCIDLib::chNull;
+                    m_mbufChars.CopyIn(&chNul, kCIDLib::c4CharBytes, 0);
+                }
+
+                tCIDLib::TCard4 c4Add(const TString& strToAdd)
+                {
+                    if (strToAdd.bIsEmpty())
+                        return 0;
+
+                    const tCIDLib::TCard4 c4Ret = m_c4CharCnt;
+                    const tCIDLib::TCard4 c4Chars = strToAdd.c4Length() + 1;
+                    m_mbufChars.CopyIn
+                    (
+                        strToAdd.pszBuffer()
+                        , c4Chars * kCIDLib::c4CharBytes
+                        , m_c4CharCnt * kCIDLib::c4CharBytes
+                    );
+                    m_c4CharCnt += c4Chars;
+                    return c4Ret;
+                }
+
+                tCIDLib::TCard4 c4Bytes() const
+                {
+                    return m_c4CharCnt * kCIDLib::c4CharBytes;
+                }
+
+                const THeapBuf& mbufChars() const
+                {
+                    return m_mbufChars;
+                }
+
+            private :
+                tCIDLib::TCard4 m_c4CharCnt;
+                THeapBuf        m_mbufChars;
+        };
+
+
+        // -----------------------------------------------------------------------
+        //  Used to build up the sorted indices. We sort these by the key and then
+        //  store the record indices in that order.
+        // -----------------------------------------------------------------------
+        class TIdxEntry
+        {
+            public :
+                static tCIDLib::ESortComps eComp(const  TIdxEntry&  ient1
+                                                , const TIdxEntry&  ient2)
+                {
+                    tCIDLib::ESortComps eRet = ient1.m_strKey.eCompare(ient2.m_strKey);
+                    if (eRet == tCIDLib::ESortComps::Equal)
+                        eRet = ient1.m_strSubKey.eCompare(ient2.m_strSubKey);
+                    return eRet;
+                }
+
+                tCIDLib::TCard4 m_c4Index;
+                TString         m_strKey;
+                TString         m_strSubKey;
+        };
+        using TIdxList = TVector<TIdxEntry>;
+
+
+        // -----------------------------------------------------------------------
+        //  Round up byte offsets so that all of the Card4 arrays are aligned
+        // -----------------------------------------------------------------------
+        inline tCIDLib::TCard4 c4Align(const tCIDLib::TCard4 c4Ofs)
+        {
+            return (c4Ofs + 3) & ~tCIDLib::TCard4(3);
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  Write out a sorted index array at the indicated offset
+        // -----------------------------------------------------------------------
+        tCIDLib::TVoid WriteIndex(          TIdxList&               colIdx
+                                    ,       TMemBuf&                mbufTar
+                                    , const tCIDLib::TCard4         c4At)
+        {
+            colIdx.Sort(&TIdxEntry::eComp);
+            const tCIDLib::TCard4 c4Count = colIdx.c4ElemCount();
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                mbufTar.PutCard4
+                (
+                    colIdx[c4Index].m_c4Index
+                    , c4At + (c4Index * sizeof(tCIDLib::TCard4))
+                );
+            }
+        }
+
+
+        // -----------------------------------------------------------------------
+        //  The offsets of the values in the control buffer, and how many times a
+        //  reader will try to get a consistent generation and size before giving
+        //  up for that round.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4CtrlOfs_Magic = 0;
+        constexpr tCIDLib::TCard4   c4CtrlOfs_Gen   = 4;
+        constexpr tCIDLib::TCard4   c4CtrlOfs_Size  = 8;
+        constexpr tCIDLib::TCard4   c4MaxCtrlReads  = 8;
+
+
+        // -----------------------------------------------------------------------
+        //  The control buffer is shared across processes, so we need a full
+        //  memory barrier between the accesses to it, so that neither the
+        //  compiler nor the CPU moves them around. A fenced set provides that.
+        // -----------------------------------------------------------------------
+        tCIDLib::TVoid MemBarrier()
+        {
+            tCIDLib::TVoid* pFence = nullptr;
+            TAtomic::pFencedSet(&pFence, pFence);
+        }
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TMediaDBImage
+//  PREFIX: mdbi
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TMediaDBImage: Public, static methods
+// ---------------------------------------------------------------------------
+
+//
+//  Clients call this to get the current generation and image size out of a
+//  control buffer. The generation is odd while the service is in the middle
+//  of publishing, so we read it, then the size, then the generation again, and
+//  only take the size if the generation was even and didn't change. If the
+//  service is publishing, we give it a moment and try again.
+//
+//  We return false if the magic value isn't there, or we never got a consistent
+//  read, in which case the caller should just try again later.
+//
+tCIDLib::TBoolean
+TMediaDBImage::bReadCtrl(const  TMemBuf&            mbufCtrl
+                        ,       tCIDLib::TCard4&    c4Gen
+                        ,       tCIDLib::TCard4&    c4Size)
+{
+    if (mbufCtrl.c4At(CQCMedia_DBImage::c4CtrlOfs_Magic) != kCQCMedia::c4MDBImgMagic)
+        return kCIDLib::False;
+
+    for (tCIDLib::TCard4 c4Tries = 0; c4Tries < CQCMedia_DBImage::c4MaxCtrlReads; c4Tries++)
+    {
+        c4Gen = mbufCtrl.c4At(CQCMedia_DBImage::c4CtrlOfs_Gen);
+        if (!(c4Gen & 1))
+        {
+            CQCMedia_DBImage::MemBarrier();
+            c4Size = mbufCtrl.c4At(CQCMedia_DBImage::c4CtrlOfs_Size);
+            CQCMedia_DBImage::MemBarrier();
+
+            if (mbufCtrl.c4At(CQCMedia_DBImage::c4CtrlOfs_Gen) == c4Gen)
+                return kCIDLib::True;
+        }
+        TThread::Sleep(1);
+    }
+    return kCIDLib::False;
+}
+
+
+//
+//  Builds up an image from the passed database. The caller also passes in the
+//  uncompressed binary dump for the same database, which we store at the end so
+//  that a full database can be faulted in if needed.
+//
+//  We figure out all of the record array offsets up front, since we know the
+//  counts, and write the records directly into the target. The contained ids and
+//  strings are accumulated separately and copied in after the records, since we
+//  only know their sizes once we've gone through everything.
+//
+tCIDLib::TCard4
+TMediaDBImage::c4BuildImage(const   TMediaDB&               mdbSrc
+                            , const TString&                strSerialNum
+                            , const tCQCMedia::EMTFlags     eMTFlags
+                            , const TMemBuf&                mbufDump
+                            , const tCIDLib::TCard4         c4DumpSz
+                            ,       TMemBuf&                mbufToFill)
+{
+    THeader hdrImg = {0};
+    hdrImg.c4Magic = kCQCMedia::c4MDBImgMagic;
+    hdrImg.c4FmtVer = kCQCMedia::c4MDBImgFmtVer;
+    hdrImg.c4MTFlags = tCIDLib::TCard4(eMTFlags);
+
+    //
+    //  Lay out the record arrays and indices for each media type. They are all
+    //  Card4 based so everything stays aligned.
+    //
+    tCIDLib::TCard4 c4CurOfs = sizeof(THeader);
+    tCQCMedia::EMediaTypes eMType = tCQCMedia::EMediaTypes::Min;
+    for (; eMType <= tCQCMedia::EMediaTypes::Max; eMType++)
+    {
+        TTypeInfo& tinfoCur = hdrImg.aTypes[tCIDLib::c4EnumOrd(eMType)];
+
+        tinfoCur.c4SetCnt = mdbSrc.c4TitleSetCnt(eMType);
+        tinfoCur.c4ColCnt = mdbSrc.c4CollectCnt(eMType);
+        tinfoCur.c4ItemCnt = mdbSrc.c4ItemCnt(eMType);
+        tinfoCur.c4ImgCnt = mdbSrc.c4ImageCnt(eMType);
+
+        tinfoCur.c4SetOfs = c4CurOfs;
+        c4CurOfs += tinfoCur.c4SetCnt * sizeof(TSetRec);
+        tinfoCur.c4ColOfs = c4CurOfs;
+        c4CurOfs += tinfoCur.c4ColCnt * sizeof(TColRec);
+        tinfoCur.c4ItemOfs = c4CurOfs;
+        c4CurOfs += tinfoCur.c4ItemCnt * sizeof(TItemRec);
+        tinfoCur.c4ImgOfs = c4CurOfs;
+        c4CurOfs += tinfoCur.c4ImgCnt * sizeof(TImgRec);
+
+        tinfoCur.c4SetUIDIdxOfs = c4CurOfs;
+        c4CurOfs += tinfoCur.c4SetCnt * sizeof(tCIDLib::TCard4);
+        tinfoCur.c4ColUIDIdxOfs = c4CurOfs;
+        c4CurOfs += tinfoCur.c4ColCnt * sizeof(tCIDLib::TCard4);
+        tinfoCur.c4ItemUIDIdxOfs = c4CurOfs;
+        c4CurOfs += tinfoCur.c4ItemCnt * sizeof(tCIDLib::TCard4);
+        tinfoCur.c4ImgUIDIdxOfs = c4CurOfs;
+        c4CurOfs += tinfoCur.c4ImgCnt * sizeof(tCIDLib::TCard4);
+        tinfoCur.c4SetArtistIdxOfs = c4CurOfs;
+        c4CurOfs += tinfoCur.c4SetCnt * sizeof(tCIDLib::TCard4);
+    }
+
+    CQCMedia_DBImage::TStrTable strtData;
+    hdrImg.c4SerialNumOfs = strtData.c4Add(strSerialNum);
+
+    THeapBuf mbufIdPool(kCIDLib::c4Sz_64K, kCIDLib::c4Sz_32M, kCIDLib::c4Sz_64K);
+    tCIDLib::TCard4 c4PoolCnt = 0;
+
+    CQCMedia_DBImage::TIdxList colIdx(1024);
+    CQCMedia_DBImage::TIdxEntry ientCur;
+    eMType = tCQCMedia::EMediaTypes::Min;
+    for (; eMType <= tCQCMedia::EMediaTypes::Max; eMType++)
+    {
+        const TTypeInfo& tinfoCur = hdrImg.aTypes[tCIDLib::c4EnumOrd(eMType)];
+
+        //
+        //  Do the title sets, along with the by UID and by artist indices. The
+        //  artist index is sub-sorted by the sort title, which is what clients
+        //  want to display.
+        //
+        TIdxList colArtistIdx(tinfoCur.c4SetCnt);
+        colIdx.RemoveAll();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < tinfoCur.c4SetCnt; c4Index++)
+        {
+            const TMediaTitleSet& mtsCur = mdbSrc.mtsAt(eMType, c4Index);
+
+            TSetRec recCur;
+            recCur.c4Id = mtsCur.c2Id();
+            recCur.c4ArtId = mtsCur.c2ArtId();
+            recCur.c4UIDOfs = strtData.c4Add(mtsCur.strUniqueId());
+            recCur.c4NameOfs = strtData.c4Add(mtsCur.strName());
+            recCur.c4ArtistOfs = strtData.c4Add(mtsCur.strArtist());
+            recCur.c4SortTitleOfs = strtData.c4Add(mtsCur.strSortTitle());
+            recCur.c4Year = mtsCur.c4Year();
+            recCur.c4ColCnt = mtsCur.c4ColCount();
+            recCur.c4ColIdsAt = c4PoolCnt;
+
+            for (tCIDLib::TCard4 c4ColInd = 0; c4ColInd < recCur.c4ColCnt; c4ColInd++)
+            {
+                mbufIdPool.PutCard4
+                (
+                    mtsCur.c2ColIdAt(c4ColInd), c4PoolCnt * sizeof(tCIDLib::TCard4)
+                );
+                c4PoolCnt++;
+            }
+
+            mbufToFill.CopyIn
+            (
+                &recCur, sizeof(recCur), tinfoCur.c4SetOfs + (c4Index * sizeof(recCur))
+            );
+
+            ientCur.m_c4Index = c4Index;
+            ientCur.m_strKey = mtsCur.strUniqueId();
+            ientCur.m_strSubKey.Clear();
+            colIdx.objAdd(ientCur);
+
+            ientCur.m_strKey = mtsCur.strArtist();
+            ientCur.m_strSubKey = mtsCur.strSortTitle();
+            colArtistIdx.objAdd(ientCur);
+        }
+        CQCMedia_DBImage::WriteIndex(colIdx, mbufToFill, tinfoCur.c4SetUIDIdxOfs);
+        CQCMedia_DBImage::WriteIndex(colArtistIdx, mbufToFill, tinfoCur.c4SetArtistIdxOfs);
+
+        // The collections and their UID index
+        colIdx.RemoveAll();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < tinfoCur.c4ColCnt; c4Index++)
+        {
+            const TMediaCollect& mcolCur = mdbSrc.mcolAt(eMType, c4Index);
+
+            TColRec recCur;
+            recCur.c4Id = mcolCur.c2Id();
+            recCur.c4ArtId = mcolCur.c2ArtId();
+            recCur.c4UIDOfs = strtData.c4Add(mcolCur.strUniqueId());
+            recCur.c4NameOfs = strtData.c4Add(mcolCur.strName());
+            recCur.c4ArtistOfs = strtData.c4Add(mcolCur.strArtist());
+            recCur.c4Year = mcolCur.c4Year();
+            recCur.c4Duration = mcolCur.c4Duration();
+            recCur.c4ItemCnt = mcolCur.c4ItemCount();
+            recCur.c4ItemIdsAt = c4PoolCnt;
+
+            for (tCIDLib::TCard4 c4ItemInd = 0; c4ItemInd < recCur.c4ItemCnt; c4ItemInd++)
+            {
+                mbufIdPool.PutCard4
+                (
+                    mcolCur.c2ItemIdAt(c4ItemInd), c4PoolCnt * sizeof(tCIDLib::TCard4)
+                );
+                c4PoolCnt++;
+            }
+
+            mbufToFill.CopyIn
+            (
+                &recCur, sizeof(recCur), tinfoCur.c4ColOfs + (c4Index * sizeof(recCur))
+            );
+
+            ientCur.m_c4Index = c4Index;
+            ientCur.m_strKey = mcolCur.strUniqueId();
+            ientCur.m_strSubKey.Clear();
+            colIdx.objAdd(ientCur);
+        }
+        CQCMedia_DBImage::WriteIndex(colIdx, mbufToFill, tinfoCur.c4ColUIDIdxOfs);
+
+        // The items and their UID index
+        colIdx.RemoveAll();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < tinfoCur.c4ItemCnt; c4Index++)
+        {
+            const TMediaItem& mitemCur = mdbSrc.mitemAt(eMType, c4Index);
+
+            TItemRec recCur;
+            recCur.c4Id = mitemCur.c2Id();
+            recCur.c4ArtId = mitemCur.c2ArtId();
+            recCur.c4UIDOfs = strtData.c4Add(mitemCur.strUniqueId());
+            recCur.c4NameOfs = strtData.c4Add(mitemCur.strName());
+            recCur.c4ArtistOfs = strtData.c4Add(mitemCur.strArtist());
+            recCur.c4LocInfoOfs = strtData.c4Add(mitemCur.strLocInfo());
+            recCur.c4Duration = mitemCur.c4Duration();
+
+            mbufToFill.CopyIn
+            (
+                &recCur, sizeof(recCur), tinfoCur.c4ItemOfs + (c4Index * sizeof(recCur))
+            );
+
+            ientCur.m_c4Index = c4Index;
+            ientCur.m_strKey = mitemCur.strUniqueId();
+            ientCur.m_strSubKey.Clear();
+            colIdx.objAdd(ientCur);
+        }
+        CQCMedia_DBImage::WriteIndex(colIdx, mbufToFill, tinfoCur.c4ItemUIDIdxOfs);
+
+        // And the images and their UID index
+        colIdx.RemoveAll();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < tinfoCur.c4ImgCnt; c4Index++)
+        {
+            const TMediaImg& mimgCur = mdbSrc.mimgAt(eMType, c4Index);
+
+            TImgRec recCur;
+            recCur.c4Id = mimgCur.c2Id();
+            recCur.c4UIDOfs = strtData.c4Add(mimgCur.strUniqueId());
+            recCur.c4LrgPathOfs = strtData.c4Add
+            (
+                mimgCur.strArtPath(tCQCMedia::ERArtTypes::LrgCover)
+            );
+            recCur.c4SmlPathOfs = strtData.c4Add
+            (
+                mimgCur.strArtPath(tCQCMedia::ERArtTypes::SmlCover)
+            );
+            recCur.c4PerIdLrgOfs = strtData.c4Add
+            (
+                mimgCur.strPersistentId(tCQCMedia::ERArtTypes::LrgCover)
+            );
+            recCur.c4PerIdSmlOfs = strtData.c4Add
+            (
+                mimgCur.strPersistentId(tCQCMedia::ERArtTypes::SmlCover)
+            );
+
+            mbufToFill.CopyIn
+            (
+                &recCur, sizeof(recCur), tinfoCur.c4ImgOfs + (c4Index * sizeof(recCur))
+            );
+
+            ientCur.m_c4Index = c4Index;
+            ientCur.m_strKey = mimgCur.strUniqueId();
+            ientCur.m_strSubKey.Clear();
+            colIdx.objAdd(ientCur);
+        }
+        CQCMedia_DBImage::WriteIndex(colIdx, mbufToFill, tinfoCur.c4ImgUIDIdxOfs);
+    }
+
+    // Now we can place the id pool, strings, and dump after the records
+    hdrImg.c4IdPoolOfs = c4CurOfs;
+    if (c4PoolCnt)
+    {
+        mbufToFill.CopyIn(mbufIdPool, c4PoolCnt * sizeof(tCIDLib::TCard4), c4CurOfs);
+        c4CurOfs += c4PoolCnt * sizeof(tCIDLib::TCard4);
+    }
+
+    hdrImg.c4StrTableOfs = c4CurOfs;
+    mbufToFill.CopyIn(strtData.mbufChars(), strtData.c4Bytes(), c4CurOfs);
+    c4CurOfs = CQCMedia_DBImage::c4Align(c4CurOfs + strtData.c4Bytes());
+
+    hdrImg.c4DumpOfs = c4CurOfs;
+    hdrImg.c4DumpSz = c4DumpSz;
+    mbufToFill.CopyIn(mbufDump, c4DumpSz, c4CurOfs);
+    c4CurOfs += c4DumpSz;
+
+    // And finally put the header in
+    hdrImg.c4TotalSz = c4CurOfs;
+    mbufToFill.CopyIn(&hdrImg, sizeof(hdrImg), 0);
+
+    return c4CurOfs;
+}
+
+
+//
+//  Build the names of the shared memory buffers for a repo's images. The control
+//  buffer name is fixed per repo. The image name includes the generation number,
+//  so that each published image gets its own buffer.
+//
+tCIDLib::TVoid
+TMediaDBImage::BuildResNames(const  TString&                strRepoMoniker
+                            , const tCIDLib::TCard4         c4Generation
+                            ,       TResourceName&          rsnCtrl
+                            ,       TResourceName&          rsnImage)
+{
+    rsnCtrl = TResourceName
+    (
+        kCIDLib::pszResCompany, kCQCMedia::pszMDBImgResCtrl, strRepoMoniker
+    );
+
+    TString strImgName(strRepoMoniker);
+    strImgName.Append(kCIDLib::chUnderscore);
+    strImgName.AppendFormatted(c4Generation);
+    rsnImage = TResourceName
+    (
+        kCIDLib::pszResCompany, kCQCMedia::pszMDBImgResData, strImgName
+    );
+}
+
+
+//
+//  The client service calls this to set up a control buffer it just created, or
+//  to get the last generation from one that is already there. A generation left
+//  odd by a publish that never finished is rounded up to the next even one.
+//
+tCIDLib::TCard4 TMediaDBImage::c4InitCtrl(TMemBuf& mbufCtrl, const tCIDLib::TBoolean bCreated)
+{
+    if (!bCreated
+    &&  (mbufCtrl.c4At(CQCMedia_DBImage::c4CtrlOfs_Magic) == kCQCMedia::c4MDBImgMagic))
+    {
+        const tCIDLib::TCard4 c4Gen = mbufCtrl.c4At(CQCMedia_DBImage::c4CtrlOfs_Gen);
+        return (c4Gen + 1) & ~tCIDLib::TCard4(1);
+    }
+
+    mbufCtrl.PutCard4(0, CQCMedia_DBImage::c4CtrlOfs_Gen);
+    mbufCtrl.PutCard4(0, CQCMedia_DBImage::c4CtrlOfs_Size);
+    CQCMedia_DBImage::MemBarrier();
+    mbufCtrl.PutCard4(kCQCMedia::c4MDBImgMagic, CQCMedia_DBImage::c4CtrlOfs_Magic);
+    return 0;
+}
+
+
+//
+//  The client service calls this to publish a new image, after the image buffer
+//  for the new generation is fully written. The new generation must be even. We
+//  set the generation to the odd value before it, so readers know we are in the
+//  middle of an update, then set the size, then the new generation. There are
+//  barriers between them so that readers can't see them out of order.
+//
+tCIDLib::TVoid
+TMediaDBImage::WriteCtrl(       TMemBuf&            mbufCtrl
+                        , const tCIDLib::TCard4     c4Gen
+                        , const tCIDLib::TCard4     c4Size)
+{
+    CIDAssert(c4Gen && !(c4Gen & 1), L"Media DB image generations must be even and non-zero");
+
+    mbufCtrl.PutCard4(c4Gen - 1, CQCMedia_DBImage::c4CtrlOfs_Gen);
+    CQCMedia_DBImage::MemBarrier();
+    mbufCtrl.PutCard4(c4Size, CQCMedia_DBImage::c4CtrlOfs_Size);
+    CQCMedia_DBImage::MemBarrier();
+    mbufCtrl.PutCard4(c4Gen, CQCMedia_DBImage::c4CtrlOfs_Gen);
+}
+
+
+// ---------------------------------------------------------------------------
+//  TMediaDBImage: Constructors and Destructor
+// ---------------------------------------------------------------------------
+
+//
+//  We validate the header and the overall offsets, so that after this we can
+//  just trust them.
+//
+TMediaDBImage::TMediaDBImage(const  tCIDLib::TCard1* const  pc1Data
+                            , const tCIDLib::TCard4         c4DataSz) :
+
+    m_c4Size(c4DataSz)
+    , m_pc1Base(pc1Data)
+    , m_phdrImg(reinterpret_cast<const THeader*>(pc1Data))
+    , m_pc4IdPool(nullptr)
+    , m_pszStrings(nullptr)
+{
+    if ((c4DataSz < sizeof(THeader))
+    ||  (m_phdrImg->c4Magic != kCQCMedia::c4MDBImgMagic)
+    ||  (m_phdrImg->c4FmtVer != kCQCMedia::c4MDBImgFmtVer)
+    ||  (m_phdrImg->c4TotalSz > c4DataSz)
+    ||  (m_phdrImg->c4IdPoolOfs > m_phdrImg->c4StrTableOfs)
+    ||  (m_phdrImg->c4StrTableOfs > m_phdrImg->c4DumpOfs)
+    ||  (m_phdrImg->c4DumpOfs + m_phdrImg->c4DumpSz > m_phdrImg->c4TotalSz))
+    {
+        facCQCMedia().ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kMedErrs::errcMDBC_BadImage
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::Format
+        );
+    }
+
+    m_pc4IdPool = reinterpret_cast<const tCIDLib::TCard4*>
+    (
+        m_pc1Base + m_phdrImg->c4IdPoolOfs
+    );
+    m_pszStrings = reinterpret_cast<const tCIDLib::TCh*>
+    (
+        m_pc1Base + m_phdrImg->c4StrTableOfs
+    );
+}
+
+TMediaDBImage::~TMediaDBImage()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TMediaDBImage: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+// Get the contained collection and item ids out of the id pool
+tCIDLib::TCard2
+TMediaDBImage::c2ColIdAt(const TSetRec& recSet, const tCIDLib::TCard4 c4At) const
+{
+    CIDAssert(c4At < recSet.c4ColCnt, L"Invalid collection index");
+    return tCIDLib::TCard2(m_pc4IdPool[recSet.c4ColIdsAt + c4At]);
+}
+
+tCIDLib::TCard2
+TMediaDBImage::c2ItemIdAt(const TColRec& recCol, const tCIDLib::TCard4 c4At) const
+{
+    CIDAssert(c4At < recCol.c4ItemCnt, L"Invalid item index");
+    return tCIDLib::TCard2(m_pc4IdPool[recCol.c4ItemIdsAt + c4At]);
+}
+
+
+tCIDLib::TCard4
+TMediaDBImage::c4ColCnt(const tCQCMedia::EMediaTypes eMType) const
+{
+    return tinfoFor(eMType).c4ColCnt;
+}
+
+tCIDLib::TCard4
+TMediaDBImage::c4ImgCnt(const tCQCMedia::EMediaTypes eMType) const
+{
+    return tinfoFor(eMType).c4ImgCnt;
+}
+
+tCIDLib::TCard4
+TMediaDBImage::c4ItemCnt(const tCQCMedia::EMediaTypes eMType) const
+{
+    return tinfoFor(eMType).c4ItemCnt;
+}
+
+tCIDLib::TCard4
+TMediaDBImage::c4SetCnt(const tCQCMedia::EMediaTypes eMType) const
+{
+    return tinfoFor(eMType).c4SetCnt;
+}
+
+
+tCQCMedia::EMTFlags TMediaDBImage::eMTFlags() const
+{
+    return tCQCMedia::EMTFlags(m_phdrImg->c4MTFlags);
+}
+
+
+//
+//  For code that needs the full database, we parse it from the embedded dump. This
+//  is the same thing that would have happened before, but at least we don't need
+//  to get it from the client service or decompress it.
+//
+tCIDLib::TVoid TMediaDBImage::LoadMediaDB(TMediaDB& mdbToFill) const
+{
+    const tCIDLib::TCard4 c4DumpSz = m_phdrImg->c4DumpSz;
+    THeapBuf mbufDump(c4DumpSz ? c4DumpSz : 8, c4DumpSz ? c4DumpSz : 8);
+    mbufDump.CopyIn(m_pc1Base + m_phdrImg->c4DumpOfs, c4DumpSz, 0);
+
+    TString strSerNum;
+    tCQCMedia::EMTFlags eMTFlags;
+    TMediaDB::ParseBinDump
+    (
+        mbufDump, c4DumpSz, eMTFlags, strSerNum, mdbToFill, kCIDLib::False
+    );
+
+    // Clients want the by artist views available
+    mdbToFill.LoadByArtistMap();
+}
+
+
+// Look up records by id. These are sorted by id so we can do a binary search
+const TMediaDBImage::TColRec*
+TMediaDBImage::precColById( const   tCQCMedia::EMediaTypes  eMType
+                            , const tCIDLib::TCard2         c2Id) const
+{
+    const TTypeInfo& tinfoSrc = tinfoFor(eMType);
+    const tCIDLib::TCard4 c4At = c4FindById
+    (
+        tinfoSrc.c4ColOfs, tinfoSrc.c4ColCnt, sizeof(TColRec), c2Id
+    );
+    if (c4At == kCIDLib::c4MaxCard)
+        return nullptr;
+    return reinterpret_cast<const TColRec*>(m_pc1Base + tinfoSrc.c4ColOfs) + c4At;
+}
+
+const TMediaDBImage::TImgRec*
+TMediaDBImage::precImgById( const   tCQCMedia::EMediaTypes  eMType
+                            , const tCIDLib::TCard2         c2Id) const
+{
+    const TTypeInfo& tinfoSrc = tinfoFor(eMType);
+    const tCIDLib::TCard4 c4At = c4FindById
+    (
+        tinfoSrc.c4ImgOfs, tinfoSrc.c4ImgCnt, sizeof(TImgRec), c2Id
+    );
+    if (c4At == kCIDLib::c4MaxCard)
+        return nullptr;
+    return reinterpret_cast<const TImgRec*>(m_pc1Base + tinfoSrc.c4ImgOfs) + c4At;
+}
+
+const TMediaDBImage::TItemRec*
+TMediaDBImage::precItemById(const   tCQCMedia::EMediaTypes  eMType
+                            , const tCIDLib::TCard2         c2Id) const
+{
+    const TTypeInfo& tinfoSrc = tinfoFor(eMType);
+    const tCIDLib::TCard4 c4At = c4FindById
+    (
+        tinfoSrc.c4ItemOfs, tinfoSrc.c4ItemCnt, sizeof(TItemRec), c2Id
+    );
+    if (c4At == kCIDLib::c4MaxCard)
+        return nullptr;
+    return reinterpret_cast<const TItemRec*>(m_pc1Base + tinfoSrc.c4ItemOfs) + c4At;
+}
+
+const TMediaDBImage::TSetRec*
+TMediaDBImage::precSetById( const   tCQCMedia::EMediaTypes  eMType
+                            , const tCIDLib::TCard2         c2Id) const
+{
+    const TTypeInfo& tinfoSrc = tinfoFor(eMType);
+    const tCIDLib::TCard4 c4At = c4FindById
+    (
+        tinfoSrc.c4SetOfs, tinfoSrc.c4SetCnt, sizeof(TSetRec), c2Id
+    );
+    if (c4At == kCIDLib::c4MaxCard)
+        return nullptr;
+    return reinterpret_cast<const TSetRec*>(m_pc1Base + tinfoSrc.c4SetOfs) + c4At;
+}
+
+
+// Look up records by unique id, via the sorted UID indices
+const TMediaDBImage::TColRec*
+TMediaDBImage::precColByUniqueId(const  tCQCMedia::EMediaTypes  eMType
+                                , const TString&                strUID) const
+{
+    const TTypeInfo& tinfoSrc = tinfoFor(eMType);
+    const tCIDLib::TCard4 c4At = c4FindByUID
+    (
+        tinfoSrc.c4ColUIDIdxOfs, tinfoSrc.c4ColCnt, tinfoSrc.c4ColOfs, sizeof(TColRec), 2, strUID
+    );
+    if (c4At == kCIDLib::c4MaxCard)
+        return nullptr;
+    return reinterpret_cast<const TColRec*>(m_pc1Base + tinfoSrc.c4ColOfs) + c4At;
+}
+
+const TMediaDBImage::TImgRec*
+TMediaDBImage::precImgByUniqueId(const  tCQCMedia::EMediaTypes  eMType
+                                , const TString&                strUID) const
+{
+    const TTypeInfo& tinfoSrc = tinfoFor(eMType);
+    const tCIDLib::TCard4 c4At = c4FindByUID
+    (
+        tinfoSrc.c4ImgUIDIdxOfs, tinfoSrc.c4ImgCnt, tinfoSrc.c4ImgOfs, sizeof(TImgRec), 1, strUID
+    );
+    if (c4At == kCIDLib::c4MaxCard)
+        return nullptr;
+    return reinterpret_cast<const TImgRec*>(m_pc1Base + tinfoSrc.c4ImgOfs) + c4At;
+}
+
+const TMediaDBImage::TItemRec*
+TMediaDBImage::precItemByUniqueId(  const   tCQCMedia::EMediaTypes  eMType
+                                    , const TString&                strUID) const
+{
+    const TTypeInfo& tinfoSrc = tinfoFor(eMType);
+    const tCIDLib::TCard4 c4At = c4FindByUID
+    (
+        tinfoSrc.c4ItemUIDIdxOfs, tinfoSrc.c4ItemCnt, tinfoSrc.c4ItemOfs, sizeof(TItemRec), 2, strUID
+    );
+    if (c4At == kCIDLib::c4MaxCard)
+        return nullptr;
+    return reinterpret_cast<const TItemRec*>(m_pc1Base + tinfoSrc.c4ItemOfs) + c4At;
+}
+
+const TMediaDBImage::TSetRec*
+TMediaDBImage::precSetByUniqueId(const  tCQCMedia::EMediaTypes  eMType
+                                , const TString&                strUID) const
+{
+    const TTypeInfo& tinfoSrc = tinfoFor(eMType);
+    const tCIDLib::TCard4 c4At = c4FindByUID
+    (
+        tinfoSrc.c4SetUIDIdxOfs, tinfoSrc.c4SetCnt, tinfoSrc.c4SetOfs, sizeof(TSetRec), 2, strUID
+    );
+    if (c4At == kCIDLib::c4MaxCard)
+        return nullptr;
+    return reinterpret_cast<const TSetRec*>(m_pc1Base + tinfoSrc.c4SetOfs) + c4At;
+}
+
+
+// Get title sets by index, in id order or in artist order
+const TMediaDBImage::TSetRec&
+TMediaDBImage::recSetAt(const   tCQCMedia::EMediaTypes  eMType
+                        , const tCIDLib::TCard4         c4At) const
+{
+    const TTypeInfo& tinfoSrc = tinfoFor(eMType);
+    CIDAssert(c4At < tinfoSrc.c4SetCnt, L"Invalid title set index");
+    return reinterpret_cast<const TSetRec*>(m_pc1Base + tinfoSrc.c4SetOfs)[c4At];
+}
+
+const TMediaDBImage::TSetRec&
+TMediaDBImage::recSetByArtistAt(const   tCQCMedia::EMediaTypes  eMType
+                                , const tCIDLib::TCard4         c4At) const
+{
+    const TTypeInfo& tinfoSrc = tinfoFor(eMType);
+    CIDAssert(c4At < tinfoSrc.c4SetCnt, L"Invalid title set index");
+
+    const tCIDLib::TCard4* pc4Idx = reinterpret_cast<const tCIDLib::TCard4*>
+    (
+        m_pc1Base + tinfoSrc.c4SetArtistIdxOfs
+    );
+    return reinterpret_cast<const TSetRec*>(m_pc1Base + tinfoSrc.c4SetOfs)[pc4Idx[c4At]];
+}
+
+
+const tCIDLib::TCh* TMediaDBImage::pszString(const tCIDLib::TCard4 c4Ofs) const
+{
+    return m_pszStrings + c4Ofs;
+}
+
+const tCIDLib::TCh* TMediaDBImage::pszSerialNum() const
+{
+    return m_pszStrings + m_phdrImg->c4SerialNumOfs;
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TMediaDBImage: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Does a binary search of the indicated UID index. The index entries are record
+//  indices, and the caller tells us which Card4 of the record is the unique id
+//  string offset (the third in set, col, and item records, the second in image
+//  records.) Returns c4MaxCard if not found.
+//
+tCIDLib::TCard4
+TMediaDBImage::c4FindByUID( const   tCIDLib::TCard4 c4IdxOfs
+                            , const tCIDLib::TCard4 c4Count
+                            , const tCIDLib::TCard4 c4RecOfs
+                            , const tCIDLib::TCard4 c4RecSz
+                            , const tCIDLib::TCard4 c4UIDField
+                            , const TString&        strUID) const
+{
+    if (!c4Count)
+        return kCIDLib::c4MaxCard;
+
+    const tCIDLib::TCard4* pc4Idx = reinterpret_cast<const tCIDLib::TCard4*>
+    (
+        m_pc1Base + c4IdxOfs
+    );
+
+    tCIDLib::TInt4 i4Begin = 0;
+    tCIDLib::TInt4 i4End = tCIDLib::TInt4(c4Count) - 1;
+    while (i4Begin <= i4End)
+    {
+        const tCIDLib::TInt4 i4Mid = (i4Begin + i4End) / 2;
+        const tCIDLib::TCard4 c4RecInd = pc4Idx[i4Mid];
+        const tCIDLib::TCard4* pc4Rec = reinterpret_cast<const tCIDLib::TCard4*>
+        (
+            m_pc1Base + c4RecOfs + (c4RecInd * c4RecSz)
+        );
+
+        const tCIDLib::ESortComps eComp = strUID.eCompare(m_pszStrings + pc4Rec[c4UIDField]);
+        if (eComp == tCIDLib::ESortComps::Equal)
+            return c4RecInd;
+
+        if (eComp == tCIDLib::ESortComps::FirstLess)
+            i4End = i4Mid - 1;
+        else
+            i4Begin = i4Mid + 1;
+    }
+    return kCIDLib::c4MaxCard;
+}
+
+
+//
+//  Does a binary search of a record array. The id is the first Card4 of all of the
+//  record types. Returns c4MaxCard if not found.
+//
+tCIDLib::TCard4
+TMediaDBImage::c4FindById(  const   tCIDLib::TCard4 c4RecOfs
+                            , const tCIDLib::TCard4 c4Count
+                            , const tCIDLib::TCard4 c4RecSz
+                            , const tCIDLib::TCard2 c2Id) const
+{
+    tCIDLib::TInt4 i4Begin = 0;
+    tCIDLib::TInt4 i4End = tCIDLib::TInt4(c4Count) - 1;
+    while (i4Begin <= i4End)
+    {
+        const tCIDLib::TInt4 i4Mid = (i4Begin + i4End) / 2;
+        const tCIDLib::TCard4 c4CurId = *reinterpret_cast<const tCIDLib::TCard4*>
+        (
+            m_pc1Base + c4RecOfs + (i4Mid * c4RecSz)
+        );
+
+        if (c4CurId == c2Id)
+            return tCIDLib::TCard4(i4Mid);
+
+        if (c2Id < c4CurId)
+            i4End = i4Mid - 1;
+        else
+            i4Begin = i4Mid + 1;
+    }
+    return kCIDLib::c4MaxCard;
+}
+
+
+const TMediaDBImage::TTypeInfo&
+TMediaDBImage::tinfoFor(const tCQCMedia::EMediaTypes eMType) const
+{
+    CIDAssert(eMType < tCQCMedia::EMediaTypes::Count, L"Invalid media type");
+    return m_phdrImg->aTypes[tCIDLib::c4EnumOrd(eMType)];
+}
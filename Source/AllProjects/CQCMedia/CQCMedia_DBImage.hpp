@@ -0,0 +1,396 @@
+//
+// FILE NAME: CQCMedia_DBImage.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  The client service downloads media databases and every client process used to
+//  get the compressed binary dump from it, decompress it, and stream it in to a
+//  TMediaDB. So every process on a host did that work and held its own copy.
+//
+//  This class defines a flat, fixed layout 'image' of a media database that can
+//  be queried in place without any parsing. The client service builds it once
+//  per new database, writes it to the local cache directory, and publishes it
+//  in a named shared memory buffer. Client processes just open that buffer read
+//  only, so they all share the same pages.
+//
+//  The layout is a header, then per media type arrays of fixed size records for
+//  title sets, collections, items, and images (sorted by id so that we can do
+//  binary searches), then some index arrays (by unique id and by artist), a
+//  pool of contained ids, and a string table. Strings are stored as null
+//  terminated raw chars, referenced by char offset into the table. Offset zero
+//  is always an empty string.
+//
+//  The local cover art queries, which are by far the most common thing clients
+//  want from the cached data, are done directly against the image. At the end we
+//  also keep the original (uncompressed) binary dump. Code that needs the full
+//  TMediaDB can fault it in from there, which avoids the network transfer and
+//  decompression, though of course it's still a full parse.
+//
+//  There is also a small control buffer per repo, which is what clients check
+//  to see if a new image has been published. It has a generation number that
+//  is bumped each time a new image is published, and the size of the image.
+//  The image buffer name is built from the repo and generation. Once published,
+//  an image buffer is never modified, so readers can hold it as long as they
+//  want. The control buffer layout is a Card4 magic value, then the generation,
+//  then the image size.
+//
+//  The generation and size are updated as a sequence lock. Published generations
+//  are even. The service sets the generation odd while it updates the size, and
+//  readers only accept a size read between two reads of the same even generation.
+//  WriteCtrl() and bReadCtrl() implement the two sides, so that they stay in
+//  sync.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1.  The image is host specific (native byte order and char size.) It is not
+//      ever sent anywhere, it's only for local sharing.
+//
+//  2.  This is just a view on a buffer, it doesn't own it. The caller has to
+//      insure the buffer lives as long as the view.
+//
+// LOG:
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TMediaDBImage
+//  PREFIX: mdbi
+// ---------------------------------------------------------------------------
+class CQCMEDIAEXPORT TMediaDBImage
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Public types
+        //
+        //  These are the fixed layout records. The ids are stored as Card4s to
+        //  keep everything aligned. The XXXOfs string values are offsets into
+        //  the string table, which pszString() turns into a pointer. The id
+        //  pool values are Card4 indices into the contained id pool.
+        // -------------------------------------------------------------------
+        struct TSetRec
+        {
+            tCIDLib::TCard4     c4Id;
+            tCIDLib::TCard4     c4ArtId;
+            tCIDLib::TCard4     c4UIDOfs;
+            tCIDLib::TCard4     c4NameOfs;
+            tCIDLib::TCard4     c4ArtistOfs;
+            tCIDLib::TCard4     c4SortTitleOfs;
+            tCIDLib::TCard4     c4Year;
+            tCIDLib::TCard4     c4ColCnt;
+            tCIDLib::TCard4     c4ColIdsAt;
+        };
+
+        struct TColRec
+        {
+            tCIDLib::TCard4     c4Id;
+            tCIDLib::TCard4     c4ArtId;
+            tCIDLib::TCard4     c4UIDOfs;
+            tCIDLib::TCard4     c4NameOfs;
+            tCIDLib::TCard4     c4ArtistOfs;
+            tCIDLib::TCard4     c4Year;
+            tCIDLib::TCard4     c4Duration;
+            tCIDLib::TCard4     c4ItemCnt;
+            tCIDLib::TCard4     c4ItemIdsAt;
+        };
+
+        struct TItemRec
+        {
+            tCIDLib::TCard4     c4Id;
+            tCIDLib::TCard4     c4ArtId;
+            tCIDLib::TCard4     c4UIDOfs;
+            tCIDLib::TCard4     c4NameOfs;
+            tCIDLib::TCard4     c4ArtistOfs;
+            tCIDLib::TCard4     c4LocInfoOfs;
+            tCIDLib::TCard4     c4Duration;
+        };
+
+        struct TImgRec
+        {
+            tCIDLib::TCard4     c4Id;
+            tCIDLib::TCard4     c4UIDOfs;
+            tCIDLib::TCard4     c4LrgPathOfs;
+            tCIDLib::TCard4     c4SmlPathOfs;
+            tCIDLib::TCard4     c4PerIdLrgOfs;
+            tCIDLib::TCard4     c4PerIdSmlOfs;
+        };
+
+
+        // -------------------------------------------------------------------
+        //  Public, static methods
+        // -------------------------------------------------------------------
+        static tCIDLib::TBoolean bReadCtrl
+        (
+            const   TMemBuf&                mbufCtrl
+            ,       tCIDLib::TCard4&        c4Gen
+            ,       tCIDLib::TCard4&        c4Size
+        );
+
+        static tCIDLib::TCard4 c4BuildImage
+        (
+            const   TMediaDB&               mdbSrc
+            , const TString&                strSerialNum
+            , const tCQCMedia::EMTFlags     eMTFlags
+            , const TMemBuf&                mbufDump
+            , const tCIDLib::TCard4         c4DumpSz
+            ,       TMemBuf&                mbufToFill
+        );
+
+        static tCIDLib::TVoid BuildResNames
+        (
+            const   TString&                strRepoMoniker
+            , const tCIDLib::TCard4         c4Generation
+            ,       TResourceName&          rsnCtrl
+            ,       TResourceName&          rsnImage
+        );
+
+        static tCIDLib::TCard4 c4InitCtrl
+        (
+                    TMemBuf&                mbufCtrl
+            , const tCIDLib::TBoolean       bCreated
+        );
+
+        static tCIDLib::TVoid WriteCtrl
+        (
+                    TMemBuf&                mbufCtrl
+            , const tCIDLib::TCard4         c4Gen
+            , const tCIDLib::TCard4         c4Size
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TMediaDBImage() = delete;
+
+        TMediaDBImage
+        (
+            const   tCIDLib::TCard1* const  pc1Data
+            , const tCIDLib::TCard4         c4DataSz
+        );
+
+        TMediaDBImage(const TMediaDBImage&) = default;
+        TMediaDBImage(TMediaDBImage&&) = delete;
+
+        ~TMediaDBImage();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TMediaDBImage& operator=(const TMediaDBImage&) = delete;
+        TMediaDBImage& operator=(TMediaDBImage&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TCard2 c2ColIdAt
+        (
+            const   TSetRec&                recSet
+            , const tCIDLib::TCard4         c4At
+        )   const;
+
+        tCIDLib::TCard2 c2ItemIdAt
+        (
+            const   TColRec&                recCol
+            , const tCIDLib::TCard4         c4At
+        )   const;
+
+        tCIDLib::TCard4 c4ColCnt
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+        )   const;
+
+        tCIDLib::TCard4 c4ImgCnt
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+        )   const;
+
+        tCIDLib::TCard4 c4ItemCnt
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+        )   const;
+
+        tCIDLib::TCard4 c4SetCnt
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+        )   const;
+
+        tCQCMedia::EMTFlags eMTFlags() const;
+
+        tCIDLib::TVoid LoadMediaDB
+        (
+                    TMediaDB&               mdbToFill
+        )   const;
+
+        const TColRec* precColById
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const tCIDLib::TCard2         c2Id
+        )   const;
+
+        const TColRec* precColByUniqueId
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const TString&                strUID
+        )   const;
+
+        const TImgRec* precImgById
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const tCIDLib::TCard2         c2Id
+        )   const;
+
+        const TImgRec* precImgByUniqueId
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const TString&                strUID
+        )   const;
+
+        const TItemRec* precItemById
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const tCIDLib::TCard2         c2Id
+        )   const;
+
+        const TItemRec* precItemByUniqueId
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const TString&                strUID
+        )   const;
+
+        const TSetRec* precSetById
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const tCIDLib::TCard2         c2Id
+        )   const;
+
+        const TSetRec* precSetByUniqueId
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const TString&                strUID
+        )   const;
+
+        const TSetRec& recSetAt
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const tCIDLib::TCard4         c4At
+        )   const;
+
+        const TSetRec& recSetByArtistAt
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const tCIDLib::TCard4         c4At
+        )   const;
+
+        const tCIDLib::TCh* pszString
+        (
+            const   tCIDLib::TCard4         c4Ofs
+        )   const;
+
+        const tCIDLib::TCh* pszSerialNum() const;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private types
+        //
+        //  These define the header and per-media type info. All offsets here
+        //  are byte offsets from the start of the image.
+        // -------------------------------------------------------------------
+        struct TTypeInfo
+        {
+            tCIDLib::TCard4     c4SetCnt;
+            tCIDLib::TCard4     c4SetOfs;
+            tCIDLib::TCard4     c4ColCnt;
+            tCIDLib::TCard4     c4ColOfs;
+            tCIDLib::TCard4     c4ItemCnt;
+            tCIDLib::TCard4     c4ItemOfs;
+            tCIDLib::TCard4     c4ImgCnt;
+            tCIDLib::TCard4     c4ImgOfs;
+            tCIDLib::TCard4     c4SetUIDIdxOfs;
+            tCIDLib::TCard4     c4ColUIDIdxOfs;
+            tCIDLib::TCard4     c4ItemUIDIdxOfs;
+            tCIDLib::TCard4     c4ImgUIDIdxOfs;
+            tCIDLib::TCard4     c4SetArtistIdxOfs;
+        };
+
+        struct THeader
+        {
+            tCIDLib::TCard4     c4Magic;
+            tCIDLib::TCard4     c4FmtVer;
+            tCIDLib::TCard4     c4TotalSz;
+            tCIDLib::TCard4     c4MTFlags;
+            tCIDLib::TCard4     c4SerialNumOfs;
+            tCIDLib::TCard4     c4IdPoolOfs;
+            tCIDLib::TCard4     c4StrTableOfs;
+            tCIDLib::TCard4     c4DumpOfs;
+            tCIDLib::TCard4     c4DumpSz;
+            TTypeInfo           aTypes[tCIDLib::c4EnumOrd(tCQCMedia::EMediaTypes::Count)];
+        };
+
+
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4 c4FindByUID
+        (
+            const   tCIDLib::TCard4         c4IdxOfs
+            , const tCIDLib::TCard4         c4Count
+            , const tCIDLib::TCard4         c4RecOfs
+            , const tCIDLib::TCard4         c4RecSz
+            , const tCIDLib::TCard4         c4UIDField
+            , const TString&                strUID
+        )   const;
+
+        tCIDLib::TCard4 c4FindById
+        (
+            const   tCIDLib::TCard4         c4RecOfs
+            , const tCIDLib::TCard4         c4Count
+            , const tCIDLib::TCard4         c4RecSz
+            , const tCIDLib::TCard2         c2Id
+        )   const;
+
+        const TTypeInfo& tinfoFor
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+        )   const;
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c4Size
+        //      The size of the image data, which we validate against the header.
+        //
+        //  m_pc1Base
+        //      The base of the image data. We don't own it.
+        //
+        //  m_phdrImg
+        //  m_pc4IdPool
+        //  m_pszStrings
+        //      Pointers into the image data for convenience.
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4         m_c4Size;
+        const tCIDLib::TCard1*  m_pc1Base;
+        const THeader*          m_phdrImg;
+        const tCIDLib::TCard4*  m_pc4IdPool;
+        const tCIDLib::TCh*     m_pszStrings;
+};
+
+#pragma CIDLIB_POPPACK
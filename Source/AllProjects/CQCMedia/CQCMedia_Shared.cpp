@@ -56,6 +56,7 @@ const TString kCQCMedia::strQuery_QueryTitleThumbArt(L"QTitleThumbArt");
 const TString kCQCMedia::strQuery_QueryItemThumbArt(L"QTitleItemArt");
 const TString kCQCMedia::strQuery_QueryPosterArt(L"QPosterArt");
 const TString kCQCMedia::strQuery_QueryImgById(L"QImgById");
+const TString kCQCMedia::strQuery_QueryImgBatch(L"QImgBatch");
 const TString kCQCMedia::strCmd_SetUserRating(L"SetUserRating");
 const TString kCQCMedia::strEvId_OnSelectCol(L"StdEvent:OnSelectCol");
 const TString kCQCMedia::strEvId_OnSelectItem(L"StdEvent:OnSelectItem");
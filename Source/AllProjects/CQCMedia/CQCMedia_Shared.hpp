@@ -127,6 +127,10 @@ namespace kCQCMedia
     //  QImgById  - Used by the client service, for caching art locally by
     //              peristent id. In this case no cookie is needed, since
     //              it's directly passing a unique art id.
+    //  QImgBatch - Same as QImgById, but a media type followed by a
+    //              space separated list of ids is passed, and the art
+    //              for as many of them as fit is returned in one round
+    //              trip. Each returned image is prefixed by its id.
     //                  
     // ------------------------------------------------------------------------
     CQCMEDIAEXPORT const extern TString strQuery_QueryArt;
@@ -137,6 +141,7 @@ namespace kCQCMedia
     CQCMEDIAEXPORT const extern TString strQuery_QueryItemThumbArt;
     CQCMEDIAEXPORT const extern TString strQuery_QueryPosterArt;
     CQCMEDIAEXPORT const extern TString strQuery_QueryImgById;
+    CQCMEDIAEXPORT const extern TString strQuery_QueryImgBatch;
     
     // ------------------------------------------------------------------------
     //  Commands that some media repo drivers support.
@@ -529,11 +529,7 @@ TCQCStdMediaRepoEng::bQueryData(const   TString&            strQType
 
         // Find the image by id
         tCQCMedia::EMediaTypes eMType;
-        if (strMType == L"Music")
-            eMType = tCQCMedia::EMediaTypes::Music;
-        else if (strMType == L"Movie")
-            eMType = tCQCMedia::EMediaTypes::Movie;
-        else
+        if (!bXlatImgMType(strMType, eMType))
             return kCIDLib::False;
 
         //
@@ -547,78 +543,58 @@ TCQCStdMediaRepoEng::bQueryData(const   TString&            strQType
         if (!pmimgRet)
             return kCIDLib::False;
 
+        c4OutBytes = c4FormatImgById(*pmimgRet, mbufToFill, 0);
+    }
+     else if (strQType == kCQCMedia::strQuery_QueryImgBatch)
+    {
         //
-        //  See if we have large art cached yet. We do this first since, if the repo
-        //  doesn't support separate thumbs, this will insure the large art gets
-        //  loaded first, and he'll cache it. Then he can scale the data he already
-        //  has loaded when we subsequently ask for the thumb data, instead of having
-        //  to load the file again.
+        //  The QData is the media type, then a space separated list of image
+        //  ids. We return the number of requested ids we processed, and the
+        //  number of images we returned, then for each one its id followed by
+        //  the same info that QImgById returns.
         //
-        c4OutBytes = 0;
-        mbufToFill.PutCard4(kCIDLib::chLatin_L, c4OutBytes);
-        c4OutBytes += 4;
-
-        tCIDLib::TCard4 c4ImgSz = pmimgRet->c4Size(tCQCMedia::ERArtTypes::LrgCover);
-        if (c4ImgSz)
-        {
-            c4ImgSz = pmimgRet->c4QueryArt
-            (
-                mbufToFill, tCQCMedia::ERArtTypes::LrgCover, c4OutBytes + 4
-            );
-        }
-         else
-        {
-            // Load new data, leave room for the size
-            c4ImgSz = c4LoadArtData
-            (
-                *pmimgRet
-                , mbufToFill
-                , tCQCMedia::ERArtTypes::LrgCover
-                , c4OutBytes + 4
-            );
-        }
-
+        //  We stop once we pass the max reply size. The client will just ask
+        //  again for any past the processed count. Any ids we can't find are
+        //  skipped, so the client will see they didn't come back.
         //
-        //  Go back and put in the size and then move past the image data,
-        //  and put out the size again as a sanity check.
-        //
-        mbufToFill.PutCard4(c4ImgSz, c4OutBytes);
-        c4OutBytes += c4ImgSz + 4;
-        mbufToFill.PutCard4(c4ImgSz, c4OutBytes);
-        c4OutBytes += 4;
+        TStringTokenizer stokIds(&strQData, L" ");
+        TString strMType;
+        if (!stokIds.bGetNextToken(strMType))
+            return kCIDLib::False;
 
+        tCQCMedia::EMediaTypes eMType;
+        if (!bXlatImgMType(strMType, eMType))
+            return kCIDLib::False;
 
-        // Now do the thumb. The same steps as above
-        mbufToFill.PutCard4(kCIDLib::chLatin_T, c4OutBytes);
-        c4OutBytes += 4;
+        // Leave room for the counts, which we fill in at the end
+        tCIDLib::TCard4 c4ImgCnt = 0;
+        tCIDLib::TCard4 c4ReqCnt = 0;
+        c4OutBytes = 8;
 
-        c4ImgSz = pmimgRet->c4Size(tCQCMedia::ERArtTypes::SmlCover);
-        if (c4ImgSz)
-        {
-            c4ImgSz = pmimgRet->c4QueryArt
-            (
-                mbufToFill, tCQCMedia::ERArtTypes::SmlCover, c4OutBytes + 4
-            );
-        }
-         else
+        TString strId;
+        tCIDLib::TCard4 c4Id;
+        while ((c4ReqCnt < kCQCMedia::c4MaxImgBatchCnt)
+        &&     (c4OutBytes < kCQCMedia::c4MaxImgBatchBytes)
+        &&     stokIds.bGetNextToken(strId))
         {
-            // Load new data, leave room for the size
-            c4ImgSz = c4LoadArtData
+            c4ReqCnt++;
+            if (!strId.bToCard4(c4Id, tCIDLib::ERadices::Dec))
+                continue;
+
+            TMediaImg* pmimgCur = m_mdbInfo.pmimgByIdNC
             (
-                *pmimgRet
-                , mbufToFill
-                , tCQCMedia::ERArtTypes::SmlCover
-                , c4OutBytes + 4
+                eMType, tCIDLib::TCard2(c4Id), kCIDLib::False
             );
-        }
-
-        // Go back and put in the size and then move past the iamge
-        mbufToFill.PutCard4(c4ImgSz, c4OutBytes);
-        c4OutBytes += c4ImgSz + 4;
+            if (!pmimgCur)
+                continue;
 
-        // And the second sanity check copy of the image size
-        mbufToFill.PutCard4(c4ImgSz, c4OutBytes);
-        c4OutBytes += 4;
+            mbufToFill.PutCard4(c4Id, c4OutBytes);
+            c4OutBytes += 4;
+            c4OutBytes += c4FormatImgById(*pmimgCur, mbufToFill, c4OutBytes);
+            c4ImgCnt++;
+        }
+        mbufToFill.PutCard4(c4ReqCnt, 0);
+        mbufToFill.PutCard4(c4ImgCnt, 4);
     }
      else
     {
@@ -1497,3 +1473,117 @@ tCIDLib::TVoid TCQCStdMediaRepoEng::ResetMediaDB(TMediaDB& mdbToLoad)
     m_mdbInfo.LoadComplete();
 }
 
+
+
+
+// ---------------------------------------------------------------------------
+//  TCQCStdMediaRepoEng: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  The image by id queries pass the media type as text. We only do music
+//  and movies here.
+//
+tCIDLib::TBoolean
+TCQCStdMediaRepoEng::bXlatImgMType( const   TString&                strToXlat
+                                    ,       tCQCMedia::EMediaTypes& eToFill) const
+{
+    if (strToXlat == L"Music")
+        eToFill = tCQCMedia::EMediaTypes::Music;
+    else if (strToXlat == L"Movie")
+        eToFill = tCQCMedia::EMediaTypes::Movie;
+    else
+        return kCIDLib::False;
+    return kCIDLib::True;
+}
+
+
+//
+//  Formats out the large and thumb art for an image, at the indicated index in
+//  the buffer, and returns the bytes written. This is the format used for both
+//  the single and batched image by id queries.
+//
+//  For each image we put out an L or T marker, then the size, then the image
+//  data, then the size again as a sanity check.
+//
+tCIDLib::TCard4
+TCQCStdMediaRepoEng::c4FormatImgById(       TMediaImg&          mimgSrc
+                                    ,       THeapBuf&           mbufToFill
+                                    , const tCIDLib::TCard4     c4At)
+{
+    //
+    //  See if we have large art cached yet. We do this first since, if the repo
+    //  doesn't support separate thumbs, this will insure the large art gets
+    //  loaded first, and he'll cache it. Then he can scale the data he already
+    //  has loaded when we subsequently ask for the thumb data, instead of having
+    //  to load the file again.
+    //
+    tCIDLib::TCard4 c4OutBytes = c4At;
+    mbufToFill.PutCard4(kCIDLib::chLatin_L, c4OutBytes);
+    c4OutBytes += 4;
+
+    tCIDLib::TCard4 c4ImgSz = mimgSrc.c4Size(tCQCMedia::ERArtTypes::LrgCover);
+    if (c4ImgSz)
+    {
+        c4ImgSz = mimgSrc.c4QueryArt
+        (
+            mbufToFill, tCQCMedia::ERArtTypes::LrgCover, c4OutBytes + 4
+        );
+    }
+     else
+    {
+        // Load new data, leave room for the size
+        c4ImgSz = c4LoadArtData
+        (
+            mimgSrc
+            , mbufToFill
+            , tCQCMedia::ERArtTypes::LrgCover
+            , c4OutBytes + 4
+        );
+    }
+
+    //
+    //  Go back and put in the size and then move past the image data,
+    //  and put out the size again as a sanity check.
+    //
+    mbufToFill.PutCard4(c4ImgSz, c4OutBytes);
+    c4OutBytes += c4ImgSz + 4;
+    mbufToFill.PutCard4(c4ImgSz, c4OutBytes);
+    c4OutBytes += 4;
+
+
+    // Now do the thumb. The same steps as above
+    mbufToFill.PutCard4(kCIDLib::chLatin_T, c4OutBytes);
+    c4OutBytes += 4;
+
+    c4ImgSz = mimgSrc.c4Size(tCQCMedia::ERArtTypes::SmlCover);
+    if (c4ImgSz)
+    {
+        c4ImgSz = mimgSrc.c4QueryArt
+        (
+            mbufToFill, tCQCMedia::ERArtTypes::SmlCover, c4OutBytes + 4
+        );
+    }
+     else
+    {
+        // Load new data, leave room for the size
+        c4ImgSz = c4LoadArtData
+        (
+            mimgSrc
+            , mbufToFill
+            , tCQCMedia::ERArtTypes::SmlCover
+            , c4OutBytes + 4
+        );
+    }
+
+    // Go back and put in the size and then move past the iamge
+    mbufToFill.PutCard4(c4ImgSz, c4OutBytes);
+    c4OutBytes += c4ImgSz + 4;
+
+    // And the second sanity check copy of the image size
+    mbufToFill.PutCard4(c4ImgSz, c4OutBytes);
+    c4OutBytes += 4;
+
+    return c4OutBytes - c4At;
+}
+
@@ -260,6 +260,23 @@ class CQCMEDIAEXPORT TCQCStdMediaRepoEng : public TObject
 
 
     private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bXlatImgMType
+        (
+            const   TString&                strToXlat
+            ,       tCQCMedia::EMediaTypes& eToFill
+        )   const;
+
+        tCIDLib::TCard4 c4FormatImgById
+        (
+                    TMediaImg&              mimgSrc
+            ,       THeapBuf&               mbufToFill
+            , const tCIDLib::TCard4         c4At
+        );
+
+
         // -------------------------------------------------------------------
         //  Private data members
         //
@@ -48,16 +48,23 @@ RTTIDecls(TFacCQCMedia,TFacility)
 // Zero the next check so that newly added ones will be updated immediately
 TMDBCacheItem::TMDBCacheItem(const TString& strRepo) :
 
-    m_enctNextCheck(0)
+    m_c4Generation(0)
+    , m_enctNextCheck(0)
     , m_eMTFlags(tCQCMedia::EMTFlags::None)
+    , m_pmbufImage(nullptr)
+    , m_pmdbiData(nullptr)
     , m_strRepoMoniker(strRepo)
 {
+    m_atomDBLoaded.Set();
 }
 
 TMDBCacheItem::TMDBCacheItem(const  TString&        strRepo
                             ,       TBinInStream&   strmSrc) :
 
-    m_enctNextCheck(TTime::enctNowPlusSecs(15))
+    m_c4Generation(0)
+    , m_enctNextCheck(TTime::enctNowPlusSecs(15))
+    , m_pmbufImage(nullptr)
+    , m_pmdbiData(nullptr)
     , m_strRepoMoniker(strRepo)
 {
     tCIDLib::TCard2 c2FmtVer;
@@ -71,10 +78,265 @@ TMDBCacheItem::TMDBCacheItem(const  TString&        strRepo
     //  database to generate those.
     //
     m_mdbData.LoadByArtistMap();
+    m_atomDBLoaded.Set();
+}
+
+//
+//  This one is created from a shared image published by the client service. We
+//  adopt the shared buffer. We don't load the full database unless someone asks
+//  for it, and the serial number and media type flags we can get from the image.
+//
+TMDBCacheItem::TMDBCacheItem(const  TString&                strRepo
+                            ,       TSharedMemBuf* const    pmbufToAdopt
+                            , const tCIDLib::TCard4         c4ImageSz
+                            , const tCIDLib::TCard4         c4Generation) :
+
+    m_c4Generation(c4Generation)
+    , m_enctNextCheck(TTime::enctNowPlusSecs(15))
+    , m_pmbufImage(pmbufToAdopt)
+    , m_pmdbiData(nullptr)
+    , m_strRepoMoniker(strRepo)
+{
+    try
+    {
+        m_pmdbiData = new TMediaDBImage(m_pmbufImage->pc1Data(), c4ImageSz);
+    }
+
+    catch(TError& errToCatch)
+    {
+        delete m_pmbufImage;
+        m_pmbufImage = nullptr;
+
+        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+        throw;
+    }
+
+    m_eMTFlags = m_pmdbiData->eMTFlags();
+    m_strDBSerialNum = m_pmdbiData->pszSerialNum();
 }
 
 TMDBCacheItem::~TMDBCacheItem()
 {
+    // Clean up the view first since it refers to the buffer
+    delete m_pmdbiData;
+    delete m_pmbufImage;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TMDBCacheItem: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Find the cover art for a cookie. If it's a title cookie, we use the title's
+//  art, or the first collection's art if the title has none. If bColOnly is set,
+//  it has to be at least a collection cookie. We return the path and persistent
+//  id for the art type requested, either of which might be empty.
+//
+//  If we have a shared image, we look it up in the image, so that the art queries
+//  (by far the most common thing local clients want) never require faulting in the
+//  full database.
+//
+tCIDLib::TBoolean
+TMDBCacheItem::bFindArt(const   TString&                strCookie
+                        , const tCIDLib::TBoolean       bColOnly
+                        , const tCQCMedia::ERArtTypes   eArtType
+                        ,       TString&                strArtPath
+                        ,       TString&                strPerId) const
+{
+    tCQCMedia::EMediaTypes eMType;
+    tCIDLib::TCard2 c2ArtId = 0;
+    if (m_pmdbiData)
+    {
+        tCIDLib::TCard2 c2CatId = 0;
+        tCIDLib::TCard2 c2TiId = 0;
+        tCIDLib::TCard2 c2ColId = 0;
+        tCIDLib::TCard2 c2ItId = 0;
+        const tCQCMedia::ECookieTypes eType = facCQCMedia().eCheckCookie
+        (
+            strCookie, eMType, c2CatId, c2TiId, c2ColId, c2ItId
+        );
+
+        // Look up the same things that TMediaDB::bFindByCookie() would
+        const TMediaDBImage::TSetRec* precSet = nullptr;
+        const TMediaDBImage::TColRec* precCol = nullptr;
+        if (eType >= tCQCMedia::ECookieTypes::Title)
+        {
+            precSet = m_pmdbiData->precSetById(eMType, c2TiId);
+            if (!precSet)
+                return kCIDLib::False;
+        }
+
+        if (eType >= tCQCMedia::ECookieTypes::Collect)
+        {
+            // Cookies use 1 based collection and item indices
+            if (!c2ColId || (c2ColId > precSet->c4ColCnt))
+                return kCIDLib::False;
+
+            precCol = m_pmdbiData->precColById
+            (
+                eMType, m_pmdbiData->c2ColIdAt(*precSet, c2ColId - 1)
+            );
+            if (!precCol)
+                return kCIDLib::False;
+        }
+
+        if (eType >= tCQCMedia::ECookieTypes::Item)
+        {
+            if (!c2ItId
+            ||  (c2ItId > precCol->c4ItemCnt)
+            ||  !m_pmdbiData->precItemById
+                (
+                    eMType, m_pmdbiData->c2ItemIdAt(*precCol, c2ItId - 1)
+                ))
+            {
+                return kCIDLib::False;
+            }
+        }
+
+        if (bColOnly && !precCol)
+            return kCIDLib::False;
+
+        if (precCol)
+        {
+            c2ArtId = tCIDLib::TCard2(precCol->c4ArtId);
+        }
+         else if (precSet)
+        {
+            c2ArtId = tCIDLib::TCard2(precSet->c4ArtId);
+            if (!c2ArtId && precSet->c4ColCnt)
+            {
+                precCol = m_pmdbiData->precColById
+                (
+                    eMType, m_pmdbiData->c2ColIdAt(*precSet, 0)
+                );
+                if (precCol)
+                    c2ArtId = tCIDLib::TCard2(precCol->c4ArtId);
+            }
+        }
+    }
+     else
+    {
+        const TMediaTitleSet*   pmtsImg;
+        const TMediaCollect*    pmcolImg;
+        const TMediaItem*       pmitemImg;
+        if (!m_mdbData.bFindByCookie(strCookie, eMType, pmtsImg, pmcolImg, pmitemImg))
+            return kCIDLib::False;
+
+        if (bColOnly && !pmcolImg)
+            return kCIDLib::False;
+
+        if (pmcolImg)
+        {
+            c2ArtId = pmcolImg->c2ArtId();
+        }
+         else if (pmtsImg)
+        {
+            c2ArtId = pmtsImg->c2ArtId();
+            if (!c2ArtId && pmtsImg->c4ColCount())
+                c2ArtId = pmtsImg->mcolAt(m_mdbData, 0).c2ArtId();
+        }
+    }
+
+    if (!c2ArtId)
+        return kCIDLib::False;
+
+    if (m_pmdbiData)
+    {
+        const TMediaDBImage::TImgRec* precImg = m_pmdbiData->precImgById(eMType, c2ArtId);
+        if (!precImg)
+            return kCIDLib::False;
+
+        const tCIDLib::TBoolean bLarge = (eArtType == tCQCMedia::ERArtTypes::LrgCover);
+        strArtPath = m_pmdbiData->pszString
+        (
+            bLarge ? precImg->c4LrgPathOfs : precImg->c4SmlPathOfs
+        );
+        strPerId = m_pmdbiData->pszString
+        (
+            bLarge ? precImg->c4PerIdLrgOfs : precImg->c4PerIdSmlOfs
+        );
+    }
+     else
+    {
+        const TMediaImg* pmimgArt = m_mdbData.pmimgById(eMType, c2ArtId, kCIDLib::False);
+        if (!pmimgArt)
+            return kCIDLib::False;
+
+        strArtPath = pmimgArt->strArtPath(eArtType);
+        strPerId = pmimgArt->strPersistentId(eArtType);
+    }
+    return kCIDLib::True;
+}
+
+
+//
+//  Find the cover art with the indicated unique id. As above, if we have a shared
+//  image we look it up there.
+//
+tCIDLib::TBoolean
+TMDBCacheItem::bFindArt(const   tCQCMedia::EMediaTypes  eMType
+                        , const TString&                strUID
+                        , const tCQCMedia::ERArtTypes   eArtType
+                        ,       TString&                strArtPath
+                        ,       TString&                strPerId) const
+{
+    if (m_pmdbiData)
+    {
+        const TMediaDBImage::TImgRec* precImg = m_pmdbiData->precImgByUniqueId
+        (
+            eMType, strUID
+        );
+        if (!precImg)
+            return kCIDLib::False;
+
+        const tCIDLib::TBoolean bLarge = (eArtType == tCQCMedia::ERArtTypes::LrgCover);
+        strArtPath = m_pmdbiData->pszString
+        (
+            bLarge ? precImg->c4LrgPathOfs : precImg->c4SmlPathOfs
+        );
+        strPerId = m_pmdbiData->pszString
+        (
+            bLarge ? precImg->c4PerIdLrgOfs : precImg->c4PerIdSmlOfs
+        );
+        return kCIDLib::True;
+    }
+
+    const TMediaImg* pmimgArt = m_mdbData.pmimgByUniqueId(eMType, strUID, kCIDLib::False);
+    if (!pmimgArt)
+        return kCIDLib::False;
+
+    strArtPath = pmimgArt->strArtPath(eArtType);
+    strPerId = pmimgArt->strPersistentId(eArtType);
+    return kCIDLib::True;
+}
+
+
+//
+//  If we were created from a shared image, fault in the full database from it
+//  upon first access. Code that can use the image view directly, such as the art
+//  lookups above, avoids this.
+//
+//  Everything else still comes through here, which means a full parse of the
+//  dump stored in the image, once per process per generation. That includes the
+//  title, collection, and item lookups the interface widgets, the gateway server
+//  and CQCVoice do. They use many of the title set, collection, and item
+//  attributes, and get at related objects through the database, so the image
+//  would have to carry all of that before they could be moved over to it. It
+//  does at least avoid the transfer from the client service and the decompression.
+//
+const TMediaDB& TMDBCacheItem::mdbData() const
+{
+    if (!m_atomDBLoaded)
+    {
+        TLocker lockrSync(&m_mtxSync);
+        if (!m_atomDBLoaded)
+        {
+            m_pmdbiData->LoadMediaDB(m_mdbData);
+            m_atomDBLoaded.Set();
+        }
+    }
+    return m_mdbData;
 }
 
 
@@ -632,60 +894,20 @@ bQueryLocalCachedArt(const  TString&            strRepoMoniker
         return kCIDLib::False;
     }
 
-    const TMediaDB& mdbInfo = cptrInfo->mdbData();
-
-    // Look up the media objects for this cookie, if not found give up
-    tCQCMedia::EMediaTypes  eMType;
-    const TMediaTitleSet*   pmtsImg;
-    const TMediaCollect*    pmcolImg;
-    const TMediaItem*       pmitemImg;
-    tCIDLib::TBoolean bRes = mdbInfo.bFindByCookie
+    //
+    //  Look up the art for this cookie. This uses the shared image if we have
+    //  one, so it doesn't require faulting in the full database.
+    //
+    tCQCMedia::ERArtTypes eArtType
     (
-        strCookie, eMType, pmtsImg, pmcolImg, pmitemImg
+        bLarge ? tCQCMedia::ERArtTypes::LrgCover : tCQCMedia::ERArtTypes::SmlCover
     );
-
-    // If not found, give up
-    if (!bRes)
-        return kCIDLib::False;
-
-    // Get the art id. If top level, check the title first
-    tCIDLib::TCard2 c2ArtId = 0;
-    if (pmcolImg)
-    {
-        // Take the collection's id
-        c2ArtId = pmcolImg->c2ArtId();
-    }
-     else if (pmtsImg)
-    {
-        // Check the title set first
-        c2ArtId = pmtsImg->c2ArtId();
-
-        // If none, let's get the first collection and check it
-        if (!c2ArtId)
-        {
-            if (pmtsImg->c4ColCount())
-            {
-                pmcolImg = &pmtsImg->mcolAt(mdbInfo, 0);
-                c2ArtId = pmcolImg->c2ArtId();
-            }
-        }
-    }
-
-    // If we got no art id in all of that, given up
-    if (!c2ArtId)
-        return kCIDLib::False;
-
-    // Look up this art. If not found, give up
-    const TMediaImg* pmimgArt = mdbInfo.pmimgById(eMType, c2ArtId, kCIDLib::False);
-    if (!pmimgArt)
+    TString strArtPath;
+    TString strArtPerId;
+    if (!cptrInfo->bFindArt(strCookie, kCIDLib::False, eArtType, strArtPath, strArtPerId))
         return kCIDLib::False;
 
     // If no path for the type we want, or the file isn't there, then give up
-    tCQCMedia::ERArtTypes eArtType
-    (
-        bLarge ? tCQCMedia::ERArtTypes::LrgCover : tCQCMedia::ERArtTypes::SmlCover
-    );
-    const TString& strArtPath = pmimgArt->strArtPath(eArtType);
     if (strArtPath.bIsEmpty() || !TFileSys::bExists(strArtPath))
         return kCIDLib::False;
 
@@ -730,7 +952,7 @@ bQueryLocalCachedArt(const  TString&            strRepoMoniker
         return kCIDLib::False;
     }
 
-    strPerId = pmimgArt->strPersistentId(eArtType);
+    strPerId = strArtPerId;
     return kCIDLib::True;
 }
 
@@ -764,60 +986,18 @@ bQueryLocalCachedArt(const  TString&            strRepoMoniker
         return kCIDLib::False;
     }
 
-    const TMediaDB& mdbInfo = cptrInfo->mdbData();
-
-    // Look up the media objects for this cookie, if not found give up
-    tCQCMedia::EMediaTypes  eMType;
-    const TMediaTitleSet*   pmtsImg;
-    const TMediaCollect*    pmcolImg;
-    const TMediaItem*       pmitemImg;
-    tCIDLib::TBoolean bRes = mdbInfo.bFindByCookie
-    (
-        strCookie, eMType, pmtsImg, pmcolImg, pmitemImg
-    );
-
-    // If the cookie is bad or not at least a collection cookie then give up.
-    if (!bRes || !pmcolImg)
-        return kCIDLib::False;
-
-    // Get the art id. If top level, check the title first
-    tCIDLib::TCard2 c2ArtId = 0;
-    if (pmcolImg)
-    {
-        // Take the collection's id
-        c2ArtId = pmcolImg->c2ArtId();
-    }
-     else if (pmtsImg)
-    {
-        // Check the title set to see if it has its own art
-        c2ArtId = pmtsImg->c2ArtId();
-
-        // If none, let's get the first collection and check it
-        if (!c2ArtId)
-        {
-            if (pmtsImg->c4ColCount())
-            {
-                pmcolImg = &pmtsImg->mcolAt(mdbInfo, 0);
-                c2ArtId = pmcolImg->c2ArtId();
-            }
-        }
-    }
-
-    // If we got no art id in all of that, given up
-    if (!c2ArtId)
-        return kCIDLib::False;
-
-    // Look up this art. If not found, give up
-    const TMediaImg* pmimgArt = mdbInfo.pmimgById(eMType, c2ArtId, kCIDLib::False);
-    if (!pmimgArt)
-        return kCIDLib::False;
-
-    // If not found or no path for the type we want, then give up
+    //
+    //  Look up the art for this cookie, which must be at least a collection
+    //  cookie. This uses the shared image if we have one.
+    //
     tCQCMedia::ERArtTypes eArtType
     (
         bLarge ? tCQCMedia::ERArtTypes::LrgCover : tCQCMedia::ERArtTypes::SmlCover
     );
-    const TString& strArtPath = pmimgArt->strArtPath(eArtType);
+    TString strArtPath;
+    TString strArtPerId;
+    if (!cptrInfo->bFindArt(strCookie, kCIDLib::True, eArtType, strArtPath, strArtPerId))
+        return kCIDLib::False;
 
     if (strArtPath.bIsEmpty() || !TFileSys::bExists(strArtPath))
         return kCIDLib::False;
@@ -866,7 +1046,7 @@ bQueryLocalCachedArt(const  TString&            strRepoMoniker
         return kCIDLib::False;
     }
 
-    strPerId = pmimgArt->strPersistentId(eArtType);
+    strPerId = strArtPerId;
     return kCIDLib::True;
 }
 
@@ -1982,26 +2162,25 @@ TFacCQCMedia::eQueryLocalCachedArt( const   TString&                strRepoMonik
         return tCIDLib::ELoadRes::NotFound;
     }
 
-    // We got it, so let's look up the image by its UID
-    const TMediaDB& mdbInfo = cptrInfo->mdbData();
-    const TMediaImg* pmimgLoad = mdbInfo.pmimgByUniqueId(eMType, strUID, kCIDLib::False);
-
-    // If not found, give up
-    if (!pmimgLoad)
-        return tCIDLib::ELoadRes::NotFound;
-
     // Set u the art type for the requested size
     const tCQCMedia::ERArtTypes eArtType
     (
         bLarge ? tCQCMedia::ERArtTypes::LrgCover : tCQCMedia::ERArtTypes::SmlCover
     );
 
+    //
+    //  We got it, so let's look up the image by its UID. This uses the shared
+    //  image if we have one. If not found, give up.
+    //
+    TString strArtPath;
+    TString strPerId;
+    if (!cptrInfo->bFindArt(eMType, strUID, eArtType, strArtPath, strPerId))
+        return tCIDLib::ELoadRes::NotFound;
+
     //
     //  If no persistent id or path for the image they want, then it doesn't exist,
     //  so give up now.
     //
-    const TString& strArtPath = pmimgLoad->strArtPath(eArtType);
-    const TString& strPerId = pmimgLoad->strPersistentId(eArtType);
     if (strPerId.bIsEmpty() || strArtPath.bIsEmpty())
         return tCIDLib::ELoadRes::NotFound;
 
@@ -2448,12 +2627,96 @@ tCIDLib::TVoid TFacCQCMedia::StopMDBCacher()
 //  TFacCQCMedia: Private, non-virtual methods
 // ---------------------------------------------------------------------------
 
+//
+//  The client service publishes a flat image of each repo's database in shared
+//  memory, along with a small control buffer that has the current generation of
+//  the image. If that's available, we check to see if the generation is not the
+//  one we already have. If it's new, we open the image and create a new cache
+//  item for it, which is returned. The caller will replace the current one.
+//
+//  We return true if the image is available, whether it's new or not, so the
+//  caller knows it doesn't need to go to the client service for the data. If it's
+//  not available for whatever reason, we return false and the caller falls back
+//  to querying the data.
+//
+tCIDLib::TBoolean
+TFacCQCMedia::bCheckDBImage(const   TMDBCacheItem&  mdbciCur
+                            ,       TMDBCacheItem*& pmdbciNew)
+{
+    pmdbciNew = nullptr;
+    try
+    {
+        TResourceName rsnCtrl;
+        TResourceName rsnImage;
+        TMediaDBImage::BuildResNames(mdbciCur.strRepoMoniker(), 0, rsnCtrl, rsnImage);
+
+        // If the control buffer isn't there, this will throw and we fall back
+        tCIDLib::TBoolean bCreated;
+        TSharedMemBuf mbufCtrl
+        (
+            kCQCMedia::c4MDBImgCtrlSz
+            , kCQCMedia::c4MDBImgCtrlSz
+            , rsnCtrl
+            , bCreated
+            , tCIDLib::EMemAccFlags::ReadOnly
+            , tCIDLib::ECreateActs::OpenIfExists
+        );
+
+        //
+        //  Get a consistent generation and size. If we can't, the service is in
+        //  the middle of publishing. If we already have an image, just keep it
+        //  and check again next time, else fall back for this round.
+        //
+        tCIDLib::TCard4 c4Gen = 0;
+        tCIDLib::TCard4 c4Size = 0;
+        if (!TMediaDBImage::bReadCtrl(mbufCtrl, c4Gen, c4Size))
+            return (mdbciCur.c4Generation() != 0);
+
+        if (!c4Gen || !c4Size)
+            return kCIDLib::False;
+
+        // If it's the one we have, then nothing new
+        if (c4Gen == mdbciCur.c4Generation())
+            return kCIDLib::True;
+
+        TMediaDBImage::BuildResNames(mdbciCur.strRepoMoniker(), c4Gen, rsnCtrl, rsnImage);
+        TSharedMemBuf* pmbufImage = new TSharedMemBuf
+        (
+            c4Size
+            , c4Size
+            , rsnImage
+            , bCreated
+            , tCIDLib::EMemAccFlags::ReadOnly
+            , tCIDLib::ECreateActs::OpenIfExists
+        );
+
+        // The cache item adopts the buffer, even if it fails
+        pmdbciNew = new TMDBCacheItem(mdbciCur.strRepoMoniker(), pmbufImage, c4Size, c4Gen);
+    }
+
+    catch(TError& errToCatch)
+    {
+        if (bLogInfo() && !errToCatch.bLogged())
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+        }
+        return kCIDLib::False;
+    }
+    return kCIDLib::True;
+}
+
+
 //
 //  This thread manages the media repo database caching thread. We just
 //  periodically connect to the client service and check to see if there's
 //  any new data available. If so we pull it down and replace the current
 //  stuff for that repo.
 //
+//  We first check for a shared image of the database published by the client
+//  service, which is much cheaper. If that's available we use it, else we fall
+//  back to getting the data via the client service's ORB interface.
+//
 tCIDLib::EExitCodes
 TFacCQCMedia::eMDBCacheThread(TThread& thrThis, tCIDLib::TVoid* pData)
 {
@@ -2549,6 +2812,27 @@ TFacCQCMedia::eMDBCacheThread(TThread& thrThis, tCIDLib::TVoid* pData)
                     if (TTime::enctNow() < cptrCur->enctNextCheck())
                         continue;
 
+                    //
+                    //  See if we can get it from the shared image first. If that
+                    //  works, we replace the current one with the new one if there
+                    //  is a new one, else just update the check time.
+                    //
+                    TMDBCacheItem* pmdbciNew = nullptr;
+                    if (bCheckDBImage(*cptrCur, pmdbciNew))
+                    {
+                        if (pmdbciNew)
+                        {
+                            TLocker lockrSync(&m_colMediaDBCache);
+                            TMDBPtr cptrNew(pmdbciNew);
+                            m_colMediaDBCache.ReplaceValue(cptrNew);
+                        }
+                         else
+                        {
+                            cptrCur->UpdateCheckTime();
+                        }
+                        continue;
+                    }
+
                     // See if this guy has new data
                     tCIDLib::TBoolean bNewData = porbcProxy->bQueryRepoDB
                     (
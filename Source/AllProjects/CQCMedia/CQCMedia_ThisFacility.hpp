@@ -69,6 +69,14 @@ class CQCMEDIAEXPORT TMDBCacheItem
             ,       TBinInStream&           strmSrc
         );
 
+        TMDBCacheItem
+        (
+            const   TString&                strRepo
+            ,       TSharedMemBuf* const    pmbufToAdopt
+            , const tCIDLib::TCard4         c4ImageSz
+            , const tCIDLib::TCard4         c4Generation
+        );
+
         TMDBCacheItem(const TMDBCacheItem&) = delete;
         TMDBCacheItem(TMDBCacheItem&&) = delete;
 
@@ -85,6 +93,29 @@ class CQCMEDIAEXPORT TMDBCacheItem
         // -------------------------------------------------------------------
         //  Public, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TBoolean bFindArt
+        (
+            const   TString&                strCookie
+            , const tCIDLib::TBoolean       bColOnly
+            , const tCQCMedia::ERArtTypes   eArtType
+            ,       TString&                strArtPath
+            ,       TString&                strPerId
+        )   const;
+
+        tCIDLib::TBoolean bFindArt
+        (
+            const   tCQCMedia::EMediaTypes  eMType
+            , const TString&                strUID
+            , const tCQCMedia::ERArtTypes   eArtType
+            ,       TString&                strArtPath
+            ,       TString&                strPerId
+        )   const;
+
+        tCIDLib::TCard4 c4Generation() const noexcept
+        {
+            return m_c4Generation;
+        }
+
         tCIDLib::TEncodedTime enctNextCheck() const noexcept
         {
             return m_enctNextCheck;
@@ -95,10 +126,7 @@ class CQCMEDIAEXPORT TMDBCacheItem
             return m_eMTFlags;
         }
 
-        const TMediaDB& mdbData() const noexcept
-        {
-            return m_mdbData;
-        }
+        const TMediaDB& mdbData() const;
 
         const TString& strDBSerialNum() const noexcept
         {
@@ -120,6 +148,17 @@ class CQCMEDIAEXPORT TMDBCacheItem
         // -------------------------------------------------------------------
         //  Private data members
         //
+        //  m_atomDBLoaded
+        //      If we were created from a shared image, the full database is
+        //      not loaded until someone asks for it. This indicates whether
+        //      it's been loaded yet. It's checked without the lock, so it has
+        //      to be atomic, and it's mutable since it's set in a const accessor.
+        //
+        //  m_c4Generation
+        //      If we were created from a shared image, this is the generation
+        //      of that image, so we can tell when a new one is published. Else
+        //      it's zero.
+        //
         //  m_enctNextCheck
         //      The next time at which we need to check this one to see if
         //      the data has changed.
@@ -130,7 +169,20 @@ class CQCMEDIAEXPORT TMDBCacheItem
         //      this, which they will often want.
         //
         //  m_mdbData
-        //      The media database for this item.
+        //      The media database for this item. If we were created from a
+        //      shared image, it's faulted in upon first access. It's mutable
+        //      for that reason.
+        //
+        //  m_mtxSync
+        //      Used to sync the fault in of the database, since multiple
+        //      client threads could access it at once.
+        //
+        //  m_pmbufImage
+        //  m_pmdbiData
+        //      If we were created from a shared image, this is the shared
+        //      buffer and the view on it. Else they are null. We own both. The
+        //      art lookups are done directly against the view, so they never
+        //      require faulting in m_mdbData.
         //
         //  m_strDBSerialNum
         //      The database serial number reported the last time we queried
@@ -141,9 +193,14 @@ class CQCMEDIAEXPORT TMDBCacheItem
         //      The repo for which we are to get data. This is also the key
         //      for the cache.
         // -------------------------------------------------------------------
+        mutable TAtomicFlag     m_atomDBLoaded;
+        tCIDLib::TCard4         m_c4Generation;
         tCIDLib::TEncodedTime   m_enctNextCheck;
         tCQCMedia::EMTFlags     m_eMTFlags;
-        TMediaDB                m_mdbData;
+        mutable TMediaDB        m_mdbData;
+        mutable TMutex          m_mtxSync;
+        TSharedMemBuf*          m_pmbufImage;
+        TMediaDBImage*          m_pmdbiData;
         TString                 m_strDBSerialNum;
         TString                 m_strRepoMoniker;
 };
@@ -630,6 +687,12 @@ class CQCMEDIAEXPORT TFacCQCMedia : public TFacility
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TBoolean bCheckDBImage
+        (
+            const   TMDBCacheItem&          mdbciCur
+            ,       TMDBCacheItem*&         pmdbciNew
+        );
+
         tCIDLib::EExitCodes eMDBCacheThread
         (
                     TThread&                thrThis
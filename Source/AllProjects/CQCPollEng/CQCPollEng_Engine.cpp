@@ -393,6 +393,9 @@ TCQCFldPollInfo& TCQCFldPollInfo::operator=(const TCQCFldPollInfo& cfpiSrc)
             m_pfvCurrent = nullptr;
         }
 
+        // We won't have a value snapshot until we get registered again
+        m_cptrValue.DropRef();
+
         // If we don't have a value and the new type is set, then create one
         if (!m_pfvCurrent && (m_flddAssoc.eType() != tCQCKit::EFldTypes::Count))
             m_pfvCurrent = facCQCKit().pfvMakeNewFor(0, 0, m_flddAssoc.eType());
@@ -537,9 +540,13 @@ tCIDLib::TBoolean TCQCFldPollInfo::bUpdateValue(TCQCPollEngine& polleToUse)
             // Make sure we've allocated the value object
             CIDAssert(m_pfvCurrent != nullptr, L"The field has not been set yet");
 
+            //
+            //  We get a shared snapshot of the value, so we don't have to copy it
+            //  while holding the engine's lock.
+            //
             const tCQCKit::EValQRes eRes = polleToUse.eQueryValue
             (
-                m_strMoniker, m_strField, m_c4SerialNum, *m_pfvCurrent, m_flnkAssoc
+                m_strMoniker, m_strField, m_c4SerialNum, m_cptrValue, m_flnkAssoc
             );
 
             if (eRes == tCQCKit::EValQRes::NewValue)
@@ -667,15 +674,30 @@ const TCQCPollEngFldLink& TCQCFldPollInfo::flnkAssoc() const
 }
 
 
+//
+//  Give the client access to the shared value snapshot, so that they can hold
+//  onto it if they want without copying it. It's not set until we get a value.
+//
+const tCQCKit::TFldValPtr& TCQCFldPollInfo::cptrValue() const
+{
+    return m_cptrValue;
+}
+
+
 //
 //  Give the client access to the current value. It's their responsibilty
 //  to know what the type is and cast it appropriately in order to get the
-//  value out.
+//  value out. If we've not gotten a value yet, we return our default value
+//  object.
 //
 const TCQCFldValue& TCQCFldPollInfo::fvCurrent() const
 {
     // Make sure the field has been set
     CIDAssert(m_pfvCurrent != nullptr, L"The field storage has not been created");
+
+    const TCQCFldValue* pfvRet = m_cptrValue.pobjData();
+    if (pfvRet)
+        return *pfvRet;
     return *m_pfvCurrent;
 }
 
@@ -706,6 +728,7 @@ tCIDLib::TVoid TCQCFldPollInfo::Reset()
 {
     delete m_pfvCurrent;
     m_pfvCurrent = nullptr;
+    m_cptrValue.DropRef();
 
     m_c4SerialNum = 0;
     m_eLastState = tCQCPollEng::EFldStates::WaitReg;
@@ -762,6 +785,7 @@ TCQCFldPollInfo::SetField(const TString& strMoniker, const TString& strField)
     // Cleanup the value object until we know the type again
     delete m_pfvCurrent;
     m_pfvCurrent = nullptr;
+    m_cptrValue.DropRef();
 
     m_flddAssoc.Reset();
     m_flnkAssoc.Reset();
@@ -794,6 +818,7 @@ tCIDLib::TVoid TCQCFldPollInfo::SetMoniker(const TString& strMoniker)
     // Cleanup the value object until we know the type again
     delete m_pfvCurrent;
     m_pfvCurrent = nullptr;
+    m_cptrValue.DropRef();
 
     m_flddAssoc.Reset();
     m_flnkAssoc.Reset();
@@ -851,6 +876,7 @@ tCIDLib::TVoid TCQCFldPollInfo::DoFieldReg(TCQCPollEngine& polleToUse)
         {
             delete m_pfvCurrent;
             m_pfvCurrent = nullptr;
+            m_cptrValue.DropRef();
         }
 
         // If we don't have storage, create one for our new type
@@ -922,9 +948,17 @@ TPESrvJanitor::TPESrvJanitor() :
 
 TPESrvJanitor::~TPESrvJanitor()
 {
-    // If we got the server, then unlock it
+    //
+    //  If we got the server, then unlock it. If the field we accessed is on the
+    //  cold list, the access will have flagged it for promotion, so let the server
+    //  know to move it to the hot list on the next round.
+    //
     if (m_psrviTar)
+    {
+        if (m_pfldiTar && m_pfldiTar->bPromote())
+            m_psrviTar->SetPromotePending();
         m_psrviTar->Unlock();
+    }
 }
 
 
@@ -1578,6 +1612,41 @@ TCQCPollEngine::eQueryValue(const   TString&            strMoniker
     return tCQCKit::EValQRes::NewValue;
 }
 
+//
+//  This one returns a shared snapshot of the value, instead of copying it into
+//  the caller's value object. So the lock is only held long enough to find the
+//  field, and the value is only copied once per change, no matter how many clients
+//  read it. The caller must not hold onto the pointer if the field is reconfigured.
+//
+tCQCKit::EValQRes
+TCQCPollEngine::eQueryValue(const   TString&                strMoniker
+                            , const TString&                strField
+                            ,       tCIDLib::TCard4&        c4SerialNum
+                            ,       tCQCKit::TFldValPtr&    cptrToFill
+                            ,       TCQCPollEngFldLink&     flnkInfo)
+{
+    TLocker lockrSync(&m_mtxSync);
+
+    // Same checks as above, see the comments there
+    TPESrvJanitor janSrv;
+    if (!janSrv.bFindField(*this, flnkInfo, kCIDLib::True))
+        return tCQCKit::EValQRes::Reconfig;
+
+    janSrv.m_pfldiTar->SetLastAccessStamp();
+    if (!janSrv.m_pdrviTar->bOnline())
+        return tCQCKit::EValQRes::Reconfig;
+
+    if (janSrv.m_pfldiTar->bInError())
+        return tCQCKit::EValQRes::InError;
+
+    if (c4SerialNum == janSrv.m_pfldiTar->c4SerialNum())
+        return tCQCKit::EValQRes::NoChange;
+
+    c4SerialNum = janSrv.m_pfldiTar->c4SerialNum();
+    cptrToFill = janSrv.m_pfldiTar->cptrSnapshot();
+    return tCQCKit::EValQRes::NewValue;
+}
+
 
 //
 //  This guy will handle registering a single field with the polling engine.
@@ -1794,7 +1863,8 @@ tCIDLib::TVoid TCQCPollEngine::StopEngine()
 //  These are called by the interface (or other client of this engine) to
 //  write a value to a field. We let any exceptions propogate out of here
 //  if we cannot get the admin proxy or the moniker or field doesn't
-//  exist.
+//  exist. But we drop the cached admin proxy first, so that the next
+//  write does a new lookup.
 //
 tCIDLib::TVoid TCQCPollEngine::WriteField(  const   TString&        strMoniker
                                             , const TString&        strFldName
@@ -1805,11 +1875,20 @@ tCIDLib::TVoid TCQCPollEngine::WriteField(  const   TString&        strMoniker
     //  Use the moniker name to get a CQC server admin proxy, which we will
     //  then use to write the value.
     //
-    tCQCKit::TCQCSrvProxy orbcAdmin(facCQCKit().orbcCQCSrvAdminProxy(strMoniker));
-    orbcAdmin->WriteFieldByName
-    (
-        strMoniker, strFldName, strValue, sectUser, tCQCKit::EDrvCmdWaits::DontCare
-    );
+    try
+    {
+        tCQCKit::TCQCSrvProxy orbcAdmin(facCQCKit().orbcCQCSrvAdminProxy(strMoniker));
+        orbcAdmin->WriteFieldByName
+        (
+            strMoniker, strFldName, strValue, sectUser, tCQCKit::EDrvCmdWaits::DontCare
+        );
+    }
+
+    catch(...)
+    {
+        facCQCKit().DropCQCSrvAdminProxy(strMoniker);
+        throw;
+    }
 }
 
 tCIDLib::TVoid TCQCPollEngine::WriteField(  const   TString&        strFullFldName
@@ -1824,15 +1903,7 @@ tCIDLib::TVoid TCQCPollEngine::WriteField(  const   TString&        strFullFldNa
     TString strMoniker;
     facCQCKit().ParseFldName(strFullFldName, strMoniker, strFldName);
 
-    //
-    //  Use the moniker name to get a CQC server admin proxy, which we will
-    //  then use to write the value.
-    //
-    tCQCKit::TCQCSrvProxy orbcAdmin(facCQCKit().orbcCQCSrvAdminProxy(strMoniker));
-    orbcAdmin->WriteFieldByName
-    (
-        strMoniker, strFldName, strValue, sectUser, tCQCKit::EDrvCmdWaits::DontCare
-    );
+    WriteField(strMoniker, strFldName, strValue, sectUser);
 }
 
 
@@ -304,6 +304,8 @@ class CQCPOLLENGEXPORT TCQCFldPollInfo : public TObject
                     TCQCPollEngine&         polleToUse
         );
 
+        const tCQCKit::TFldValPtr& cptrValue() const;
+
         tCQCPollEng::EFldStates eState() const;
 
         const TCQCFldDef& flddAssoc() const;
@@ -361,6 +363,11 @@ class CQCPOLLENGEXPORT TCQCFldPollInfo : public TObject
         //      serial number for each field, bumped when it changes, either
         //      value or state.
         //
+        //  m_cptrValue
+        //      The shared value snapshot we got from the polling engine on
+        //      our last update that returned a new value. These are never
+        //      modified, the engine gives us a new one when it changes.
+        //
         //  m_eLastState
         //      The last state we saw for the field, during registration or
         //      update. Let's us know where we stand, and we just keep trying
@@ -380,7 +387,8 @@ class CQCPOLLENGEXPORT TCQCFldPollInfo : public TObject
         //  m_pfvCurrent
         //      This is a polymorphic field value pointer. According to the
         //      type of the field set on us, we allocate it for the appropriate
-        //      field type.
+        //      field type. It provides the default value until we have a
+        //      value snapshot.
         //
         //  m_strField
         //      The name of the field we are associated with. This is somewhat
@@ -401,6 +409,7 @@ class CQCPOLLENGEXPORT TCQCFldPollInfo : public TObject
         //      The moniker of the field we are associated with.
         // -------------------------------------------------------------------
         tCIDLib::TCard4             m_c4SerialNum;
+        tCQCKit::TFldValPtr         m_cptrValue;
         tCQCPollEng::EFldStates     m_eLastState;
         TCQCFldDef                  m_flddAssoc;
         TCQCPollEngFldLink          m_flnkAssoc;
@@ -456,7 +465,7 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
         //   CLASS: TFldItem
         //  PREFIX: fldi
         // -------------------------------------------------------------------
-        class TFldItem
+        class CQCPOLLENGEXPORT TFldItem
         {
             public :
                 // -----------------------------------------------------------
@@ -498,6 +507,18 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
                 // -----------------------------------------------------------
                 tCIDLib::TBoolean bInError() const;
 
+                tCIDLib::TBoolean bIsCold
+                (
+                    const   tCIDLib::TEncodedTime enctNow
+                )   const;
+
+                tCIDLib::TBoolean bOnColdList() const;
+
+                tCIDLib::TBoolean bOnColdList
+                (
+                    const   tCIDLib::TBoolean   bToSet
+                );
+
                 tCIDLib::TBoolean bOnPollList() const;
 
                 tCIDLib::TBoolean bOnPollList
@@ -510,10 +531,14 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
                     const   tCIDLib::TEncodedTime enctSince
                 )   const;
 
+                tCIDLib::TBoolean bPromote() const;
+
                 tCIDLib::TCard4 c4FieldId() const;
 
                 tCIDLib::TCard4 c4SerialNum() const;
 
+                const tCQCKit::TFldValPtr& cptrSnapshot();
+
                 tCIDLib::TEncodedTime enctLastAccess() const;
 
                 const TCQCFldDef& flddInfo() const;
@@ -539,6 +564,8 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
 
                 tCIDLib::TVoid SetLastAccessStamp() const;
 
+                tCIDLib::TVoid SetLastChangeStamp();
+
                 tCIDLib::TVoid UpdateServerId
                 (
                     const   tCIDLib::TCard4     c4NewSrvId
@@ -549,6 +576,17 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
                 // -----------------------------------------------------------
                 //  Private data members
                 //
+                //  m_bOnColdList
+                //  m_bPromote
+                //      Which of the server's poll lists we are on, hot or
+                //      cold. If we are on the cold list and a client reads
+                //      us, or the cold poll sees a new value, the promote
+                //      flag is set, so that the poll thread will move us
+                //      back to the hot list on its next round instead of
+                //      waiting for the prune pass. Both are only accessed
+                //      with the server locked. The promote flag is set
+                //      from SetLastAccessStamp(), so it is mutable.
+                //
                 //  m_bOnPollList
                 //      Multiple client objects may want to access the same
                 //      field. So we need to know if a field is already on
@@ -561,6 +599,16 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
                 //      us know when we need to refresh the string formatted
                 //      version, which we only update upon access.
                 //
+                //  m_c4SnapSerialNum
+                //  m_cptrSnapshot
+                //      An immutable copy of the current value, shared by all
+                //      of the clients that read it via counted pointer. It's
+                //      faulted in upon first access after the value changes,
+                //      so each change is copied once no matter how many
+                //      clients read it, and only if anyone does. The serial
+                //      number tells us if it's out of date. We never modify
+                //      a snapshot once handed out, we just replace it.
+                //
                 //  m_enctLastAccess
                 //      If a field hasn't been read by anyone for the last
                 //      so many seconds, the server will periodically remove
@@ -572,6 +620,12 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
                 //      the server's last prune time, then we are currently
                 //      on the servers' I/O list.
                 //
+                //  m_enctLastChange
+                //      The last time the poll thread saw a new value or error
+                //      state for this field. Along with the last access time
+                //      this is used to decide if we go on the hot or cold
+                //      poll list.
+                //
                 //  m_flddInfo
                 //      This is the field description info, which tells us
                 //      all about the field. This is gotten from our driver
@@ -593,9 +647,14 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
                 //      know if we need to update the string format because
                 //      the field value has been changed.
                 // -----------------------------------------------------------
+                tCIDLib::TBoolean               m_bOnColdList;
                 tCIDLib::TBoolean               m_bOnPollList;
+                mutable tCIDLib::TBoolean       m_bPromote;
                 mutable tCIDLib::TCard4         m_c4FmtSerialNum;
+                tCIDLib::TCard4                 m_c4SnapSerialNum;
+                tCQCKit::TFldValPtr             m_cptrSnapshot;
                 mutable tCIDLib::TEncodedTime   m_enctLastAccess;
+                tCIDLib::TEncodedTime           m_enctLastChange;
                 TCQCFldDef                      m_flddInfo;
                 TCQCPollEngFldLink              m_flnkThis;
                 TCQCFldValue*                   m_pfvCurrent;
@@ -901,6 +960,8 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
 
                 tCIDLib::TVoid Reset();
 
+                tCIDLib::TVoid SetPromotePending();
+
                 const TString& strNodeName() const;
 
                 tCIDLib::TVoid StartShutdown();
@@ -919,12 +980,52 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
                 // -----------------------------------------------------------
                 //  Private, non-virtual methods
                 // -----------------------------------------------------------
+                tCIDLib::TBoolean bPrunePacket
+                (
+                            TFldIOPacket&           fiopSrc
+                    ,       TFldIOPacket&           fiopOther
+                    , const tCIDLib::TBoolean       bColdList
+                    , const tCIDLib::TEncodedTime   enctNow
+                    , const tCIDLib::TEncodedTime   enctDropTest
+                );
+
                 tCIDLib::TVoid LoadNewFields();
 
+                tCIDLib::TVoid MoveFieldAt
+                (
+                            TFldIOPacket&           fiopSrc
+                    ,       TFldIOPacket&           fiopTar
+                    , const tCIDLib::TCard4         c4DInd
+                    , const tCIDLib::TCard4         c4FInd
+                    , const TDrvItem&               drviOwner
+                    ,       TFldItem&               fldiMove
+                    , const tCIDLib::TBoolean       bToCold
+                );
+
+                tCIDLib::TVoid PollPacket
+                (
+                            TFldIOPacket&           fiopTar
+                );
+
+                tCIDLib::TVoid PromoteFields();
+
 
                 // -----------------------------------------------------------
                 //  Private data members
                 //
+                //  m_bPromotePending
+                //      Set when any field on the cold list has been flagged
+                //      for promotion, either by a client reading it (via the
+                //      server janitor) or by the cold poll seeing a new value.
+                //      The poll thread checks it each round and, if set,
+                //      moves the flagged fields back to the hot list, so that
+                //      we don't have to scan the cold list every round. Only
+                //      accessed with the server locked.
+                //
+                //  m_c4ColdRound
+                //      Counts poll rounds so that we only poll the cold list
+                //      every so many rounds. Only used by the poll thread.
+                //
                 //  m_c4DriverListId
                 //      This is the id for the server's driver list, which we
                 //      got the last time we updated from the server. This
@@ -1003,12 +1104,23 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
                 //      some queries to the server. Only used internally by
                 //      the poll thread.
                 //
+                //  m_fiopCold
                 //  m_fiopPoll
-                //      The I/O polling list that our polling thread uses
+                //      The I/O polling lists that our polling thread uses
                 //      to do the field polling. This cannot ever be accessed
                 //      by incoming calls directly. Only our own poll thread
                 //      accesses this.
                 //
+                //      The poll list is the hot list, polled every round. The
+                //      cold list holds fields that no client has read lately
+                //      and that haven't changed for a while, and is only
+                //      polled every so many rounds. So the per-round packet
+                //      only includes fields someone is actively watching or
+                //      that are actively changing. Fields are moved between
+                //      them during the prune pass, and cold fields are also
+                //      promoted back to the hot list at the start of the next
+                //      round once they are accessed or change.
+                //
                 //  m_mbufPoll
                 //      We need a memory buffer for polling. The data is
                 //      returned in a flattened format, and then we use the
@@ -1070,6 +1182,8 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
                 //      with and polling our server. It's pointed to the
                 //      ePollThread method.
                 // -----------------------------------------------------------
+                tCIDLib::TBoolean           m_bPromotePending;
+                tCIDLib::TCard4             m_c4ColdRound;
                 tCIDLib::TCard4             m_c4DriverListId;
                 tCIDLib::TCard4             m_c4ServerId;
                 TDriverIdList               m_colById;
@@ -1082,6 +1196,7 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
                 tCIDLib::TEncodedTime       m_enctLastStateChange;
                 ESrvStates                  m_eState;
                 TFundVector<tCIDLib::TCard8> m_fcolTmp;
+                TFldIOPacket                m_fiopCold;
                 TFldIOPacket                m_fiopPoll;
                 THeapBuf                    m_mbufPoll;
                 THeapBuf                    m_mbufTmpPoll;
@@ -1193,6 +1308,15 @@ class CQCPOLLENGEXPORT TCQCPollEngine : public TObject
             ,       TCQCPollEngFldLink&     flnkInfo
         );
 
+        tCQCKit::EValQRes eQueryValue
+        (
+            const   TString&                strMoniker
+            , const TString&                strField
+            ,       tCIDLib::TCard4&        c4SerialNum
+            ,       tCQCKit::TFldValPtr&    cptrToFill
+            ,       TCQCPollEngFldLink&     flnkInfo
+        );
+
         tCQCKit::EValQRes eQueryValue
         (
             const   TString&                strToRead
@@ -44,6 +44,16 @@ namespace
         constexpr tCIDLib::TEncodedTime enctReconnThreshold = (kCIDLib::enctOneSecond * 3);
         constexpr tCIDLib::TEncodedTime enctPruneCheckInterval = (kCIDLib::enctOneSecond * 15);
         constexpr tCIDLib::TEncodedTime enctStateChangeThreshold = kCIDLib::enctOneMinute;
+
+
+        // -----------------------------------------------------------------------
+        //  Fields that haven't been read by any client within the cold access time,
+        //  and haven't changed within the cold change time, are moved to the cold
+        //  poll list, which is only polled once every so many poll rounds.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TEncodedTime enctColdAccess = (kCIDLib::enctOneSecond * 10);
+        constexpr tCIDLib::TEncodedTime enctColdChange = kCIDLib::enctOneMinute;
+        constexpr tCIDLib::TCard4       c4ColdPollRounds = 8;
     }
 }
 
@@ -70,9 +80,13 @@ TCQCPollEngine::TFldItem::strKey(const TCQCPollEngine::TFldItem& fldiSrc)
 TCQCPollEngine::TFldItem::TFldItem( const   tCIDLib::TCard4     c4DriverId
                                     , const TCQCFldDef&         flddData
                                     , const TCQCPollEngFldLink& flnkThis) :
-    m_bOnPollList(kCIDLib::False)
+    m_bOnColdList(kCIDLib::False)
+    , m_bOnPollList(kCIDLib::False)
+    , m_bPromote(kCIDLib::False)
     , m_c4FmtSerialNum(0)
+    , m_c4SnapSerialNum(0)
     , m_enctLastAccess(TTime::enctNow())
+    , m_enctLastChange(TTime::enctNow())
     , m_flddInfo(flddData)
     , m_flnkThis(flnkThis)
     , m_pfvCurrent(nullptr)
@@ -100,6 +114,37 @@ tCIDLib::TBoolean TCQCPollEngine::TFldItem::bInError() const
 }
 
 
+//
+//  Indicates whether this field should be on the cold poll list, i.e. no client
+//  has read it recently and it hasn't changed for a while.
+//
+tCIDLib::TBoolean
+TCQCPollEngine::TFldItem::bIsCold(const tCIDLib::TEncodedTime enctNow) const
+{
+    return (m_enctLastAccess + CQCPollEng_Engine2::enctColdAccess < enctNow)
+           && (m_enctLastChange + CQCPollEng_Engine2::enctColdChange < enctNow);
+}
+
+
+//
+//  Get or set the on cold list flag. The poll thread sets this when it moves us
+//  between the server's hot and cold lists, and that also clears any pending
+//  promotion, since we've been moved.
+//
+tCIDLib::TBoolean TCQCPollEngine::TFldItem::bOnColdList() const
+{
+    return m_bOnColdList;
+}
+
+tCIDLib::TBoolean
+TCQCPollEngine::TFldItem::bOnColdList(const tCIDLib::TBoolean bToSet)
+{
+    m_bOnColdList = bToSet;
+    m_bPromote = kCIDLib::False;
+    return m_bOnColdList;
+}
+
+
 // Get or set the on poll list flag
 tCIDLib::TBoolean TCQCPollEngine::TFldItem::bOnPollList() const
 {
@@ -121,6 +166,13 @@ TCQCPollEngine::TFldItem::bPolledSince(const tCIDLib::TEncodedTime enctSince) co
 }
 
 
+// Indicates we are on the cold list but have been accessed or changed since
+tCIDLib::TBoolean TCQCPollEngine::TFldItem::bPromote() const
+{
+    return m_bPromote;
+}
+
+
 tCIDLib::TCard4 TCQCPollEngine::TFldItem::c4FieldId() const
 {
     return m_flddInfo.c4Id();
@@ -133,6 +185,30 @@ tCIDLib::TCard4 TCQCPollEngine::TFldItem::c4SerialNum() const
 }
 
 
+//
+//  Return a shared snapshot of the current value, creating a new one if the value
+//  has changed since the last one was made. The engine lock must be held. The
+//  snapshot is never changed once created, so the caller can hold onto it and
+//  read it without any locking.
+//
+const tCQCKit::TFldValPtr& TCQCPollEngine::TFldItem::cptrSnapshot()
+{
+    if (!m_cptrSnapshot.pobjData() || (m_c4SnapSerialNum != m_pfvCurrent->c4SerialNum()))
+    {
+        TCQCFldValue* pfvNew = facCQCKit().pfvMakeNewFor
+        (
+            m_pfvCurrent->c4DriverId(), m_pfvCurrent->c4FieldId(), m_flddInfo.eType()
+        );
+        TJanitor<TCQCFldValue> janNew(pfvNew);
+        QueryValue(*pfvNew);
+
+        m_cptrSnapshot.SetPointer(janNew.pobjOrphan());
+        m_c4SnapSerialNum = m_pfvCurrent->c4SerialNum();
+    }
+    return m_cptrSnapshot;
+}
+
+
 tCIDLib::TEncodedTime TCQCPollEngine::TFldItem::enctLastAccess() const
 {
     return m_enctLastAccess;
@@ -271,9 +347,26 @@ tCIDLib::TVoid TCQCPollEngine::TFldItem::SetErrorState()
 //  only look at the field item value, and that has to update the access
 //  stamp, which is mutable for this purpose.
 //
+//  If we are on the cold list, then flag us for promotion back to the hot
+//  list, since someone is watching us again.
+//
 tCIDLib::TVoid TCQCPollEngine::TFldItem::SetLastAccessStamp() const
 {
     m_enctLastAccess = TTime::enctNow();
+    if (m_bOnColdList)
+        m_bPromote = kCIDLib::True;
+}
+
+
+//
+//  The poll thread calls this when it gets a new value or state for us. If we
+//  are on the cold list we are changing again, so flag us for promotion.
+//
+tCIDLib::TVoid TCQCPollEngine::TFldItem::SetLastChangeStamp()
+{
+    m_enctLastChange = TTime::enctNow();
+    if (m_bOnColdList)
+        m_bPromote = kCIDLib::True;
 }
 
 
@@ -567,7 +660,9 @@ TCQCPollEngine::TSrvItem::TSrvItem(         TCQCPollEngine* const   polleOwner
                                     , const TString&                strNodeName
                                     , const tCIDLib::TEncodedTime   enctDropInterval) :
 
-    m_c4DriverListId(kCIDLib::c4MaxCard)
+    m_bPromotePending(kCIDLib::False)
+    , m_c4ColdRound(0)
+    , m_c4DriverListId(kCIDLib::c4MaxCard)
     , m_colById(tCIDLib::EAdoptOpts::NoAdopt)
     , m_colDrivers(tCIDLib::EAdoptOpts::Adopt, 29, TStringKeyOps(), &TDrvItem::strKey)
     , m_enctDropInterval(enctDropInterval)
@@ -1038,8 +1133,9 @@ tCIDLib::TVoid TCQCPollEngine::TSrvItem::Poll()
     #endif
 
     //
-    //  Add any fields to the poll list that have been queued up since we last polled. He
-    //  will lock as required.
+    //  Add any fields to the poll list that have been queued up since we last polled,
+    //  and promote any cold fields that have been accessed or changed since then back
+    //  to the hot list. He will lock as required.
     //
     LoadNewFields();
 
@@ -1069,376 +1165,133 @@ tCIDLib::TVoid TCQCPollEngine::TSrvItem::Poll()
         m_enctLastPrune = enctNow;
 
         //
-        //  Run through the I/O poll list and look up each field. If it its last access
-        //  time is before the last prune, then toss it.
+        //  Run through the hot and cold poll lists and drop any fields that have not
+        //  been accessed within the drop interval, and move any whose access or change
+        //  rate has changed to the other list.
         //
         //  NOTE:   We DO NOT remove drivers from the list, even if we remove
         //          all the fields, so that we'll see field list changes
         //          during polling and get an 'out of sync' exception that
         //          will make us update.
         //
-        tCIDLib::TCard4 c4DCount = m_fiopPoll.c4DriverCount();
-        for (tCIDLib::TCard4 c4DInd = 0; c4DInd < c4DCount; c4DInd++)
-        {
-            // Find our driver corresponding to this driver index in the I/o
-            TDrvItem* pdrviCur = pdrviFind(m_fiopPoll.c4DriverIdAt(c4DInd));
-
-            // And get the number of fields in the I/O for this index
-            tCIDLib::TCard4 c4FCount = m_fiopPoll.c4FieldCountAt(c4DInd);
-            tCIDLib::TCard4 c4FInd = 0;
-            while (c4FInd < c4FCount)
-            {
-                // Find our druver for the current driver/field index
-                const TFldIOData& fiodCur = m_fiopPoll.fiodAt(c4DInd, c4FInd);
-                TFldItem* pfldiCur = pdrviCur->pfldiFind(fiodCur.c4FieldId());
-
-                //  If it's out of date, drop it.
-                if (pfldiCur->enctLastAccess() < enctDropTest)
-                {
-                    // Remove this one and bump down the count
-                    m_fiopPoll.RemoveFieldAt(c4DInd, c4FInd);
-                    c4FCount--;
-
-                    // Mark it as no longer on the list
-                    pfldiCur->bOnPollList(kCIDLib::False);
-
-                    // Remember we removed some
-                    bRemovedSome = kCIDLib::True;
-                }
-                 else
-                {
-                    // We kept this one so move up the index
-                    c4FInd++;
-                }
-            }
-        }
+        if (bPrunePacket(m_fiopPoll, m_fiopCold, kCIDLib::False, enctNow, enctDropTest))
+            bRemovedSome = kCIDLib::True;
+        if (bPrunePacket(m_fiopCold, m_fiopPoll, kCIDLib::True, enctNow, enctDropTest))
+            bRemovedSome = kCIDLib::True;
 
         //
         //  If no fields left, then we mark ourself as in idle state, and
         //  set our 'idle since' stamp, which lets the engine remove us
         //  if we stay idle for a period of time.
         //
-        if (m_fiopPoll.bNoFields())
+        if (m_fiopPoll.bNoFields() && m_fiopCold.bNoFields())
         {
+            m_c4ColdRound = 0;
             eState(ESrvStates::Idle);
             return;
         }
     }
 
     //
-    //  Ok, now poll the fields in our field I/O list and store away any
-    //  new data or error states.
+    //  Ok, now poll the fields in our hot list. Every so many rounds we also do the
+    //  cold list, if we are still ready after the hot poll.
     //
-    try
+    PollPacket(m_fiopPoll);
+
+    m_c4ColdRound++;
+    if (m_c4ColdRound >= CQCPollEng_Engine2::c4ColdPollRounds)
     {
-        // Ask the server for any changes
-        tCIDLib::TCard4 c4Bytes;
-        m_porbcAdmin->ReadFields(m_fiopPoll, c4Bytes, m_mbufPoll);
+        m_c4ColdRound = 0;
+        if (!m_fiopCold.bNoFields() && (m_eState == ESrvStates::Ready))
+            PollPacket(m_fiopCold);
+    }
+}
 
-        //
-        //  Now loop through the results and pull out any results. Check
-        //  first for the start object marker and format version.
-        //
-        TBinMBufInStream strmSrc(&m_mbufPoll, c4Bytes);
 
-        strmSrc.CheckForStartMarker(CID_FILE, CID_LINE);
-        tCIDLib::TCard1 c1FmtVersion;
-        strmSrc >> c1FmtVersion;
 
-        if (c1FmtVersion != kCQCKit::c1FldFmtVersion)
-        {
-            facCQCKit().ThrowErr
-            (
-                CID_FILE
-                , CID_LINE
-                , kKitErrs::errcFIOP_BadFmtVersion
-                , tCIDLib::ESeverities::Failed
-                , tCIDLib::EErrClasses::Format
-                , TCardinal(c1FmtVersion)
-                , TString("TCQCPollEngine::TSrvItem")
-            );
-        }
+//
+//  Goes through the poll list and returns the list of fields currently
+//  on the list for this server. We can either replace or append. the caller
+//  must lock before calling this.
+//
+tCIDLib::TVoid TCQCPollEngine::
+TSrvItem::QueryActiveFlds(          tCIDLib::TStrCollect&   colToFill
+                            , const tCIDLib::TBoolean       bAppend)
+{
+    if (!bAppend)
+        colToFill.RemoveAll();
 
-        // OK, now we ahve to lock while we store the field info
-        TLocker lockrSync(&m_mtxSync);
+    TString strFld;
+    for (tCIDLib::TCard4 c4PInd = 0; c4PInd < 2; c4PInd++)
+    {
+        // Do the hot list and then the cold list
+        const TFldIOPacket& fiopCur = c4PInd ? m_fiopCold : m_fiopPoll;
 
-        tCIDLib::TCard1 c1Marker;
-        tCIDLib::TCard1 c1State;
-        tCIDLib::TCard1 c1Type;
-        tCIDLib::TCard2 c2Id;
-        tCIDLib::TCard4 c4SerialNum;
-        TDrvItem*       pdrviCur = nullptr;
-        while (!strmSrc.bEndOfStream())
+        tCIDLib::TCard4 c4DCount = fiopCur.c4DriverCount();
+        for (tCIDLib::TCard4 c4DInd = 0; c4DInd < c4DCount; c4DInd++)
         {
-            // Each new chunk should start with a start object marker
-            strmSrc.CheckForStartMarker(CID_FILE, CID_LINE);
-
-            // And next we should see a chunk type
-            strmSrc >> c1Type;
+            // Find our driver corresponding to this driver index in the I/o
+            TDrvItem* pdrviCur = pdrviFind(fiopCur.c4DriverIdAt(c4DInd));
 
-            // According to the type, do the correct thing
-            if (c1Type == kCQCKit::c1FldType_DriverOffline)
-            {
-                //
-                //  Get the id, look up the driver. If we were online before,
-                //  then mark it offline.
-                //
-                strmSrc >> c2Id >> c1State;
-                pdrviCur = m_colById[c2Id];
-                pdrviCur->SetState(tCQCKit::EDrvStates(c1State));
+            // And get the number of fields in the I/O for this index
+            tCIDLib::TCard4 c4FCount = fiopCur.c4FieldCountAt(c4DInd);
 
-                //
-                //  Now set the driver pointer back to zero, since there
-                //  should be no field chunks for this driver.
-                //
-                pdrviCur = 0;
-            }
-             else if (c1Type == kCQCKit::c1FldType_DriverOnline)
-            {
-                //
-                //  Get the id, look up the driver, and mark it online if not
-                //  already. Leave the driver pointer set, since it will now
-                //  become the target driver for subsequent field chunks.
-                //
-                strmSrc >> c2Id;
-                pdrviCur = m_colById[c2Id];
-                pdrviCur->SetState(tCQCKit::EDrvStates::Connected);
-            }
-             else if (c1Type == kCQCKit::c1FldType_Field)
+            for (tCIDLib::TCard4 c4FInd = 0; c4FInd < c4FCount; c4FInd++)
             {
-                // We must have seen a previous server
-                CIDAssert(pdrviCur != 0, L"Did not see a server before fields");
-
-                // Get the id of the field out and the marker
-                strmSrc >> c2Id >> c1Marker;
+                // Find our druver for the current driver/field index
+                const TFldIOData& fiodCur = fiopCur.fiodAt(c4DInd, c4FInd);
+                const TFldItem* pfldiCur = pdrviCur->pfldiFind(fiodCur.c4FieldId());
 
-                // Look up this field
-                TFldItem* pfldiCur = pdrviCur->pfldiFind(c2Id);
-                if (!pfldiCur)
+                if (pfldiCur)
                 {
-                    facCQCKit().ThrowErr
-                    (
-                        CID_FILE
-                        , CID_LINE
-                        , kKitErrs::errcFIOP_FldIdNotFound
-                        , tCIDLib::ESeverities::Failed
-                        , tCIDLib::EErrClasses::NotFound
-                        , TCardinal(c2Id)
-                    );
+                    strFld = pdrviCur->strMoniker();
+                    strFld.Append(L'.');
+                    strFld.Append(pfldiCur->strName());
+                    colToFill.objAdd(strFld);
                 }
+            }
+        }
+    }
+}
 
-                //
-                //  If the marker indicates no change, then we don't have
-                //  to do anything. If it indicates new data, we have to
-                //  store this info.
-                //
-                if (c1Marker == kCQCKit::c1FldData_Changed)
-                {
-                    //
-                    //  Get the serial number out and update the I/O packet
-                    //  for this field to hold the new serial number.
-                    //
-                    strmSrc >> c4SerialNum;
-                    m_fiopPoll.SetSerialNum(pdrviCur->c4DriverId(), c2Id, c4SerialNum);
-
-                    //
-                    //  Get the value out, according to the type of field,
-                    //  and store the value into the field item.
-                    //
-                    TCQCFldValue& fvSet = pfldiCur->fvCurrent();
-                    switch(pfldiCur->flddInfo().eType())
-                    {
-                        case tCQCKit::EFldTypes::Boolean :
-                        {
-                            tCIDLib::TBoolean bValue;
-                            strmSrc >> bValue;
-                            static_cast<TCQCBoolFldValue&>(fvSet).bSetValue(bValue);
-                            break;
-                        }
 
-                        case tCQCKit::EFldTypes::Card :
-                        {
-                            tCIDLib::TCard4 c4Value;
-                            strmSrc >> c4Value;
-                            static_cast<TCQCCardFldValue&>(fvSet).bSetValue(c4Value);
-                            break;
-                        }
 
-                        case tCQCKit::EFldTypes::Float :
-                        {
-                            tCIDLib::TFloat8 f8Value;
-                            strmSrc >> f8Value;
-                            static_cast<TCQCFloatFldValue&>(fvSet).bSetValue(f8Value);
-                            break;
-                        }
+//
+//  Before this is called, the node name must be set, either via the ctor,
+//  or after the fact if the default ctor was used.
+//
+//  We don't have to lock here since, until we are successful and at the
+//  very end we mark ourselves now as idle, any clients will see that we
+//  aren't ready and won't try to access anything.
+//
+tCIDLib::TVoid TCQCPollEngine::TSrvItem::Reload()
+{
+    //
+    //  Make sure the client proxy has been set. If not, then drop back to the
+    //  offline state. There is a slight chance this can happen, if we get an
+    //  out of sync error because the server is going down and fall back to
+    //  unloaded state, but then we get here and it's gone.
+    //
+    if (!m_porbcAdmin)
+    {
+        Reset();
+        return;
+    }
 
-                        case tCQCKit::EFldTypes::Int :
-                        {
-                            tCIDLib::TInt4 i4Value;
-                            strmSrc >> i4Value;
-                            static_cast<TCQCIntFldValue&>(fvSet).bSetValue(i4Value);
-                            break;
-                        }
+    //
+    //  Do an initial reset of the I/O packet to make sure it gets cleaned
+    //  out. We'll reset it again below with the real driver list id, if we
+    //  can get it. But in case something goes awry before that, we want to
+    //  be sure its empty, since this drives the polling system.
+    //
+    m_fiopPoll.Reset(kCIDLib::c4MaxCard);
+    m_fiopCold.Reset(kCIDLib::c4MaxCard);
 
-                        case tCQCKit::EFldTypes::String :
-                        {
-                            strmSrc >> m_strTmpPoll;
-                            static_cast<TCQCStringFldValue&>(fvSet).bSetValue(m_strTmpPoll);
-                            break;
-                        }
-
-                        case tCQCKit::EFldTypes::StringList :
-                        {
-                            strmSrc >> m_colTmpPoll;
-                            static_cast<TCQCStrListFldValue&>(fvSet).bSetValue(m_colTmpPoll);
-                            break;
-                        }
-
-                        case tCQCKit::EFldTypes::Time :
-                        {
-                            tCIDLib::TCard8 c8Val;
-                            strmSrc >> c8Val;
-                            static_cast<TCQCTimeFldValue&>(fvSet).bSetValue(c8Val);
-                            break;
-                        }
-
-                        default :
-                            #if CID_DEBUG_ON
-                            TPopUp::PopUpMsg
-                            (
-                                CID_FILE
-                                , CID_LINE
-                                , L"CQC Intf Engine"
-                                , L"Charmed Quark Systems, Ltd"
-                                , L"Unknown field type"
-                                , 0
-                            );
-                            #endif
-                            break;
-                    };
-                }
-                 else if (c1Marker == kCQCKit::c1FldData_InError)
-                {
-                    //
-                    //  If not already in error state, then set the state. Zero
-                    //  the serial number in the field I/O packet to insure we get
-                    //  a good read when it comes back online.
-                    //
-                    if (!pfldiCur->bInError())
-                    {
-                        pfldiCur->SetErrorState();
-                        m_fiopPoll.SetSerialNum(pdrviCur->c4DriverId(), c2Id, 0);
-                    }
-                }
-                 else if (c1Marker != kCQCKit::c1FldData_Unchanged)
-                {
-                    // Something is wrong
-                    // <TBD>
-                }
-            }
-             else
-            {
-                // Something went wry
-                // <TBD>
-            }
-        }
-    }
-
-    catch(const TError& errToCatch)
-    {
-        //
-        //  If its an out of sync error, then we set our state to indicate
-        //  that we are unloaded, which will cause us to reload on the
-        //  next round.
-        //
-        //  Else, its a lost of connection or something unexpected, so reset
-        //  and start over.
-        //
-        if (errToCatch.eClass() == tCIDLib::EErrClasses::OutOfSync)
-            eState(ESrvStates::NotLoaded);
-        else
-            Reset();
-    }
-}
-
-
-
-//
-//  Goes through the poll list and returns the list of fields currently
-//  on the list for this server. We can either replace or append. the caller
-//  must lock before calling this.
-//
-tCIDLib::TVoid TCQCPollEngine::
-TSrvItem::QueryActiveFlds(          tCIDLib::TStrCollect&   colToFill
-                            , const tCIDLib::TBoolean       bAppend)
-{
-    if (!bAppend)
-        colToFill.RemoveAll();
-
-    TString strFld;
-    tCIDLib::TCard4 c4DCount = m_fiopPoll.c4DriverCount();
-    for (tCIDLib::TCard4 c4DInd = 0; c4DInd < c4DCount; c4DInd++)
-    {
-        // Find our driver corresponding to this driver index in the I/o
-        TDrvItem* pdrviCur = pdrviFind(m_fiopPoll.c4DriverIdAt(c4DInd));
-
-        // And get the number of fields in the I/O for this index
-        tCIDLib::TCard4 c4FCount = m_fiopPoll.c4FieldCountAt(c4DInd);
-
-        for (tCIDLib::TCard4 c4FInd = 0; c4FInd < c4FCount; c4FInd++)
-        {
-            // Find our druver for the current driver/field index
-            const TFldIOData& fiodCur = m_fiopPoll.fiodAt(c4DInd, c4FInd);
-            const TFldItem* pfldiCur = pdrviCur->pfldiFind(fiodCur.c4FieldId());
-
-            if (pfldiCur)
-            {
-                strFld = pdrviCur->strMoniker();
-                strFld.Append(L'.');
-                strFld.Append(pfldiCur->strName());
-                colToFill.objAdd(strFld);
-            }
-        }
-    }
-}
-
-
-
-//
-//  Before this is called, the node name must be set, either via the ctor,
-//  or after the fact if the default ctor was used.
-//
-//  We don't have to lock here since, until we are successful and at the
-//  very end we mark ourselves now as idle, any clients will see that we
-//  aren't ready and won't try to access anything.
-//
-tCIDLib::TVoid TCQCPollEngine::TSrvItem::Reload()
-{
-    //
-    //  Make sure the client proxy has been set. If not, then drop back to the
-    //  offline state. There is a slight chance this can happen, if we get an
-    //  out of sync error because the server is going down and fall back to
-    //  unloaded state, but then we get here and it's gone.
-    //
-    if (!m_porbcAdmin)
-    {
-        Reset();
-        return;
-    }
-
-    //
-    //  Do an initial reset of the I/O packet to make sure it gets cleaned
-    //  out. We'll reset it again below with the real driver list id, if we
-    //  can get it. But in case something goes awry before that, we want to
-    //  be sure its empty, since this drives the polling system.
-    //
-    m_fiopPoll.Reset(kCIDLib::c4MaxCard);
-
-    //
-    //  Also reset our last prune time as well, since it might otherwise
-    //  kick off just after this and do an unnecessary prune cycle.
-    //
-    m_enctLastPrune = TTime::enctNow();
+    //
+    //  Also reset our last prune time as well, since it might otherwise
+    //  kick off just after this and do an unnecessary prune cycle.
+    //
+    m_enctLastPrune = TTime::enctNow();
 
     //
     //  Reset our driver list id so that we will invalidate any links to
@@ -1469,6 +1322,7 @@ tCIDLib::TVoid TCQCPollEngine::TSrvItem::Reload()
         //  GUI widgets relink to it during their polling cycle.
         //
         m_fiopPoll.Reset(m_c4DriverListId);
+        m_fiopCold.Reset(m_c4DriverListId);
 
         const tCIDLib::TCard4   c4Count = colMonikers.c4ElemCount();
         for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
@@ -1545,6 +1399,9 @@ tCIDLib::TVoid TCQCPollEngine::TSrvItem::Reset()
     m_colDrivers.RemoveAll();
     m_colNewFlds.RemoveAll();
     m_fiopPoll.Reset(kCIDLib::c4MaxCard);
+    m_fiopCold.Reset(kCIDLib::c4MaxCard);
+    m_bPromotePending = kCIDLib::False;
+    m_c4ColdRound = 0;
     m_enctLastPrune = TTime::enctNow();
     delete m_porbcAdmin;
     m_porbcAdmin = 0;
@@ -1555,6 +1412,17 @@ tCIDLib::TVoid TCQCPollEngine::TSrvItem::Reset()
 }
 
 
+//
+//  The server janitor calls this, with us locked, when it releases a field that
+//  has been flagged for promotion from the cold to the hot list, so that the poll
+//  thread knows it needs to go look for them on the next round.
+//
+tCIDLib::TVoid TCQCPollEngine::TSrvItem::SetPromotePending()
+{
+    m_bPromotePending = kCIDLib::True;
+}
+
+
 const TString& TCQCPollEngine::TSrvItem::strNodeName() const
 {
     return m_strNodeName;
@@ -1628,6 +1496,62 @@ tCIDLib::TVoid TCQCPollEngine::TSrvItem::WaitShutdown()
 //  TCQCPollEngine::TSrvItem: Private, non-virual methods
 // ---------------------------------------------------------------------------
 
+//
+//  Called during the prune pass for the hot and cold poll lists. Any fields that
+//  have not been accessed within the drop interval are removed. Any that no longer
+//  belong in this list (according to whether it's the cold list or not) are moved
+//  to the other list, keeping their serial numbers so we don't get a redundant
+//  value. The caller must lock. We return true if we dropped any fields.
+//
+tCIDLib::TBoolean
+TCQCPollEngine::TSrvItem::bPrunePacket(         TFldIOPacket&           fiopSrc
+                                        ,       TFldIOPacket&           fiopOther
+                                        , const tCIDLib::TBoolean       bColdList
+                                        , const tCIDLib::TEncodedTime   enctNow
+                                        , const tCIDLib::TEncodedTime   enctDropTest)
+{
+    tCIDLib::TBoolean bRemovedSome = kCIDLib::False;
+
+    const tCIDLib::TCard4 c4DCount = fiopSrc.c4DriverCount();
+    for (tCIDLib::TCard4 c4DInd = 0; c4DInd < c4DCount; c4DInd++)
+    {
+        // Find our driver corresponding to this driver index in the I/o
+        TDrvItem* pdrviCur = pdrviFind(fiopSrc.c4DriverIdAt(c4DInd));
+
+        // And get the number of fields in the I/O for this index
+        tCIDLib::TCard4 c4FCount = fiopSrc.c4FieldCountAt(c4DInd);
+        tCIDLib::TCard4 c4FInd = 0;
+        while (c4FInd < c4FCount)
+        {
+            const TFldIOData& fiodCur = fiopSrc.fiodAt(c4DInd, c4FInd);
+            TFldItem* pfldiCur = pdrviCur->pfldiFind(fiodCur.c4FieldId());
+
+            if (pfldiCur->enctLastAccess() < enctDropTest)
+            {
+                // It's out of date, so drop it and mark it no longer on the list
+                fiopSrc.RemoveFieldAt(c4DInd, c4FInd);
+                c4FCount--;
+                pfldiCur->bOnPollList(kCIDLib::False);
+                pfldiCur->bOnColdList(kCIDLib::False);
+                bRemovedSome = kCIDLib::True;
+            }
+             else if (pfldiCur->bIsCold(enctNow) != bColdList)
+            {
+                // It belongs on the other list, so move it over
+                MoveFieldAt(fiopSrc, fiopOther, c4DInd, c4FInd, *pdrviCur, *pfldiCur, !bColdList);
+                c4FCount--;
+            }
+             else
+            {
+                // We kept this one so move up the index
+                c4FInd++;
+            }
+        }
+    }
+    return bRemovedSome;
+}
+
+
 //
 //  The poll list will call this before each poll round to see if the clients
 //  have added new fields for us to poll. They can't add them directly to
@@ -1651,7 +1575,16 @@ tCIDLib::TVoid TCQCPollEngine::TSrvItem::LoadNewFields()
             if (pdrviAdd)
             {
                 TFldItem* pfldiAdd = pdrviAdd->pfldiFind(kvalCur.strValue());
-                if (pfldiAdd)
+                if (pfldiAdd && pfldiAdd->bOnColdList())
+                {
+                    //
+                    //  Already on the cold list, so don't add it to the hot list
+                    //  as well. Just flag it for promotion below.
+                    //
+                    pfldiAdd->SetLastAccessStamp();
+                    m_bPromotePending = kCIDLib::True;
+                }
+                 else if (pfldiAdd)
                 {
                     m_fiopPoll.c4AddOrFindField
                     (
@@ -1682,6 +1615,10 @@ tCIDLib::TVoid TCQCPollEngine::TSrvItem::LoadNewFields()
     // Flush the list now
     m_colNewFlds.RemoveAll();
 
+    // If any cold fields have been flagged for promotion, move them over
+    if (m_bPromotePending)
+        PromoteFields();
+
     //
     //  If we are in idle state, put us into ready state if we added any
     //  fields, since we now have at least one field to poll.
@@ -1690,3 +1627,315 @@ tCIDLib::TVoid TCQCPollEngine::TSrvItem::LoadNewFields()
         eState(ESrvStates::Ready);
 }
 
+
+//
+//  Moves the indicated field from one of our poll lists to the other, keeping
+//  its serial number so that we don't get a redundant value, and updates the
+//  field's cold list flag. The caller must lock.
+//
+tCIDLib::TVoid
+TCQCPollEngine::TSrvItem::MoveFieldAt(          TFldIOPacket&       fiopSrc
+                                        ,       TFldIOPacket&       fiopTar
+                                        , const tCIDLib::TCard4     c4DInd
+                                        , const tCIDLib::TCard4     c4FInd
+                                        , const TDrvItem&           drviOwner
+                                        ,       TFldItem&           fldiMove
+                                        , const tCIDLib::TBoolean   bToCold)
+{
+    const tCIDLib::TCard4 c4SerialNum = fiopSrc.fiodAt(c4DInd, c4FInd).c4SerialNum();
+    fiopTar.c4AddOrFindField
+    (
+        drviOwner.c4DriverId()
+        , drviOwner.c4FieldListId()
+        , fldiMove.c4FieldId()
+        , fldiMove.flddInfo().eType()
+    );
+    fiopTar.SetSerialNum(drviOwner.c4DriverId(), fldiMove.c4FieldId(), c4SerialNum);
+    fiopSrc.RemoveFieldAt(c4DInd, c4FInd);
+
+    fldiMove.bOnColdList(bToCold);
+}
+
+
+//
+//  Does a remote poll of one of our poll lists, and stores away any new data or error
+//  states for the fields in it. The caller provides the list, either the hot or cold
+//  one.
+//
+tCIDLib::TVoid TCQCPollEngine::TSrvItem::PollPacket(TFldIOPacket& fiopTar)
+{
+    try
+    {
+        // Ask the server for any changes
+        tCIDLib::TCard4 c4Bytes;
+        m_porbcAdmin->ReadFields(fiopTar, c4Bytes, m_mbufPoll);
+
+        //
+        //  Now loop through the results and pull out any results. Check
+        //  first for the start object marker and format version.
+        //
+        TBinMBufInStream strmSrc(&m_mbufPoll, c4Bytes);
+
+        strmSrc.CheckForStartMarker(CID_FILE, CID_LINE);
+        tCIDLib::TCard1 c1FmtVersion;
+        strmSrc >> c1FmtVersion;
+
+        if (c1FmtVersion != kCQCKit::c1FldFmtVersion)
+        {
+            facCQCKit().ThrowErr
+            (
+                CID_FILE
+                , CID_LINE
+                , kKitErrs::errcFIOP_BadFmtVersion
+                , tCIDLib::ESeverities::Failed
+                , tCIDLib::EErrClasses::Format
+                , TCardinal(c1FmtVersion)
+                , TString("TCQCPollEngine::TSrvItem")
+            );
+        }
+
+        // OK, now we ahve to lock while we store the field info
+        TLocker lockrSync(&m_mtxSync);
+
+        tCIDLib::TCard1 c1Marker;
+        tCIDLib::TCard1 c1State;
+        tCIDLib::TCard1 c1Type;
+        tCIDLib::TCard2 c2Id;
+        tCIDLib::TCard4 c4SerialNum;
+        TDrvItem*       pdrviCur = nullptr;
+        while (!strmSrc.bEndOfStream())
+        {
+            // Each new chunk should start with a start object marker
+            strmSrc.CheckForStartMarker(CID_FILE, CID_LINE);
+
+            // And next we should see a chunk type
+            strmSrc >> c1Type;
+
+            // According to the type, do the correct thing
+            if (c1Type == kCQCKit::c1FldType_DriverOffline)
+            {
+                //
+                //  Get the id, look up the driver. If we were online before,
+                //  then mark it offline.
+                //
+                strmSrc >> c2Id >> c1State;
+                pdrviCur = m_colById[c2Id];
+                pdrviCur->SetState(tCQCKit::EDrvStates(c1State));
+
+                //
+                //  Now set the driver pointer back to zero, since there
+                //  should be no field chunks for this driver.
+                //
+                pdrviCur = 0;
+            }
+             else if (c1Type == kCQCKit::c1FldType_DriverOnline)
+            {
+                //
+                //  Get the id, look up the driver, and mark it online if not
+                //  already. Leave the driver pointer set, since it will now
+                //  become the target driver for subsequent field chunks.
+                //
+                strmSrc >> c2Id;
+                pdrviCur = m_colById[c2Id];
+                pdrviCur->SetState(tCQCKit::EDrvStates::Connected);
+            }
+             else if (c1Type == kCQCKit::c1FldType_Field)
+            {
+                // We must have seen a previous server
+                CIDAssert(pdrviCur != 0, L"Did not see a server before fields");
+
+                // Get the id of the field out and the marker
+                strmSrc >> c2Id >> c1Marker;
+
+                // Look up this field
+                TFldItem* pfldiCur = pdrviCur->pfldiFind(c2Id);
+                if (!pfldiCur)
+                {
+                    facCQCKit().ThrowErr
+                    (
+                        CID_FILE
+                        , CID_LINE
+                        , kKitErrs::errcFIOP_FldIdNotFound
+                        , tCIDLib::ESeverities::Failed
+                        , tCIDLib::EErrClasses::NotFound
+                        , TCardinal(c2Id)
+                    );
+                }
+
+                //
+                //  If the marker indicates no change, then we don't have
+                //  to do anything. If it indicates new data, we have to
+                //  store this info.
+                //
+                if (c1Marker == kCQCKit::c1FldData_Changed)
+                {
+                    //
+                    //  Get the serial number out and update the I/O packet
+                    //  for this field to hold the new serial number.
+                    //
+                    strmSrc >> c4SerialNum;
+                    fiopTar.SetSerialNum(pdrviCur->c4DriverId(), c2Id, c4SerialNum);
+                    pfldiCur->SetLastChangeStamp();
+                    if (pfldiCur->bPromote())
+                        m_bPromotePending = kCIDLib::True;
+
+                    //
+                    //  Get the value out, according to the type of field,
+                    //  and store the value into the field item.
+                    //
+                    TCQCFldValue& fvSet = pfldiCur->fvCurrent();
+                    switch(pfldiCur->flddInfo().eType())
+                    {
+                        case tCQCKit::EFldTypes::Boolean :
+                        {
+                            tCIDLib::TBoolean bValue;
+                            strmSrc >> bValue;
+                            static_cast<TCQCBoolFldValue&>(fvSet).bSetValue(bValue);
+                            break;
+                        }
+
+                        case tCQCKit::EFldTypes::Card :
+                        {
+                            tCIDLib::TCard4 c4Value;
+                            strmSrc >> c4Value;
+                            static_cast<TCQCCardFldValue&>(fvSet).bSetValue(c4Value);
+                            break;
+                        }
+
+                        case tCQCKit::EFldTypes::Float :
+                        {
+                            tCIDLib::TFloat8 f8Value;
+                            strmSrc >> f8Value;
+                            static_cast<TCQCFloatFldValue&>(fvSet).bSetValue(f8Value);
+                            break;
+                        }
+
+                        case tCQCKit::EFldTypes::Int :
+                        {
+                            tCIDLib::TInt4 i4Value;
+                            strmSrc >> i4Value;
+                            static_cast<TCQCIntFldValue&>(fvSet).bSetValue(i4Value);
+                            break;
+                        }
+
+                        case tCQCKit::EFldTypes::String :
+                        {
+                            strmSrc >> m_strTmpPoll;
+                            static_cast<TCQCStringFldValue&>(fvSet).bSetValue(m_strTmpPoll);
+                            break;
+                        }
+
+                        case tCQCKit::EFldTypes::StringList :
+                        {
+                            strmSrc >> m_colTmpPoll;
+                            static_cast<TCQCStrListFldValue&>(fvSet).bSetValue(m_colTmpPoll);
+                            break;
+                        }
+
+                        case tCQCKit::EFldTypes::Time :
+                        {
+                            tCIDLib::TCard8 c8Val;
+                            strmSrc >> c8Val;
+                            static_cast<TCQCTimeFldValue&>(fvSet).bSetValue(c8Val);
+                            break;
+                        }
+
+                        default :
+                            #if CID_DEBUG_ON
+                            TPopUp::PopUpMsg
+                            (
+                                CID_FILE
+                                , CID_LINE
+                                , L"CQC Intf Engine"
+                                , L"Charmed Quark Systems, Ltd"
+                                , L"Unknown field type"
+                                , 0
+                            );
+                            #endif
+                            break;
+                    };
+                }
+                 else if (c1Marker == kCQCKit::c1FldData_InError)
+                {
+                    //
+                    //  If not already in error state, then set the state. Zero
+                    //  the serial number in the field I/O packet to insure we get
+                    //  a good read when it comes back online.
+                    //
+                    if (!pfldiCur->bInError())
+                    {
+                        pfldiCur->SetErrorState();
+                        pfldiCur->SetLastChangeStamp();
+                        fiopTar.SetSerialNum(pdrviCur->c4DriverId(), c2Id, 0);
+                        if (pfldiCur->bPromote())
+                            m_bPromotePending = kCIDLib::True;
+                    }
+                }
+                 else if (c1Marker != kCQCKit::c1FldData_Unchanged)
+                {
+                    // Something is wrong
+                    // <TBD>
+                }
+            }
+             else
+            {
+                // Something went wry
+                // <TBD>
+            }
+        }
+    }
+
+    catch(const TError& errToCatch)
+    {
+        //
+        //  If its an out of sync error, then we set our state to indicate
+        //  that we are unloaded, which will cause us to reload on the
+        //  next round.
+        //
+        //  Else, its a lost of connection or something unexpected, so reset
+        //  and start over.
+        //
+        if (errToCatch.eClass() == tCIDLib::EErrClasses::OutOfSync)
+            eState(ESrvStates::NotLoaded);
+        else
+            Reset();
+    }
+}
+
+
+//
+//  Called from LoadNewFields() when the promote pending flag is set. We run
+//  through the cold list and move any fields flagged for promotion back to the
+//  hot list. The caller must lock.
+//
+tCIDLib::TVoid TCQCPollEngine::TSrvItem::PromoteFields()
+{
+    const tCIDLib::TCard4 c4DCount = m_fiopCold.c4DriverCount();
+    for (tCIDLib::TCard4 c4DInd = 0; c4DInd < c4DCount; c4DInd++)
+    {
+        TDrvItem* pdrviCur = pdrviFind(m_fiopCold.c4DriverIdAt(c4DInd));
+
+        tCIDLib::TCard4 c4FCount = m_fiopCold.c4FieldCountAt(c4DInd);
+        tCIDLib::TCard4 c4FInd = 0;
+        while (c4FInd < c4FCount)
+        {
+            const TFldIOData& fiodCur = m_fiopCold.fiodAt(c4DInd, c4FInd);
+            TFldItem* pfldiCur = pdrviCur->pfldiFind(fiodCur.c4FieldId());
+
+            if (pfldiCur->bPromote())
+            {
+                MoveFieldAt
+                (
+                    m_fiopCold, m_fiopPoll, c4DInd, c4FInd, *pdrviCur, *pfldiCur, kCIDLib::False
+                );
+                c4FCount--;
+            }
+             else
+            {
+                c4FInd++;
+            }
+        }
+    }
+    m_bPromotePending = kCIDLib::False;
+}
+
@@ -494,9 +494,12 @@ tCIDLib::TVoid TFacCQCServer::UnloadDeadDrivers()
             }
         }
 
-        // If we removed any, bump the driver id list
+        // If we removed any, bump the driver id list and update the index
         if (bDriversUnloaded)
+        {
             m_c4DriverListId++;
+            RebuildDrvIndex();
+        }
     }
 }
 
@@ -571,6 +574,11 @@ TFacCQCServer::LoadADriver(const TCQCDriverObjCfg& cqcdcToLoad)
     //  We don't need a path, it'll be in the same directory as our exe, which means
     //  we don't have to do anything special for driver dev IDE vs production system.
     //
+    //  Drivers can be loaded by more than one thread at once, but loading facilities
+    //  and running their factory functions aren't known to be thread safe. So we
+    //  do one at a time, through the creation of the driver object.
+    //
+    TLocker lockrFacLoad(&m_mtxFacLoad);
     TFacility* pfacDriver = new TFacility
     (
         strBaseLibName
@@ -649,6 +657,7 @@ TFacCQCServer::LoadADriver(const TCQCDriverObjCfg& cqcdcToLoad)
         }
         throw;
     }
+    lockrFacLoad.Release();
 
     {
         // Lock while we do this
@@ -666,6 +675,7 @@ TFacCQCServer::LoadADriver(const TCQCDriverObjCfg& cqcdcToLoad)
         //  orphaned out of the janitor we temporarily put on it.
         //
         m_colDriverList.Add(new TServerDriverInfo(janFac.pobjOrphan(), psdrvNew));
+        RebuildDrvIndex();
 
         //
         //  At this point, the driver is ready to go, so start the driver processing
@@ -713,7 +723,7 @@ TFacCQCServer::LoadADriver(const TCQCDriverObjCfg& cqcdcToLoad)
 //  must clean up during shutdown.
 //
 //  What we do here is first is loop through the drivers and set their shutdown flags. Then
-//  we just go through the list looking for them to reach terminated state.
+//  we just wait for each of their threads to end, removing them as they do.
 //
 //  If calling during shutdown, no locking is required because we are already hidden from
 //  the outside work. If being called to remotely force an unload, the caller should lock.
@@ -835,35 +845,37 @@ tCIDLib::TVoid TFacCQCServer::UnloadDrivers()
     }   while (cursDrivers.bNext());
 
     //
-    //  Now we just wait around waiting for them to go into terminated state.
-    //  When we find terminated ones, we remove them. We keep going until we
-    //  empty the list or have waited as long as we are willing to wait.
+    //  They are all shutting down in parallel now, so just wait for each one's poll
+    //  thread to end, which is the last thing it does once it has gone to terminated
+    //  state. We wait on the thread itself, so we wake up as soon as it's done, with
+    //  whatever time is left of the overall time we are willing to wait. Since they
+    //  are all going down at once, by the time we've waited for the slowest of the
+    //  earlier ones, the later ones are likely already done.
     //
     const tCIDLib::TEncodedTime enctEnd = TTime::enctNowPlusSecs(20);
-    tCIDLib::TEncodedTime enctNow = TTime::enctNow();
-    while (enctNow < enctEnd)
+    cursDrivers.bReset();
+    while (cursDrivers.bIsValid())
     {
-        // If we've emptied the list, then break out
-        if (!cursDrivers.bReset())
+        const tCIDLib::TEncodedTime enctNow = TTime::enctNow();
+        if (enctNow >= enctEnd)
             break;
 
-        // Sleep a bit before each round
-        TThread::Sleep(250);
-        do
-        {
-            TServerDriverInfo& sdiCur = *cursDrivers;
-            if (sdiCur.bIsDead(500))
-                m_colDriverList.RemoveAt(cursDrivers);
-            else
-                cursDrivers.bNext();
-
-            // Loop until we hit the end or the list is empty
-        }   while (cursDrivers.bIsValid());
+        const tCIDLib::TCard4 c4WaitMS = tCIDLib::TCard4
+        (
+            (enctEnd - enctNow) / kCIDLib::enctOneMilliSec
+        );
 
-        enctNow = TTime::enctNow();
+        TServerDriverInfo& sdiCur = *cursDrivers;
+        if (sdiCur.bWaitTillDead(c4WaitMS))
+            m_colDriverList.RemoveAt(cursDrivers);
+        else
+            break;
     }
 
-    if (enctNow >= enctEnd)
+    // Update the moniker index for any we removed
+    RebuildDrvIndex();
+
+    if (!m_colDriverList.bIsEmpty())
     {
         facCQCServer.LogMsg
         (
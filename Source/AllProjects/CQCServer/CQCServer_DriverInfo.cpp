@@ -80,6 +80,22 @@ TServerDriverInfo::bIsDead(const tCIDLib::TCard4 c4WaitMS)
 }
 
 
+//
+//  Once StartShutdown has been called, this can be used to block until the driver
+//  thread ends, up to the indicated time. Unlike bIsDead we don't check the state
+//  first, since it won't be terminated until just before the thread ends.
+//
+tCIDLib::TBoolean
+TServerDriverInfo::bWaitTillDead(const tCIDLib::TCard4 c4WaitMS)
+{
+    // Shouldn't happen, but just in case
+    if (!m_psdrvDriver)
+        return kCIDLib::True;
+
+    return m_psdrvDriver->bWaitTillDead(c4WaitMS);
+}
+
+
 //
 //  If the scavenger thread sees our thread with a terminated state, it will
 //  call this so we can clean it up. The driver will be all closed down now
@@ -23,7 +23,8 @@
 //  We provide some helper methods as well. StartShutdown will set the
 //  shutdown request on the driver, starting it down. It does a non-syncing
 //  thread shutdown request, so that it never blocks. The bIsDead method is
-//  used to wait for the thread to actually end.
+//  used to check for the thread having actually ended. bWaitTillDead will
+//  block on the thread ending, for use once the shutdown has been started.
 //
 //  When a driver is fully down, DropDriver is called to clean up the driver
 //  and facility object, then this object can be destroyed.
@@ -74,6 +75,11 @@ class TServerDriverInfo : public TObject
             const   tCIDLib::TCard4         c4WaitMS
         );
 
+        tCIDLib::TBoolean bWaitTillDead
+        (
+            const   tCIDLib::TCard4         c4WaitMS
+        );
+
         tCIDLib::TVoid DropDriver();
 
         const TFacility& facDriver() const;
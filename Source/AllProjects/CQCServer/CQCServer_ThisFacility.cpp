@@ -37,6 +37,26 @@
 RTTIDecls(TFacCQCServer,TCQCSrvCore)
 
 
+// ---------------------------------------------------------------------------
+//  Local types and constants
+// ---------------------------------------------------------------------------
+namespace CQCServer_ThisFacility
+{
+    //
+    //  The most driver loader threads we'll start up at once. See
+    //  StartWorkerThreads().
+    //
+    const tCIDLib::TCard4   c4MaxLoaders = 4;
+
+    //
+    //  How many times a semantic field query over all drivers will start over,
+    //  because the driver list changed, before it just locks for the whole
+    //  query. See c4QuerySemFields().
+    //
+    const tCIDLib::TCard4   c4MaxSemRestarts = 3;
+}
+
+
 
 
 // ---------------------------------------------------------------------------
@@ -66,7 +86,9 @@ TFacCQCServer::TFacCQCServer() :
     , m_c4DriverListId(1)
     , m_c4GC100SerialNum(0)
     , m_c4JAPSerialNum(0)
+    , m_c4NextLoad(0)
     , m_colDriverList(tCIDLib::EAdoptOpts::NoAdopt)
+    , m_colDrvIndex(109, TStringKeyOps(kCIDLib::True), &TDrvIndexEnt::strKey)
     , m_porbsAdmin(nullptr)
     , m_thrMaint
       (
@@ -1127,6 +1149,13 @@ c4QueryDriverIdList2(           tCIDLib::TStrList&  colMonikers
 //  definitions because we are returning a heterogenous list of fields from
 //  potentially different drivers.
 //
+//  The drivers keep their fields indexed by semantic type, so each one only has
+//  to look at its matching fields. And we only hold the overall lock while we
+//  query each driver, not for the whole walk, so that we don't hold up all other
+//  client calls while we go through them all. If the driver list changes while
+//  we are doing that, we just start over. If it keeps changing, after a few tries
+//  we just lock for the whole walk.
+//
 tCIDLib::TCard4
 TFacCQCServer::c4QuerySemFields(const   tCQCKit::TFldSTypeList& fcolTypes
                                 , const tCQCKit::EReqAccess     eReqAccess
@@ -1137,34 +1166,79 @@ TFacCQCServer::c4QuerySemFields(const   tCQCKit::TFldSTypeList& fcolTypes
     colToFill.RemoveAll();
     tCIDLib::TCard4 c4FCnt;
 
-    // Lock while we do this
-    TLocker lockrSync(&m_mtxLock);
-
     // If we are looking for a specific moniker, do that, else check them all
     if (strMoniker.bIsEmpty())
     {
-        const tCIDLib::TCard4 c4Count = m_colDriverList.c4ElemCount();
-        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        tCIDLib::TCard4 c4Restarts = 0;
+        tCIDLib::TBoolean bChanged = kCIDLib::True;
+        while (bChanged && (c4Restarts < CQCServer_ThisFacility::c4MaxSemRestarts))
         {
-            const TServerDriverInfo* psdiCur = psdiFindDrvById
-            (
-                m_c4DriverListId, c4Index
-            );
-            const TCQCServerBase& sdrvCur = psdiCur->sdrvDriver();
+            c4Restarts++;
+            bChanged = kCIDLib::False;
+            colToFill.RemoveAll();
 
-            colFlds.RemoveAll();
-            c4FCnt = sdrvCur.c4QuerySemFields(fcolTypes, eReqAccess, colFlds);
-            for (tCIDLib::TCard4 c4FInd = 0; c4FInd < c4FCnt; c4FInd++)
+            tCIDLib::TCard4 c4ListId;
+            tCIDLib::TCard4 c4Count;
             {
-                colToFill.objAdd
-                (
-                    TCQCDrvFldDef(sdrvCur.strMoniker(), colFlds[c4FInd])
-                );
+                TLocker lockrSync(&m_mtxLock);
+                c4ListId = m_c4DriverListId;
+                c4Count = m_colDriverList.c4ElemCount();
+            }
+
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                TLocker lockrSync(&m_mtxLock);
+                if (m_c4DriverListId != c4ListId)
+                {
+                    bChanged = kCIDLib::True;
+                    break;
+                }
+
+                const TServerDriverInfo* psdiCur = psdiFindDrvById(c4ListId, c4Index);
+                const TCQCServerBase& sdrvCur = psdiCur->sdrvDriver();
+
+                colFlds.RemoveAll();
+                c4FCnt = sdrvCur.c4QuerySemFields(fcolTypes, eReqAccess, colFlds);
+                for (tCIDLib::TCard4 c4FInd = 0; c4FInd < c4FCnt; c4FInd++)
+                {
+                    colToFill.objAdd
+                    (
+                        TCQCDrvFldDef(sdrvCur.strMoniker(), colFlds[c4FInd])
+                    );
+                }
+            }
+        }
+
+        //
+        //  If the list kept changing on us, then just do them all under the lock in
+        //  one go, so that we can't be kept from ever finishing.
+        //
+        if (bChanged)
+        {
+            colToFill.RemoveAll();
+
+            TLocker lockrSync(&m_mtxLock);
+            const tCIDLib::TCard4 c4Count = m_colDriverList.c4ElemCount();
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            {
+                const TCQCServerBase& sdrvCur = m_colDriverList[c4Index]->sdrvDriver();
+
+                colFlds.RemoveAll();
+                c4FCnt = sdrvCur.c4QuerySemFields(fcolTypes, eReqAccess, colFlds);
+                for (tCIDLib::TCard4 c4FInd = 0; c4FInd < c4FCnt; c4FInd++)
+                {
+                    colToFill.objAdd
+                    (
+                        TCQCDrvFldDef(sdrvCur.strMoniker(), colFlds[c4FInd])
+                    );
+                }
             }
         }
     }
      else
     {
+        TLocker lockrSync(&m_mtxLock);
+
         tCIDLib::TCard4 c4Index;
         const TServerDriverInfo* psdiCur = psdiFindDrv(strMoniker, c4Index);
         const TCQCServerBase& sdrvCur = psdiCur->sdrvDriver();
@@ -2823,13 +2897,152 @@ tCIDLib::TVoid TFacCQCServer::StopWorkerThreads()
 //  for the installation server to show up in our prerequisites wait callback, so
 //  it should be there now.
 //
+//  The drivers are loaded by a small pool of loader threads, each of which pulls the
+//  next driver config to load till they are all done. There's no dependency info in
+//  the driver config, so they are all independent as far as we know, and getting each
+//  one going is mostly waiting on the installation server and the library load. So
+//  doing a few at a time gets us up a lot faster when there are many drivers, without
+//  having them all banging away at once. The drivers themselves do their connecting
+//  on their own poll threads, so loading one doesn't wait for its device.
+//
 tCIDLib::TVoid TFacCQCServer::StartWorkerThreads()
 {
+    //
+    //  Get an installation server proxy for the first loader. We do this here, so
+    //  that if we can't get one we fail as before, instead of every loader failing.
+    //  The others get their own, since proxies aren't meant to be shared by threads.
+    //
     tCQCKit::TInstSrvProxy orbcIS = facCQCKit().orbcInstSrvProxy(8000);
+
+    // Start up the loaders, but no more than we have drivers for
+    m_c4NextLoad = 0;
+    const tCIDLib::TCard4 c4LoaderCnt = tCIDLib::MinVal
+    (
+        CQCServer_ThisFacility::c4MaxLoaders, m_colCfgObjs.c4ElemCount()
+    );
+
+    TRefVector<TThread> colLoaders
+    (
+        tCIDLib::EAdoptOpts::Adopt, CQCServer_ThisFacility::c4MaxLoaders
+    );
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4LoaderCnt; c4Index++)
+    {
+        TThread* pthrNew = new TThread
+        (
+            facCIDLib().strNextThreadName(L"CQCSrvDrvLoader")
+            , TMemberFunc<TFacCQCServer>(this, &TFacCQCServer::eLoadThread)
+        );
+        colLoaders.Add(pthrNew);
+        pthrNew->Start(c4Index ? nullptr : &orbcIS);
+    }
+
+    //
+    //  And wait for them to finish. They watch for a shutdown request between drivers,
+    //  so they won't hold us up beyond any driver currently being loaded.
+    //
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4LoaderCnt; c4Index++)
+        colLoaders[c4Index]->eWaitForDeath(kCIDLib::c4MaxWait);
+
+    // If we were asked to shut down, don't bother with the maintenance thread
+    if (bWait(0))
+        return;
+
+    // Start our maintenace thread which scavenges removed drivers
+    m_thrMaint.Start();
+}
+
+
+//
+//  We only do our non-driver stuff here. Each driver also has a faux binding that
+//  provides info about it and that points to our server admin interface. But those
+//  will get dropped when the drivers are unloaded.
+//
+tCIDLib::TVoid TFacCQCServer::UnbindSrvObjs(tCIDOrbUC::TNSrvProxy& orbcNS)
+{
+    // Build up a list of bindings to remove
+    TString  strBinding;
+    tCIDLib::TStrList colToRemove(64UL);
+
+    // Do our driver admin interface
+    strBinding = TCQCSrvAdminServerBase::strAdminScope;
+    strBinding.Append(L'/');
+    strBinding.Append(TSysInfo::strIPHostName());
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TFacCQCServer: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+// If the passed drv list id is not the same as ours, throw and out of sync
+tCIDLib::TVoid
+TFacCQCServer::CheckDrvListId(const tCIDLib::TCard4 c4DriverListId) const
+{
+    if (c4DriverListId != m_c4DriverListId)
+    {
+        ThrowErr
+        (
+            CID_FILE
+            , CID_LINE
+            , kCQCSErrs::errcFld_DrvListOutOfSync
+            , tCIDLib::ESeverities::Failed
+            , tCIDLib::EErrClasses::OutOfSync
+        );
+    }
+}
+
+
+//
+//  The driver loader threads started by StartWorkerThreads run here. The data is the
+//  installation server proxy to use for the first one, and null for the others, which
+//  get their own. We pull the next driver config to load, refresh the base part of its
+//  config from the installation server if it's changed, and load it, until there are
+//  no more or we are asked to shut down.
+//
+tCIDLib::EExitCodes
+TFacCQCServer::eLoadThread(TThread& thrThis, tCIDLib::TVoid* pData)
+{
+    tCQCKit::TInstSrvProxy orbcIS;
+    if (pData)
+        orbcIS = *static_cast<tCQCKit::TInstSrvProxy*>(pData);
+    thrThis.Sync();
+
+    //
+    //  If we have to get our own and can't, then just give up. The other loaders
+    //  will pick up the drivers we would have done.
+    //
+    if (!orbcIS.pobjData())
+    {
+        try
+        {
+            orbcIS = facCQCKit().orbcInstSrvProxy(8000);
+        }
+
+        catch(TError& errToCatch)
+        {
+            if (bShouldLog(errToCatch))
+            {
+                errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+                LogEventObj(errToCatch);
+            }
+            return tCIDLib::EExitCodes::InitFailed;
+        }
+    }
+
     const tCIDLib::TCard4 c4Count = m_colCfgObjs.c4ElemCount();
     TCQCDriverCfg cqcdcLatest;
-    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    while (!bWait(0))
     {
+        // Get the next one to do, if any are left
+        tCIDLib::TCard4 c4Index;
+        {
+            TLocker lockrSync(&m_mtxLock);
+            if (m_c4NextLoad >= c4Count)
+                break;
+            c4Index = m_c4NextLoad++;
+        }
+
         // Get a copy of current config object and let's try to add it
         TCQCDriverObjCfg cqcdcCur = m_colCfgObjs[c4Index];
         try
@@ -2866,15 +3079,8 @@ tCIDLib::TVoid TFacCQCServer::StartWorkerThreads()
                 );
             }
 
+            // This will log each one as it gets loaded and started
             LoadADriver(cqcdcCur);
-
-            //
-            //  Pause a little bit between each one, so that they all aren't trying
-            //  to bang away at the same time getting started. Our parent class
-            //  provides a helper to do this in a shutdown friendly way.
-            //
-            if (bWait(250))
-                return;
         }
 
         catch(TError& errToCatch)
@@ -2915,50 +3121,7 @@ tCIDLib::TVoid TFacCQCServer::StartWorkerThreads()
             }
         }
     }
-
-    // Start our maintenace thread which scavenges removed drivers
-    m_thrMaint.Start();
-}
-
-
-//
-//  We only do our non-driver stuff here. Each driver also has a faux binding that
-//  provides info about it and that points to our server admin interface. But those
-//  will get dropped when the drivers are unloaded.
-//
-tCIDLib::TVoid TFacCQCServer::UnbindSrvObjs(tCIDOrbUC::TNSrvProxy& orbcNS)
-{
-    // Build up a list of bindings to remove
-    TString  strBinding;
-    tCIDLib::TStrList colToRemove(64UL);
-
-    // Do our driver admin interface
-    strBinding = TCQCSrvAdminServerBase::strAdminScope;
-    strBinding.Append(L'/');
-    strBinding.Append(TSysInfo::strIPHostName());
-}
-
-
-
-// ---------------------------------------------------------------------------
-//  TFacCQCServer: Private, non-virtual methods
-// ---------------------------------------------------------------------------
-
-// If the passed drv list id is not the same as ours, throw and out of sync
-tCIDLib::TVoid
-TFacCQCServer::CheckDrvListId(const tCIDLib::TCard4 c4DriverListId) const
-{
-    if (c4DriverListId != m_c4DriverListId)
-    {
-        ThrowErr
-        (
-            CID_FILE
-            , CID_LINE
-            , kCQCSErrs::errcFld_DrvListOutOfSync
-            , tCIDLib::ESeverities::Failed
-            , tCIDLib::EErrClasses::OutOfSync
-        );
-    }
+    return tCIDLib::EExitCodes::Normal;
 }
 
 
@@ -3044,6 +3207,26 @@ TFacCQCServer::eMaintThread(TThread& thrThis, tCIDLib::TVoid*)
 
 
 
+//
+//  Finds the index of the driver with the indicated moniker, or max card if not
+//  found. The moniker index is rebuilt any time the driver list changes, so we
+//  just trust it.
+//
+tCIDLib::TCard4 TFacCQCServer::c4FindDrvIndex(const TString& strMonikerToFind) const
+{
+    const TDrvIndexEnt* pdieFind = m_colDrvIndex.pobjFindByKey(strMonikerToFind);
+    if (!pdieFind)
+        return kCIDLib::c4MaxCard;
+
+    CIDAssert
+    (
+        pdieFind->m_c4Index < m_colDriverList.c4ElemCount()
+        , L"The driver moniker index is out of sync with the driver list"
+    );
+    return pdieFind->m_c4Index;
+}
+
+
 //
 //  Finds the driver with the indicated moniker in our driver list and
 //  returns the index of it as well as a pointer to it.
@@ -3053,18 +3236,9 @@ TFacCQCServer::psdiFindDrv( const   TString&            strMonikerToFind
                             ,       tCIDLib::TCard4&    c4Index
                             , const tCIDLib::TBoolean   bThrowIfNot) const
 {
-    const tCIDLib::TCard4 c4Count = m_colDriverList.c4ElemCount();
-    if (c4Count)
-    {
-        for (c4Index = 0; c4Index < c4Count; c4Index++)
-        {
-            const TServerDriverInfo* psdiCur = m_colDriverList[c4Index];
-
-            // If this is our guy, return the pointer to it
-            if (psdiCur->sdrvDriver().strMoniker() == strMonikerToFind)
-                return psdiCur;
-        }
-    }
+    c4Index = c4FindDrvIndex(strMonikerToFind);
+    if (c4Index != kCIDLib::c4MaxCard)
+        return m_colDriverList[c4Index];
 
     if (bThrowIfNot)
     {
@@ -3091,18 +3265,9 @@ TFacCQCServer::psdiFindDrv( const   TString&            strMonikerToFind
                             ,       tCIDLib::TCard4&    c4Index
                             , const tCIDLib::TBoolean   bThrowIfNot)
 {
-    const tCIDLib::TCard4 c4Count = m_colDriverList.c4ElemCount();
-    if (c4Count)
-    {
-        for (c4Index = 0; c4Index < c4Count; c4Index++)
-        {
-            TServerDriverInfo* psdiCur = m_colDriverList[c4Index];
-
-            // If this is our guy, return the pointer to it
-            if (psdiCur->sdrvDriver().strMoniker() == strMonikerToFind)
-                return psdiCur;
-        }
-    }
+    c4Index = c4FindDrvIndex(strMonikerToFind);
+    if (c4Index != kCIDLib::c4MaxCard)
+        return m_colDriverList[c4Index];
 
     if (bThrowIfNot)
     {
@@ -3161,6 +3326,24 @@ TFacCQCServer::psdiFindDrvById( const   tCIDLib::TCard4 c4DriverListId
 }
 
 
+//
+//  Called any time the driver list is changed, to update the moniker index. The
+//  caller must have the list locked.
+//
+tCIDLib::TVoid TFacCQCServer::RebuildDrvIndex()
+{
+    m_colDrvIndex.RemoveAll();
+    const tCIDLib::TCard4 c4Count = m_colDriverList.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        m_colDrvIndex.objAdd
+        (
+            TDrvIndexEnt(m_colDriverList[c4Index]->sdrvDriver().strMoniker(), c4Index)
+        );
+    }
+}
+
+
 //
 //  Called on startup to register com port factories for anything other
 //  than the default local ports factory.
@@ -821,11 +821,53 @@ class TFacCQCServer : public TCQCSrvCore
 
 
     private :
+        // -------------------------------------------------------------------
+        //  Private types
+        //
+        //  We keep a hash of driver monikers to their index in the driver list,
+        //  so that all of the by name operations don't have to search the list.
+        // -------------------------------------------------------------------
+        class TDrvIndexEnt
+        {
+            public :
+                static const TString& strKey(const TDrvIndexEnt& dieSrc)
+                {
+                    return dieSrc.m_strMoniker;
+                }
+
+                TDrvIndexEnt() :
+
+                    m_c4Index(0)
+                {
+                }
+
+                TDrvIndexEnt(const TString& strMoniker, const tCIDLib::TCard4 c4Index) :
+
+                    m_c4Index(c4Index)
+                    , m_strMoniker(strMoniker)
+                {
+                }
+
+                TDrvIndexEnt(const TDrvIndexEnt&) = default;
+                ~TDrvIndexEnt() = default;
+                TDrvIndexEnt& operator=(const TDrvIndexEnt&) = default;
+
+                tCIDLib::TCard4     m_c4Index;
+                TString             m_strMoniker;
+        };
+        using TDrvIndex = TKeyedHashSet<TDrvIndexEnt, TString, TStringKeyOps>;
+
+
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bWaitDataServer();
 
+        tCIDLib::TCard4 c4FindDrvIndex
+        (
+            const   TString&                strMonikerToFind
+        )   const;
+
         tCIDLib::TVoid CheckDrvListId
         (
             const   tCIDLib::TCard4         c4DriverListId
@@ -836,6 +878,12 @@ class TFacCQCServer : public TCQCSrvCore
             const   TCQCDriverObjCfg&       cqcdcToDel
         );
 
+        tCIDLib::EExitCodes eLoadThread
+        (
+                    TThread&                thrThis
+            ,       tCIDLib::TVoid*         pData
+        );
+
         tCIDLib::EExitCodes eMaintThread
         (
                     TThread&                thrThis
@@ -873,6 +921,8 @@ class TFacCQCServer : public TCQCSrvCore
             , const tCIDLib::TCard4         c4FieldListId = 0
         );
 
+        tCIDLib::TVoid RebuildDrvIndex();
+
         tCIDLib::TVoid RegisterPortFactories();
 
         tCIDLib::TVoid UnloadDeadDrivers();
@@ -900,6 +950,11 @@ class TFacCQCServer : public TCQCSrvCore
         //      last serial number around so that we can pass it back in for the next
         //      read.
         //
+        //  m_c4NextLoad
+        //      During startup, the index in m_colCfgObjs of the next driver config
+        //      to be loaded by the loader threads. They get and bump it under the
+        //      m_mtxLock.
+        //
         //  m_colCfgObjs
         //      The configuration we load. It's a list of driver config objects. We have
         //      to save it for later use when we do the actual driver loading. Once the
@@ -911,6 +966,11 @@ class TFacCQCServer : public TCQCSrvCore
         //      our host and create this list. We also deal with requests from clients
         //      to add, remove, pause, etc... drivers and update this list accordingly.
         //
+        //  m_colDrvIndex
+        //      A hash of driver monikers to their index in m_colDriverList. It is
+        //      rebuilt any time the driver list changes, under the same lock, so
+        //      lookups can trust it and never have to search the list.
+        //
         //  m_gcclPorts
         //      This is the GC-100 port configuration data. We try to load it during
         //      init and register the GC-100 port factory. Any time a client updates
@@ -925,6 +985,11 @@ class TFacCQCServer : public TCQCSrvCore
         //      we'll update this, and pass it on to the JAP port factory we installed
         //      on startup.
         //
+        //  m_mtxFacLoad
+        //      Drivers can be loaded on more than one thread at once, so we use
+        //      this to make sure only one of them at a time is loading a driver
+        //      facility and creating the driver from it. See LoadADriver().
+        //
         //  m_mtxLock
         //      This used for synchronization of the overall driver list or other
         //      things that require complete synchronization of all incoming calls.
@@ -951,10 +1016,13 @@ class TFacCQCServer : public TCQCSrvCore
         tCIDLib::TCard4         m_c4DriverListId;
         tCIDLib::TCard4         m_c4GC100SerialNum;
         tCIDLib::TCard4         m_c4JAPSerialNum;
+        tCIDLib::TCard4         m_c4NextLoad;
         tCQCKit::TDrvCfgList    m_colCfgObjs;
         tCQCServer::TDrvList    m_colDriverList;
+        TDrvIndex               m_colDrvIndex;
         TGC100CfgList           m_gcclPorts;
         TJAPwrCfgList           m_japlPorts;
+        TMutex                  m_mtxFacLoad;
         TMutex                  m_mtxLock;
         TOrbObjId               m_ooidAdmin;
         TCQCSrvAdminImpl*       m_porbsAdmin;
@@ -53,6 +53,24 @@ namespace kCQLogicSrv
     //  the same as the executable name.
     // -----------------------------------------------------------------------
     const tCIDLib::TCh* const   pszEvLogicSrv   = L"CQLogicSrv";
+
+
+    // -----------------------------------------------------------------------
+    //  How often we check the source fields for changes, and how often we give
+    //  the time driven fields a chance to update themselves, in milliseconds.
+    //  Checking for changes is cheap now, since we only check each unique source
+    //  field once and only evaluate the fields that depend on changed ones.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard4   c4ChangeCheckMSs    = 50;
+    constexpr tCIDLib::TCard4   c4TimeTickMSs       = 250;
+
+
+    // -----------------------------------------------------------------------
+    //  If a field is in error after being evaluated, or its evaluation fails,
+    //  we don't evaluate it again till one of its sources changes or this long
+    //  has passed, in milliseconds.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard4   c4ErrRetryMSs       = 5000;
 }
 
 
@@ -61,6 +79,7 @@ namespace kCQLogicSrv
 // ---------------------------------------------------------------------------
 #include    "CQLogicSrv_LSIntfServerBase.hpp"
 #include    "CQLogicSrv_LSIntfImpl.hpp"
+#include    "CQLogicSrv_TSStore.hpp"
 
 
 // ---------------------------------------------------------------------------
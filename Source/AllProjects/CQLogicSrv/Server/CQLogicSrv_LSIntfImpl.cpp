@@ -73,6 +73,32 @@ bQueryGraphSamples( const   TString&                        strFldName
 }
 
 
+tCIDLib::TBoolean TLogicSrvImpl::
+bQueryGraphRange(const  TString&                        strFldName
+                , const tCIDLib::TCard8                 enctStart
+                , const tCIDLib::TCard8                 enctEnd
+                , const tCIDLib::TCard4                 c4MaxPoints
+                ,       tCIDLib::TCard4&                c4Level
+                ,       TFundVector<tCIDLib::TCard8>&   fcolTimes
+                ,       TFundVector<tCIDLib::TFloat4>&  fcolAvgs
+                ,       TFundVector<tCIDLib::TFloat4>&  fcolMins
+                ,       TFundVector<tCIDLib::TFloat4>&  fcolMaxs)
+{
+    return facCQLogicSrv.bQueryGraphRange
+    (
+        strFldName
+        , enctStart
+        , enctEnd
+        , c4MaxPoints
+        , c4Level
+        , fcolTimes
+        , fcolAvgs
+        , fcolMins
+        , fcolMaxs
+    );
+}
+
+
 tCIDLib::TCard4 TLogicSrvImpl::c4QueryGraphFlds(TVector<TString>& colToFill)
 {
     return facCQLogicSrv.c4QueryGraphFlds(colToFill);
@@ -71,6 +71,19 @@ class TLogicSrvImpl : public TLogicSrvServerBase
             ,       TFundVector<tCIDLib::TFloat4>& fcolNewSamples
         )   final;
 
+        tCIDLib::TBoolean bQueryGraphRange
+        (
+            const   TString&                strFldName
+            , const tCIDLib::TCard8         enctStart
+            , const tCIDLib::TCard8         enctEnd
+            , const tCIDLib::TCard4         c4MaxPoints
+            ,       tCIDLib::TCard4&        c4Level
+            ,       TFundVector<tCIDLib::TCard8>& fcolTimes
+            ,       TFundVector<tCIDLib::TFloat4>& fcolAvgs
+            ,       TFundVector<tCIDLib::TFloat4>& fcolMins
+            ,       TFundVector<tCIDLib::TFloat4>& fcolMaxs
+        )   final;
+
         tCIDLib::TCard4 c4QueryGraphFlds
         (
                     TVector<TString>&       colToFill
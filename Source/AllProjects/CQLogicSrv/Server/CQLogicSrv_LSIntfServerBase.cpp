@@ -95,6 +95,42 @@ tCIDLib::TVoid TLogicSrvServerBase::Dispatch(const TString& strMethodName, TOrbC
         orbcToDispatch.strmOut() << c4SerialNum;
         orbcToDispatch.strmOut() << c4NewSamples;
         orbcToDispatch.strmOut() << fcolNewSamples;
+    }
+     else if (strMethodName == L"bQueryGraphRange")
+    {
+        TString strFldName;
+        orbcToDispatch.strmIn() >> strFldName;
+        tCIDLib::TCard8 enctStart;
+        orbcToDispatch.strmIn() >> enctStart;
+        tCIDLib::TCard8 enctEnd;
+        orbcToDispatch.strmIn() >> enctEnd;
+        tCIDLib::TCard4 c4MaxPoints;
+        orbcToDispatch.strmIn() >> c4MaxPoints;
+        tCIDLib::TCard4 c4Level = {};
+        orbcToDispatch.strmIn() >> c4Level;
+        TFundVector<tCIDLib::TCard8> fcolTimes;
+        TFundVector<tCIDLib::TFloat4> fcolAvgs;
+        TFundVector<tCIDLib::TFloat4> fcolMins;
+        TFundVector<tCIDLib::TFloat4> fcolMaxs;
+        tCIDLib::TBoolean retVal = bQueryGraphRange
+        (
+            strFldName
+          , enctStart
+          , enctEnd
+          , c4MaxPoints
+          , c4Level
+          , fcolTimes
+          , fcolAvgs
+          , fcolMins
+          , fcolMaxs
+        );
+        orbcToDispatch.strmOut().Reset();
+        orbcToDispatch.strmOut() << retVal;
+        orbcToDispatch.strmOut() << c4Level;
+        orbcToDispatch.strmOut() << fcolTimes;
+        orbcToDispatch.strmOut() << fcolAvgs;
+        orbcToDispatch.strmOut() << fcolMins;
+        orbcToDispatch.strmOut() << fcolMaxs;
     }
      else if (strMethodName == L"c4QueryGraphFlds")
     {
@@ -54,6 +54,19 @@ class  TLogicSrvServerBase : public TOrbServerBase
             , COP TFundVector<tCIDLib::TFloat4>& fcolNewSamples
         ) = 0;
 
+        virtual tCIDLib::TBoolean bQueryGraphRange
+        (
+            const TString& strFldName
+            , const tCIDLib::TCard8 enctStart
+            , const tCIDLib::TCard8 enctEnd
+            , const tCIDLib::TCard4 c4MaxPoints
+            , CIOP tCIDLib::TCard4& c4Level
+            , COP TFundVector<tCIDLib::TCard8>& fcolTimes
+            , COP TFundVector<tCIDLib::TFloat4>& fcolAvgs
+            , COP TFundVector<tCIDLib::TFloat4>& fcolMins
+            , COP TFundVector<tCIDLib::TFloat4>& fcolMaxs
+        ) = 0;
+
         virtual tCIDLib::TCard4 c4QueryGraphFlds
         (
             COP TVector<TString>& colToFill
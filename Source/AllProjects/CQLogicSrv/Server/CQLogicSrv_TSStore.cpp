@@ -0,0 +1,503 @@
+//
+// FILE NAME: CQLogicSrv_TSStore.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the persistent time series store for graph fields.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+
+
+// ---------------------------------------------------------------------------
+//  Includes
+// ---------------------------------------------------------------------------
+#include    "CQLogicSrv.hpp"
+
+
+
+// ---------------------------------------------------------------------------
+//  Local types and constants
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace CQLogicSrv_TSStore
+    {
+        // -----------------------------------------------------------------------
+        //  The magic value and format version at the start of our files, and the
+        //  extension and sub-directory we use for them.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4           c4Magic = 0xC6A9F105;
+        constexpr tCIDLib::TCard4           c4FmtVer = 1;
+        constexpr const tCIDLib::TCh* const pszDirName = L"LogicSrvGraphs";
+        constexpr const tCIDLib::TCh* const pszFileExt = L"CQLGraph";
+
+
+        // -----------------------------------------------------------------------
+        //  The capacity of each level's ring, and the bucket period of each level.
+        //  This gets us a day of raw samples (at the 10 second sub-sample rate),
+        //  two weeks of minutes, 180 days of hours, and 10 years of days, for a
+        //  bit over a meg per field.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4 ac4Capacities[kCQLogicSh::c4GraphLvlCnt] =
+        {
+            8640, 20160, 4320, 3650
+        };
+
+        const tCIDLib::TEncodedTime aenctPeriods[kCQLogicSh::c4GraphLvlCnt] =
+        {
+            kCQLogicSh::c4SubSamplSecs * kCIDLib::enctOneSecond
+            , kCIDLib::enctOneMinute
+            , kCIDLib::enctOneHour
+            , kCIDLib::enctOneDay
+        };
+
+
+        // -----------------------------------------------------------------------
+        //  The max points we'll return from a range query, and how many records
+        //  we read at a time while doing one.
+        // -----------------------------------------------------------------------
+        constexpr tCIDLib::TCard4   c4MaxQueryPts = 8192;
+        constexpr tCIDLib::TCard4   c4ReadChunk = 256;
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TCQLSrvTSStore
+//  PREFIX: tss
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TCQLSrvTSStore: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TCQLSrvTSStore::TCQLSrvTSStore() :
+
+    m_colSeries(tCIDLib::EAdoptOpts::Adopt, 29, TStringKeyOps(), &TSeries::strKey)
+{
+}
+
+TCQLSrvTSStore::~TCQLSrvTSStore()
+{
+    Close();
+}
+
+
+// ---------------------------------------------------------------------------
+//  TCQLSrvTSStore: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Return the history of a field for the given time range. If the caller passes
+//  the auto level, we pick the finest level that covers the range in no more
+//  than the max points, and which is still likely to have data back that far,
+//  and return the level we used.
+//
+//  We return false if we don't have a series for this field, or the level is
+//  not valid. Else we return true, though we may not have any points to return.
+//
+tCIDLib::TBoolean
+TCQLSrvTSStore::bQueryRange(const   TString&                        strFldName
+                            , const tCIDLib::TEncodedTime           enctStart
+                            , const tCIDLib::TEncodedTime           enctEnd
+                            , const tCIDLib::TCard4                 c4MaxPoints
+                            ,       tCIDLib::TCard4&                c4Level
+                            ,       TFundVector<tCIDLib::TCard8>&   fcolTimes
+                            ,       tCQLogicSh::TSampleList&        fcolAvgs
+                            ,       tCQLogicSh::TSampleList&        fcolMins
+                            ,       tCQLogicSh::TSampleList&        fcolMaxs)
+{
+    fcolTimes.RemoveAll();
+    fcolAvgs.RemoveAll();
+    fcolMins.RemoveAll();
+    fcolMaxs.RemoveAll();
+
+    TSeries* pserSrc = m_colSeries.pobjFindByKey(strFldName);
+    if (!pserSrc)
+        return kCIDLib::False;
+
+    tCIDLib::TCard4 c4MaxPts = c4MaxPoints;
+    if (!c4MaxPts || (c4MaxPts > CQLogicSrv_TSStore::c4MaxQueryPts))
+        c4MaxPts = CQLogicSrv_TSStore::c4MaxQueryPts;
+
+    if (c4Level == kCQLogicSh::c4GraphLvl_Auto)
+    {
+        const tCIDLib::TEncodedTime enctNow = TTime::enctNow();
+        const tCIDLib::TEncodedTime enctSpan = (enctEnd > enctStart) ? enctEnd - enctStart : 0;
+
+        c4Level = kCQLogicSh::c4GraphLvl_Day;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < kCQLogicSh::c4GraphLvlCnt; c4Index++)
+        {
+            const tCIDLib::TEncodedTime enctPer = CQLogicSrv_TSStore::aenctPeriods[c4Index];
+            const tCIDLib::TEncodedTime enctKept
+            (
+                enctPer * CQLogicSrv_TSStore::ac4Capacities[c4Index]
+            );
+
+            if (((enctSpan / enctPer) <= c4MaxPts)
+            &&  ((enctKept >= enctNow) || (enctStart >= enctNow - enctKept)))
+            {
+                c4Level = c4Index;
+                break;
+            }
+        }
+    }
+     else if (c4Level >= kCQLogicSh::c4GraphLvlCnt)
+    {
+        return kCIDLib::False;
+    }
+
+    if (enctEnd < enctStart)
+        return kCIDLib::True;
+
+    //
+    //  For the roll-up levels, back up the start to the start of its bucket, so
+    //  that we get the bucket the start time is within.
+    //
+    tCIDLib::TEncodedTime enctFrom = enctStart;
+    if (c4Level != kCQLogicSh::c4GraphLvl_Raw)
+        enctFrom -= enctFrom % CQLogicSrv_TSStore::aenctPeriods[c4Level];
+
+    // Find the first one at or after that and read forward till we hit the end
+    const TLvlInfo& lvliSrc = pserSrc->m_hdrData.aLevels[c4Level];
+    tCIDLib::TCard4 c4LogIndex = c4FindFirst(*pserSrc, c4Level, enctFrom);
+
+    TRec arecBuf[CQLogicSrv_TSStore::c4ReadChunk];
+    tCIDLib::TBoolean bDone = kCIDLib::False;
+    while (!bDone && (c4LogIndex < lvliSrc.c4Count) && (fcolTimes.c4ElemCount() < c4MaxPts))
+    {
+        const tCIDLib::TCard4 c4Got = c4ReadRecs
+        (
+            *pserSrc, c4Level, c4LogIndex, CQLogicSrv_TSStore::c4ReadChunk, arecBuf
+        );
+        c4LogIndex += c4Got;
+
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Got; c4Index++)
+        {
+            const TRec& recCur = arecBuf[c4Index];
+            if ((recCur.c8Time > enctEnd) || (fcolTimes.c4ElemCount() >= c4MaxPts))
+            {
+                bDone = kCIDLib::True;
+                break;
+            }
+
+            fcolTimes.c4AddElement(recCur.c8Time);
+            fcolAvgs.c4AddElement(tCIDLib::TFloat4(recCur.f8Sum / recCur.c4Count));
+            fcolMins.c4AddElement(recCur.f4Min);
+            fcolMaxs.c4AddElement(recCur.f4Max);
+        }
+    }
+
+    //
+    //  For the roll-up levels, the current bucket is still being accumulated. If
+    //  it's in the range, return it as well so that the caller is up to date.
+    //
+    if (c4Level != kCQLogicSh::c4GraphLvl_Raw)
+    {
+        const TRec& recAccum = lvliSrc.recAccum;
+        if (recAccum.c4Count
+        &&  (recAccum.c8Time >= enctFrom)
+        &&  (recAccum.c8Time <= enctEnd)
+        &&  (fcolTimes.c4ElemCount() < c4MaxPts))
+        {
+            fcolTimes.c4AddElement(recAccum.c8Time);
+            fcolAvgs.c4AddElement(tCIDLib::TFloat4(recAccum.f8Sum / recAccum.c4Count));
+            fcolMins.c4AddElement(recAccum.f4Min);
+            fcolMaxs.c4AddElement(recAccum.f4Max);
+        }
+    }
+    return kCIDLib::True;
+}
+
+
+// Close all our files, which the series objects do when destroyed
+tCIDLib::TVoid TCQLSrvTSStore::Close()
+{
+    m_colSeries.RemoveAll();
+}
+
+
+//
+//  Called when the field configuration is set, to open up the series for the
+//  current graph fields. It's not worth trying to keep ones that are still in
+//  the list, config changes are rare. If one fails to open, we log it and just
+//  don't keep history for that field.
+//
+tCIDLib::TVoid TCQLSrvTSStore::SetFields(const tCIDLib::TStrList& colFldNames)
+{
+    Close();
+
+    // Fault in our directory if not done yet
+    if (m_strDir.bIsEmpty())
+    {
+        TPathStr pathDir(facCQCKit().strRepositoryDir());
+        pathDir.AddLevel(CQLogicSrv_TSStore::pszDirName);
+        TFileSys::MakePath(pathDir);
+        m_strDir = pathDir;
+    }
+
+    TPathStr pathFile;
+    const tCIDLib::TCard4 c4Count = colFldNames.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        const TString& strFldName = colFldNames[c4Index];
+
+        pathFile = m_strDir;
+        pathFile.AddLevel(strFldName);
+        pathFile.AppendExt(CQLogicSrv_TSStore::pszFileExt);
+
+        TJanitor<TSeries> janSeries(new TSeries(strFldName, pathFile));
+        try
+        {
+            OpenSeries(*janSeries.pobjThis());
+            m_colSeries.Add(janSeries.pobjOrphan());
+        }
+
+        catch(TError& errToCatch)
+        {
+            if (facCQLogicSrv.bLogWarnings() && !errToCatch.bLogged())
+            {
+                errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+                TModule::LogEventObj(errToCatch);
+            }
+        }
+    }
+}
+
+
+//
+//  Store a new raw sample for the indicated field. It goes into the raw level,
+//  and is rolled into the accumulators for the other levels. Any whose bucket
+//  has been completed get written out first.
+//
+tCIDLib::TVoid
+TCQLSrvTSStore::StoreSample(const   TString&                strFldName
+                            , const tCIDLib::TEncodedTime   enctAt
+                            , const tCIDLib::TFloat4        f4Value)
+{
+    TSeries* pserTar = m_colSeries.pobjFindByKey(strFldName);
+    if (!pserTar)
+        return;
+
+    //
+    //  If the time has gone backwards (the clock was changed), we just ignore
+    //  samples until we get back into the current minute bucket. Else we'd get
+    //  records out of order, which would break the binary search.
+    //
+    THeader& hdrTar = pserTar->m_hdrData;
+    const TRec& recLastMin = hdrTar.aLevels[kCQLogicSh::c4GraphLvl_Minute].recAccum;
+    if (recLastMin.c4Count && (enctAt < recLastMin.c8Time))
+        return;
+
+    TRec recNew = {};
+    recNew.c8Time = enctAt;
+    recNew.f8Sum = f4Value;
+    recNew.f4Min = f4Value;
+    recNew.f4Max = f4Value;
+    recNew.c4Count = 1;
+    WriteRec(*pserTar, kCQLogicSh::c4GraphLvl_Raw, recNew);
+
+    for (tCIDLib::TCard4 c4Level = kCQLogicSh::c4GraphLvl_Minute;
+                            c4Level < kCQLogicSh::c4GraphLvlCnt; c4Level++)
+    {
+        const tCIDLib::TEncodedTime enctBucket
+        (
+            enctAt - (enctAt % CQLogicSrv_TSStore::aenctPeriods[c4Level])
+        );
+
+        TRec& recAccum = hdrTar.aLevels[c4Level].recAccum;
+        if (recAccum.c4Count && (recAccum.c8Time != enctBucket))
+        {
+            WriteRec(*pserTar, c4Level, recAccum);
+            recAccum.c4Count = 0;
+        }
+
+        if (recAccum.c4Count)
+        {
+            recAccum.f8Sum += f4Value;
+            if (f4Value < recAccum.f4Min)
+                recAccum.f4Min = f4Value;
+            if (f4Value > recAccum.f4Max)
+                recAccum.f4Max = f4Value;
+            recAccum.c4Count++;
+        }
+         else
+        {
+            recAccum = recNew;
+            recAccum.c8Time = enctBucket;
+        }
+    }
+
+    // And store the updated header
+    WriteHeader(*pserTar);
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TCQLSrvTSStore: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Does a binary search of the indicated level's records, to find the logical
+//  index of the first record at or after the indicated time. If there aren't
+//  any, it returns the count.
+//
+tCIDLib::TCard4
+TCQLSrvTSStore::c4FindFirst(        TSeries&                serSrc
+                            , const tCIDLib::TCard4         c4Level
+                            , const tCIDLib::TEncodedTime   enctStart)
+{
+    tCIDLib::TCard4 c4Low = 0;
+    tCIDLib::TCard4 c4High = serSrc.m_hdrData.aLevels[c4Level].c4Count;
+
+    TRec recTest;
+    while (c4Low < c4High)
+    {
+        const tCIDLib::TCard4 c4Mid = c4Low + ((c4High - c4Low) / 2);
+        c4ReadRecs(serSrc, c4Level, c4Mid, 1, &recTest);
+
+        if (recTest.c8Time < enctStart)
+            c4Low = c4Mid + 1;
+        else
+            c4High = c4Mid;
+    }
+    return c4Low;
+}
+
+
+//
+//  Reads up to the max records, starting at the indicated logical index (zero
+//  being the oldest record.) We don't wrap around in one read, so we can return
+//  fewer than are available. We return how many we read.
+//
+tCIDLib::TCard4
+TCQLSrvTSStore::c4ReadRecs(         TSeries&            serSrc
+                            , const tCIDLib::TCard4     c4Level
+                            , const tCIDLib::TCard4     c4LogIndex
+                            , const tCIDLib::TCard4     c4MaxRecs
+                            ,       TRec* const         parecToFill)
+{
+    const TLvlInfo& lvliSrc = serSrc.m_hdrData.aLevels[c4Level];
+    const tCIDLib::TCard4 c4Cap = CQLogicSrv_TSStore::ac4Capacities[c4Level];
+    if (c4LogIndex >= lvliSrc.c4Count)
+        return 0;
+
+    // If not full yet, the oldest is at zero, else it's at the next slot
+    const tCIDLib::TCard4 c4Oldest = (lvliSrc.c4Count < c4Cap) ? 0 : lvliSrc.c4Next;
+    const tCIDLib::TCard4 c4PhysInd = (c4Oldest + c4LogIndex) % c4Cap;
+
+    tCIDLib::TCard4 c4ToRead = lvliSrc.c4Count - c4LogIndex;
+    if (c4ToRead > c4MaxRecs)
+        c4ToRead = c4MaxRecs;
+    if (c4ToRead > c4Cap - c4PhysInd)
+        c4ToRead = c4Cap - c4PhysInd;
+
+    serSrc.m_flData.SetFilePos(c8LevelOfs(c4Level) + (c4PhysInd * sizeof(TRec)));
+    serSrc.m_flData.c4ReadBuffer
+    (
+        parecToFill, c4ToRead * sizeof(TRec), tCIDLib::EAllData::FailIfNotAll
+    );
+    return c4ToRead;
+}
+
+
+// Calculate the file offset of a given level's ring
+tCIDLib::TCard8 TCQLSrvTSStore::c8LevelOfs(const tCIDLib::TCard4 c4Level) const
+{
+    tCIDLib::TCard8 c8Ret = sizeof(THeader);
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Level; c4Index++)
+        c8Ret += tCIDLib::TCard8(CQLogicSrv_TSStore::ac4Capacities[c4Index]) * sizeof(TRec);
+    return c8Ret;
+}
+
+
+//
+//  Open up a series file, creating it if needed, and read in the header. If
+//  it's not valid, we just reset it, since there's nothing else that can be
+//  done and we don't want to stop storing new history.
+//
+tCIDLib::TVoid TCQLSrvTSStore::OpenSeries(TSeries& serTar)
+{
+    serTar.m_flData.Open
+    (
+        tCIDLib::EAccessModes::Excl_ReadWrite
+        , tCIDLib::ECreateActs::OpenOrCreate
+        , tCIDLib::EFilePerms::Default
+        , tCIDLib::EFileFlags::None
+    );
+
+    THeader& hdrTar = serTar.m_hdrData;
+    tCIDLib::TBoolean bGood = kCIDLib::False;
+    if (serTar.m_flData.c8CurSize() >= sizeof(THeader))
+    {
+        serTar.m_flData.SetFilePos(0);
+        serTar.m_flData.c4ReadBuffer
+        (
+            &hdrTar, sizeof(THeader), tCIDLib::EAllData::FailIfNotAll
+        );
+
+        bGood = (hdrTar.c4Magic == CQLogicSrv_TSStore::c4Magic)
+                && (hdrTar.c4FmtVer == CQLogicSrv_TSStore::c4FmtVer);
+
+        for (tCIDLib::TCard4 c4Index = 0; bGood && (c4Index < kCQLogicSh::c4GraphLvlCnt); c4Index++)
+        {
+            const tCIDLib::TCard4 c4Cap = CQLogicSrv_TSStore::ac4Capacities[c4Index];
+            bGood = (hdrTar.aLevels[c4Index].c4Count <= c4Cap)
+                    && (hdrTar.aLevels[c4Index].c4Next < c4Cap);
+        }
+    }
+
+    if (!bGood)
+    {
+        hdrTar = THeader{};
+        hdrTar.c4Magic = CQLogicSrv_TSStore::c4Magic;
+        hdrTar.c4FmtVer = CQLogicSrv_TSStore::c4FmtVer;
+        WriteHeader(serTar);
+    }
+}
+
+
+tCIDLib::TVoid TCQLSrvTSStore::WriteHeader(TSeries& serTar)
+{
+    serTar.m_flData.SetFilePos(0);
+    serTar.m_flData.c4WriteBuffer(&serTar.m_hdrData, sizeof(THeader));
+}
+
+
+//
+//  Write a record to the next slot of the indicated level and move the ring
+//  info forward. The caller writes the header when done.
+//
+tCIDLib::TVoid
+TCQLSrvTSStore::WriteRec(       TSeries&            serTar
+                        , const tCIDLib::TCard4     c4Level
+                        , const TRec&               recToWrite)
+{
+    TLvlInfo& lvliTar = serTar.m_hdrData.aLevels[c4Level];
+    const tCIDLib::TCard4 c4Cap = CQLogicSrv_TSStore::ac4Capacities[c4Level];
+
+    serTar.m_flData.SetFilePos(c8LevelOfs(c4Level) + (lvliTar.c4Next * sizeof(TRec)));
+    serTar.m_flData.c4WriteBuffer(&recToWrite, sizeof(TRec));
+
+    lvliTar.c4Next++;
+    if (lvliTar.c4Next == c4Cap)
+        lvliTar.c4Next = 0;
+    if (lvliTar.c4Count < c4Cap)
+        lvliTar.c4Count++;
+}
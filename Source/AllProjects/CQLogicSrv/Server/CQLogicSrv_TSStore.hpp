@@ -0,0 +1,230 @@
+//
+// FILE NAME: CQLogicSrv_TSStore.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  The graph fields only keep a small in-memory set of samples, which is lost
+//  on restart. This class provides a persistent time series store for them, so
+//  that clients can query long term history.
+//
+//  Each graph field gets a file of its own. The file holds a header and then
+//  four fixed size circular record lists, one per resolution level (raw sub-
+//  samples, minutes, hours, days.) Each record holds the start time of the
+//  bucket and the sum, min, and max values of the samples that went into
+//  it, and the count of samples. Raw records are just single samples.
+//
+//  New raw samples are written to the raw list and rolled into per-level
+//  accumulators for the other levels. When a sample arrives for a new bucket,
+//  the previous accumulated bucket is written out to that level's list. The
+//  accumulators are kept in the header, so partial buckets survive a restart.
+//
+//  Since the lists are fixed size, the files never grow beyond a fixed size and
+//  the oldest data at each level just gets overwritten. The capacities are set
+//  so that we keep a day of raw data, two weeks of minutes, half a year of hours,
+//  and ten years of days. Within each list records are in time order, so range
+//  queries just do a binary search for the start and read forward, and they are
+//  done against the coarsest level that still gives the caller the resolution
+//  they want, so we never have to scan raw samples for long ranges.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1.  Bucket times are UTC based, so the day level buckets are UTC days.
+//
+//  2.  We aren't thread safe. The facility class locks around our use.
+//
+//  3.  Files for fields that are removed or renamed are left in place, so that
+//      history isn't lost if the user puts it back.
+//
+// LOG:
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TCQLSrvTSStore
+//  PREFIX: tss
+// ---------------------------------------------------------------------------
+class TCQLSrvTSStore
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TCQLSrvTSStore();
+
+        TCQLSrvTSStore(const TCQLSrvTSStore&) = delete;
+        TCQLSrvTSStore(TCQLSrvTSStore&&) = delete;
+
+        ~TCQLSrvTSStore();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TCQLSrvTSStore& operator=(const TCQLSrvTSStore&) = delete;
+        TCQLSrvTSStore& operator=(TCQLSrvTSStore&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bQueryRange
+        (
+            const   TString&                strFldName
+            , const tCIDLib::TEncodedTime   enctStart
+            , const tCIDLib::TEncodedTime   enctEnd
+            , const tCIDLib::TCard4         c4MaxPoints
+            ,       tCIDLib::TCard4&        c4Level
+            ,       TFundVector<tCIDLib::TCard8>& fcolTimes
+            ,       tCQLogicSh::TSampleList& fcolAvgs
+            ,       tCQLogicSh::TSampleList& fcolMins
+            ,       tCQLogicSh::TSampleList& fcolMaxs
+        );
+
+        tCIDLib::TVoid Close();
+
+        tCIDLib::TVoid SetFields
+        (
+            const   tCIDLib::TStrList&      colFldNames
+        );
+
+        tCIDLib::TVoid StoreSample
+        (
+            const   TString&                strFldName
+            , const tCIDLib::TEncodedTime   enctAt
+            , const tCIDLib::TFloat4        f4Value
+        );
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private types
+        //
+        //  TRec is the on disk record. We keep the sum and count of samples
+        //  and the average is calculated when queried, so the same record
+        //  works as the accumulator. TLvlInfo is the per-level ring info, and
+        //  the accumulator for that level (not used for the raw level.)
+        //
+        //  TSeries is the runtime info for a single field's file.
+        // -------------------------------------------------------------------
+        struct TRec
+        {
+            tCIDLib::TCard8     c8Time;
+            tCIDLib::TFloat8    f8Sum;
+            tCIDLib::TFloat4    f4Min;
+            tCIDLib::TFloat4    f4Max;
+            tCIDLib::TCard4     c4Count;
+            tCIDLib::TCard4     c4Reserved;
+        };
+
+        struct TLvlInfo
+        {
+            tCIDLib::TCard4     c4Next;
+            tCIDLib::TCard4     c4Count;
+            TRec                recAccum;
+        };
+
+        struct THeader
+        {
+            tCIDLib::TCard4     c4Magic;
+            tCIDLib::TCard4     c4FmtVer;
+            TLvlInfo            aLevels[kCQLogicSh::c4GraphLvlCnt];
+        };
+
+        class TSeries
+        {
+            public :
+                static const TString& strKey(const TSeries& serSrc)
+                {
+                    return serSrc.m_strFldName;
+                }
+
+                TSeries(const TString& strFldName, const TString& strPath) :
+
+                    m_flData(strPath)
+                    , m_strFldName(strFldName)
+                {
+                }
+
+                TSeries(const TSeries&) = delete;
+                TSeries(TSeries&&) = delete;
+                TSeries& operator=(const TSeries&) = delete;
+                TSeries& operator=(TSeries&&) = delete;
+
+                TBinaryFile     m_flData;
+                THeader         m_hdrData;
+                TString         m_strFldName;
+        };
+        using TSeriesList = TRefKeyedHashSet<TSeries, TString, TStringKeyOps>;
+
+
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4 c4FindFirst
+        (
+                    TSeries&                serSrc
+            , const tCIDLib::TCard4         c4Level
+            , const tCIDLib::TEncodedTime   enctStart
+        );
+
+        tCIDLib::TCard4 c4ReadRecs
+        (
+                    TSeries&                serSrc
+            , const tCIDLib::TCard4         c4Level
+            , const tCIDLib::TCard4         c4LogIndex
+            , const tCIDLib::TCard4         c4MaxRecs
+            ,       TRec* const             parecToFill
+        );
+
+        tCIDLib::TCard8 c8LevelOfs
+        (
+            const   tCIDLib::TCard4         c4Level
+        )   const;
+
+        tCIDLib::TVoid OpenSeries
+        (
+                    TSeries&                serTar
+        );
+
+        tCIDLib::TVoid WriteHeader
+        (
+                    TSeries&                serTar
+        );
+
+        tCIDLib::TVoid WriteRec
+        (
+                    TSeries&                serTar
+            , const tCIDLib::TCard4         c4Level
+            , const TRec&                   recToWrite
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_colSeries
+        //      The series we currently have open, keyed by field name.
+        //
+        //  m_strDir
+        //      The directory our files go into. It's under the repository dir.
+        // -------------------------------------------------------------------
+        TSeriesList             m_colSeries;
+        TString                 m_strDir;
+};
+
+#pragma CIDLIB_POPPACK
@@ -63,6 +63,7 @@ TFacCQLogicSrv::TFacCQLogicSrv() :
         , tCQCSrvFW::ESrvOpts::None
     )
     , m_c4CfgSerialNum(1)
+    , m_colSrcDeps(tCIDLib::EAdoptOpts::Adopt, 109, TStringKeyOps(), &TSrcFldDeps::strKey)
     , m_colValues(tCIDLib::EAdoptOpts::Adopt)
     , m_porbsImpl(nullptr)
     , m_strFldCfgPath(L"/Cfg/FieldDefs")
@@ -205,6 +206,39 @@ bQueryGraphSamples( const   TString&                        strFldName
 }
 
 
+//
+//  This is called when a client wants the persistent history of a graph field
+//  over a range of time. We just pass it on to the time series store.
+//
+tCIDLib::TBoolean TFacCQLogicSrv::
+bQueryGraphRange(const  TString&                        strFldName
+                , const tCIDLib::TCard8                 enctStart
+                , const tCIDLib::TCard8                 enctEnd
+                , const tCIDLib::TCard4                 c4MaxPoints
+                ,       tCIDLib::TCard4&                c4Level
+                ,       TFundVector<tCIDLib::TCard8>&   fcolTimes
+                ,       TFundVector<tCIDLib::TFloat4>&  fcolAvgs
+                ,       TFundVector<tCIDLib::TFloat4>&  fcolMins
+                ,       TFundVector<tCIDLib::TFloat4>&  fcolMaxs)
+{
+    // Lock while we do this
+    TLocker lockrLock(&m_mtxLock);
+
+    return m_tssGraphs.bQueryRange
+    (
+        strFldName
+        , enctStart
+        , enctEnd
+        , c4MaxPoints
+        , c4Level
+        , fcolTimes
+        , fcolAvgs
+        , fcolMins
+        , fcolMaxs
+    );
+}
+
+
 //
 //  This is called when a client wants to know all of the graph type fields,
 //  which is basically the Intf. Designer tab for the graph widget, to let
@@ -474,8 +508,9 @@ tCIDLib::TVoid TFacCQLogicSrv::StoreConfig()
         LogEventObj(errToCatch);
     }
 
-    // Close the repo
+    // Close the repo and the graph history files
     m_oseData.Close();
+    m_tssGraphs.Close();
 }
 
 
@@ -483,8 +518,18 @@ tCIDLib::TVoid TFacCQLogicSrv::StoreConfig()
 //  We override this so that we can do other things while mostly blocking on the shutdown
 //  event. Otherwise we'd have to create another thread to do this work.
 //
+//  We wake up often to check for source field changes, but that only checks each
+//  unique source field once and only evaluates the fields that depend on changed
+//  ones. The time driven fields get called on a slower, regular time tick.
+//
 tCIDLib::TVoid TFacCQLogicSrv::WaitForTerm(TEvent& evWait)
 {
+    const tCIDLib::TEncodedTime enctTickPeriod
+    (
+        kCQLogicSrv::c4TimeTickMSs * kCIDLib::enctOneMilliSec
+    );
+    tCIDLib::TEncodedTime enctNextTick = 0;
+
     while(kCIDLib::True)
     {
         try
@@ -494,34 +539,23 @@ tCIDLib::TVoid TFacCQLogicSrv::WaitForTerm(TEvent& evWait)
             //  back true, then it was triggered, which means we were asked
             //  to shut down.
             //
-            if (evWait.bWaitFor(250))
+            if (evWait.bWaitFor(kCQLogicSrv::c4ChangeCheckMSs))
             {
                 break;
             }
              else
             {
-                // Get the hour and minute to pass in
-                TTime tmNow(tCIDLib::ESpecialTimes::CurrentTime);
-                tCIDLib::TCard4 c4Hour;
-                tCIDLib::TCard4 c4Minute;
-                tCIDLib::TCard4 c4Second;
-                tmNow.c4AsTimeInfo(c4Hour, c4Minute, c4Second);
-
-                // Lock while we do this
-                TLocker lockrLock(&m_mtxLock);
-
-                //
-                //  And give each of our pseudo fields a chance to update itself.
-                //  We pass it the polling engine so that it can look up any
-                //  fields it needs to.
-                //
-                tCQLogicSh::TFldList& colFlds = m_lscfgServer.colFldTypes();
-                const tCIDLib::TCard4 c4Count = colFlds.c4ElemCount();
-                for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
-                {
-                    TCQLSrvFldType* pclsftCur = colFlds[c4Index];
-                    pclsftCur->Evaluate(m_polleSrv, c4Hour, c4Minute);
-                }
+                // See if it's time for a time tick
+                const tCIDLib::TEncodedTime enctNow = TTime::enctNow();
+    const tCIDLib::TEncodedTime enctRetryPeriod
+    (
+        kCQLogicSrv::c4ErrRetryMSs * kCIDLib::enctOneMilliSec
+    );
+                const tCIDLib::TBoolean bTimeTick = (enctNow >= enctNextTick);
+                if (bTimeTick)
+                    enctNextTick = enctNow + enctTickPeriod;
+
+                EvalFields(bTimeTick);
             }
         }
 
@@ -582,6 +616,168 @@ tCIDLib::TVoid TFacCQLogicSrv::UnbindSrvObjs(tCIDOrbUC::TNSrvProxy&  orbcNS)
 //  TFacCQLogicSrv: Private, non-virtual methods
 // ---------------------------------------------------------------------------
 
+//
+//  This is called after the fields are registered, to build up our source field
+//  to logic field dependency graph. For each unique source field we register one
+//  watcher with the polling engine, and keep the indices of the fields that use it.
+//  All of the fields start out dirty so that they get an initial evaluation.
+//
+//  The caller has to have the lock.
+//
+tCIDLib::TVoid TFacCQLogicSrv::BuildDepGraph(const TCQCFldCache& cfcInit)
+{
+    m_colSrcDeps.RemoveAll();
+
+    TString strMoniker;
+    TString strField;
+    const tCQLogicSh::TFldList& colFlds = m_lscfgServer.colFldTypes();
+    const tCIDLib::TCard4 c4Count = colFlds.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        const TCQLSrvFldType* pclsftCur = colFlds[c4Index];
+        const tCIDLib::TCard4 c4SrcCnt = pclsftCur->c4SrcFldCount();
+        for (tCIDLib::TCard4 c4SrcInd = 0; c4SrcInd < c4SrcCnt; c4SrcInd++)
+        {
+            const TString& strSrcFld = pclsftCur->strSrcFldAt(c4SrcInd);
+            TSrcFldDeps* psfdCur = m_colSrcDeps.pobjFindByKey(strSrcFld);
+            if (!psfdCur)
+            {
+                facCQCKit().ParseFldName(strSrcFld, strMoniker, strField);
+                psfdCur = new TSrcFldDeps(strMoniker, strField);
+                m_colSrcDeps.Add(psfdCur);
+                psfdCur->m_cfpiWatch.bRegister(m_polleSrv, cfcInit);
+            }
+
+            // The same field could be used more than once by a field
+            const tCIDLib::TCard4 c4DepCnt = psfdCur->m_fcolDependents.c4ElemCount();
+            tCIDLib::TCard4 c4DepInd = 0;
+            for (; c4DepInd < c4DepCnt; c4DepInd++)
+            {
+                if (psfdCur->m_fcolDependents[c4DepInd] == c4Index)
+                    break;
+            }
+            if (c4DepInd == c4DepCnt)
+                psfdCur->m_fcolDependents.c4AddElement(c4Index);
+        }
+    }
+
+    m_fcolDirty.RemoveAll();
+    m_fcolRetryAt.RemoveAll();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        m_fcolDirty.c4AddElement(kCIDLib::True);
+        m_fcolRetryAt.c4AddElement(0);
+    }
+}
+
+
+//
+//  Called from the main thread loop to update our fields. We check each of the
+//  watched source fields for changes and mark their dependents dirty. Then we
+//  evaluate any that are dirty, or are time driven and this is a time tick.
+//
+//  If a field ends up in error, or its evaluation throws, we don't leave it dirty,
+//  else it would be evaluated every round forever. A change in its sources will
+//  make it dirty again. Otherwise it's retried after a while.
+//
+tCIDLib::TVoid TFacCQLogicSrv::EvalFields(const tCIDLib::TBoolean bTimeTick)
+{
+    // Get the hour and minute to pass in
+    TTime tmNow(tCIDLib::ESpecialTimes::CurrentTime);
+    tCIDLib::TCard4 c4Hour;
+    tCIDLib::TCard4 c4Minute;
+    tCIDLib::TCard4 c4Second;
+    tmNow.c4AsTimeInfo(c4Hour, c4Minute, c4Second);
+    const tCIDLib::TEncodedTime enctNow = TTime::enctNow();
+    const tCIDLib::TEncodedTime enctRetryPeriod
+    (
+        kCQLogicSrv::c4ErrRetryMSs * kCIDLib::enctOneMilliSec
+    );
+
+    // Lock while we do this
+    TLocker lockrLock(&m_mtxLock);
+
+    TSrcDepList::TNCCursor cursDeps(&m_colSrcDeps);
+    for (; cursDeps; ++cursDeps)
+    {
+        TSrcFldDeps& sfdCur = *cursDeps;
+        if (sfdCur.m_cfpiWatch.bUpdateValue(m_polleSrv))
+        {
+            const tCIDLib::TCard4 c4DepCnt = sfdCur.m_fcolDependents.c4ElemCount();
+            for (tCIDLib::TCard4 c4DepInd = 0; c4DepInd < c4DepCnt; c4DepInd++)
+                m_fcolDirty[sfdCur.m_fcolDependents[c4DepInd]] = kCIDLib::True;
+        }
+    }
+
+    //
+    //  And give each of our pseudo fields that needs it a chance to update
+    //  itself. We pass it the polling engine so that it can look up any fields
+    //  it needs to.
+    //
+    tCQLogicSh::TFldList& colFlds = m_lscfgServer.colFldTypes();
+    const tCIDLib::TCard4 c4Count = colFlds.c4ElemCount();
+    CIDAssert(m_fcolDirty.c4ElemCount() == c4Count, L"Dirty list is out of sync");
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        TCQLSrvFldType* pclsftCur = colFlds[c4Index];
+        const tCIDLib::TEncodedTime enctRetry = m_fcolRetryAt[c4Index];
+        if (!m_fcolDirty[c4Index]
+        &&  !(bTimeTick && pclsftCur->bAlwaysStore())
+        &&  !(enctRetry && (enctNow >= enctRetry)))
+        {
+            continue;
+        }
+
+        m_fcolDirty[c4Index] = kCIDLib::False;
+        m_fcolRetryAt[c4Index] = 0;
+        tCIDLib::TBoolean bFailed = kCIDLib::False;
+        try
+        {
+            pclsftCur->Evaluate(m_polleSrv, c4Hour, c4Minute);
+            bFailed = pclsftCur->fvCurrent().bInError();
+        }
+
+        catch(TError& errToCatch)
+        {
+            if (bShouldLog(errToCatch))
+            {
+                errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+                TModule::LogEventObj(errToCatch);
+            }
+            TStatsCache::c8IncCounter(m_sciCalcErrors);
+            bFailed = kCIDLib::True;
+        }
+
+        if (bFailed)
+            m_fcolRetryAt[c4Index] = enctNow + enctRetryPeriod;
+
+        // If a graph field took a new sub-sample, add it to the history
+        if (!pclsftCur->bNormalFld() && pclsftCur->bIsA(TCQSLLDGraph::clsThis()))
+        {
+            tCIDLib::TEncodedTime enctAt;
+            tCIDLib::TFloat4 f4Value;
+            TCQSLLDGraph* pclsftGraph = static_cast<TCQSLLDGraph*>(pclsftCur);
+            if (pclsftGraph->bTakeSubSample(f4Value, enctAt))
+            {
+                try
+                {
+                    m_tssGraphs.StoreSample(pclsftCur->strFldName(), enctAt, f4Value);
+                }
+
+                catch(TError& errToCatch)
+                {
+                    if (bShouldLog(errToCatch))
+                    {
+                        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+                        TModule::LogEventObj(errToCatch);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
 //
 //  This is called after we load config or get new config from the admin
 //  interface client, to get the fields set up.
@@ -619,6 +815,32 @@ tCIDLib::TVoid TFacCQLogicSrv::InitFields()
     for (tCIDLib::TCard4 c4Index = 0; c4Index < c4SrcCount; c4Index++)
         colSrcFlds[c4Index]->Initialize(cfcInit);
 
+    // And build up the dependency graph that drives evaluation
+    BuildDepGraph(cfcInit);
+
+    // Open up the history for the graph fields
+    tCIDLib::TStrList colGraphFlds;
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4SrcCount; c4Index++)
+    {
+        const TCQLSrvFldType* pclsftCur = colSrcFlds[c4Index];
+        if (!pclsftCur->bNormalFld() && pclsftCur->bIsA(TCQSLLDGraph::clsThis()))
+            colGraphFlds.objAdd(pclsftCur->strFldName());
+    }
+
+    try
+    {
+        m_tssGraphs.SetFields(colGraphFlds);
+    }
+
+    catch(TError& errToCatch)
+    {
+        if (bShouldLog(errToCatch))
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+        }
+    }
+
     // Set the stats cache item
     TStatsCache::SetValue(m_sciFieldCnt, c4SrcCount);
 }
@@ -36,6 +36,9 @@
 //  We also provide some methods for our implementation of the standard
 //  server admin protocol can call.
 //
+//  And we keep a persistent history of the graph fields' values, see the
+//  TCQLSrvTSStore class.
+//
 // CAVEATS/GOTCHAS:
 //
 // LOG:
@@ -90,6 +93,19 @@ class TFacCQLogicSrv : public TCQCSrvCore
             ,       TFundVector<tCIDLib::TFloat4>& fcolNewSamples
         );
 
+        tCIDLib::TBoolean bQueryGraphRange
+        (
+            const   TString&                strFldName
+            , const tCIDLib::TCard8         enctStart
+            , const tCIDLib::TCard8         enctEnd
+            , const tCIDLib::TCard4         c4MaxPoints
+            ,       tCIDLib::TCard4&        c4Level
+            ,       TFundVector<tCIDLib::TCard8>& fcolTimes
+            ,       TFundVector<tCIDLib::TFloat4>& fcolAvgs
+            ,       TFundVector<tCIDLib::TFloat4>& fcolMins
+            ,       TFundVector<tCIDLib::TFloat4>& fcolMaxs
+        );
+
         tCIDLib::TCard4 c4QueryGraphFlds
         (
                     TVector<TString>&       colToFill
@@ -155,9 +171,52 @@ class TFacCQLogicSrv : public TCQCSrvCore
 
 
     private :
+        // -------------------------------------------------------------------
+        //  Private types
+        //
+        //  For each unique source field referenced by our configured fields, we
+        //  keep one poll info object that we use to watch for changes, and the
+        //  indices of the configured fields that depend on it. So this is our
+        //  source field to logic field dependency graph.
+        // -------------------------------------------------------------------
+        class TSrcFldDeps
+        {
+            public :
+                static const TString& strKey(const TSrcFldDeps& sfdSrc)
+                {
+                    return sfdSrc.m_cfpiWatch.strFullFldName();
+                }
+
+                TSrcFldDeps(const TString& strMoniker, const TString& strField) :
+
+                    m_cfpiWatch(strMoniker, strField)
+                {
+                }
+
+                TSrcFldDeps(const TSrcFldDeps&) = delete;
+                TSrcFldDeps(TSrcFldDeps&&) = delete;
+                TSrcFldDeps& operator=(const TSrcFldDeps&) = delete;
+                TSrcFldDeps& operator=(TSrcFldDeps&&) = delete;
+
+                TCQCFldPollInfo     m_cfpiWatch;
+                tCIDLib::TCardList  m_fcolDependents;
+        };
+        using TSrcDepList = TRefKeyedHashSet<TSrcFldDeps, TString, TStringKeyOps>;
+
+
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid BuildDepGraph
+        (
+            const   TCQCFldCache&           cfcInit
+        );
+
+        tCIDLib::TVoid EvalFields
+        (
+            const   tCIDLib::TBoolean       bTimeTick
+        );
+
         tCIDLib::TVoid InitFields();
 
         tCIDLib::TVoid ProcessRequests();
@@ -171,6 +230,25 @@ class TFacCQLogicSrv : public TCQCSrvCore
         //      has to pass in the last serial number it got, so that we can
         //      tell it if the config has changed.
         //
+        //  m_colSrcDeps
+        //      Our source field dependency graph. Each round we just check each
+        //      unique source field once, and mark the fields that depend on any
+        //      that have changed as dirty. See BuildDepGraph().
+        //
+        //  m_fcolDirty
+        //      A flag per configured field, in the same order, which indicates
+        //      it has to be evaluated on the next round, because one of its
+        //      sources changed. The time driven ones (those that want to be
+        //      always called) are also evaluated on each time tick, whether
+        //      dirty or not.
+        //
+        //  m_fcolRetryAt
+        //      A time per configured field, in the same order. If a field is in
+        //      error after an evaluation, or the evaluation throws, it's no
+        //      longer dirty but we set this so that it's tried again after a
+        //      while, in case it's not a source change that will fix it. Zero
+        //      if not waiting to retry.
+        //
         //  m_lscfgServer
         //      This is our configuration data, which defines the virtual
         //      fields that we provide. And it also provides the means to
@@ -215,10 +293,18 @@ class TFacCQLogicSrv : public TCQCSrvCore
         //
         //  m_strFldCfgPath
         //      The path in our private repo of the field config data
+        //
+        //  m_tssGraphs
+        //      The persistent time series store for our graph fields. After
+        //      each evaluation of a graph field, we pass on any new sub-sample
+        //      to it. Clients query it for history via bQueryGraphRange().
         // -------------------------------------------------------------------
         tCIDLib::TCard4         m_c4CfgSerialNum;
         TCQLogicSrvCfg          m_lscfgServer;
+        TSrcDepList             m_colSrcDeps;
         tCQCKit::TFldValList    m_colValues;
+        TFundVector<tCIDLib::TBoolean> m_fcolDirty;
+        TFundVector<tCIDLib::TEncodedTime> m_fcolRetryAt;
         TCIDObjStore            m_oseData;
         TMutex                  m_mtxLock;
         TOrbObjId               m_ooidAdmin;
@@ -227,6 +313,7 @@ class TFacCQLogicSrv : public TCQCSrvCore
         TStatsCacheItem         m_sciCalcErrors;
         TStatsCacheItem         m_sciFieldCnt;
         const TString           m_strFldCfgPath;
+        TCQLSrvTSStore          m_tssGraphs;
 
 
         // -------------------------------------------------------------------
@@ -78,6 +78,21 @@ namespace kCQLogicSh
     constexpr tCIDLib::TCard4   c4SubSamplSecs = 10;
 
 
+    // -----------------------------------------------------------------------
+    //  The logic server also keeps a persistent history for graph fields, at
+    //  a few resolutions. Raw is the sub-sample rate above, then there are per
+    //  minute, per hour, and per day roll-ups. Clients pass one of these to the
+    //  history range query, or the auto value to let the server pick the finest
+    //  one that will cover the range in the number of points they want.
+    // -----------------------------------------------------------------------
+    constexpr tCIDLib::TCard4   c4GraphLvl_Raw = 0;
+    constexpr tCIDLib::TCard4   c4GraphLvl_Minute = 1;
+    constexpr tCIDLib::TCard4   c4GraphLvl_Hour = 2;
+    constexpr tCIDLib::TCard4   c4GraphLvl_Day = 3;
+    constexpr tCIDLib::TCard4   c4GraphLvlCnt = 4;
+    constexpr tCIDLib::TCard4   c4GraphLvl_Auto = kCIDLib::c4MaxCard;
+
+
     // -----------------------------------------------------------------------
     //  The sample value we store if the field was in error or not available
     // -----------------------------------------------------------------------
@@ -95,10 +95,13 @@ TCQSLLDGraph::TCQSLLDGraph(const TString& strName) :
         , kCIDLib::True
         , 1
     )
+    , m_bNewSub(kCIDLib::False)
     , m_c4Minutes(1)
+    , m_enctLastSub(0)
     , m_enctNextSub(0)
     , m_enctNextSample(0)
     , m_fcolSubSamples(CQLogicSh_GraphFld::c4MaxSubSamples)
+    , m_f4LastSub(0)
     , m_grdatSamples(kCQLogicSh::c4GraphSampleCnt)
 {
 }
@@ -106,10 +109,13 @@ TCQSLLDGraph::TCQSLLDGraph(const TString& strName) :
 TCQSLLDGraph::TCQSLLDGraph(const TCQSLLDGraph& clsftSrc) :
 
     TCQLSrvFldType(clsftSrc)
+    , m_bNewSub(kCIDLib::False)
     , m_c4Minutes(clsftSrc.m_c4Minutes)
+    , m_enctLastSub(0)
     , m_enctNextSub(0)
     , m_enctNextSample(0)
     , m_fcolSubSamples(CQLogicSh_GraphFld::c4MaxSubSamples)
+    , m_f4LastSub(0)
     , m_grdatSamples(kCQLogicSh::c4GraphSampleCnt)
 {
     // The samples and times are runtime only and don't need to be copied
@@ -131,8 +137,11 @@ TCQSLLDGraph& TCQSLLDGraph::operator=(const TCQSLLDGraph& clsftSrc)
         m_c4Minutes   = clsftSrc.m_c4Minutes;
 
         // The samples and times are runtime only and don't need to be copied
+        m_bNewSub = kCIDLib::False;
+        m_enctLastSub = 0;
         m_enctNextSub = 0;
         m_enctNextSample = 0;
+        m_f4LastSub = 0;
         m_fcolSubSamples.RemoveAll();
         m_grdatSamples.Reset(1UL);
     }
@@ -211,6 +220,7 @@ tCIDLib::TVoid TCQSLLDGraph::Initialize(TCQCFldCache& cfcInit)
     //
     m_enctNextSample = TTime::enctNow() + m_enctSamplePeriod;
     m_enctNextSub = 0;
+    m_bNewSub = kCIDLib::False;
 
     // Reset the sample index and clear our lists
     m_fcolSubSamples.RemoveAll();
@@ -243,6 +253,23 @@ TCQSLLDGraph::bQuerySamples(tCIDLib::TCard4&                    c4SerialNum
 }
 
 
+//
+//  The server calls this after each evaluation, to get any new good sub-sample
+//  for its persistent history. We only return each one once.
+//
+tCIDLib::TBoolean
+TCQSLLDGraph::bTakeSubSample(tCIDLib::TFloat4& f4Value, tCIDLib::TEncodedTime& enctAt)
+{
+    if (!m_bNewSub)
+        return kCIDLib::False;
+
+    f4Value = m_f4LastSub;
+    enctAt = m_enctLastSub;
+    m_bNewSub = kCIDLib::False;
+    return kCIDLib::True;
+}
+
+
 // Get/set the minutes value
 tCIDLib::TCard4 TCQSLLDGraph::c4Minutes() const
 {
@@ -264,10 +291,13 @@ tCIDLib::TCard4 TCQSLLDGraph::c4Minutes(const tCIDLib::TCard4 c4ToSet)
 TCQSLLDGraph::TCQSLLDGraph() :
 
     TCQLSrvFldType(kCIDLib::False, kCIDLib::True, 1)
+    , m_bNewSub(kCIDLib::False)
     , m_c4Minutes(1)
+    , m_enctLastSub(0)
     , m_enctNextSub(0)
     , m_enctNextSample(0)
     , m_fcolSubSamples(CQLogicSh_GraphFld::c4MaxSubSamples)
+    , m_f4LastSub(0)
     , m_grdatSamples(kCQLogicSh::c4GraphSampleCnt)
 {
 }
@@ -346,7 +376,14 @@ TCQSLLDGraph::eBuildValue(  const   tCQLogicSh::TInfoList& colFlds
 
             // If we got a good value, then store it
             if (f4NewVal != kCQLogicSh::f4SampleErr)
+            {
                 m_fcolSubSamples.c4AddElement(f4NewVal);
+
+                // And remember it for the server's history
+                m_bNewSub = kCIDLib::True;
+                m_enctLastSub = enctCur;
+                m_f4LastSub = f4NewVal;
+            }
         }
         m_enctNextSub = enctCur + m_enctSubPeriod;
     }
@@ -42,6 +42,11 @@
 //  sub-samples, we know that we need to store a bad value sample. Otherwise,
 //  we can just sample as many as we have.
 //
+//  The server also keeps a persistent history of each graph field's values. It
+//  calls bTakeSubSample() after each evaluation to pick up any new good sub-
+//  sample, which it feeds to its time series store. We just remember the last
+//  one and whether it's been taken yet.
+//
 // CAVEATS/GOTCHAS:
 //
 //  1)  Note that we tell the logic server to call our build value method
@@ -139,6 +144,12 @@ class CQLOGICSHEXPORT TCQSLLDGraph : public TCQLSrvFldType
             ,       tCIDLib::TCard4&        c4NewSamples
         )   const;
 
+        tCIDLib::TBoolean bTakeSubSample
+        (
+                    tCIDLib::TFloat4&       f4Value
+            ,       tCIDLib::TEncodedTime&  enctAt
+        );
+
         tCIDLib::TCard4 c4Minutes() const;
 
         tCIDLib::TCard4 c4Minutes
@@ -180,6 +191,12 @@ class CQLOGICSHEXPORT TCQSLLDGraph : public TCQLSrvFldType
         // -------------------------------------------------------------------
         //  Private data members
         //
+        //  m_bNewSub
+        //  m_enctLastSub
+        //  m_f4LastSub
+        //      The last good sub-sample we took and when, and whether the
+        //      server has taken it yet for its history. Runtime only.
+        //
         //  m_c4Minutes
         //      The number of minutes between samples. This is a user configured
         //      values and persisted.
@@ -204,12 +221,15 @@ class CQLOGICSHEXPORT TCQSLLDGraph : public TCQLSrvFldType
         //      If the source field is in error, we store a special value
         //      which clients will treat as invalid date in any graph display.
         // -------------------------------------------------------------------
+        tCIDLib::TBoolean       m_bNewSub;
         tCIDLib::TCard4         m_c4Minutes;
+        tCIDLib::TEncodedTime   m_enctLastSub;
         tCIDLib::TEncodedTime   m_enctNextSample;
         tCIDLib::TEncodedTime   m_enctNextSub;
         tCIDLib::TEncodedTime   m_enctSamplePeriod;
         tCIDLib::TEncodedTime   m_enctSubPeriod;
         tCQLogicSh::TSampleList m_fcolSubSamples;
+        tCIDLib::TFloat4        m_f4LastSub;
         TGraphData              m_grdatSamples;
 
 
@@ -130,6 +130,49 @@ tCIDLib::TBoolean TLogicSrvClientProxy::bQueryGraphSamples
     return retVal;
 }
 
+tCIDLib::TBoolean TLogicSrvClientProxy::bQueryGraphRange
+(
+    const TString& strFldName
+    , const tCIDLib::TCard8 enctStart
+    , const tCIDLib::TCard8 enctEnd
+    , const tCIDLib::TCard4 c4MaxPoints
+    , CIOP tCIDLib::TCard4& c4Level
+    , COP TFundVector<tCIDLib::TCard8>& fcolTimes
+    , COP TFundVector<tCIDLib::TFloat4>& fcolAvgs
+    , COP TFundVector<tCIDLib::TFloat4>& fcolMins
+    , COP TFundVector<tCIDLib::TFloat4>& fcolMaxs)
+{
+    #pragma warning(suppress : 26494)
+    tCIDLib::TBoolean retVal;
+    TCmdQItem* pcqiToUse = pcqiGetCmdItem(ooidThis().oidKey());
+    TOrbCmd& ocmdToUse = pcqiToUse->ocmdData();
+    try
+    {
+        ocmdToUse.strmOut() << TString(L"bQueryGraphRange");
+        ocmdToUse.strmOut() << strFldName;
+        ocmdToUse.strmOut() << enctStart;
+        ocmdToUse.strmOut() << enctEnd;
+        ocmdToUse.strmOut() << c4MaxPoints;
+        ocmdToUse.strmOut() << c4Level;
+        Dispatch(30000, pcqiToUse);
+        ocmdToUse.strmIn().Reset();
+        ocmdToUse.strmIn() >> retVal;
+        ocmdToUse.strmIn() >> c4Level;
+        ocmdToUse.strmIn() >> fcolTimes;
+        ocmdToUse.strmIn() >> fcolAvgs;
+        ocmdToUse.strmIn() >> fcolMins;
+        ocmdToUse.strmIn() >> fcolMaxs;
+        GiveBackCmdItem(pcqiToUse);
+    }
+    catch(TError& errToCatch)
+    {
+        GiveBackCmdItem(pcqiToUse);
+        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+        throw;
+    }
+    return retVal;
+}
+
 tCIDLib::TCard4 TLogicSrvClientProxy::c4QueryGraphFlds
 (
     COP TVector<TString>& colToFill)
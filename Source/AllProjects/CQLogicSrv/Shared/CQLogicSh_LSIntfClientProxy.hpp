@@ -67,6 +67,19 @@ class CQLOGICSHEXPORT TLogicSrvClientProxy : public TOrbClientBase
             , COP TFundVector<tCIDLib::TFloat4>& fcolNewSamples
         );
 
+        tCIDLib::TBoolean bQueryGraphRange
+        (
+            const TString& strFldName
+            , const tCIDLib::TCard8 enctStart
+            , const tCIDLib::TCard8 enctEnd
+            , const tCIDLib::TCard4 c4MaxPoints
+            , CIOP tCIDLib::TCard4& c4Level
+            , COP TFundVector<tCIDLib::TCard8>& fcolTimes
+            , COP TFundVector<tCIDLib::TFloat4>& fcolAvgs
+            , COP TFundVector<tCIDLib::TFloat4>& fcolMins
+            , COP TFundVector<tCIDLib::TFloat4>& fcolMaxs
+        );
+
         tCIDLib::TCard4 c4QueryGraphFlds
         (
             COP TVector<TString>& colToFill
@@ -204,19 +204,26 @@ TCQSLLDMath::TNode::~TNode()
 }
 
 
-// Some helpers to get the current value, cast to the indicated type
-tCIDLib::TCard4 TCQSLLDMath::TNode::c4AsCard() const
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TCQSLLDMath::TValue
+//  PREFIX: val
+// ---------------------------------------------------------------------------
+
+// Some helpers to get a value, cast to the indicated type
+tCIDLib::TCard4 TCQSLLDMath::TValue::c4AsCard() const
 {
-    switch(m_eFldType)
+    switch(eFldType)
     {
         case tCQCKit::EFldTypes::Card :
-            return m_c4Value;
+            return c4Value;
 
         case tCQCKit::EFldTypes::Float :
-            return tCIDLib::TCard4(m_f8Value);
+            return tCIDLib::TCard4(f8Value);
 
         case tCQCKit::EFldTypes::Int :
-            return tCIDLib::TCard4(m_i4Value);
+            return tCIDLib::TCard4(i4Value);
     };
 
     // We shouldn't get here
@@ -224,18 +231,18 @@ tCIDLib::TCard4 TCQSLLDMath::TNode::c4AsCard() const
     return 0;
 }
 
-tCIDLib::TFloat8 TCQSLLDMath::TNode::f8AsFloat() const
+tCIDLib::TFloat8 TCQSLLDMath::TValue::f8AsFloat() const
 {
-    switch(m_eFldType)
+    switch(eFldType)
     {
         case tCQCKit::EFldTypes::Card :
-            return tCIDLib::TFloat8(m_c4Value);
+            return tCIDLib::TFloat8(c4Value);
 
         case tCQCKit::EFldTypes::Float :
-            return m_f8Value;
+            return f8Value;
 
         case tCQCKit::EFldTypes::Int :
-            return tCIDLib::TFloat8(m_i4Value);
+            return tCIDLib::TFloat8(i4Value);
     };
 
     // We shouldn't get here
@@ -243,18 +250,18 @@ tCIDLib::TFloat8 TCQSLLDMath::TNode::f8AsFloat() const
     return 0;
 }
 
-tCIDLib::TInt4 TCQSLLDMath::TNode::i4AsInt() const
+tCIDLib::TInt4 TCQSLLDMath::TValue::i4AsInt() const
 {
-    switch(m_eFldType)
+    switch(eFldType)
     {
         case tCQCKit::EFldTypes::Card :
-            return tCIDLib::TInt4(m_c4Value);
+            return tCIDLib::TInt4(c4Value);
 
         case tCQCKit::EFldTypes::Float :
-            return tCIDLib::TInt4(m_f8Value);
+            return tCIDLib::TInt4(f8Value);
 
         case tCQCKit::EFldTypes::Int :
-            return m_i4Value;
+            return i4Value;
     };
 
     // We shouldn't get here
@@ -263,257 +270,6 @@ tCIDLib::TInt4 TCQSLLDMath::TNode::i4AsInt() const
 }
 
 
-//
-//  Handles recursive evaluation of the value. We drill down to the terminal
-//  nodes, then start building back up and combining.
-//
-tCIDLib::TVoid TCQSLLDMath::TNode::Evaluate(const tCQLogicSh::TInfoList& colVals)
-{
-    if (m_pnodeLeft && !m_pnodeRight)
-    {
-        //
-        //  This one operates on a single child node, which may be a single factor or
-        //  a whole tree. So ask it to evaluate itself recursively before we do our thing.
-        //
-        m_pnodeLeft->Evaluate(colVals);
-
-        // Perform our configured operation on the result
-        switch(m_eType)
-        {
-            case ENodeTypes::Abs :
-                m_f8Value = TMathLib::f8Abs(m_pnodeLeft->f8AsFloat());
-                break;
-
-            case ENodeTypes::Cosine :
-                m_f8Value = TMathLib::f8Cosine(m_pnodeLeft->f8AsFloat());
-                break;
-
-            case ENodeTypes::NLog :
-                m_f8Value = TMathLib::f8Log(m_pnodeLeft->f8AsFloat());
-                break;
-
-            case ENodeTypes::Sine :
-                m_f8Value = TMathLib::f8Sine(m_pnodeLeft->f8AsFloat());
-                break;
-
-            case ENodeTypes::SqRoot :
-                m_f8Value = TMathLib::f8SqrRoot(m_pnodeLeft->f8AsFloat());
-                break;
-
-            case ENodeTypes::ToCard :
-                m_c4Value = m_pnodeLeft->c4AsCard();
-                break;
-
-            case ENodeTypes::ToFloat :
-                m_f8Value = m_pnodeLeft->f8AsFloat();
-                break;
-
-            case ENodeTypes::ToInt :
-                m_i4Value = m_pnodeLeft->i4AsInt();
-                break;
-
-            default :
-                CIDAssert2(L"Unknown function node type");
-                break;
-        }
-    }
-     else if (m_pnodeLeft && m_pnodeRight)
-    {
-        //
-        //  We are a left/right operation type of node, so ask both of
-        //  our contained nodes to evaluate themselves. This includes
-        //  functions that have two parameters, as well as operators.
-        //
-        m_pnodeLeft->Evaluate(colVals);
-        m_pnodeRight->Evaluate(colVals);
-
-        //
-        //  For some operations we figure out our data type based on the
-        //  children. For others, it's fixed.
-        //
-        switch(m_eType)
-        {
-            case ENodeTypes::Add :
-            case ENodeTypes::Div :
-            case ENodeTypes::ModDiv :
-            case ENodeTypes::Mul :
-            case ENodeTypes::Sub :
-                if ((m_pnodeLeft->m_eFldType == tCQCKit::EFldTypes::Float)
-                ||  (m_pnodeRight->m_eFldType == tCQCKit::EFldTypes::Float))
-                {
-                    m_eFldType = tCQCKit::EFldTypes::Float;
-                }
-                 else if ((m_pnodeLeft->m_eFldType == tCQCKit::EFldTypes::Int)
-                      ||  (m_pnodeRight->m_eFldType == tCQCKit::EFldTypes::Int))
-                {
-                    m_eFldType = tCQCKit::EFldTypes::Int;
-                }
-                 else
-                {
-                    m_eFldType = tCQCKit::EFldTypes::Card;
-                }
-                break;
-
-            case ENodeTypes::AND :
-            case ENodeTypes::OR :
-            case ENodeTypes::XOR :
-                m_eFldType = tCQCKit::EFldTypes::Card;
-                break;
-
-            case ENodeTypes::Power :
-                m_eFldType = tCQCKit::EFldTypes::Float;
-                break;
-
-            default :
-                CIDAssert2(L"Node is not op type");
-                break;
-        };
-
-        //
-        //  And combine their values appropriately to create our value,
-        //  depending on the type we decided on above.
-        //
-        if (m_eFldType == tCQCKit::EFldTypes::Card)
-        {
-            const tCIDLib::TCard4 c4Left = m_pnodeLeft->c4AsCard();
-            const tCIDLib::TCard4 c4Right = m_pnodeRight->c4AsCard();
-            switch(m_eType)
-            {
-                case ENodeTypes::Add :
-                    m_c4Value = c4Left + c4Right;
-                    break;
-
-                case ENodeTypes::Div :
-                    m_c4Value = c4Left / c4Right;
-                    break;
-
-                case ENodeTypes::ModDiv :
-                    m_c4Value = c4Left % c4Right;
-                    break;
-
-                case ENodeTypes::Mul :
-                    m_c4Value = c4Left * c4Right;
-                    break;
-
-                case ENodeTypes::Sub :
-                    m_c4Value = c4Left - c4Right;
-                    break;
-
-                case ENodeTypes::AND :
-                    m_c4Value = c4Left & c4Right;
-                    break;
-
-                case ENodeTypes::OR :
-                    m_c4Value = c4Left | c4Right;
-                    break;
-
-                case ENodeTypes::XOR :
-                    m_c4Value = c4Left ^ c4Right;
-                    break;
-
-                default :
-                    CIDAssert2(L"Node is not op type");
-                    break;
-            };
-        }
-         else if (m_eFldType == tCQCKit::EFldTypes::Float)
-        {
-            const tCIDLib::TFloat8 f8Left = m_pnodeLeft->f8AsFloat();
-            const tCIDLib::TFloat8 f8Right = m_pnodeRight->f8AsFloat();
-            switch(m_eType)
-            {
-                case ENodeTypes::Add :
-                    m_f8Value = f8Left + f8Right;
-                    break;
-
-                case ENodeTypes::Div :
-                    m_f8Value = f8Left / f8Right;
-                    break;
-
-                case ENodeTypes::ModDiv :
-                    m_f8Value = TMathLib::f8Mod(f8Left, f8Right);
-                    break;
-
-                case ENodeTypes::Mul :
-                    m_f8Value = f8Left * f8Right;
-                    break;
-
-                case ENodeTypes::Power :
-                    m_f8Value = TMathLib::f8Power(f8Left, f8Right);
-                    break;
-
-                case ENodeTypes::Sub :
-                    m_f8Value = f8Left - f8Right;
-                    break;
-
-                default :
-                    CIDAssert2(L"Node is not op type");
-                    break;
-            };
-        }
-         else if (m_eFldType == tCQCKit::EFldTypes::Int)
-        {
-            const tCIDLib::TInt4 i4Left = m_pnodeLeft->i4AsInt();
-            const tCIDLib::TInt4 i4Right = m_pnodeRight->i4AsInt();
-            switch(m_eType)
-            {
-                case ENodeTypes::Add :
-                    m_i4Value = i4Left + i4Right;
-                    break;
-
-                case ENodeTypes::Div :
-                    m_i4Value = i4Left / i4Right;
-                    break;
-
-                case ENodeTypes::ModDiv :
-                    m_i4Value = i4Left % i4Right;
-                    break;
-
-                case ENodeTypes::Mul :
-                    m_i4Value = i4Left * i4Right;
-                    break;
-
-                case ENodeTypes::Sub :
-                    m_i4Value = i4Left - i4Right;
-                    break;
-
-                default :
-                    CIDAssert2(L"Node is not op type");
-                    break;
-            };
-        }
-         else
-        {
-            CIDAssert2(L"Non-numeric field type seen");
-        }
-    }
-     else if (m_eType == ENodeTypes::FldRef)
-    {
-        // We are a field ref. So set our value and type to the field's
-        const TCQCFldPollInfo& cfpiUs = colVals[m_c4FldIndex];
-        m_eFldType = cfpiUs.flddAssoc().eType();
-        switch(m_eFldType)
-        {
-            case tCQCKit::EFldTypes::Card :
-                m_c4Value = static_cast<const TCQCCardFldValue&>(cfpiUs.fvCurrent()).c4Value();
-                break;
-
-            case tCQCKit::EFldTypes::Float :
-                m_f8Value = static_cast<const TCQCFloatFldValue&>(cfpiUs.fvCurrent()).f8Value();
-                break;
-
-            case tCQCKit::EFldTypes::Int :
-                m_i4Value = static_cast<const TCQCIntFldValue&>(cfpiUs.fvCurrent()).i4Value();
-                break;
-
-            default :
-                CIDAssert2(L"Non-numeric field type seen");
-                break;
-        };
-    }
-}
-
-
 
 
 
@@ -528,23 +284,33 @@ tCIDLib::TVoid TCQSLLDMath::TNode::Evaluate(const tCQLogicSh::TInfoList& colVals
 TCQSLLDMath::TCQSLLDMath(const TString& strName, const tCQCKit::EFldTypes eType) :
 
     TCQLSrvFldType(strName, eType, tCQCKit::EFldAccess::Read)
-    , m_pnodeRoot(nullptr)
+    , m_c4CodeCnt(0)
+    , m_c4SlotCnt(0)
+    , m_c4StackSz(0)
+    , m_chPush(kCIDLib::chNull)
+    , m_painstrCode(nullptr)
+    , m_pavalStack(nullptr)
 {
 }
 
 TCQSLLDMath::TCQSLLDMath(const TCQSLLDMath& clsftSrc) :
 
     TCQLSrvFldType(clsftSrc)
-    , m_pnodeRoot(nullptr)
+    , m_c4CodeCnt(0)
+    , m_c4SlotCnt(0)
+    , m_c4StackSz(0)
+    , m_chPush(kCIDLib::chNull)
+    , m_painstrCode(nullptr)
+    , m_pavalStack(nullptr)
     , m_strFormula(clsftSrc.m_strFormula)
 {
+    // The compiled code is runtime only and doesn't need to be copied
 }
 
 TCQSLLDMath::~TCQSLLDMath()
 {
-    // Clean up our evaluation tree
-    delete m_pnodeRoot;
-    m_pnodeRoot = nullptr;
+    // Clean up our compiled code
+    ClearCode();
 }
 
 
@@ -558,9 +324,8 @@ TCQSLLDMath& TCQSLLDMath::operator=(const TCQSLLDMath& clsftSrc)
         TParent::operator=(clsftSrc);
         m_strFormula = clsftSrc.m_strFormula;
 
-        // Clean up our evaluation tree
-        delete m_pnodeRoot;
-        m_pnodeRoot = nullptr;
+        // Clean up our compiled code
+        ClearCode();
     }
     return *this;
 }
@@ -654,18 +419,21 @@ TCQCFldFilter* TCQSLLDMath::pffiltToUse()
 //
 //  Parses the formula and returns a success or failure. This is used by
 //  the client side to do validation. On the server side it is used to create
-//  the tree for value evaluation. In theory it can't fail on the server side
-//  since the client won't let them save one that doesn' parse.
+//  the compiled code for value evaluation. In theory it can't fail on the
+//  server side since the client won't let them save one that doesn' parse.
+//
+//  We parse to a tree, then compile the tree to our instruction list, and the
+//  tree is dropped.
 //
 tCIDLib::TBoolean TCQSLLDMath::bParseExpression(TString& strError)
 {
     // Start the recusrive parsing process
     TTextStringInStream strmSrc(&m_strFormula);
+    TNode* pnodeRoot = nullptr;
     try
     {
-        // Clean up any existing tree
-        delete m_pnodeRoot;
-        m_pnodeRoot = nullptr;
+        // Clean up any existing code
+        ClearCode();
 
         // Clear the pushback char
         m_chPush = kCIDLib::chNull;
@@ -689,7 +457,7 @@ tCIDLib::TBoolean TCQSLLDMath::bParseExpression(TString& strError)
         //  a single field reference of literal value. So we indicate that
         //  it can be a factor.
         //
-        m_pnodeRoot = pnodeParseClause(strmSrc, kCIDLib::True);
+        pnodeRoot = pnodeParseClause(strmSrc, kCIDLib::True);
 
         //
         //  Now just keep looking forward for another op. If we get one, then
@@ -707,7 +475,7 @@ tCIDLib::TBoolean TCQSLLDMath::bParseExpression(TString& strError)
             TNode* pnodeRight = pnodeParseFactor(strmSrc);
 
             // And create a new root that includes these
-            m_pnodeRoot = new TNode(eType, m_pnodeRoot, pnodeRight);
+            pnodeRoot = new TNode(eType, pnodeRoot, pnodeRight);
         }
 
         // If we saw an open paren, we have to see a close one
@@ -728,13 +496,29 @@ tCIDLib::TBoolean TCQSLLDMath::bParseExpression(TString& strError)
                 , tCIDLib::EErrClasses::Format
             );
         }
+
+        //
+        //  Compile the tree. Figure out how many instructions there will be,
+        //  since there's one per node, and allocate the list. The compile will
+        //  tell us the max stack depth, and we allocate the stack then.
+        //
+        m_c4CodeCnt = c4CountNodes(*pnodeRoot);
+        m_painstrCode = new TInstr[m_c4CodeCnt];
+        m_c4CodeCnt = 0;
+
+        tCIDLib::TCard4 c4Depth = 0;
+        CompileNode(*pnodeRoot, c4Depth);
+        m_pavalStack = new TValue[m_c4StackSz];
+
+        // And we don't need the tree anymore
+        delete pnodeRoot;
     }
 
     catch(const TError& errTCatch)
     {
-        // Clean up the tree we built
-        delete m_pnodeRoot;
-        m_pnodeRoot = nullptr;
+        // Clean up the tree we built and any partial code
+        delete pnodeRoot;
+        ClearCode();
 
         // Give the caller back the error text
         strError = errTCatch.strErrText();
@@ -748,7 +532,7 @@ tCIDLib::TBoolean TCQSLLDMath::bParseExpression(TString& strError)
 //
 //  Get/set the formula string. The set is only ever called from the client
 //  side driver during config, so we don't have to worry about updating the
-//  evaluation tree.
+//  compiled code.
 //
 const TString& TCQSLLDMath::strFormula() const
 {
@@ -770,7 +554,12 @@ const TString& TCQSLLDMath::strFormula(const TString& strToSet)
 TCQSLLDMath::TCQSLLDMath() :
 
     TCQLSrvFldType()
-    , m_pnodeRoot(nullptr)
+    , m_c4CodeCnt(0)
+    , m_c4SlotCnt(0)
+    , m_c4StackSz(0)
+    , m_chPush(kCIDLib::chNull)
+    , m_painstrCode(nullptr)
+    , m_pavalStack(nullptr)
 {
 }
 
@@ -787,9 +576,8 @@ TCQSLLDMath::TCQSLLDMath() :
 //  the caller checked, in which case an exception will be thrown and the
 //  caller has to deal with it.
 //
-//  We make a recursive call on the root node that will do a depth first
-//  evaluation of all the nodes. Field ref nodes will have their type set
-//  as they are evaluated, to match that of the field.
+//  We just run our compiled code, and the result is left on the bottom of
+//  the stack.
 //
 tCQLogicSh::EEvalRes
 TCQSLLDMath::eBuildValue(const  tCQLogicSh::TInfoList&  colVals
@@ -798,14 +586,14 @@ TCQSLLDMath::eBuildValue(const  tCQLogicSh::TInfoList&  colVals
                         , const tCIDLib::TCard4         )
 {
     //
-    //  If the pointer is null, then we couldn't parse the formula for
-    //  some reason, so we indicate failure
+    //  If no code, then we couldn't parse the formula for some reason, so we
+    //  indicate failure
     //
-    if (!m_pnodeRoot)
+    if (!m_c4CodeCnt)
         return tCQLogicSh::EEvalRes::Error;
 
-    // Ask the root to evaluate
-    m_pnodeRoot->Evaluate(colVals);
+    // Run the code
+    const TValue& valRes = valRunCode(colVals);
 
     // And get the resulting value as our type and put it into the value
     tCIDLib::TBoolean bChanged = kCIDLib::False;
@@ -814,21 +602,21 @@ TCQSLLDMath::eBuildValue(const  tCQLogicSh::TInfoList&  colVals
         case tCQCKit::EFldTypes::Card :
             bChanged = static_cast<TCQCCardFldValue&>(fldvToFill).bSetValue
             (
-                m_pnodeRoot->c4AsCard()
+                valRes.c4AsCard()
             );
             break;
 
         case tCQCKit::EFldTypes::Float :
             bChanged = static_cast<TCQCFloatFldValue&>(fldvToFill).bSetValue
             (
-                m_pnodeRoot->f8AsFloat()
+                valRes.f8AsFloat()
             );
             break;
 
         case tCQCKit::EFldTypes::Int :
             bChanged = static_cast<TCQCIntFldValue&>(fldvToFill).bSetValue
             (
-                m_pnodeRoot->i4AsInt()
+                valRes.i4AsInt()
             );
             break;
 
@@ -895,6 +683,170 @@ tCIDLib::TVoid TCQSLLDMath::StreamTo(TBinOutStream& strmToWriteTo) const
 //  TCQSLLDMath: Private, non-virtual methods
 // ---------------------------------------------------------------------------
 
+//
+//  Applies a two operand operation. The result replaces the left value. For
+//  some operations we figure out the result type from the operands, based on
+//  the field types at this point. For others it's fixed.
+//
+tCIDLib::TVoid
+TCQSLLDMath::ApplyBinOp(const   TNode::ENodeTypes   eOp
+                        ,       TValue&             valLeft
+                        , const TValue&             valRight) const
+{
+    tCQCKit::EFldTypes eResType = tCQCKit::EFldTypes::Card;
+    switch(eOp)
+    {
+        case TNode::ENodeTypes::Add :
+        case TNode::ENodeTypes::Div :
+        case TNode::ENodeTypes::ModDiv :
+        case TNode::ENodeTypes::Mul :
+        case TNode::ENodeTypes::Sub :
+            if ((valLeft.eFldType == tCQCKit::EFldTypes::Float)
+            ||  (valRight.eFldType == tCQCKit::EFldTypes::Float))
+            {
+                eResType = tCQCKit::EFldTypes::Float;
+            }
+             else if ((valLeft.eFldType == tCQCKit::EFldTypes::Int)
+                  ||  (valRight.eFldType == tCQCKit::EFldTypes::Int))
+            {
+                eResType = tCQCKit::EFldTypes::Int;
+            }
+             else
+            {
+                eResType = tCQCKit::EFldTypes::Card;
+            }
+            break;
+
+        case TNode::ENodeTypes::AND :
+        case TNode::ENodeTypes::OR :
+        case TNode::ENodeTypes::XOR :
+            eResType = tCQCKit::EFldTypes::Card;
+            break;
+
+        case TNode::ENodeTypes::Power :
+            eResType = tCQCKit::EFldTypes::Float;
+            break;
+
+        default :
+            CIDAssert2(L"Instruction is not op type");
+            break;
+    };
+
+    if (eResType == tCQCKit::EFldTypes::Card)
+    {
+        const tCIDLib::TCard4 c4Left = valLeft.c4AsCard();
+        const tCIDLib::TCard4 c4Right = valRight.c4AsCard();
+        switch(eOp)
+        {
+            case TNode::ENodeTypes::Add :
+                valLeft.c4Value = c4Left + c4Right;
+                break;
+
+            case TNode::ENodeTypes::Div :
+                valLeft.c4Value = c4Left / c4Right;
+                break;
+
+            case TNode::ENodeTypes::ModDiv :
+                valLeft.c4Value = c4Left % c4Right;
+                break;
+
+            case TNode::ENodeTypes::Mul :
+                valLeft.c4Value = c4Left * c4Right;
+                break;
+
+            case TNode::ENodeTypes::Sub :
+                valLeft.c4Value = c4Left - c4Right;
+                break;
+
+            case TNode::ENodeTypes::AND :
+                valLeft.c4Value = c4Left & c4Right;
+                break;
+
+            case TNode::ENodeTypes::OR :
+                valLeft.c4Value = c4Left | c4Right;
+                break;
+
+            case TNode::ENodeTypes::XOR :
+                valLeft.c4Value = c4Left ^ c4Right;
+                break;
+
+            default :
+                CIDAssert2(L"Instruction is not op type");
+                break;
+        };
+    }
+     else if (eResType == tCQCKit::EFldTypes::Float)
+    {
+        const tCIDLib::TFloat8 f8Left = valLeft.f8AsFloat();
+        const tCIDLib::TFloat8 f8Right = valRight.f8AsFloat();
+        switch(eOp)
+        {
+            case TNode::ENodeTypes::Add :
+                valLeft.f8Value = f8Left + f8Right;
+                break;
+
+            case TNode::ENodeTypes::Div :
+                valLeft.f8Value = f8Left / f8Right;
+                break;
+
+            case TNode::ENodeTypes::ModDiv :
+                valLeft.f8Value = TMathLib::f8Mod(f8Left, f8Right);
+                break;
+
+            case TNode::ENodeTypes::Mul :
+                valLeft.f8Value = f8Left * f8Right;
+                break;
+
+            case TNode::ENodeTypes::Power :
+                valLeft.f8Value = TMathLib::f8Power(f8Left, f8Right);
+                break;
+
+            case TNode::ENodeTypes::Sub :
+                valLeft.f8Value = f8Left - f8Right;
+                break;
+
+            default :
+                CIDAssert2(L"Instruction is not op type");
+                break;
+        };
+    }
+     else if (eResType == tCQCKit::EFldTypes::Int)
+    {
+        const tCIDLib::TInt4 i4Left = valLeft.i4AsInt();
+        const tCIDLib::TInt4 i4Right = valRight.i4AsInt();
+        switch(eOp)
+        {
+            case TNode::ENodeTypes::Add :
+                valLeft.i4Value = i4Left + i4Right;
+                break;
+
+            case TNode::ENodeTypes::Div :
+                valLeft.i4Value = i4Left / i4Right;
+                break;
+
+            case TNode::ENodeTypes::ModDiv :
+                valLeft.i4Value = i4Left % i4Right;
+                break;
+
+            case TNode::ENodeTypes::Mul :
+                valLeft.i4Value = i4Left * i4Right;
+                break;
+
+            case TNode::ENodeTypes::Sub :
+                valLeft.i4Value = i4Left - i4Right;
+                break;
+
+            default :
+                CIDAssert2(L"Instruction is not op type");
+                break;
+        };
+    }
+
+    // The left value is now the result
+    valLeft.eFldType = eResType;
+}
+
+
 //
 //  Checks that the next character is the indicated one, and eats it if so.
 //  If not, it either returns false or throws, depending on the bMustBe parm.
@@ -1005,6 +957,21 @@ TCQSLLDMath::bParseOp(          TTextStringInStream&    strmSrc
 
 
 
+//
+//  Returns the number of nodes in the tree under (and including) the passed
+//  node, which is how many instructions it will compile to.
+//
+tCIDLib::TCard4 TCQSLLDMath::c4CountNodes(const TNode& nodeSrc) const
+{
+    tCIDLib::TCard4 c4Ret = 1;
+    if (nodeSrc.m_pnodeLeft)
+        c4Ret += c4CountNodes(*nodeSrc.m_pnodeLeft);
+    if (nodeSrc.m_pnodeRight)
+        c4Ret += c4CountNodes(*nodeSrc.m_pnodeRight);
+    return c4Ret;
+}
+
+
 // Return the next available character
 tCIDLib::TCh
 TCQSLLDMath::chGetNext(         TTextStringInStream&    strmSrc
@@ -1080,6 +1047,86 @@ tCIDLib::TCh TCQSLLDMath::chGetDigit(TTextStringInStream& strmSrc)
 }
 
 
+// Clean up any compiled code and reset the code info
+tCIDLib::TVoid TCQSLLDMath::ClearCode()
+{
+    delete [] m_painstrCode;
+    m_painstrCode = nullptr;
+    delete [] m_pavalStack;
+    m_pavalStack = nullptr;
+
+    m_c4CodeCnt = 0;
+    m_c4SlotCnt = 0;
+    m_c4StackSz = 0;
+}
+
+
+//
+//  A recursive method that compiles the parse tree into our instruction list.
+//  We do a depth first traversal, so the operands of each operation are on the
+//  stack by the time it runs. We track the stack depth as we go, to know how
+//  big a stack we need.
+//
+//  Field refs are mapped to slots, one per unique field referenced.
+//
+tCIDLib::TVoid
+TCQSLLDMath::CompileNode(const TNode& nodeSrc, tCIDLib::TCard4& c4Depth)
+{
+    if (nodeSrc.m_pnodeLeft)
+        CompileNode(*nodeSrc.m_pnodeLeft, c4Depth);
+    if (nodeSrc.m_pnodeRight)
+        CompileNode(*nodeSrc.m_pnodeRight, c4Depth);
+
+    TInstr& instrNew = m_painstrCode[m_c4CodeCnt++];
+    instrNew.eOp = nodeSrc.m_eType;
+    instrNew.c4Slot = 0;
+    instrNew.valLit = TValue{};
+
+    if (nodeSrc.m_pnodeLeft && nodeSrc.m_pnodeRight)
+    {
+        // Pops two and pushes the result
+        c4Depth--;
+    }
+     else if (nodeSrc.m_pnodeLeft)
+    {
+        // A function. It replaces the top of stack with a value of its type
+        instrNew.valLit.eFldType = nodeSrc.m_eFldType;
+    }
+     else
+    {
+        // A terminal, so it pushes a value
+        if (nodeSrc.m_eType == TNode::ENodeTypes::FldRef)
+        {
+            tCIDLib::TCard4 c4SlotInd = 0;
+            for (; c4SlotInd < m_c4SlotCnt; c4SlotInd++)
+            {
+                if (m_ac4SlotFlds[c4SlotInd] == nodeSrc.m_c4FldIndex)
+                    break;
+            }
+
+            if (c4SlotInd == m_c4SlotCnt)
+                m_ac4SlotFlds[m_c4SlotCnt++] = nodeSrc.m_c4FldIndex;
+            instrNew.c4Slot = c4SlotInd;
+        }
+         else
+        {
+            instrNew.valLit.eFldType = nodeSrc.m_eFldType;
+            if (nodeSrc.m_eFldType == tCQCKit::EFldTypes::Card)
+                instrNew.valLit.c4Value = nodeSrc.m_c4Value;
+            else if (nodeSrc.m_eFldType == tCQCKit::EFldTypes::Float)
+                instrNew.valLit.f8Value = nodeSrc.m_f8Value;
+            else
+                instrNew.valLit.i4Value = nodeSrc.m_i4Value;
+        }
+
+        c4Depth++;
+        if (c4Depth > m_c4StackSz)
+            m_c4StackSz = c4Depth;
+    }
+}
+
+
+
 //
 //  A recursive method that parses the formula and builds the evaluation
 //  tree. At this point we have to be dealing with a clause. So we parse a
@@ -1516,3 +1563,120 @@ tCIDLib::TVoid TCQSLLDMath::SkipSpace(TTextStringInStream& strmSrc)
 }
 
 
+//
+//  Runs our compiled code and returns the result, which is left at the bottom
+//  of the stack. We first load up the field slots from the source fields. The
+//  field types are picked up here since they could change (if the field is
+//  redefined), and the operations figure out their result types based on the
+//  types of their operands as they go.
+//
+const TCQSLLDMath::TValue&
+TCQSLLDMath::valRunCode(const tCQLogicSh::TInfoList& colVals)
+{
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c4SlotCnt; c4Index++)
+    {
+        const TCQCFldPollInfo& cfpiCur = colVals[m_ac4SlotFlds[c4Index]];
+        TValue& valSlot = m_avalSlots[c4Index];
+        valSlot.eFldType = cfpiCur.flddAssoc().eType();
+        switch(valSlot.eFldType)
+        {
+            case tCQCKit::EFldTypes::Card :
+                valSlot.c4Value = static_cast<const TCQCCardFldValue&>(cfpiCur.fvCurrent()).c4Value();
+                break;
+
+            case tCQCKit::EFldTypes::Float :
+                valSlot.f8Value = static_cast<const TCQCFloatFldValue&>(cfpiCur.fvCurrent()).f8Value();
+                break;
+
+            case tCQCKit::EFldTypes::Int :
+                valSlot.i4Value = static_cast<const TCQCIntFldValue&>(cfpiCur.fvCurrent()).i4Value();
+                break;
+
+            default :
+                CIDAssert2(L"Non-numeric field type seen");
+                break;
+        };
+    }
+
+    tCIDLib::TCard4 c4SP = 0;
+    for (tCIDLib::TCard4 c4IP = 0; c4IP < m_c4CodeCnt; c4IP++)
+    {
+        const TInstr& instrCur = m_painstrCode[c4IP];
+        switch(instrCur.eOp)
+        {
+            case TNode::ENodeTypes::Float :
+            case TNode::ENodeTypes::Signed :
+            case TNode::ENodeTypes::Unsigned :
+                m_pavalStack[c4SP++] = instrCur.valLit;
+                break;
+
+            case TNode::ENodeTypes::FldRef :
+                m_pavalStack[c4SP++] = m_avalSlots[instrCur.c4Slot];
+                break;
+
+            case TNode::ENodeTypes::Abs :
+            case TNode::ENodeTypes::Cosine :
+            case TNode::ENodeTypes::NLog :
+            case TNode::ENodeTypes::Sine :
+            case TNode::ENodeTypes::SqRoot :
+            case TNode::ENodeTypes::ToCard :
+            case TNode::ENodeTypes::ToFloat :
+            case TNode::ENodeTypes::ToInt :
+            {
+                // Functions replace the top of stack with a value of their type
+                TValue& valTop = m_pavalStack[c4SP - 1];
+                const TValue valArg = valTop;
+                valTop.eFldType = instrCur.valLit.eFldType;
+                switch(instrCur.eOp)
+                {
+                    case TNode::ENodeTypes::Abs :
+                        valTop.f8Value = TMathLib::f8Abs(valArg.f8AsFloat());
+                        break;
+
+                    case TNode::ENodeTypes::Cosine :
+                        valTop.f8Value = TMathLib::f8Cosine(valArg.f8AsFloat());
+                        break;
+
+                    case TNode::ENodeTypes::NLog :
+                        valTop.f8Value = TMathLib::f8Log(valArg.f8AsFloat());
+                        break;
+
+                    case TNode::ENodeTypes::Sine :
+                        valTop.f8Value = TMathLib::f8Sine(valArg.f8AsFloat());
+                        break;
+
+                    case TNode::ENodeTypes::SqRoot :
+                        valTop.f8Value = TMathLib::f8SqrRoot(valArg.f8AsFloat());
+                        break;
+
+                    case TNode::ENodeTypes::ToCard :
+                        valTop.c4Value = valArg.c4AsCard();
+                        break;
+
+                    case TNode::ENodeTypes::ToFloat :
+                        valTop.f8Value = valArg.f8AsFloat();
+                        break;
+
+                    case TNode::ENodeTypes::ToInt :
+                        valTop.i4Value = valArg.i4AsInt();
+                        break;
+
+                    default :
+                        break;
+                };
+                break;
+            }
+
+            default :
+            {
+                // Everything else is a two operand op
+                c4SP--;
+                ApplyBinOp(instrCur.eOp, m_pavalStack[c4SP - 1], m_pavalStack[c4SP]);
+                break;
+            }
+        };
+    }
+
+    CIDAssert(c4SP == 1, L"The math field evaluation stack is out of sync");
+    return m_pavalStack[0];
+}
@@ -27,6 +27,15 @@
 //  give back the result. The expression is parsed into a simple tree graph
 //  that eventually resolves down to literal values or field tokens.
 //
+//  The tree is only used during parsing though. Once parsed, it is compiled
+//  into a flat list of stack machine instructions, in depth first order, and
+//  that's what we run at evaluation time. So evaluation is just a loop over
+//  an array with no recursion or pointer chasing. The field refs are resolved
+//  to a small set of slots, one per unique source field used, and each slot
+//  is loaded once per evaluation, no matter how many times it's referenced.
+//  Since we are only parsed when the configuration is loaded, we are only
+//  compiled then as well.
+//
 //  The expression has to at least have start and end parens, so the minimal
 //  expression is something like "(x + y)" (without quotes) which simplifies
 //  the parsing a lot, and insures that the root node will always be an
@@ -135,6 +144,9 @@ class CQLOGICSHEXPORT TCQSLLDMath : public TCQLSrvFldType
         //  The terminal nodes can be a literal or a field ref. If a literal
         //  we store the value and the type. If a field ref, the type is
         //  determined at evaluation time based on the field type.
+        //
+        //  This is only used during parsing, and then compiled down to our
+        //  instruction list.
         // -------------------------------------------------------------------
         class TNode
         {
@@ -216,17 +228,6 @@ class CQLOGICSHEXPORT TCQSLLDMath : public TCQLSrvFldType
                 TNode& operator=(const TNode&) = delete;
                 TNode& operator=(TNode&&) = delete;
 
-                tCIDLib::TVoid Evaluate
-                (
-                    const   tCQLogicSh::TInfoList& colVals
-                );
-
-                tCIDLib::TCard4 c4AsCard() const;
-
-                tCIDLib::TFloat8 f8AsFloat() const;
-
-                tCIDLib::TInt4 i4AsInt() const;
-
 
                 tCIDLib::TCard4     m_c4FldIndex;
                 tCIDLib::TCard4     m_c4Value;
@@ -268,9 +269,48 @@ class CQLOGICSHEXPORT TCQSLLDMath : public TCQLSrvFldType
 
 
     private :
+        // -------------------------------------------------------------------
+        //  Private types
+        //
+        //  TValue is a typed value on the evaluation stack (or in a field
+        //  slot.) The type is Card, Int or Float, and says which value is
+        //  the valid one.
+        //
+        //  TInstr is a compiled instruction. The op is the node type it was
+        //  compiled from. For literals the value is the literal. For functions
+        //  the value's type is the fixed result type. For field refs the slot
+        //  is the index of the field slot to push.
+        // -------------------------------------------------------------------
+        struct TValue
+        {
+            tCIDLib::TCard4 c4AsCard() const;
+            tCIDLib::TFloat8 f8AsFloat() const;
+            tCIDLib::TInt4 i4AsInt() const;
+
+            tCQCKit::EFldTypes  eFldType;
+            tCIDLib::TCard4     c4Value;
+            tCIDLib::TFloat8    f8Value;
+            tCIDLib::TInt4      i4Value;
+        };
+
+        struct TInstr
+        {
+            TNode::ENodeTypes   eOp;
+            tCIDLib::TCard4     c4Slot;
+            TValue              valLit;
+        };
+
+
         // -------------------------------------------------------------------
         //  Private, non-virtual methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid ApplyBinOp
+        (
+            const   TNode::ENodeTypes       eOp
+            ,       TValue&                 valLeft
+            , const TValue&                 valRight
+        )   const;
+
         tCIDLib::TBoolean bParseOp
         (
                     TTextStringInStream&    strmSrc
@@ -285,6 +325,11 @@ class CQLOGICSHEXPORT TCQSLLDMath : public TCQLSrvFldType
             , const tCIDLib::TBoolean       bThrowIfNot = kCIDLib::True
         );
 
+        tCIDLib::TCard4 c4CountNodes
+        (
+            const   TNode&                  nodeSrc
+        )   const;
+
         tCIDLib::TCh chGetDigit
         (
                     TTextStringInStream&    strmSrc
@@ -301,6 +346,14 @@ class CQLOGICSHEXPORT TCQSLLDMath : public TCQLSrvFldType
                     TTextStringInStream&    strmSrc
         );
 
+        tCIDLib::TVoid ClearCode();
+
+        tCIDLib::TVoid CompileNode
+        (
+            const   TNode&                  nodeSrc
+            ,       tCIDLib::TCard4&        c4Depth
+        );
+
         [[nodiscard]] TNode* pnodeParseClause
         (
                     TTextStringInStream&    strmSrc
@@ -328,29 +381,53 @@ class CQLOGICSHEXPORT TCQSLLDMath : public TCQLSrvFldType
                     TTextStringInStream&    strmSrc
         );
 
+        const TValue& valRunCode
+        (
+            const   tCQLogicSh::TInfoList&  colVals
+        );
+
 
         // -------------------------------------------------------------------
         //  Private data members
         //
+        //  m_ac4SlotFlds
+        //  m_avalSlots
+        //  m_c4SlotCnt
+        //      The field slots. For each unique source field the expression
+        //      references, we store the source field index and a value that
+        //      is loaded from the field at the start of each evaluation.
+        //
+        //  m_c4CodeCnt
+        //  m_painstrCode
+        //      Our compiled instructions. If the count is zero, we either have
+        //      not been parsed, or the parse failed.
+        //
+        //  m_c4StackSz
+        //  m_pavalStack
+        //      The evaluation stack. The compiler works out how deep it can
+        //      get, so we allocate it then and never have to check at runtime.
+        //
         //  m_chPush
         //      We need a place to push back a character to be seen upstream
         //      after returning back from a method. If null, nothing has been
         //      pushed back. chNext() will check this first and return it, else
         //      get another.
         //
-        //  m_pnodeRoot
-        //      The root of our expression tree. It represents the top-most
-        //      clause.
-        //
         //  m_strFormula
-        //      The formula string that we parse to build our tree. This is
-        //      the only persisted value.
+        //      The formula string that we parse and compile. This is the only
+        //      persisted value.
         //
         //  m_strTmp
         //      For tmp use, parsing out stuff
         // -------------------------------------------------------------------
+        tCIDLib::TCard4 m_ac4SlotFlds[kCQLogicSh::c4MaxSrcFields];
+        TValue          m_avalSlots[kCQLogicSh::c4MaxSrcFields];
+        tCIDLib::TCard4 m_c4CodeCnt;
+        tCIDLib::TCard4 m_c4SlotCnt;
+        tCIDLib::TCard4 m_c4StackSz;
         tCIDLib::TCh    m_chPush;
-        TNode*          m_pnodeRoot;
+        TInstr*         m_painstrCode;
+        TValue*         m_pavalStack;
         TString         m_strFormula;
         TString         m_strTmp;
 
@@ -759,6 +759,9 @@ TMainFrameWnd::bSelectRepo( const   TWindow&            wndOwner
     m_mrsCurrent = mrsNew;
     m_strRepoMoniker = strNewRepo;
 
+    // Remember what it looked like as downloaded, so we can check for changes
+    HashDB(m_strDBHash);
+
     // If asked to reload, then do that
     if (bReload)
     {
@@ -821,20 +824,15 @@ tCIDLib::TVoid TMainFrameWnd::CheckSaveChanges()
     if (m_strDBSerialNum.bIsEmpty())
         return;
 
-    TString strTestSerNum;
-    {
-        tCIDLib::TCard4 c4DBSize;
-        TChunkedBinOutStream strmTar(32 * (1024 * 1024));
-        strmTar << m_mdbEdit << kCIDLib::FlushIt;
-        c4DBSize = strmTar.c4CurSize();
-
-        // Hash this data to create our database serial number
-        TChunkedBinInStream strmSrc(strmTar);
-        facCQCMedia().CreatePersistentId(strmSrc, c4DBSize, strTestSerNum);
-    }
+    //
+    //  Compare against the hash we took when it was downloaded. The server's serial
+    //  number isn't always the hash of the DB content.
+    //
+    TString strTestHash;
+    HashDB(strTestHash);
 
-    // If the serial number is different, then ask if we should change them
-    if (strTestSerNum != m_strDBSerialNum)
+    // If the hash is different, then ask if we should save them
+    if (strTestHash != m_strDBHash)
     {
         TYesNoBox msgbSave
         (
@@ -848,6 +846,23 @@ tCIDLib::TVoid TMainFrameWnd::CheckSaveChanges()
 }
 
 
+//
+//  Flattens and hashes the database we are editing, the same way the server does to
+//  create a serial number for an uploaded one. We do this when it's downloaded, and
+//  again later to see if there are any changes.
+//
+tCIDLib::TVoid TMainFrameWnd::HashDB(TString& strToFill) const
+{
+    tCIDLib::TCard4 c4DBSize;
+    TChunkedBinOutStream strmTar(32 * (1024 * 1024));
+    strmTar << m_mdbEdit << kCIDLib::FlushIt;
+    c4DBSize = strmTar.c4CurSize();
+
+    TChunkedBinInStream strmSrc(strmTar);
+    facCQCMedia().CreatePersistentId(strmSrc, c4DBSize, strToFill);
+}
+
+
 //
 //  Loads the indicated art id and sets it on our static image widget. We have
 //  some special concerns here. We cache image data in the database until the user
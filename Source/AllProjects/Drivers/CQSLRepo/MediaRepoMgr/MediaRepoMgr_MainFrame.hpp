@@ -215,6 +215,11 @@ class TMainFrameWnd : public TFrameWnd
 
         tCIDLib::TVoid GetLease();
 
+        tCIDLib::TVoid HashDB
+        (
+                    TString&                strToFill
+        )   const;
+
         tCIDLib::TVoid LoadArt
         (
             const   tCQCMedia::EMediaTypes  eMType
@@ -317,6 +322,12 @@ class TMainFrameWnd : public TFrameWnd
         //      Typed pointers to our child widgets we need to interact with
         //      in a type specific way. We don't own them.
         //
+        //  m_strDBHash
+        //      When we download a new repo, we hash the database as downloaded, so
+        //      that we can check if the user has changed it. We can't just compare
+        //      against the serial number, since the server doesn't always update it
+        //      to the hash of the DB (e.g. for journaled rating changes.)
+        //
         //  m_strDBSerialNum
         //      when we download a new repo, we store the DB serial number so that
         //      we can check to see if it has actually changed since the last time
@@ -365,6 +376,7 @@ class TMainFrameWnd : public TFrameWnd
         TStaticText*            m_pwndTitle;
         TListBox*               m_pwndTitleList;
         TStaticText*            m_pwndYear;
+        TString                 m_strDBHash;
         TString                 m_strDBSerialNum;
         TString                 m_strLeaseId;
         TString                 m_strRepoMoniker;
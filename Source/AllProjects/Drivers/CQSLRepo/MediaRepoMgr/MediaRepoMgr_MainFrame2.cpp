@@ -840,6 +840,7 @@ tCIDLib::TVoid TMainFrameWnd::SendChanges()
             m_eMTFlags = eMTFlags;
             m_strRepoPath = strRepoPath;
             m_strDBSerialNum = strDBSerNum;
+            HashDB(m_strDBHash);
         }
     }
 
@@ -178,6 +178,7 @@ TCQSLRepoSDriver::TCQSLRepoSDriver(const TCQCDriverObjCfg& cqcdcToLoad) :
     , m_c4FldId_Status(kCIDLib::c4MaxCard)
     , m_c4FldId_ReloadDB(kCIDLib::c4MaxCard)
     , m_c4FldId_TitleCnt(kCIDLib::c4MaxCard)
+    , m_c4JrnlCnt(0)
     , m_enctLastClientLease(0)
     , m_eUplState(EUplStates::Idle)
     , m_ippnUpload(23482)
@@ -328,8 +329,8 @@ TCQSLRepoSDriver::c4SendCmd(const TString& strCmd, const TString& strParms)
             TMediaDB& mdbTar = m_srdbEngine.mdbInfo();
             mdbTar.pmtsSetTitleRating(c2TitleId, eMType, c4Rating);
 
-            // And update the stored database and serial number
-            StoreDBChanges();
+            // And journal the change and update the serial number
+            StoreTitleRating(c2TitleId, eMType, c4Rating);
         }
     }
      else
@@ -560,6 +561,9 @@ tCIDLib::TBoolean TCQSLRepoSDriver::bWaitConfig(TThread&)
         }
          else
         {
+            // Apply any changes journaled since the database was last written out
+            ReplayJournal(mdbTmp, strDBSerNum);
+
             //
             //  Do a check to make sure that all of the internal media files (the ones
             //  we ripped, currently music files) have location info paths that are
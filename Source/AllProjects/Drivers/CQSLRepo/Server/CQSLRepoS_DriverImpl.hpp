@@ -419,6 +419,14 @@ class TCQSLRepoSDriver : public TCQCStdMediaRepoDrv
 
         tCIDLib::TVoid RenewNSLease();
 
+        tCIDLib::TVoid ReplayJournal
+        (
+                    TMediaDB&               mdbTar
+            ,       TString&                strDBSerNum
+        );
+
+        tCIDLib::TVoid ResetJournal();
+
         tCIDLib::TVoid SendError
         (
                     TServerStreamSocket&    sockUpload
@@ -457,6 +465,13 @@ class TCQSLRepoSDriver : public TCQCStdMediaRepoDrv
             ,       TPathStr&               pathTar
         );
 
+        tCIDLib::TVoid StoreTitleRating
+        (
+            const   tCIDLib::TCard2         c2TitleId
+            , const tCQCMedia::EMediaTypes  eMType
+            , const tCIDLib::TCard4         c4Rating
+        );
+
 
         //
         //  These are only for pre-4.4.912 compatibilty, to load the data
@@ -485,6 +500,10 @@ class TCQSLRepoSDriver : public TCQCStdMediaRepoDrv
         //      We look up the ids of our fields after registering them, so that we
         //      can do efficient 'by id' reads/writes.
         //
+        //  m_c4JrnlCnt
+        //      The number of records in the change journal. When it hits a max
+        //      we write out the whole database again, which resets the journal.
+        //
         //  m_c4UploadCookie
         //      When we get a request to start an upload, we give them back a cookie.
         //      They have to pass this back in on the other socket that is used for
@@ -510,6 +529,12 @@ class TCQSLRepoSDriver : public TCQCStdMediaRepoDrv
         //      uploads new data or if individual DB changes are sent (such as a
         //      dynamic update of title rating.)
         //
+        //  m_pathJrnlFile
+        //      The path to the change journal, which is the DB file name with _Jrnl
+        //      appended. Dynamic changes (such as title rating) are appended to this,
+        //      instead of writing out the whole DB file. It is replayed when the DB
+        //      is loaded, and is reset any time the DB file is written out.
+        //
         //  m_pathStartPath
         //      We get the top of the path to search as one of the driver prompts when
         //      we are loaded. This is the root path of the repo directory.
@@ -569,12 +594,14 @@ class TCQSLRepoSDriver : public TCQCStdMediaRepoDrv
         tCIDLib::TCard4         m_c4FldId_Status;
         tCIDLib::TCard4         m_c4FldId_ReloadDB;
         tCIDLib::TCard4         m_c4FldId_TitleCnt;
+        tCIDLib::TCard4         m_c4JrnlCnt;
         tCIDLib::TEncodedTime   m_enctLastClientLease;
         EUplStates              m_eUplState;
         tCIDLib::TIPPortNum     m_ippnUpload;
         TMutex                  m_mtxSync;
         TCQSLMediaRepoEng       m_srdbEngine;
         TPathStr                m_pathDBFile;
+        TPathStr                m_pathJrnlFile;
         TPathStr                m_pathStart;
         TPathStr                m_pathUpload;
         TCQSLRepoMgrImpl*       m_porbsMgrIntf;
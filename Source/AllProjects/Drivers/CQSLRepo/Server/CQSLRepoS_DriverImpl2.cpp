@@ -39,6 +39,18 @@
 namespace CQSLRepoS_DriverImpl
 {
     const tCIDLib::TCard2   c2DBFmtVersion = 1;
+
+    //
+    //  The format version of the records in the change journal, and the max number
+    //  of records we'll let it get to before we write out the whole database again
+    //  and start a new one. Any record over the max size is taken as garbage.
+    //
+    const tCIDLib::TCard2   c2JrnlFmtVersion = 1;
+    const tCIDLib::TCard4   c4MaxJrnlRecs = 256;
+    const tCIDLib::TCard4   c4MaxJrnlRecSz = 4096;
+
+    // The types of records in the journal
+    const tCIDLib::TCard1   c1JrnlRec_TitleRating = 1;
 }
 
 
@@ -168,9 +180,11 @@ tCIDLib::TBoolean TCQSLRepoSDriver::bInitRepo()
             }
         }
 
-        // Create the path to the DB file
+        // Create the path to the DB file, and the change journal that goes with it
         m_pathDBFile = m_pathStart;
         m_pathDBFile.AddLevel(kCQSLRepoS::pszDBFileName);
+        m_pathJrnlFile = m_pathDBFile;
+        m_pathJrnlFile.Append(L"_Jrnl");
 
         //
         //  If it doesn't exist, but the old data directories do, then we
@@ -372,6 +386,141 @@ TCQSLRepoSDriver::InstallNewDB(TMediaDB& mdbToAccept, const TString& strDBSerNum
 }
 
 
+//
+//  After the database is loaded, this is called to apply any changes in the change
+//  journal. Each record holds the serial number of the database it was applied to,
+//  and the new serial number is a hash of the record. So we only apply records that
+//  chain on from the loaded database. If the first doesn't, the database was written
+//  out after the journal and it's stale. If we hit a partial or bad record, we stop
+//  there, since that's where we must have failed while writing it.
+//
+//  The passed serial number is updated to that of the last record we apply.
+//
+tCIDLib::TVoid
+TCQSLRepoSDriver::ReplayJournal(TMediaDB& mdbTar, TString& strDBSerNum)
+{
+    m_c4JrnlCnt = 0;
+    if (!TFileSys::bExists(m_pathJrnlFile))
+        return;
+
+    try
+    {
+        TBinaryFile flJrnl(m_pathJrnlFile);
+        flJrnl.Open
+        (
+            tCIDLib::EAccessModes::Excl_Read
+            , tCIDLib::ECreateActs::OpenIfExists
+            , tCIDLib::EFilePerms::Default
+            , tCIDLib::EFileFlags::SequentialScan
+        );
+
+        THeapBuf mbufRec(512, CQSLRepoS_DriverImpl::c4MaxJrnlRecSz);
+        TString strPrevSerNum;
+        TString strNewSerNum;
+        tCIDLib::TCard4 c4RecSz;
+        tCIDLib::TBoolean bClean = kCIDLib::False;
+        while (kCIDLib::True)
+        {
+            const tCIDLib::TCard4 c4SzBytes = flJrnl.c4ReadBuffer
+            (
+                &c4RecSz, sizeof(c4RecSz), tCIDLib::EAllData::OkIfNotAll
+            );
+
+            // If we hit the end between records, it's all good
+            if (!c4SzBytes)
+            {
+                bClean = kCIDLib::True;
+                break;
+            }
+
+            if ((c4SzBytes != sizeof(c4RecSz))
+            ||  !c4RecSz
+            ||  (c4RecSz > CQSLRepoS_DriverImpl::c4MaxJrnlRecSz)
+            ||  (flJrnl.c4ReadBuffer(mbufRec, c4RecSz) != c4RecSz))
+            {
+                break;
+            }
+
+            TBinMBufInStream strmRec(&mbufRec, c4RecSz);
+            tCIDLib::TCard1 c1RecType;
+            tCIDLib::TCard2 c2FmtVersion;
+            strmRec.CheckForStartMarker(CID_FILE, CID_LINE);
+            strmRec >> c2FmtVersion >> strPrevSerNum >> c1RecType;
+            if ((c2FmtVersion != CQSLRepoS_DriverImpl::c2JrnlFmtVersion)
+            ||  (strPrevSerNum != strDBSerNum))
+            {
+                break;
+            }
+
+            if (c1RecType == CQSLRepoS_DriverImpl::c1JrnlRec_TitleRating)
+            {
+                tCIDLib::TCard2 c2TitleId;
+                tCIDLib::TCard4 c4MType;
+                tCIDLib::TCard4 c4Rating;
+                strmRec >> c2TitleId >> c4MType >> c4Rating;
+                strmRec.CheckForEndMarker(CID_FILE, CID_LINE);
+
+                mdbTar.pmtsSetTitleRating
+                (
+                    c2TitleId, tCQCMedia::EMediaTypes(c4MType), c4Rating
+                );
+            }
+             else
+            {
+                break;
+            }
+
+            facCQCMedia().CreatePersistentId(mbufRec, c4RecSz, strNewSerNum);
+            strDBSerNum = strNewSerNum;
+            m_c4JrnlCnt++;
+        }
+
+        //
+        //  If we didn't get to the end cleanly, anything we append would come after
+        //  the bad bit and so would never get replayed. So force the next change to
+        //  write out the full DB, which starts a new journal.
+        //
+        if (!bClean)
+            m_c4JrnlCnt = CQSLRepoS_DriverImpl::c4MaxJrnlRecs;
+    }
+
+    catch(TError& errToCatch)
+    {
+        // Keep whatever we got applied, but force a full write as above
+        if (eVerboseLevel() >= tCQCKit::EVerboseLvls::Low)
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+        }
+        m_c4JrnlCnt = CQSLRepoS_DriverImpl::c4MaxJrnlRecs;
+    }
+}
+
+
+//
+//  The database file was just written out, so it has all of the journaled changes
+//  and we can start a new journal. If we can't delete it, it's not the end of the
+//  world since it won't chain from the new database's serial number.
+//
+tCIDLib::TVoid TCQSLRepoSDriver::ResetJournal()
+{
+    m_c4JrnlCnt = 0;
+    if (TFileSys::bExists(m_pathJrnlFile))
+    {
+        try
+        {
+            TFileSys::DeleteFile(m_pathJrnlFile);
+        }
+
+        catch(TError& errToCatch)
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+        }
+    }
+}
+
+
 //
 //  This is called if we come up without a database file (or old format content
 //  that we can convert forward.) We'll set up some initial data.
@@ -447,13 +596,10 @@ TCQSLRepoSDriver::SetInitDBContents(TMediaDB& mdbTar)
 //
 //  Though almost all changes to the database are made by the repo manager and
 //  then uploaded en masse, we do allow dynamic updates to some info, such as
-//  user rating, which can be updated by the clients via a backdoor command. This
-//  kind of sucks given our current way of doing things since we have to write out
-//  the whole database and this will cause the client service to have see changes
-//  and come get the new stuf, etc...
-//
-//  But it can't be avoided. After such changes, this is called and it just
-//  coordinates the other helper methods to do what needs to be done.
+//  user rating, which can be updated by the clients via a backdoor command. Those
+//  are normally just appended to the change journal (see StoreTitleRating), but
+//  when the journal gets full, or it can't be written, this is called to write out
+//  the whole database, which starts a new journal.
 //
 //  Since the DB we are storing is already the active one, we don't have to do change
 //  any loaded, loading, etc... status fields or swap anything in. We just need to
@@ -573,6 +719,9 @@ TCQSLRepoSDriver::StoreDBFile(const TMediaDB& mdbToStore, TString& strDBSerNum)
 
     // OK, that worked, so let's swap it in to replace the old file
     DoFileSwap(m_pathStart, kCQSLRepoS::pszDBFileName);
+
+    // It has any journaled changes now, so start a new journal
+    ResetJournal();
 }
 
 
@@ -638,3 +787,76 @@ TCQSLRepoSDriver::StoreImgFile( const   tCIDLib::TCard2         c2Id
 }
 
 
+//
+//  When a client changes a title's user rating, c4SendCmd updates the title and
+//  calls us. Instead of writing out the whole database, we append a record for the
+//  change to the change journal. The new database serial number is a hash of the
+//  record, which includes the previous serial number, so it changes without our
+//  having to hash the whole database. Once the journal gets to a certain size, or
+//  if we can't write to it, we write out the whole database, which resets it.
+//
+tCIDLib::TVoid
+TCQSLRepoSDriver::StoreTitleRating( const   tCIDLib::TCard2         c2TitleId
+                                    , const tCQCMedia::EMediaTypes  eMType
+                                    , const tCIDLib::TCard4         c4Rating)
+{
+    if (m_c4JrnlCnt >= CQSLRepoS_DriverImpl::c4MaxJrnlRecs)
+    {
+        StoreDBChanges();
+        return;
+    }
+
+    TString strDBSerNum;
+    try
+    {
+        // Flatten the record
+        THeapBuf mbufRec(512, CQSLRepoS_DriverImpl::c4MaxJrnlRecSz);
+        tCIDLib::TCard4 c4RecSz;
+        {
+            TBinMBufOutStream strmRec(&mbufRec);
+            strmRec << tCIDLib::EStreamMarkers::StartObject
+                    << CQSLRepoS_DriverImpl::c2JrnlFmtVersion
+                    << strDBSerialNum()
+                    << CQSLRepoS_DriverImpl::c1JrnlRec_TitleRating
+                    << c2TitleId
+                    << tCIDLib::c4EnumOrd(eMType)
+                    << c4Rating
+                    << tCIDLib::EStreamMarkers::EndObject
+                    << kCIDLib::FlushIt;
+            c4RecSz = strmRec.c4CurSize();
+        }
+
+        // And append it to the journal, with its size before it
+        TBinaryFile flJrnl(m_pathJrnlFile);
+        flJrnl.Open
+        (
+            tCIDLib::EAccessModes::Excl_Write
+            , tCIDLib::ECreateActs::OpenOrCreate
+            , tCIDLib::EFilePerms::Default
+            , tCIDLib::EFileFlags::None
+        );
+        flJrnl.SetFilePos(flJrnl.c8CurSize());
+        flJrnl.c4WriteBuffer(&c4RecSz, sizeof(c4RecSz));
+        flJrnl.c4WriteBuffer(mbufRec, c4RecSz);
+
+        facCQCMedia().CreatePersistentId(mbufRec, c4RecSz, strDBSerNum);
+        m_c4JrnlCnt++;
+    }
+
+    catch(TError& errToCatch)
+    {
+        if (eVerboseLevel() >= tCQCKit::EVerboseLvls::Low)
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+        }
+
+        // Fall back to writing it all out
+        StoreDBChanges();
+        return;
+    }
+
+    // Update the DB serial number field and our parent class
+    bStoreStringFld(m_c4FldId_DBSerialNum, strDBSerNum, kCIDLib::True);
+    SetDBSerialNum(strDBSerNum);
+}
@@ -52,6 +52,17 @@ namespace kGenProtoS_
     //  The name of the magic state that indicates acceptance of a message.
     // -----------------------------------------------------------------------
     const tCIDLib::TCh* const   pszAcceptState = L"<Accept>";
+
+
+    // -----------------------------------------------------------------------
+    //  Used in indexing the msg matches. A match key offset of c4MatchKeyLen
+    //  means the reply length is the key, else it's the offset of a reply byte.
+    //  We check for keys in the first c4MaxMatchKeyOfs bytes, and don't bother
+    //  with an index unless at least c4MinIndexedMatches can use it.
+    // -----------------------------------------------------------------------
+    const tCIDLib::TCard4   c4MatchKeyLen = kCIDLib::c4MaxCard;
+    const tCIDLib::TCard4   c4MaxMatchKeyOfs = 16;
+    const tCIDLib::TCard4   c4MinIndexedMatches = 4;
 }
 
 
@@ -60,6 +71,7 @@ namespace kGenProtoS_
 //  we have lots of classes for the internal representation of all of the data
 //  in a protocol description, which aren't needed by the outside world.
 // ---------------------------------------------------------------------------
+#include    "GenProtoS_ExprProg_.hpp"
 #include    "GenProtoS_ConstExpression_.hpp"
 #include    "GenProtoS_ExprBaseFuncs_.hpp"
 #include    "GenProtoS_ExprMathFuncs_.hpp"
@@ -117,6 +117,16 @@ TGenProtoCastNode::operator=(const TGenProtoCastNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoCastNode: Public, inherited methods
 // ---------------------------------------------------------------------------
+tCIDLib::TVoid TGenProtoCastNode::Apply(TGenProtoCtx&)
+{
+    //
+    //  Set our value to set itself from our child's result, which will have
+    //  the result of casting the value as needed.
+    //
+    evalCur().SetFrom(m_pnodeToCast->evalCur());
+}
+
+
 tCIDLib::TBoolean TGenProtoCastNode::bIsConst() const
 {
     // If our child is const, then we are
@@ -124,16 +134,19 @@ tCIDLib::TBoolean TGenProtoCastNode::bIsConst() const
 }
 
 
+tCIDLib::TVoid TGenProtoCastNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our child goes first, then we set our value from it
+    m_pnodeToCast->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
 tCIDLib::TVoid TGenProtoCastNode::Evaluate(TGenProtoCtx& ctxThis)
 {
-    // Ask our child node to evaluate himself
+    // Evaluate our child, then set our value from it
     m_pnodeToCast->Evaluate(ctxThis);
-
-    //
-    //  Set our value to set itself from our child's result, which will have
-    //  the result of casting the value as needed.
-    //
-    evalCur().SetFrom(m_pnodeToCast->evalCur());
+    Apply(ctxThis);
 }
 
 
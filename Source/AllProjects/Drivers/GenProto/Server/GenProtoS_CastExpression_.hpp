@@ -73,8 +73,18 @@ class TGenProtoCastNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -159,6 +159,15 @@ tCIDLib::TBoolean TGenProtoConstNode::bIsConst() const
 }
 
 
+tCIDLib::TVoid TGenProtoConstNode::Compile(TGenProtoExprProg&)
+{
+    //
+    //  We don't emit anything. Our value never changes, so whoever uses it
+    //  can just read it.
+    //
+}
+
+
 tCIDLib::TVoid TGenProtoConstNode::Evaluate(TGenProtoCtx&)
 {
     //
@@ -114,6 +114,11 @@ class TGenProtoConstNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bIsConst() const final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        ) final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -62,6 +62,13 @@ namespace kGenProtoS
     //  is the maximum value we will accept for the maximum timeouts value.
     // -----------------------------------------------------------------------
     const tCIDLib::TCard4   c4MaxMaxTimeouts        = 16;
+
+
+    // -----------------------------------------------------------------------
+    //  The size of the input buffer the device connections use, so that we
+    //  aren't making a system call for every byte read.
+    // -----------------------------------------------------------------------
+    const tCIDLib::TCard4   c4ReadBufSz             = 1024;
 }
 
 
@@ -18,6 +18,8 @@
 //  This file implements the device connection abstraction used by this
 //  generic driver.
 //
+//  The base class handles buffering of input, see the header comments.
+//
 // CAVEATS/GOTCHAS:
 //
 // LOG:
@@ -56,8 +58,80 @@ TDevConn::~TDevConn()
 // ---------------------------------------------------------------------------
 //  TDevConn: Hidden constructors
 // ---------------------------------------------------------------------------
-TDevConn::TDevConn()
+TDevConn::TDevConn() :
+
+    m_c4ReadCnt(0)
+    , m_c4ReadInd(0)
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TDevConn: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  If we have buffered bytes, we return the next one. Else we ask the derived
+//  class to refill the buffer. It waits up to the indicated time for at least
+//  one byte, same as if we'd just read a single byte, and gets anything else
+//  that is available without waiting further.
+//
+tCIDLib::TBoolean
+TDevConn::bReadByte(const tCIDLib::TCard4 c4WaitFor, tCIDLib::TCard1& c1ToFill)
+{
+    if (m_c4ReadInd == m_c4ReadCnt)
+    {
+        // Make sure we are empty if this throws
+        m_c4ReadCnt = 0;
+        m_c4ReadInd = 0;
+
+        m_c4ReadCnt = c4ReadAvail(m_ac1ReadBuf, kGenProtoS::c4ReadBufSz, c4WaitFor);
+        if (!m_c4ReadCnt)
+            return kCIDLib::False;
+    }
+    c1ToFill = m_ac1ReadBuf[m_c4ReadInd++];
+    return kCIDLib::True;
+}
+
+
+//
+//  If there's anything in the buffer we have to give that back first, to keep
+//  things in order. In that case we just return what we have and don't wait for
+//  any more, which is ok since the caller has to deal with partial reads anyway.
+//
+tCIDLib::TCard4
+TDevConn::c4Read(       TMemBuf&        mbufToFill
+                , const tCIDLib::TCard4 c4MaxToRead
+                , const tCIDLib::TCard4 c4Wait)
+{
+    if (m_c4ReadInd < m_c4ReadCnt)
+    {
+        tCIDLib::TCard4 c4Ret = m_c4ReadCnt - m_c4ReadInd;
+        if (c4Ret > c4MaxToRead)
+            c4Ret = c4MaxToRead;
+
+        mbufToFill.CopyIn(&m_ac1ReadBuf[m_c4ReadInd], c4Ret);
+        m_c4ReadInd += c4Ret;
+        return c4Ret;
+    }
+    return c4ReadBuf(mbufToFill, c4MaxToRead, c4Wait);
+}
+
+
+tCIDLib::TVoid TDevConn::PurgeReadBuf()
+{
+    ResetReadBuf();
+    PurgeDevData();
+}
+
+
+// ---------------------------------------------------------------------------
+//  TDevConn: Protected, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TVoid TDevConn::ResetReadBuf()
 {
+    m_c4ReadCnt = 0;
+    m_c4ReadInd = 0;
 }
 
 
@@ -155,6 +229,7 @@ TSerialConn::bGetCommResource(TThread&, const tCQCKit::EVerboseLvls eVerbose)
         m_pcommDev->SetCfg(m_conncfgToUse.cpcfgSerial());
 
         // Purge any partial gorp we might have waiting
+        ResetReadBuf();
         m_pcommDev->PurgeReadData();
     }
 
@@ -190,20 +265,6 @@ tCIDLib::TBoolean TSerialConn::bIsConnected() const
 }
 
 
-tCIDLib::TBoolean
-TSerialConn::bReadByte( const   tCIDLib::TCard4     c4WaitFor
-                        ,       tCIDLib::TCard1&    c1ToFill)
-{
-    // If not created yet, then obvious we failed
-    if (!m_pcommDev)
-        return kCIDLib::False;
-
-    if (!m_pcommDev->c4ReadRawBufMS(&c1ToFill, 1, c4WaitFor))
-        return kCIDLib::False;
-    return kCIDLib::True;
-}
-
-
 tCIDLib::TBoolean
 TSerialConn::bWrite(TMemBuf& mbufToFill, const tCIDLib::TCard4 c4ToWrite)
 {
@@ -219,28 +280,12 @@ TSerialConn::bWrite(TMemBuf& mbufToFill, const tCIDLib::TCard4 c4ToWrite)
 }
 
 
-tCIDLib::TCard4
-TSerialConn::c4Read(        TMemBuf&        mbufToFill
-                    , const tCIDLib::TCard4 c4MaxToRead
-                    , const tCIDLib::TCard4 c4Wait)
-{
-    // If not created yet, then obvious we failed
-    if (!m_pcommDev)
-        return 0;
-    return m_pcommDev->c4ReadMBufMS(mbufToFill, c4MaxToRead, c4Wait);
-}
-
-
-tCIDLib::TVoid TSerialConn::PurgeReadBuf()
-{
-    if (m_pcommDev)
-        m_pcommDev->PurgeReadData();
-}
-
-
 tCIDLib::TVoid
 TSerialConn::ReleaseCommResource(const tCQCKit::EVerboseLvls eVerbose)
 {
+    // Toss any buffered input
+    ResetReadBuf();
+
     try
     {
         // If we've created the object and it's open, then close
@@ -263,6 +308,49 @@ TSerialConn::ReleaseCommResource(const tCQCKit::EVerboseLvls eVerbose)
 }
 
 
+// ---------------------------------------------------------------------------
+//  TSerialConn: Protected, inherited methods
+// ---------------------------------------------------------------------------
+
+//
+//  Wait for a byte, and if we get one grab anything else that's already arrived,
+//  with no further waiting.
+//
+tCIDLib::TCard4
+TSerialConn::c4ReadAvail(       tCIDLib::TCard1* const  pc1ToFill
+                        , const tCIDLib::TCard4         c4MaxBytes
+                        , const tCIDLib::TCard4         c4WaitFor)
+{
+    // If not created yet, then obvious we failed
+    if (!m_pcommDev)
+        return 0;
+
+    tCIDLib::TCard4 c4Ret = m_pcommDev->c4ReadRawBufMS(pc1ToFill, 1, c4WaitFor);
+    if (c4Ret && (c4MaxBytes > 1))
+        c4Ret += m_pcommDev->c4ReadRawBufMS(pc1ToFill + 1, c4MaxBytes - 1, 0);
+    return c4Ret;
+}
+
+
+tCIDLib::TCard4
+TSerialConn::c4ReadBuf(         TMemBuf&        mbufToFill
+                        , const tCIDLib::TCard4 c4MaxToRead
+                        , const tCIDLib::TCard4 c4Wait)
+{
+    // If not created yet, then obvious we failed
+    if (!m_pcommDev)
+        return 0;
+    return m_pcommDev->c4ReadMBufMS(mbufToFill, c4MaxToRead, c4Wait);
+}
+
+
+tCIDLib::TVoid TSerialConn::PurgeDevData()
+{
+    if (m_pcommDev)
+        m_pcommDev->PurgeReadData();
+}
+
+
 
 
 // ---------------------------------------------------------------------------
@@ -307,6 +395,9 @@ TSockConn::~TSockConn()
 tCIDLib::TBoolean
 TSockConn::bConnect(TThread& thrThis, const tCQCKit::EVerboseLvls eVerbose)
 {
+    // Anything buffered is from a previous connection
+    ResetReadBuf();
+
     try
     {
         // Try to connect to the remote end point
@@ -367,18 +458,6 @@ tCIDLib::TBoolean TSockConn::bIsConnected() const
 }
 
 
-tCIDLib::TBoolean
-TSockConn::bReadByte(const  tCIDLib::TCard4     c4WaitFor
-                    ,       tCIDLib::TCard1&    c1ToFill)
-{
-    const tCIDLib::TCard4 c4Cnt = m_sockDev.c4ReceiveRawTOMS
-    (
-        &c1ToFill, c4WaitFor, 1, tCIDLib::EAllData::OkIfNotAll
-    );
-    return (c4Cnt == 1);
-}
-
-
 tCIDLib::TBoolean
 TSockConn::bWrite(TMemBuf& mbufToFill, const tCIDLib::TCard4 c4ToWrite)
 {
@@ -387,24 +466,12 @@ TSockConn::bWrite(TMemBuf& mbufToFill, const tCIDLib::TCard4 c4ToWrite)
 }
 
 
-tCIDLib::TCard4
-TSockConn::c4Read(          TMemBuf&        mbufToFill
-                    , const tCIDLib::TCard4 c4MaxToRead
-                    , const tCIDLib::TCard4 c4Wait)
-{
-    return m_sockDev.c4ReceiveMBufTOMS(mbufToFill, c4Wait, c4MaxToRead);
-}
-
-
-tCIDLib::TVoid TSockConn::PurgeReadBuf()
-{
-    // <TBD>
-}
-
-
 tCIDLib::TVoid
 TSockConn::ReleaseCommResource(const tCQCKit::EVerboseLvls eVerbose)
 {
+    // Toss any buffered input
+    ResetReadBuf();
+
     // First do a clean shutdown
     try
     {
@@ -445,3 +512,45 @@ TSockConn::ReleaseCommResource(const tCQCKit::EVerboseLvls eVerbose)
 }
 
 
+// ---------------------------------------------------------------------------
+//  TSockConn: Protected, inherited methods
+// ---------------------------------------------------------------------------
+
+//
+//  Wait for a byte, and if we get one grab anything else that's already arrived,
+//  with no further waiting.
+//
+tCIDLib::TCard4
+TSockConn::c4ReadAvail(         tCIDLib::TCard1* const  pc1ToFill
+                        , const tCIDLib::TCard4         c4MaxBytes
+                        , const tCIDLib::TCard4         c4WaitFor)
+{
+    tCIDLib::TCard4 c4Ret = m_sockDev.c4ReceiveRawTOMS
+    (
+        pc1ToFill, c4WaitFor, 1, tCIDLib::EAllData::OkIfNotAll
+    );
+
+    if (c4Ret && (c4MaxBytes > 1))
+    {
+        c4Ret += m_sockDev.c4ReceiveRawTOMS
+        (
+            pc1ToFill + 1, 0, c4MaxBytes - 1, tCIDLib::EAllData::OkIfNotAll
+        );
+    }
+    return c4Ret;
+}
+
+
+tCIDLib::TCard4
+TSockConn::c4ReadBuf(           TMemBuf&        mbufToFill
+                        , const tCIDLib::TCard4 c4MaxToRead
+                        , const tCIDLib::TCard4 c4Wait)
+{
+    return m_sockDev.c4ReceiveMBufTOMS(mbufToFill, c4Wait, c4MaxToRead);
+}
+
+
+tCIDLib::TVoid TSockConn::PurgeDevData()
+{
+    // <TBD>
+}
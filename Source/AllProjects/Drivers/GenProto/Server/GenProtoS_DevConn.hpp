@@ -23,8 +23,19 @@
 //  the passed connection config, and after that just deals with them
 //  abstractly.
 //
+//  The base class provides buffering of input. The state machine reads a byte
+//  at a time, which would otherwise mean a system call per byte. So, when the
+//  buffer is empty, we ask the derived class to wait for input in the usual way,
+//  but to also grab whatever else is already available. Subsequent byte reads are
+//  then just served from the buffer until it's empty again.
+//
 // CAVEATS/GOTCHAS:
 //
+//  1.  Since there can be buffered input, the public read and purge methods are
+//      non-virtual and the derived classes implement protected versions that
+//      just deal with the raw connection. They must call ResetReadBuf() if
+//      they reconnect or release the connection, so that old data isn't seen.
+//
 // LOG:
 //
 
@@ -71,31 +82,35 @@ class TDevConn : public TObject
 
         virtual tCIDLib::TBoolean bIsConnected() const = 0;
 
-        virtual tCIDLib::TBoolean bReadByte
-        (
-            const   tCIDLib::TCard4         c4WaitFor
-            ,       tCIDLib::TCard1&        c1ToFill
-        ) = 0;
-
         virtual tCIDLib::TBoolean bWrite
         (
                     TMemBuf&                mbufToFill
             , const tCIDLib::TCard4         c4ToWrite
         ) = 0;
 
-        virtual tCIDLib::TCard4 c4Read
+        virtual tCIDLib::TVoid ReleaseCommResource
         (
-                    TMemBuf&                mbufToFill
-            , const tCIDLib::TCard4         c4MaxToRead
-            , const tCIDLib::TCard4         c4Wait = kCIDLib::c4MaxWait
+            const   tCQCKit::EVerboseLvls   eVerbose
         ) = 0;
 
-        virtual tCIDLib::TVoid PurgeReadBuf() = 0;
 
-        virtual tCIDLib::TVoid ReleaseCommResource
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bReadByte
         (
-            const   tCQCKit::EVerboseLvls   eVerbose
-        ) = 0;
+            const   tCIDLib::TCard4         c4WaitFor
+            ,       tCIDLib::TCard1&        c1ToFill
+        );
+
+        tCIDLib::TCard4 c4Read
+        (
+                    TMemBuf&                mbufToFill
+            , const tCIDLib::TCard4         c4MaxToRead
+            , const tCIDLib::TCard4         c4Wait = kCIDLib::c4MaxWait
+        );
+
+        tCIDLib::TVoid PurgeReadBuf();
 
 
     protected :
@@ -105,8 +120,51 @@ class TDevConn : public TObject
         TDevConn();
 
 
+        // -------------------------------------------------------------------
+        //  Protected, virtual methods
+        // -------------------------------------------------------------------
+        virtual tCIDLib::TCard4 c4ReadAvail
+        (
+                    tCIDLib::TCard1* const  pc1ToFill
+            , const tCIDLib::TCard4         c4MaxBytes
+            , const tCIDLib::TCard4         c4WaitFor
+        ) = 0;
+
+        virtual tCIDLib::TCard4 c4ReadBuf
+        (
+                    TMemBuf&                mbufToFill
+            , const tCIDLib::TCard4         c4MaxToRead
+            , const tCIDLib::TCard4         c4Wait
+        ) = 0;
+
+        virtual tCIDLib::TVoid PurgeDevData() = 0;
+
+
+        // -------------------------------------------------------------------
+        //  Protected, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid ResetReadBuf();
+
+
     private :
-            // -------------------------------------------------------------------
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_ac1ReadBuf
+        //      The input buffer. We only refill it when it's empty, so we just
+        //      need the current index and the count of bytes in it.
+        //
+        //  m_c4ReadCnt
+        //  m_c4ReadInd
+        //      The number of bytes in m_ac1ReadBuf and the index of the next one
+        //      to return. When they are equal the buffer is empty.
+        // -------------------------------------------------------------------
+        tCIDLib::TCard1         m_ac1ReadBuf[kGenProtoS::c4ReadBufSz];
+        tCIDLib::TCard4         m_c4ReadCnt;
+        tCIDLib::TCard4         m_c4ReadInd;
+
+
+        // -------------------------------------------------------------------
         //  Magic macros
         // -------------------------------------------------------------------
         RTTIDefs(TDevConn,TObject)
@@ -160,32 +218,38 @@ class TSerialConn : public TDevConn
 
         tCIDLib::TBoolean bIsConnected() const final;
 
-        tCIDLib::TBoolean bReadByte
-        (
-            const   tCIDLib::TCard4         c4WaitFor
-            ,       tCIDLib::TCard1&        c1ToFill
-        )   final;
-
         tCIDLib::TBoolean bWrite
         (
                     TMemBuf&                mbufToFill
             , const tCIDLib::TCard4         c4ToWrite
         )   final;
 
-        tCIDLib::TCard4 c4Read
+        tCIDLib::TVoid ReleaseCommResource
         (
-                    TMemBuf&                mbufToFill
-            , const tCIDLib::TCard4         c4MaxToRead
-            , const tCIDLib::TCard4         c4Wait = kCIDLib::c4MaxWait
+            const   tCQCKit::EVerboseLvls   eVerbose
         )   final;
 
-        tCIDLib::TVoid PurgeReadBuf() final;
 
-        tCIDLib::TVoid ReleaseCommResource
+    protected :
+        // -------------------------------------------------------------------
+        //  Protected, inherited methods
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4 c4ReadAvail
         (
-            const   tCQCKit::EVerboseLvls   eVerbose
+                    tCIDLib::TCard1* const  pc1ToFill
+            , const tCIDLib::TCard4         c4MaxBytes
+            , const tCIDLib::TCard4         c4WaitFor
+        )   final;
+
+        tCIDLib::TCard4 c4ReadBuf
+        (
+                    TMemBuf&                mbufToFill
+            , const tCIDLib::TCard4         c4MaxToRead
+            , const tCIDLib::TCard4         c4Wait
         )   final;
 
+        tCIDLib::TVoid PurgeDevData() final;
+
 
     private :
         // -------------------------------------------------------------------
@@ -256,32 +320,38 @@ class TSockConn : public TDevConn
 
         tCIDLib::TBoolean bIsConnected() const final;
 
-        tCIDLib::TBoolean bReadByte
-        (
-            const   tCIDLib::TCard4         c4WaitFor
-            ,       tCIDLib::TCard1&        c1ToFill
-        )   final;
-
         tCIDLib::TBoolean bWrite
         (
                     TMemBuf&                mbufToFill
             , const tCIDLib::TCard4         c4ToWrite
         )   final;
 
-        tCIDLib::TCard4 c4Read
+        tCIDLib::TVoid ReleaseCommResource
         (
-                    TMemBuf&                mbufToFill
-            , const tCIDLib::TCard4         c4MaxToRead
-            , const tCIDLib::TCard4         c4Wait = kCIDLib::c4MaxWait
+            const   tCQCKit::EVerboseLvls   eVerbose
         )   final;
 
-        tCIDLib::TVoid PurgeReadBuf() final;
 
-        tCIDLib::TVoid ReleaseCommResource
+    protected :
+        // -------------------------------------------------------------------
+        //  Protected, inherited methods
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4 c4ReadAvail
         (
-            const   tCQCKit::EVerboseLvls   eVerbose
+                    tCIDLib::TCard1* const  pc1ToFill
+            , const tCIDLib::TCard4         c4MaxBytes
+            , const tCIDLib::TCard4         c4WaitFor
         )   final;
 
+        tCIDLib::TCard4 c4ReadBuf
+        (
+                    TMemBuf&                mbufToFill
+            , const tCIDLib::TCard4         c4MaxToRead
+            , const tCIDLib::TCard4         c4Wait
+        )   final;
+
+        tCIDLib::TVoid PurgeDevData() final;
+
 
     private :
         // -------------------------------------------------------------------
@@ -60,6 +60,7 @@ TGenProtoSDriver::TGenProtoSDriver(const TCQCDriverObjCfg& cqcdcToLoad) :
     , m_bTestMode(kCIDLib::False)
     , m_c4AcceptStateInd(0)
     , m_c4LastSendTime(0)
+    , m_c4MatchKeyOfs(kGenProtoS_::c4MatchKeyLen)
     , m_c4MinSendInterval(0)
     , m_c4PostConnWait(0)
     , m_c4Timeouts(0)
@@ -76,6 +77,8 @@ TGenProtoSDriver::TGenProtoSDriver(const TCQCDriverObjCfg& cqcdcToLoad) :
     , m_ctxWriteCmd(tGenProtoS::ESpecNodes::WriteCmd, L"write command")
     , m_eMsgToShow(tGenProtoS::EDbgMsgs::Default)
     , m_eProtoType(tGenProtoS::EProtoTypes::TwoWay)
+    , m_fcolMatchIndex(64)
+    , m_fcolMatchOthers(64)
     , m_pdevcTar(nullptr)
     , m_pmdbgCallback(nullptr)
 {
@@ -453,6 +456,8 @@ tCQCKit::EDrvInitRes TGenProtoSDriver::eInitializeImpl()
             m_colReplies.RemoveAll();
             m_colStateMachine.RemoveAll();
             m_colVariables.RemoveAll();
+            m_fcolMatchIndex.RemoveAll();
+            m_fcolMatchOthers.RemoveAll();
 
             ParseProtocol(mbufSrc, c4SrcBytes);
         }
@@ -1310,6 +1315,105 @@ TGenProtoSDriver::bGetReply(        TThread&            thrThis
 }
 
 
+//
+//  Get the value of the match index key from the reply in the passed context.
+//  If it's a reply byte that an Extract() would fail on, we return false, and
+//  only the non-indexed matches are checked.
+//
+tCIDLib::TBoolean
+TGenProtoSDriver::bQueryReplyKey(TGenProtoCtx& ctxToUse, tCIDLib::TCard4& c4KeyVal) const
+{
+    if (m_c4MatchKeyOfs == kGenProtoS_::c4MatchKeyLen)
+    {
+        c4KeyVal = ctxToUse.c4ReplyBytes();
+        return kCIDLib::True;
+    }
+
+    //
+    //  Check against the bytes actually in this reply. The buffer can be larger,
+    //  and anything past the reply bytes is left over from previous replies.
+    //
+    if (m_c4MatchKeyOfs >= ctxToUse.c4ReplyBytes())
+        return kCIDLib::False;
+
+    c4KeyVal = ctxToUse.mbufReply().c1At(m_c4MatchKeyOfs);
+    return kCIDLib::True;
+}
+
+
+//
+//  Called after the msg matches are parsed, to build the index that lets us
+//  avoid evaluating matches that can't possibly match a given reply. See the
+//  header comments for m_fcolMatchIndex.
+//
+tCIDLib::TVoid TGenProtoSDriver::BuildMatchIndex()
+{
+    m_fcolMatchIndex.RemoveAll();
+    m_fcolMatchOthers.RemoveAll();
+    m_c4MatchKeyOfs = kGenProtoS_::c4MatchKeyLen;
+
+    //
+    //  Find the key that the most matches can be indexed by. We try the reply
+    //  length first, then each of the header bytes.
+    //
+    const tCIDLib::TCard4 c4Count = m_colMatches.c4ElemCount();
+    tCIDLib::TCard4 c4BestCnt = 0;
+    tCIDLib::TCard4 c4KeyVal;
+    tCIDLib::TCard4 c4KeyOfs = kGenProtoS_::c4MatchKeyLen;
+    while (kCIDLib::True)
+    {
+        tCIDLib::TCard4 c4KeyCnt = 0;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        {
+            if (m_colMatches[c4Index]->bQueryMatchKey(c4KeyOfs, c4KeyVal))
+                c4KeyCnt++;
+        }
+
+        if (c4KeyCnt > c4BestCnt)
+        {
+            c4BestCnt = c4KeyCnt;
+            m_c4MatchKeyOfs = c4KeyOfs;
+        }
+
+        if (c4KeyOfs == kGenProtoS_::c4MatchKeyLen)
+            c4KeyOfs = 0;
+        else
+            c4KeyOfs++;
+
+        if (c4KeyOfs == kGenProtoS_::c4MaxMatchKeyOfs)
+            break;
+    }
+
+    //
+    //  If there aren't enough to be worth it, just put them all in the others
+    //  list, so that they are just checked in order as before.
+    //
+    if (c4BestCnt < kGenProtoS_::c4MinIndexedMatches)
+    {
+        m_c4MatchKeyOfs = kGenProtoS_::c4MatchKeyLen;
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+            m_fcolMatchOthers.c4AddElement(c4Index);
+        return;
+    }
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        if (m_colMatches[c4Index]->bQueryMatchKey(m_c4MatchKeyOfs, c4KeyVal))
+        {
+            m_fcolMatchIndex.c4AddElement
+            (
+                (tCIDLib::TCard8(c4KeyVal) << 32) | c4Index
+            );
+        }
+         else
+        {
+            m_fcolMatchOthers.c4AddElement(c4Index);
+        }
+    }
+    m_fcolMatchIndex.Sort(tCIDLib::eComp<tCIDLib::TCard8>);
+}
+
+
 // Check for any incoming async replies and process them
 tCIDLib::TVoid TGenProtoSDriver::CheckAsync(TThread& thrCalling)
 {
@@ -1854,9 +1958,60 @@ TGenProtoSDriver::prepMatchReply(TGenProtoCtx&          ctxToUse
         }
     }
 
+    //
+    //  If we have a match index, get the range of indexed matches that could
+    //  match this reply's key. The others always have to be checked. We merge
+    //  the two lists as we go, so that the matches are still checked in their
+    //  original order.
+    //
+    tCIDLib::TCard4 c4KeyInd = 0;
+    tCIDLib::TCard4 c4KeyEnd = 0;
+    tCIDLib::TCard4 c4KeyVal;
+    if (!m_fcolMatchIndex.bIsEmpty() && bQueryReplyKey(ctxToUse, c4KeyVal))
+    {
+        // Find the first entry with this key
+        const tCIDLib::TCard8 c8Low = tCIDLib::TCard8(c4KeyVal) << 32;
+        c4KeyEnd = m_fcolMatchIndex.c4ElemCount();
+        while (c4KeyInd < c4KeyEnd)
+        {
+            const tCIDLib::TCard4 c4Mid = c4KeyInd + ((c4KeyEnd - c4KeyInd) / 2);
+            if (m_fcolMatchIndex[c4Mid] < c8Low)
+                c4KeyInd = c4Mid + 1;
+            else
+                c4KeyEnd = c4Mid;
+        }
+
+        // And move forward past the ones for this key
+        const tCIDLib::TCard4 c4IndexCnt = m_fcolMatchIndex.c4ElemCount();
+        while ((c4KeyEnd < c4IndexCnt)
+        &&     (tCIDLib::TCard4(m_fcolMatchIndex[c4KeyEnd] >> 32) == c4KeyVal))
+        {
+            c4KeyEnd++;
+        }
+    }
+
+    const tCIDLib::TCard4 c4OtherCnt = m_fcolMatchOthers.c4ElemCount();
+    tCIDLib::TCard4 c4OtherInd = 0;
     TGenProtoReply* prepRet = 0;
-    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    while (kCIDLib::True)
     {
+        // Take whichever of the two lists has the lower match index next
+        tCIDLib::TCard4 c4Index;
+        if ((c4KeyInd < c4KeyEnd)
+        &&  ((c4OtherInd == c4OtherCnt)
+        ||   (tCIDLib::TCard4(m_fcolMatchIndex[c4KeyInd]) < m_fcolMatchOthers[c4OtherInd])))
+        {
+            c4Index = tCIDLib::TCard4(m_fcolMatchIndex[c4KeyInd++]);
+        }
+         else if (c4OtherInd < c4OtherCnt)
+        {
+            c4Index = m_fcolMatchOthers[c4OtherInd++];
+        }
+         else
+        {
+            break;
+        }
+
         TGenProtoMsgMatch* pmsgmCur = m_colMatches[c4Index];
 
         // If its the expected, then skip it, since we checked it above
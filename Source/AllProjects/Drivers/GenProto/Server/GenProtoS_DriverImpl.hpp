@@ -194,6 +194,14 @@ class GENPROTOSEXPORT TGenProtoSDriver : public TCQCServerBase
             , const tCIDLib::TBoolean       bFastCheck
         );
 
+        tCIDLib::TBoolean bQueryReplyKey
+        (
+                    TGenProtoCtx&           ctxToUse
+            ,       tCIDLib::TCard4&        c4KeyVal
+        )   const;
+
+        tCIDLib::TVoid BuildMatchIndex();
+
         tCIDLib::TVoid CheckAsync
         (
                     TThread&                thrCalling
@@ -358,6 +366,24 @@ class GENPROTOSEXPORT TGenProtoSDriver : public TCQCServerBase
         //      device. This is used in conjunction with m_c4MinSendInterval
         //      to providing throttling when devices require that.
         //
+        //  m_c4MatchKeyOfs
+        //  m_fcolMatchIndex
+        //  m_fcolMatchOthers
+        //      An index over m_colMatches, built after the msg matches are
+        //      parsed. Most protocols identify replies by a fixed header byte
+        //      (or by their length), so we find the reply byte (or length)
+        //      that the most matches require a particular value for, and
+        //      that becomes the key. m_c4MatchKeyOfs is the offset of that
+        //      byte, or kGenProtoS_::c4MatchKeyLen if the length is the key.
+        //
+        //      The index holds the key value in the high 32 bits and the
+        //      match index in the low, sorted, so we can binary search for
+        //      the candidates for a given key. Matches that don't require a
+        //      particular key value go into the others list. If there's no
+        //      useful key, all of them go into the others list. Both lists
+        //      are in match order within a key, so merging them keeps the
+        //      original first match wins semantics.
+        //
         //  m_c4MinSendInterval
         //      The minimum interval between sending messages to the device,
         //      in milliseconds. It defaults to zero if not provided.
@@ -490,6 +516,7 @@ class GENPROTOSEXPORT TGenProtoSDriver : public TCQCServerBase
         tCIDLib::TBoolean       m_bTestMode;
         tCIDLib::TCard4         m_c4AcceptStateInd;
         tCIDLib::TCard4         m_c4LastSendTime;
+        tCIDLib::TCard4         m_c4MatchKeyOfs;
         tCIDLib::TCard4         m_c4MinSendInterval;
         tCIDLib::TCard4         m_c4PostConnWait;
         tCIDLib::TCard4         m_c4Timeouts;
@@ -509,6 +536,8 @@ class GENPROTOSEXPORT TGenProtoSDriver : public TCQCServerBase
         TGenProtoCtx            m_ctxWriteCmd;
         tGenProtoS::EDbgMsgs    m_eMsgToShow;
         tGenProtoS::EProtoTypes m_eProtoType;
+        TFundVector<tCIDLib::TCard8> m_fcolMatchIndex;
+        TFundVector<tCIDLib::TCard4> m_fcolMatchOthers;
         TGenProtoInfo           m_gpinfoThis;
         TDevConn*               m_pdevcTar;
         MGenProtoDebug*         m_pmdbgCallback;
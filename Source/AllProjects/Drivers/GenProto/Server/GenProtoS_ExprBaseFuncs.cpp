@@ -107,13 +107,7 @@ operator=(const TGenProtoArrayExtractNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoArrayExtractNode::bIsConst() const
-{
-    // We are never constant
-    return kCIDLib::False;
-}
-
-tCIDLib::TVoid TGenProtoArrayExtractNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoArrayExtractNode::Apply(TGenProtoCtx& ctxThis)
 {
     //
     //  The array that we access is in the context object, since it can change
@@ -127,8 +121,6 @@ tCIDLib::TVoid TGenProtoArrayExtractNode::Evaluate(TGenProtoCtx& ctxThis)
                               ? &ctxThis.mbufReply()
                               : &ctxThis.mbufSend();
 
-    // Evaluate the offset expression to get the offset to use
-    m_pnodeOffset->Evaluate(ctxThis);
     tCIDLib::TCard4 c4Ofs = m_pnodeOffset->evalCur().c4Value();
 
     //
@@ -215,6 +207,28 @@ tCIDLib::TVoid TGenProtoArrayExtractNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoArrayExtractNode::bIsConst() const
+{
+    // We are never constant
+    return kCIDLib::False;
+}
+
+tCIDLib::TVoid TGenProtoArrayExtractNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // The offset goes first, then we extract our value from the buffer
+    m_pnodeOffset->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoArrayExtractNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate the offset, then extract our value from the buffer
+    m_pnodeOffset->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoArrayExtractNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -250,6 +264,29 @@ tCIDLib::TVoid TGenProtoArrayExtractNode::PostParseValidation()
 }
 
 
+// ---------------------------------------------------------------------------
+//  Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Used when indexing the msg matches. We say yes if we extract a single byte
+//  from the reply buffer at a fixed offset, and that offset is the one asked
+//  about. The offset expression will have been optimized by now, so if it's
+//  fixed it will be a const node.
+//
+tCIDLib::TBoolean
+TGenProtoArrayExtractNode::bIsReplyByteAt(const tCIDLib::TCard4 c4Ofs) const
+{
+    if ((m_eExprType != tGenProtoS::ESpecNodes::ReplyBuf)
+    ||  (eType() != tGenProtoS::ETypes::Card1)
+    ||  (m_pnodeOffset->clsIsA() != TGenProtoConstNode::clsThis()))
+    {
+        return kCIDLib::False;
+    }
+    return (m_pnodeOffset->evalCur().c4Value() == c4Ofs);
+}
+
+
 
 // ---------------------------------------------------------------------------
 //   CLASS: TGenProtoArrayLenNode
@@ -314,6 +351,15 @@ tCIDLib::TVoid TGenProtoArrayLenNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+// ---------------------------------------------------------------------------
+//  Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean TGenProtoArrayLenNode::bIsReplyLen() const
+{
+    return (m_eExprType == tGenProtoS::ESpecNodes::ReplyBuf);
+}
+
+
 
 
 // ---------------------------------------------------------------------------
@@ -433,10 +479,10 @@ TGenProtoBitOpsNode::operator=(const TGenProtoBitOpsNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoBitOpsNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TVoid TGenProtoBitOpsNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoBitOpsNode::Apply(TGenProtoCtx&)
 {
     //
-    //  For each child node in our list, evaluate it, then get its value
+    //  For each child node in our list, get its (already evaluated) value
     //  as a Card4, and AND it into our return value. We start the value
     //  off with the value of the first child.
     //
@@ -448,8 +494,6 @@ tCIDLib::TVoid TGenProtoBitOpsNode::Evaluate(TGenProtoCtx& ctxThis)
     {
         TGenProtoExprNode* pnodeCur = colList[c4Index];
 
-        pnodeCur->Evaluate(ctxThis);
-
         if (c4Index)
         {
             // After the first child, do the bit op against the return value
@@ -507,6 +551,28 @@ tCIDLib::TVoid TGenProtoBitOpsNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TVoid TGenProtoBitOpsNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    TChildList& colList = colChildren();
+    const tCIDLib::TCard4 c4Count = colList.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        colList[c4Index]->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoBitOpsNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    TChildList& colList = colChildren();
+    const tCIDLib::TCard4 c4Count = colList.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        colList[c4Index]->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoBitOpsNode::PostParseValidation()
 {
     TChildList& colList = colChildren();
@@ -593,6 +659,19 @@ TGenProtoBitsAreSetNode::operator=(const TGenProtoBitsAreSetNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoBitsAreSetNode: Public, inherited methods
 // ---------------------------------------------------------------------------
+tCIDLib::TVoid TGenProtoBitsAreSetNode::Apply(TGenProtoCtx&)
+{
+    // Get the mask out for convenience, as the largest unsigned type
+    const tCIDLib::TCard4 c4Mask = m_pnodeMask->evalCur().c4Value();
+
+    //
+    //  And now set our boolean value according to whether the indicated
+    //  bits are all set.
+    //
+    evalCur().bValue((m_pnodeValue->evalCur().c4Value() & c4Mask) == c4Mask);
+}
+
+
 tCIDLib::TBoolean TGenProtoBitsAreSetNode::bIsConst() const
 {
     // If both our children are const, then we are
@@ -600,20 +679,21 @@ tCIDLib::TBoolean TGenProtoBitsAreSetNode::bIsConst() const
 }
 
 
+tCIDLib::TVoid TGenProtoBitsAreSetNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeMask->Compile(eprogTar);
+    m_pnodeValue->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
 tCIDLib::TVoid TGenProtoBitsAreSetNode::Evaluate(TGenProtoCtx& ctxThis)
 {
-    // Evalute the two child nodes
+    // Evaluate our children, then calculate our value from them
     m_pnodeMask->Evaluate(ctxThis);
     m_pnodeValue->Evaluate(ctxThis);
-
-    // Get the mask out for convenience, as the largest unsigned type
-    const tCIDLib::TCard4 c4Mask = m_pnodeMask->evalCur().c4Value();
-
-    //
-    //  And now set our boolean value according to whether the indicated
-    //  bits are all set.
-    //
-    evalCur().bValue((m_pnodeValue->evalCur().c4Value() & c4Mask) == c4Mask);
+    Apply(ctxThis);
 }
 
 
@@ -730,6 +810,30 @@ tCIDLib::TBoolean TGenProtoBoolSelNode::bIsConst() const
 }
 
 
+tCIDLib::TVoid TGenProtoBoolSelNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    //
+    //  We only evaluate one of the true/false nodes, so we have to jump around
+    //  the one we don't want, according to the selection value.
+    //
+    m_pnodeSelVal->Compile(eprogTar);
+    const tCIDLib::TCard4 c4FalseJmp = eprogTar.c4AddOp
+    (
+        TGenProtoExprProg::EOps::JumpIfFalse, m_pnodeSelVal
+    );
+
+    m_pnodeTrueVal->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Copy, this, m_pnodeTrueVal);
+    const tCIDLib::TCard4 c4EndJmp = eprogTar.c4AddOp(TGenProtoExprProg::EOps::Jump);
+
+    eprogTar.SetJumpTarget(c4FalseJmp);
+    m_pnodeFalseVal->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Copy, this, m_pnodeFalseVal);
+
+    eprogTar.SetJumpTarget(c4EndJmp);
+}
+
+
 tCIDLib::TVoid TGenProtoBoolSelNode::Evaluate(TGenProtoCtx& ctxThis)
 {
     // Evaluate the selection value node
@@ -825,6 +929,56 @@ TGenProtoIfAllNode::operator=(const TGenProtoIfAllNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoIfAllNode: Public, inherited methods
 // ---------------------------------------------------------------------------
+tCIDLib::TBoolean
+TGenProtoIfAllNode::bQueryMatchKey( const   tCIDLib::TCard4     c4KeyOfs
+                                    ,       tCIDLib::TCard4&    c4KeyVal) const
+{
+    //
+    //  Since all of our children have to be true for us to be true, if any of
+    //  them requires a particular key value, then so do we.
+    //
+    const TChildList& colList = colChildren();
+    const tCIDLib::TCard4 c4Count = colList.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        if (colList[c4Index]->bQueryMatchKey(c4KeyOfs, c4KeyVal))
+            return kCIDLib::True;
+    }
+    return kCIDLib::False;
+}
+
+tCIDLib::TVoid TGenProtoIfAllNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    //
+    //  After each child, jump out if it comes up false, so that the rest
+    //  are not evaluated. If we get through them all we set our value true,
+    //  else the jumps land on the op that sets it false.
+    //
+    tCIDLib::TCardList fcolJmps;
+    TChildList& colList = colChildren();
+    const tCIDLib::TCard4 c4Count = colList.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        TGenProtoExprNode* pnodeCur = colList[c4Index];
+        pnodeCur->Compile(eprogTar);
+        fcolJmps.c4AddElement
+        (
+            eprogTar.c4AddOp(TGenProtoExprProg::EOps::JumpIfFalse, pnodeCur)
+        );
+    }
+
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::SetTrue, this);
+    const tCIDLib::TCard4 c4EndJmp = eprogTar.c4AddOp(TGenProtoExprProg::EOps::Jump);
+
+    const tCIDLib::TCard4 c4JmpCnt = fcolJmps.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4JmpCnt; c4Index++)
+        eprogTar.SetJumpTarget(fcolJmps[c4Index]);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::SetFalse, this);
+
+    eprogTar.SetJumpTarget(c4EndJmp);
+}
+
+
 tCIDLib::TVoid TGenProtoIfAllNode::Evaluate(TGenProtoCtx& ctxThis)
 {
     //
@@ -908,6 +1062,38 @@ TGenProtoIfAnyNode::operator=(const TGenProtoIfAnyNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoIfAnyNode: Public, inherited methods
 // ---------------------------------------------------------------------------
+tCIDLib::TVoid TGenProtoIfAnyNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    //
+    //  After each child, jump out if it comes up true, so that the rest
+    //  are not evaluated. If we get through them all we set our value false,
+    //  else the jumps land on the op that sets it true.
+    //
+    tCIDLib::TCardList fcolJmps;
+    TChildList& colList = colChildren();
+    const tCIDLib::TCard4 c4Count = colList.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+    {
+        TGenProtoExprNode* pnodeCur = colList[c4Index];
+        pnodeCur->Compile(eprogTar);
+        fcolJmps.c4AddElement
+        (
+            eprogTar.c4AddOp(TGenProtoExprProg::EOps::JumpIfTrue, pnodeCur)
+        );
+    }
+
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::SetFalse, this);
+    const tCIDLib::TCard4 c4EndJmp = eprogTar.c4AddOp(TGenProtoExprProg::EOps::Jump);
+
+    const tCIDLib::TCard4 c4JmpCnt = fcolJmps.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4JmpCnt; c4Index++)
+        eprogTar.SetJumpTarget(fcolJmps[c4Index]);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::SetTrue, this);
+
+    eprogTar.SetJumpTarget(c4EndJmp);
+}
+
+
 tCIDLib::TVoid TGenProtoIfAnyNode::Evaluate(TGenProtoCtx& ctxThis)
 {
     //
@@ -1002,6 +1188,13 @@ TGenProtoIsZeroNode::operator=(const TGenProtoIsZeroNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoIsZeroNode: Public, inherited methods
 // ---------------------------------------------------------------------------
+tCIDLib::TVoid TGenProtoIsZeroNode::Apply(TGenProtoCtx&)
+{
+    // Set our boolean value according to whether the value is zero or not
+    evalCur().bValue(m_pnodeValue->evalCur().bIsZero());
+}
+
+
 tCIDLib::TBoolean TGenProtoIsZeroNode::bIsConst() const
 {
     // If our child is const, then we are
@@ -1009,13 +1202,19 @@ tCIDLib::TBoolean TGenProtoIsZeroNode::bIsConst() const
 }
 
 
+tCIDLib::TVoid TGenProtoIsZeroNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our child goes first, then we calculate our value from it
+    m_pnodeValue->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
 tCIDLib::TVoid TGenProtoIsZeroNode::Evaluate(TGenProtoCtx& ctxThis)
 {
-    // Evalute our value node
+    // Evaluate our child, then calculate our value from it
     m_pnodeValue->Evaluate(ctxThis);
-
-    // Set our boolean value according to whether the value is zero or not
-    evalCur().bValue(m_pnodeValue->evalCur().bIsZero());
+    Apply(ctxThis);
 }
 
 
@@ -1115,18 +1314,8 @@ TGenProtoMapFromNode::operator=(const TGenProtoMapFromNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoMapFromNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoMapFromNode::bIsConst() const
+tCIDLib::TVoid TGenProtoMapFromNode::Apply(TGenProtoCtx&)
 {
-    // If our child is const, then we are
-    return m_pnodeMapVal->bIsConst();
-}
-
-
-tCIDLib::TVoid TGenProtoMapFromNode::Evaluate(TGenProtoCtx& ctxThis)
-{
-    // Evaluate the value node and use that to look up the value
-    m_pnodeMapVal->Evaluate(ctxThis);
-
     //
     //  In this case we search the map for the item with the value node's
     //  numeric value.
@@ -1142,6 +1331,29 @@ tCIDLib::TVoid TGenProtoMapFromNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoMapFromNode::bIsConst() const
+{
+    // If our child is const, then we are
+    return m_pnodeMapVal->bIsConst();
+}
+
+
+tCIDLib::TVoid TGenProtoMapFromNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // The value node goes first, then we map it
+    m_pnodeMapVal->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoMapFromNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate the value node, then map it
+    m_pnodeMapVal->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoMapFromNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -1237,18 +1449,8 @@ TGenProtoMapToNode::operator=(const TGenProtoMapToNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoMapToNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoMapToNode::bIsConst() const
+tCIDLib::TVoid TGenProtoMapToNode::Apply(TGenProtoCtx&)
 {
-    // If our child is const, then we are
-    return m_pnodeMapVal->bIsConst();
-}
-
-
-tCIDLib::TVoid TGenProtoMapToNode::Evaluate(TGenProtoCtx& ctxThis)
-{
-    // Evaluate the value node and use that to look up the value
-    m_pnodeMapVal->Evaluate(ctxThis);
-
     //
     //  Do the mapping using the string value of the value node. That gets
     //  us an expression value, which we use to set our value. Tell it to
@@ -1263,6 +1465,29 @@ tCIDLib::TVoid TGenProtoMapToNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoMapToNode::bIsConst() const
+{
+    // If our child is const, then we are
+    return m_pnodeMapVal->bIsConst();
+}
+
+
+tCIDLib::TVoid TGenProtoMapToNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // The value node goes first, then we map it
+    m_pnodeMapVal->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoMapToNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate the value node, then map it
+    m_pnodeMapVal->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoMapToNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -1347,6 +1572,13 @@ TGenProtoNOTNode::operator=(const TGenProtoNOTNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoNOTNode: Public, inherited methods
 // ---------------------------------------------------------------------------
+tCIDLib::TVoid TGenProtoNOTNode::Apply(TGenProtoCtx&)
+{
+    // Set our value to the NOT of our child's value
+    evalCur().bValue(!m_pnodeValue->evalCur().bValue());
+}
+
+
 tCIDLib::TBoolean TGenProtoNOTNode::bIsConst() const
 {
     // If our child is const, then we are
@@ -1354,11 +1586,19 @@ tCIDLib::TBoolean TGenProtoNOTNode::bIsConst() const
 }
 
 
+tCIDLib::TVoid TGenProtoNOTNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our child goes first, then we calculate our value from it
+    m_pnodeValue->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
 tCIDLib::TVoid TGenProtoNOTNode::Evaluate(TGenProtoCtx& ctxThis)
 {
-    // Evalute the the child node and set our value as it's NOT
+    // Evaluate our child, then calculate our value from it
     m_pnodeValue->Evaluate(ctxThis);
-    evalCur().bValue(!m_pnodeValue->evalCur().bValue());
+    Apply(ctxThis);
 }
 
 
@@ -1463,19 +1703,8 @@ TGenProtoShiftNode::operator=(const TGenProtoShiftNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoShiftNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoShiftNode::bIsConst() const
+tCIDLib::TVoid TGenProtoShiftNode::Apply(TGenProtoCtx&)
 {
-    // If both our children are const, then we are
-    return (m_pnodeValue->bIsConst() && m_pnodeShift->bIsConst());
-}
-
-
-tCIDLib::TVoid TGenProtoShiftNode::Evaluate(TGenProtoCtx& ctxThis)
-{
-    // Evaluate the two nodes
-    m_pnodeValue->Evaluate(ctxThis);
-    m_pnodeShift->Evaluate(ctxThis);
-
     // Get the value out so we can modify it
     tCIDLib::TCard4 c4Ret = m_pnodeValue->evalCur().c4Value();
 
@@ -1489,6 +1718,31 @@ tCIDLib::TVoid TGenProtoShiftNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoShiftNode::bIsConst() const
+{
+    // If both our children are const, then we are
+    return (m_pnodeValue->bIsConst() && m_pnodeShift->bIsConst());
+}
+
+
+tCIDLib::TVoid TGenProtoShiftNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeValue->Compile(eprogTar);
+    m_pnodeShift->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoShiftNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeValue->Evaluate(ctxThis);
+    m_pnodeShift->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoShiftNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -70,8 +70,18 @@ class TGenProtoArrayExtractNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -85,6 +95,15 @@ class TGenProtoArrayExtractNode : public TGenProtoExprNode
         tCIDLib::TVoid PostParseValidation()  final;
 
 
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bIsReplyByteAt
+        (
+            const   tCIDLib::TCard4         c4Ofs
+        )   const;
+
+
     private :
         // -------------------------------------------------------------------
         //  Private data members
@@ -152,6 +171,12 @@ class TGenProtoArrayLenNode : public TGenProtoExprNode
         )  final;
 
 
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bIsReplyLen() const;
+
+
     private :
         // -------------------------------------------------------------------
         //  Private data members
@@ -236,6 +261,16 @@ class TGenProtoBitOpsNode : public TGenProtoArbChildNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -299,8 +334,18 @@ class TGenProtoBitsAreSetNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -376,6 +421,11 @@ class TGenProtoBoolSelNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -452,6 +502,17 @@ class TGenProtoIfAllNode : public TGenProtoArbChildNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TBoolean bQueryMatchKey
+        (
+            const   tCIDLib::TCard4         c4KeyOfs
+            ,       tCIDLib::TCard4&        c4KeyVal
+        )   const final;
+
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -502,6 +563,11 @@ class TGenProtoIfAnyNode : public TGenProtoArbChildNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -555,8 +621,18 @@ class TGenProtoIsZeroNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -625,8 +701,18 @@ class TGenProtoMapFromNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -703,8 +789,18 @@ class TGenProtoMapToNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -778,8 +874,18 @@ class TGenProtoNOTNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -850,8 +956,18 @@ class TGenProtoShiftNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -146,19 +146,8 @@ TGenProtoAddNode::operator=(const TGenProtoAddNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoAddNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoAddNode::bIsConst() const
+tCIDLib::TVoid TGenProtoAddNode::Apply(TGenProtoCtx&)
 {
-    // If both our children are const, then we are
-    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
-}
-
-
-tCIDLib::TVoid TGenProtoAddNode::Evaluate(TGenProtoCtx& ctxThis)
-{
-    // Evaluate the two child nodes
-    m_pnodeLHS->Evaluate(ctxThis);
-    m_pnodeRHS->Evaluate(ctxThis);
-
     //
     //  Determine the resolution at which to do the operation. It will be the
     //  highest capacity type of the two source nodes or our type.
@@ -191,6 +180,31 @@ tCIDLib::TVoid TGenProtoAddNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoAddNode::bIsConst() const
+{
+    // If both our children are const, then we are
+    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
+}
+
+
+tCIDLib::TVoid TGenProtoAddNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeLHS->Compile(eprogTar);
+    m_pnodeRHS->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoAddNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeLHS->Evaluate(ctxThis);
+    m_pnodeRHS->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoAddNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -286,19 +300,8 @@ TGenProtoDivNode::operator=(const TGenProtoDivNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoDivNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoDivNode::bIsConst() const
+tCIDLib::TVoid TGenProtoDivNode::Apply(TGenProtoCtx&)
 {
-    // If both our children are const, then we are
-    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
-}
-
-
-tCIDLib::TVoid TGenProtoDivNode::Evaluate(TGenProtoCtx& ctxThis)
-{
-    // Evaluate the two child nodes
-    m_pnodeLHS->Evaluate(ctxThis);
-    m_pnodeRHS->Evaluate(ctxThis);
-
     //
     //  Determine the resolution at which to do the operation. It will be the
     //  highest capacity type of the two source nodes or our type.
@@ -331,6 +334,31 @@ tCIDLib::TVoid TGenProtoDivNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoDivNode::bIsConst() const
+{
+    // If both our children are const, then we are
+    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
+}
+
+
+tCIDLib::TVoid TGenProtoDivNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeLHS->Compile(eprogTar);
+    m_pnodeRHS->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoDivNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeLHS->Evaluate(ctxThis);
+    m_pnodeRHS->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoDivNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -427,19 +455,8 @@ TGenProtoEqualsNode::operator=(const TGenProtoEqualsNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoEqualsNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoEqualsNode::bIsConst() const
+tCIDLib::TVoid TGenProtoEqualsNode::Apply(TGenProtoCtx&)
 {
-    // If both our children are const, then we are
-    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
-}
-
-
-tCIDLib::TVoid TGenProtoEqualsNode::Evaluate(TGenProtoCtx& ctxThis)
-{
-    // Evaluate the two child nodes
-    m_pnodeLHS->Evaluate(ctxThis);
-    m_pnodeRHS->Evaluate(ctxThis);
-
     // Special case for strings. In this case they both have to be strings
     if (m_pnodeLHS->evalCur().eType() == tGenProtoS::ETypes::String)
     {
@@ -483,6 +500,86 @@ tCIDLib::TVoid TGenProtoEqualsNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoEqualsNode::bIsConst() const
+{
+    // If both our children are const, then we are
+    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
+}
+
+
+tCIDLib::TBoolean
+TGenProtoEqualsNode::bQueryMatchKey(const   tCIDLib::TCard4     c4KeyOfs
+                                    ,       tCIDLib::TCard4&    c4KeyVal) const
+{
+    //
+    //  We can be indexed if one side is a cardinal constant and the other is
+    //  either the reply length or a fixed reply byte, whichever is being asked
+    //  about. It can be on either side.
+    //
+    const TGenProtoExprNode* pnodeConst = m_pnodeRHS;
+    const TGenProtoExprNode* pnodeKey = m_pnodeLHS;
+    if (pnodeConst->clsIsA() != TGenProtoConstNode::clsThis())
+    {
+        pnodeConst = m_pnodeLHS;
+        pnodeKey = m_pnodeRHS;
+        if (pnodeConst->clsIsA() != TGenProtoConstNode::clsThis())
+            return kCIDLib::False;
+    }
+
+    const tGenProtoS::ETypes eConstType = pnodeConst->eType();
+    if ((eConstType != tGenProtoS::ETypes::Card1)
+    &&  (eConstType != tGenProtoS::ETypes::Card2)
+    &&  (eConstType != tGenProtoS::ETypes::Card4))
+    {
+        return kCIDLib::False;
+    }
+    const tCIDLib::TCard4 c4Const = pnodeConst->evalCur().c4Value();
+
+    if (c4KeyOfs == kGenProtoS_::c4MatchKeyLen)
+    {
+        if (pnodeKey->clsIsA() != TGenProtoArrayLenNode::clsThis())
+            return kCIDLib::False;
+
+        if (!static_cast<const TGenProtoArrayLenNode*>(pnodeKey)->bIsReplyLen())
+            return kCIDLib::False;
+    }
+     else
+    {
+        if ((pnodeKey->clsIsA() != TGenProtoArrayExtractNode::clsThis())
+        ||  (c4Const > kCIDLib::c1MaxCard))
+        {
+            return kCIDLib::False;
+        }
+
+        const TGenProtoArrayExtractNode* pnodeExtract
+                        = static_cast<const TGenProtoArrayExtractNode*>(pnodeKey);
+        if (!pnodeExtract->bIsReplyByteAt(c4KeyOfs))
+            return kCIDLib::False;
+    }
+
+    c4KeyVal = c4Const;
+    return kCIDLib::True;
+}
+
+
+tCIDLib::TVoid TGenProtoEqualsNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeLHS->Compile(eprogTar);
+    m_pnodeRHS->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoEqualsNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeLHS->Evaluate(ctxThis);
+    m_pnodeRHS->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoEqualsNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -598,19 +695,8 @@ TGenProtoMulNode& TGenProtoMulNode::operator=(const TGenProtoMulNode& nodeToAssi
 // ---------------------------------------------------------------------------
 //  TGenProtoMulNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoMulNode::bIsConst() const
+tCIDLib::TVoid TGenProtoMulNode::Apply(TGenProtoCtx&)
 {
-    // If both our children are const, then we are
-    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
-}
-
-
-tCIDLib::TVoid TGenProtoMulNode::Evaluate(TGenProtoCtx& ctxThis)
-{
-    // Evaluate the two child nodes
-    m_pnodeLHS->Evaluate(ctxThis);
-    m_pnodeRHS->Evaluate(ctxThis);
-
     //
     //  Determine the resolution at which to do the operation. It will be the
     //  highest capacity type of the two source nodes or our type.
@@ -643,6 +729,31 @@ tCIDLib::TVoid TGenProtoMulNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoMulNode::bIsConst() const
+{
+    // If both our children are const, then we are
+    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
+}
+
+
+tCIDLib::TVoid TGenProtoMulNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeLHS->Compile(eprogTar);
+    m_pnodeRHS->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoMulNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeLHS->Evaluate(ctxThis);
+    m_pnodeRHS->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoMulNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -745,19 +856,8 @@ TGenProtoNumMagNode::operator=(const TGenProtoNumMagNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoNumMagNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoNumMagNode::bIsConst() const
-{
-    // If both our children are const, then we are
-    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
-}
-
-
-tCIDLib::TVoid TGenProtoNumMagNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoNumMagNode::Apply(TGenProtoCtx&)
 {
-    // Evaluate the two child nodes
-    m_pnodeLHS->Evaluate(ctxThis);
-    m_pnodeRHS->Evaluate(ctxThis);
-
     //
     //  Determine the resolution at which to do the operation. It will be the
     //  highest capacity type of the two source nodes or our type.
@@ -790,6 +890,31 @@ tCIDLib::TVoid TGenProtoNumMagNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoNumMagNode::bIsConst() const
+{
+    // If both our children are const, then we are
+    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
+}
+
+
+tCIDLib::TVoid TGenProtoNumMagNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeLHS->Compile(eprogTar);
+    m_pnodeRHS->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoNumMagNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeLHS->Evaluate(ctxThis);
+    m_pnodeRHS->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoNumMagNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -907,26 +1032,8 @@ TGenProtoRangeRotNode::operator=(const TGenProtoRangeRotNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoRangeRotNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoRangeRotNode::bIsConst() const
-{
-    // If all our children are const, then we will be const
-    return  m_pnodeDirection->bIsConst()
-            && m_pnodeOrgVal->bIsConst()
-            && m_pnodeRangeHigh->bIsConst()
-            && m_pnodeRangeLow->bIsConst()
-            && m_pnodeWrapAround->bIsConst();
-}
-
-
-tCIDLib::TVoid TGenProtoRangeRotNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoRangeRotNode::Apply(TGenProtoCtx&)
 {
-    // Evaluate the child nodes
-    m_pnodeOrgVal->Evaluate(ctxThis);
-    m_pnodeDirection->Evaluate(ctxThis);
-    m_pnodeRangeLow->Evaluate(ctxThis);
-    m_pnodeRangeHigh->Evaluate(ctxThis);
-    m_pnodeWrapAround->Evaluate(ctxThis);
-
     // The wrap around flag is the same for both scenarios
     const tCIDLib::TBoolean bWrap = m_pnodeWrapAround->evalCur().bValue();
 
@@ -1043,6 +1150,41 @@ tCIDLib::TVoid TGenProtoRangeRotNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoRangeRotNode::bIsConst() const
+{
+    // If all our children are const, then we will be const
+    return  m_pnodeDirection->bIsConst()
+            && m_pnodeOrgVal->bIsConst()
+            && m_pnodeRangeHigh->bIsConst()
+            && m_pnodeRangeLow->bIsConst()
+            && m_pnodeWrapAround->bIsConst();
+}
+
+
+tCIDLib::TVoid TGenProtoRangeRotNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeOrgVal->Compile(eprogTar);
+    m_pnodeDirection->Compile(eprogTar);
+    m_pnodeRangeLow->Compile(eprogTar);
+    m_pnodeRangeHigh->Compile(eprogTar);
+    m_pnodeWrapAround->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoRangeRotNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeOrgVal->Evaluate(ctxThis);
+    m_pnodeDirection->Evaluate(ctxThis);
+    m_pnodeRangeLow->Evaluate(ctxThis);
+    m_pnodeRangeHigh->Evaluate(ctxThis);
+    m_pnodeWrapAround->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoRangeRotNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -1169,18 +1311,8 @@ TGenProtoRoundFloatNode::operator=(const TGenProtoRoundFloatNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoRoundFloatNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoRoundFloatNode::bIsConst() const
-{
-    // If our child expression is const, then we are
-    return m_pnodeValue->bIsConst();
-}
-
-
-tCIDLib::TVoid TGenProtoRoundFloatNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoRoundFloatNode::Apply(TGenProtoCtx&)
 {
-    // Evaluate the child node
-    m_pnodeValue->Evaluate(ctxThis);
-
     //
     //  And now get the value, perform the rounding on it, and store it as
     //  our value. Do it at the native resolution of our expression.
@@ -1200,6 +1332,29 @@ tCIDLib::TVoid TGenProtoRoundFloatNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoRoundFloatNode::bIsConst() const
+{
+    // If our child expression is const, then we are
+    return m_pnodeValue->bIsConst();
+}
+
+
+tCIDLib::TVoid TGenProtoRoundFloatNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our child goes first, then we calculate our value from it
+    m_pnodeValue->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoRoundFloatNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our child, then calculate our value from it
+    m_pnodeValue->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoRoundFloatNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -1316,29 +1471,8 @@ TGenProtoScaleRngNode::operator=(const TGenProtoScaleRngNode& nodeSrc)
 // ---------------------------------------------------------------------------
 //  TGenProtoScaleRngNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoScaleRngNode::bIsConst() const
+tCIDLib::TVoid TGenProtoScaleRngNode::Apply(TGenProtoCtx&)
 {
-    // If all our chldren are, we are
-    return
-    (
-        m_pnodeVal->bIsConst()
-        && m_pnodeMaxRng->bIsConst()
-        && m_pnodeMinRng->bIsConst()
-        && m_pnodeMaxVal->bIsConst()
-        && m_pnodeMinVal->bIsConst()
-    );
-}
-
-
-tCIDLib::TVoid TGenProtoScaleRngNode::Evaluate(TGenProtoCtx& ctxThis)
-{
-    // Evaluate the child nodes
-    m_pnodeVal->Evaluate(ctxThis);
-    m_pnodeMaxRng->Evaluate(ctxThis);
-    m_pnodeMinRng->Evaluate(ctxThis);
-    m_pnodeMaxVal->Evaluate(ctxThis);
-    m_pnodeMinVal->Evaluate(ctxThis);
-
     //
     //  We do the calculates in floating point and only store the value in the
     //  source value's resolution at the end.
@@ -1400,6 +1534,44 @@ tCIDLib::TVoid TGenProtoScaleRngNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoScaleRngNode::bIsConst() const
+{
+    // If all our chldren are, we are
+    return
+    (
+        m_pnodeVal->bIsConst()
+        && m_pnodeMaxRng->bIsConst()
+        && m_pnodeMinRng->bIsConst()
+        && m_pnodeMaxVal->bIsConst()
+        && m_pnodeMinVal->bIsConst()
+    );
+}
+
+
+tCIDLib::TVoid TGenProtoScaleRngNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeVal->Compile(eprogTar);
+    m_pnodeMaxRng->Compile(eprogTar);
+    m_pnodeMinRng->Compile(eprogTar);
+    m_pnodeMaxVal->Compile(eprogTar);
+    m_pnodeMinVal->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoScaleRngNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeVal->Evaluate(ctxThis);
+    m_pnodeMaxRng->Evaluate(ctxThis);
+    m_pnodeMinRng->Evaluate(ctxThis);
+    m_pnodeMaxVal->Evaluate(ctxThis);
+    m_pnodeMinVal->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoScaleRngNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -1506,19 +1678,8 @@ TGenProtoSubNode::operator=(const TGenProtoSubNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoSubNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoSubNode::bIsConst() const
+tCIDLib::TVoid TGenProtoSubNode::Apply(TGenProtoCtx&)
 {
-    // If both our children are const, then we are
-    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
-}
-
-
-tCIDLib::TVoid TGenProtoSubNode::Evaluate(TGenProtoCtx& ctxThis)
-{
-    // Evaluate the two child nodes
-    m_pnodeLHS->Evaluate(ctxThis);
-    m_pnodeRHS->Evaluate(ctxThis);
-
     //
     //  Determine the resolution at which to do the operation. It will be the
     //  highest capacity type of the two source nodes or our type.
@@ -1551,6 +1712,31 @@ tCIDLib::TVoid TGenProtoSubNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoSubNode::bIsConst() const
+{
+    // If both our children are const, then we are
+    return (m_pnodeLHS->bIsConst() && m_pnodeRHS->bIsConst());
+}
+
+
+tCIDLib::TVoid TGenProtoSubNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeLHS->Compile(eprogTar);
+    m_pnodeRHS->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoSubNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeLHS->Evaluate(ctxThis);
+    m_pnodeRHS->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoSubNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -1653,19 +1839,8 @@ TGenProtoTranscNode::operator=(const TGenProtoTranscNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoTranscNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoTranscNode::bIsConst() const
-{
-    // If both our children are const, then we are
-    return (m_pnodeVal->bIsConst() && m_pnodeType->bIsConst());
-}
-
-
-tCIDLib::TVoid TGenProtoTranscNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoTranscNode::Apply(TGenProtoCtx&)
 {
-    // Evaluate the two child nodes
-    m_pnodeVal->Evaluate(ctxThis);
-    m_pnodeType->Evaluate(ctxThis);
-
     // We can do either in Float8, so get the value to that
     tCIDLib::TFloat8 f8Val;
     if (m_pnodeVal->eType() == tGenProtoS::ETypes::Float4)
@@ -1722,6 +1897,31 @@ tCIDLib::TVoid TGenProtoTranscNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoTranscNode::bIsConst() const
+{
+    // If both our children are const, then we are
+    return (m_pnodeVal->bIsConst() && m_pnodeType->bIsConst());
+}
+
+
+tCIDLib::TVoid TGenProtoTranscNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeVal->Compile(eprogTar);
+    m_pnodeType->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoTranscNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeVal->Evaluate(ctxThis);
+    m_pnodeType->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoTranscNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -66,8 +66,18 @@ class TGenProtoAddNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -140,8 +150,18 @@ class TGenProtoDivNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -213,8 +233,24 @@ class TGenProtoEqualsNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TBoolean bQueryMatchKey
+        (
+            const   tCIDLib::TCard4         c4KeyOfs
+            ,       tCIDLib::TCard4&        c4KeyVal
+        )   const final;
+
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -286,8 +322,18 @@ class TGenProtoMulNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -360,8 +406,18 @@ class TGenProtoNumMagNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -442,8 +498,18 @@ class TGenProtoRangeRotNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -522,8 +588,18 @@ class TGenProtoRoundFloatNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -600,8 +676,18 @@ class TGenProtoScaleRngNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -683,8 +769,18 @@ class TGenProtoSubNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -758,8 +854,18 @@ class TGenProtoTranscNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
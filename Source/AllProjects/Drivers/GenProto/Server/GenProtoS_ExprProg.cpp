@@ -0,0 +1,153 @@
+//
+// FILE NAME: GenProtoS_ExprProg.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the compiled form of an expression tree.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+
+
+// ---------------------------------------------------------------------------
+//  Includes
+// ---------------------------------------------------------------------------
+#include    "GenProtoS_.hpp"
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TGenProtoExprProg
+//  PREFIX: eprog
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TGenProtoExprProg: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TGenProtoExprProg::TGenProtoExprProg() :
+
+    m_colOps(16)
+{
+}
+
+TGenProtoExprProg::~TGenProtoExprProg()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TGenProtoExprProg: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+// Add a new op and return its index, so jumps can be updated later
+tCIDLib::TCard4
+TGenProtoExprProg::c4AddOp( const   EOps                        eOp
+                            ,       TGenProtoExprNode* const    pnodeTar
+                            ,       TGenProtoExprNode* const    pnodeSrc)
+{
+    TOp opNew;
+    opNew.m_c4Target = 0;
+    opNew.m_eOp = eOp;
+    opNew.m_pnodeSrc = pnodeSrc;
+    opNew.m_pnodeTar = pnodeTar;
+    m_colOps.objAdd(opNew);
+
+    return m_colOps.c4ElemCount() - 1;
+}
+
+
+tCIDLib::TCard4 TGenProtoExprProg::c4OpCount() const
+{
+    return m_colOps.c4ElemCount();
+}
+
+
+//
+//  Run the ops. When we are done, the root node the program was compiled from
+//  has its final value, same as if it had been evaluated.
+//
+tCIDLib::TVoid TGenProtoExprProg::Exec(TGenProtoCtx& ctxThis)
+{
+    const tCIDLib::TCard4 c4Count = m_colOps.c4ElemCount();
+    tCIDLib::TCard4 c4Index = 0;
+    while (c4Index < c4Count)
+    {
+        const TOp& opCur = m_colOps[c4Index++];
+        switch(opCur.m_eOp)
+        {
+            case EOps::Apply :
+                opCur.m_pnodeTar->Apply(ctxThis);
+                break;
+
+            case EOps::Copy :
+                opCur.m_pnodeTar->evalCur().SetFrom(opCur.m_pnodeSrc->evalCur());
+                break;
+
+            case EOps::Eval :
+                opCur.m_pnodeTar->Evaluate(ctxThis);
+                break;
+
+            case EOps::Jump :
+                c4Index = opCur.m_c4Target;
+                break;
+
+            case EOps::JumpIfFalse :
+                if (!opCur.m_pnodeTar->evalCur().bValue())
+                    c4Index = opCur.m_c4Target;
+                break;
+
+            case EOps::JumpIfTrue :
+                if (opCur.m_pnodeTar->evalCur().bValue())
+                    c4Index = opCur.m_c4Target;
+                break;
+
+            case EOps::SetFalse :
+                opCur.m_pnodeTar->evalCur().bValue(kCIDLib::False);
+                break;
+
+            case EOps::SetTrue :
+                opCur.m_pnodeTar->evalCur().bValue(kCIDLib::True);
+                break;
+
+            default :
+                #if CID_DEBUG_ON
+                facCIDLib().ThrowErr
+                (
+                    CID_FILE
+                    , CID_LINE
+                    , kCIDErrs::errcGen_BadEnumValue
+                    , tCIDLib::ESeverities::Failed
+                    , tCIDLib::EErrClasses::Internal
+                    , TCardinal(tCIDLib::c4EnumOrd(opCur.m_eOp))
+                    , TString(L"TGenProtoExprProg::EOps")
+                );
+                #endif
+                break;
+        }
+    }
+}
+
+
+//
+//  Jumps are always forward, so they are added before we know where they go.
+//  This is called once the target is reached, and points the jump at the next
+//  op to be added.
+//
+tCIDLib::TVoid TGenProtoExprProg::SetJumpTarget(const tCIDLib::TCard4 c4OpInd)
+{
+    m_colOps[c4OpInd].m_c4Target = m_colOps.c4ElemCount();
+}
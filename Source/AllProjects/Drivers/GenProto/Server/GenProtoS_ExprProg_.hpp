@@ -0,0 +1,146 @@
+//
+// FILE NAME: GenProtoS_ExprProg_.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header file for the GenProtoS_ExprProg.cpp file, which
+//  implements a flat, compiled form of an expression tree. The runtime
+//  expressions (message builds, reply validation and matching, field stores,
+//  state transitions) are evaluated over and over again, and walking the node
+//  tree recursively for each one costs a virtual call and a stack frame per
+//  node, and const nodes get 'evaluated' every time even though they never
+//  change.
+//
+//  So each root node compiles itself into one of these the first time it is
+//  run. Each node's Compile() method emits the ops for its children, then an
+//  op for itself. So the ops are in post-order and we can just run them in a
+//  simple loop. Const nodes emit nothing, since their values are set up front.
+//  Nodes that only evaluate some of their children (IfAll, IfAny, BoolSel) use
+//  jump ops to skip the ones that aren't needed, so that the semantics are the
+//  same as the tree walk.
+//
+//  The nodes still hold their own values, as they always have, so the ops just
+//  reference nodes. An Apply op tells a node to calculate its value from the
+//  already evaluated values of its children. An Eval op tells a node to do a
+//  full, regular evaluation, which is what leaf nodes do, and what any node
+//  that doesn't provide a Compile() override gets by default.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  The ops point at the nodes in the tree they were compiled from. So
+//      they are not copied when a node is copied. The copy just compiles its
+//      own upon first use.
+//
+// LOG:
+//
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TGenProtoExprProg
+//  PREFIX: eprog
+// ---------------------------------------------------------------------------
+class TGenProtoExprProg
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Public types
+        // -------------------------------------------------------------------
+        enum class EOps
+        {
+            Apply
+            , Copy
+            , Eval
+            , Jump
+            , JumpIfFalse
+            , JumpIfTrue
+            , SetFalse
+            , SetTrue
+        };
+
+
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TGenProtoExprProg();
+
+        TGenProtoExprProg(const TGenProtoExprProg&) = delete;
+        TGenProtoExprProg(TGenProtoExprProg&&) = delete;
+
+        ~TGenProtoExprProg();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TGenProtoExprProg& operator=(const TGenProtoExprProg&) = delete;
+        TGenProtoExprProg& operator=(TGenProtoExprProg&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4 c4AddOp
+        (
+            const   EOps                    eOp
+            ,       TGenProtoExprNode* const pnodeTar = nullptr
+            ,       TGenProtoExprNode* const pnodeSrc = nullptr
+        );
+
+        tCIDLib::TCard4 c4OpCount() const;
+
+        tCIDLib::TVoid Exec
+        (
+                    TGenProtoCtx&           ctxThis
+        );
+
+        tCIDLib::TVoid SetJumpTarget
+        (
+            const   tCIDLib::TCard4         c4OpInd
+        );
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private types
+        //
+        //  The target node is the one the op acts on, or the one whose boolean
+        //  value is tested by the conditional jumps. The source node is only
+        //  used by Copy, which sets the target's value from the source's. The
+        //  jump target is the index of the op to go to.
+        // -------------------------------------------------------------------
+        class TOp
+        {
+            public :
+                tCIDLib::TCard4     m_c4Target;
+                EOps                m_eOp;
+                TGenProtoExprNode*  m_pnodeSrc;
+                TGenProtoExprNode*  m_pnodeTar;
+        };
+        using TOpList = TVector<TOp>;
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_colOps
+        //      The list of ops, in the order they are to be run (other than
+        //      jumps of course.)
+        // -------------------------------------------------------------------
+        TOpList     m_colOps;
+};
+
+#pragma CIDLIB_POPPACK
@@ -47,12 +47,42 @@ RTTIDecls(TGenProtoArbChildNode,TGenProtoExprNode)
 // ---------------------------------------------------------------------------
 TGenProtoExprNode::~TGenProtoExprNode()
 {
+    delete m_peprogRun;
 }
 
 
 // ---------------------------------------------------------------------------
 //  TGenProtoExprNode: Public, virtual methods
 // ---------------------------------------------------------------------------
+
+//
+//  Only nodes that emit an Apply op for themselves get this called, and they
+//  must override it. But just in case, a full evaluation gets the same result.
+//
+tCIDLib::TVoid TGenProtoExprNode::Apply(TGenProtoCtx& ctxToUse)
+{
+    Evaluate(ctxToUse);
+}
+
+
+tCIDLib::TBoolean
+TGenProtoExprNode::bQueryMatchKey(const tCIDLib::TCard4, tCIDLib::TCard4&) const
+{
+    // By default we can't be indexed
+    return kCIDLib::False;
+}
+
+
+//
+//  By default we just get fully evaluated when the program runs. Leaf nodes
+//  don't need anything else.
+//
+tCIDLib::TVoid TGenProtoExprNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Eval, this);
+}
+
+
 tCIDLib::TVoid TGenProtoExprNode::Optimize(TGenProtoCtx& ctxToUse)
 {
     // A purposefully empty default implementation
@@ -114,6 +144,23 @@ tGenProtoS::ETypes TGenProtoExprNode::eType() const
 }
 
 
+//
+//  The runtime code calls this on root nodes, instead of Evaluate(). The first
+//  time, we compile our tree into a flat program. After that we just run it.
+//  The result ends up in our value, same as Evaluate().
+//
+tCIDLib::TVoid TGenProtoExprNode::Run(TGenProtoCtx& ctxToUse)
+{
+    if (!m_peprogRun)
+    {
+        TJanitor<TGenProtoExprProg> janProg(new TGenProtoExprProg);
+        Compile(*janProg.pobjThis());
+        m_peprogRun = janProg.pobjOrphan();
+    }
+    m_peprogRun->Exec(ctxToUse);
+}
+
+
 const TString& TGenProtoExprNode::strDescription() const
 {
     return m_strDescr;
@@ -126,13 +173,19 @@ const TString& TGenProtoExprNode::strDescription() const
 TGenProtoExprNode::TGenProtoExprNode(const  tGenProtoS::ETypes  eType
                                     , const TString&            strDescr) :
     m_evalCur(eType)
+    , m_peprogRun(nullptr)
     , m_strDescr(strDescr)
 {
 }
 
+//
+//  We don't copy the program. It points at the source's nodes, so we compile our
+//  own if we get run.
+//
 TGenProtoExprNode::TGenProtoExprNode(const TGenProtoExprNode& nodeSrc) :
 
     m_evalCur(nodeSrc.m_evalCur)
+    , m_peprogRun(nullptr)
     , m_strDescr(nodeSrc.m_strDescr)
 {
 }
@@ -144,6 +197,10 @@ TGenProtoExprNode::operator=(const TGenProtoExprNode& nodeSrc)
     {
         m_evalCur   = nodeSrc.m_evalCur;
         m_strDescr  = nodeSrc.m_strDescr;
+
+        // Our children are being replaced, so drop any program
+        delete m_peprogRun;
+        m_peprogRun = nullptr;
     }
     return *this;
 }
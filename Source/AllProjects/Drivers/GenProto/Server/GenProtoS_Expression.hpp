@@ -43,6 +43,19 @@
 //  store its value upon demand. It receives a context object, which passes in
 //  some information that is only known at runtime.
 //
+//  The runtime code doesn't call Evaluate() on the root nodes though. It calls
+//  Run(), which compiles the tree into a flat list of ops (see the internal
+//  GenProtoS_ExprProg_.hpp header) upon first use and runs that. Nodes that
+//  override Compile() to emit their children and then an Apply op for themselves
+//  must override Apply() to calculate their value from their already evaluated
+//  children. Evaluate() is then just evaluating the children and calling Apply().
+//  Nodes that don't override Compile() get fully evaluated by the program.
+//
+//  It also defines a bQueryMatchKey() method, which is used to index the msg
+//  matches. Nodes that can only be true if a particular reply byte (or the
+//  reply length) has a particular value override it and return that value.
+//  The default just says no.
+//
 //  We also define here a simple derivative that holds an arbitrary number of
 //  child nodes. This is kind of common, so having a base node to handle the
 //  grunt work is nice. They still have to provide the evaluation and validation
@@ -64,6 +77,7 @@
 #pragma CIDLIB_PACK(CIDLIBPACK)
 
 class TGenProtoCtx;
+class TGenProtoExprProg;
 
 
 // ---------------------------------------------------------------------------
@@ -82,8 +96,24 @@ class GENPROTOSEXPORT TGenProtoExprNode : public TObject, public MDuplicable
         // -------------------------------------------------------------------
         //  Public, virtual methods
         // -------------------------------------------------------------------
+        virtual tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        );
+
         virtual tCIDLib::TBoolean bIsConst() const = 0;
 
+        virtual tCIDLib::TBoolean bQueryMatchKey
+        (
+            const   tCIDLib::TCard4         c4KeyOfs
+            ,       tCIDLib::TCard4&        c4KeyVal
+        )   const;
+
+        virtual tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        );
+
         virtual tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -114,6 +144,11 @@ class GENPROTOSEXPORT TGenProtoExprNode : public TObject, public MDuplicable
 
         tGenProtoS::ETypes eType() const;
 
+        tCIDLib::TVoid Run
+        (
+                    TGenProtoCtx&           ctxThis
+        );
+
         const TString& strDescription() const;
 
 
@@ -217,12 +252,18 @@ class GENPROTOSEXPORT TGenProtoExprNode : public TObject, public MDuplicable
         //      desired evaluation type in the ctor, and we set it on the
         //      value object, which fixes the node's return type.
         //
+        //  m_peprogRun
+        //      If we are the root of an expression that is Run(), this is the
+        //      compiled form of our tree, which is created upon first use. It
+        //      is never copied, since it points at our own child nodes.
+        //
         //  m_strDescr
         //      A descriptive string that is provided by the derived class,
         //      which can be used in error messages. Its not supposed to be
         //      narrative, but something like "Constant Integer" or whatnot.
         // -------------------------------------------------------------------
         TGenProtoExprVal    m_evalCur;
+        TGenProtoExprProg*  m_peprogRun;
         TString             m_strDescr;
 
 
@@ -213,7 +213,7 @@ tCIDLib::TVoid TGenProtoFldInfo::BuildWriteCmd(TGenProtoCtx& ctxToUse)
 
         // Get the node and evaluate it with the current context
         TGenProtoExprNode* pnodeCur = m_colWriteCmd[c4Index];
-        pnodeCur->Evaluate(ctxToUse);
+        pnodeCur->Run(ctxToUse);
 
         //
         //  And ask it to write its value to our buffer. It will update
@@ -75,13 +75,25 @@ TGenProtoMsgMatch::~TGenProtoMsgMatch()
 tCIDLib::TBoolean TGenProtoMsgMatch::bMatches(TGenProtoCtx& ctxToUse)
 {
     // Evaluate our match expressions
-    m_pnodeMatch->Evaluate(ctxToUse);
+    m_pnodeMatch->Run(ctxToUse);
 
     // And return the boolean result
     return m_pnodeMatch->evalCur().bValue();
 }
 
 
+//
+//  Used by the driver to index the matches. See if our expression requires a
+//  particular value for the indicated key.
+//
+tCIDLib::TBoolean
+TGenProtoMsgMatch::bQueryMatchKey(  const   tCIDLib::TCard4     c4KeyOfs
+                                    ,       tCIDLib::TCard4&    c4KeyVal) const
+{
+    return m_pnodeMatch->bQueryMatchKey(c4KeyOfs, c4KeyVal);
+}
+
+
 TGenProtoReply* TGenProtoMsgMatch::prepMatch()
 {
     return m_prepToUse;
@@ -64,6 +64,12 @@ class GENPROTOSEXPORT TGenProtoMsgMatch : public TObject
                     TGenProtoCtx&           ctxToUse
         );
 
+        tCIDLib::TBoolean bQueryMatchKey
+        (
+            const   tCIDLib::TCard4         c4KeyOfs
+            ,       tCIDLib::TCard4&        c4KeyVal
+        )   const;
+
         TGenProtoReply* prepMatch();
 
 
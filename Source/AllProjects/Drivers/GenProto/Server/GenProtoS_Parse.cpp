@@ -2358,6 +2358,9 @@ for (tCIDLib::TCard4 c4Index = 0; c4Index < c4StateCount; c4Index++)
     // And we have to see the the close of the msgs matching and the semicolon
     tokToUse.CheckNextToken(tGenProtoS::ETokens::EndMsgMatching);
     tokToUse.CheckNextToken(tGenProtoS::ETokens::SemiColon);
+
+    // Now we can index the matches
+    BuildMatchIndex();
 }
 
 
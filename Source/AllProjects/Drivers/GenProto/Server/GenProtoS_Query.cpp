@@ -153,7 +153,7 @@ tCIDLib::TVoid TGenProtoQuery::BuildQueryCmd(TGenProtoCtx& ctxToUse)
         try
         {
             TGenProtoExprNode* pnodeCur = m_colExprs[c4Index];
-            pnodeCur->Evaluate(ctxToUse);
+            pnodeCur->Run(ctxToUse);
 
             //
             //  And ask it to write its value to our buffer. It will update
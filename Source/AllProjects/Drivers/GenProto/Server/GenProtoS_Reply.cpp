@@ -178,7 +178,7 @@ tCIDLib::TBoolean TGenProtoReply::bValidateReply(TGenProtoCtx& ctxThis)
         {
             // Get the current node and evaluate it
             TGenProtoExprNode* pnodeCur = m_colValidate[c4Index];
-            pnodeCur->Evaluate(ctxThis);
+            pnodeCur->Run(ctxThis);
 
             // If it comes back false, give up
             if (!pnodeCur->evalCur().bValue())
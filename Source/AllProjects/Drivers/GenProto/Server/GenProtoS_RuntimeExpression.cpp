@@ -110,14 +110,7 @@ TGenProtoCheckSumNode::operator=(const TGenProtoCheckSumNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoCheckSumNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoCheckSumNode::bIsConst() const
-{
-    // We are never const
-    return kCIDLib::False;
-}
-
-
-tCIDLib::TVoid TGenProtoCheckSumNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoCheckSumNode::Apply(TGenProtoCtx& ctxThis)
 {
     // Get the buffer that we are working with
     const TMemBuf* pmbufSrc = (m_eExprType == tGenProtoS::ESpecNodes::ReplyBuf)
@@ -127,10 +120,7 @@ tCIDLib::TVoid TGenProtoCheckSumNode::Evaluate(TGenProtoCtx& ctxThis)
                                      ? ctxThis.c4ReplyBytes()
                                      : ctxThis.c4SendBytes();
 
-    // Evaluate the two expressions and get the offset/len values
-    m_pnodeOfs->Evaluate(ctxThis);
-    m_pnodeLen->Evaluate(ctxThis);
-
+    // Get the offset/len values from our two expressions
     tCIDLib::TCard4         c4Index = m_pnodeOfs->evalCur().c4Value();
     const tCIDLib::TCard4   c4End   = c4Index + m_pnodeLen->evalCur().c4Value();
 
@@ -244,6 +234,31 @@ tCIDLib::TVoid TGenProtoCheckSumNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoCheckSumNode::bIsConst() const
+{
+    // We are never const
+    return kCIDLib::False;
+}
+
+
+tCIDLib::TVoid TGenProtoCheckSumNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeOfs->Compile(eprogTar);
+    m_pnodeLen->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoCheckSumNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeOfs->Evaluate(ctxThis);
+    m_pnodeLen->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 
 tCIDLib::TVoid TGenProtoCheckSumNode::Optimize(TGenProtoCtx& ctxThis)
 {
@@ -361,14 +376,7 @@ TGenProtoCRC16Node::operator=(const TGenProtoCRC16Node& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoCRC16Node: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoCRC16Node::bIsConst() const
-{
-    // We are never const
-    return kCIDLib::False;
-}
-
-
-tCIDLib::TVoid TGenProtoCRC16Node::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoCRC16Node::Apply(TGenProtoCtx& ctxThis)
 {
     // Get the buffer that we are working with
     const TMemBuf* pmbufSrc = (m_eExprType == tGenProtoS::ESpecNodes::ReplyBuf)
@@ -378,10 +386,7 @@ tCIDLib::TVoid TGenProtoCRC16Node::Evaluate(TGenProtoCtx& ctxThis)
                                      ? ctxThis.c4ReplyBytes()
                                      : ctxThis.c4SendBytes();
 
-    // Evaluate the two expressions and get the offset/len values
-    m_pnodeOfs->Evaluate(ctxThis);
-    m_pnodeLen->Evaluate(ctxThis);
-
+    // Get the offset/len values from our two expressions
     tCIDLib::TCard4         c4Index  = m_pnodeOfs->evalCur().c4Value();
     const tCIDLib::TCard4   c4EndInd = c4Index + m_pnodeLen->evalCur().c4Value();
     const tCIDLib::TCard2   c2Poly   = m_pnodePoly->evalCur().c2Value();
@@ -424,6 +429,31 @@ tCIDLib::TVoid TGenProtoCRC16Node::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoCRC16Node::bIsConst() const
+{
+    // We are never const
+    return kCIDLib::False;
+}
+
+
+tCIDLib::TVoid TGenProtoCRC16Node::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeOfs->Compile(eprogTar);
+    m_pnodeLen->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoCRC16Node::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeOfs->Evaluate(ctxThis);
+    m_pnodeLen->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 
 tCIDLib::TVoid TGenProtoCRC16Node::Optimize(TGenProtoCtx& ctxThis)
 {
@@ -518,10 +548,16 @@ tCIDLib::TBoolean TGenProtoFldValNode::bIsConst() const
 
 tCIDLib::TVoid TGenProtoFldValNode::Evaluate(TGenProtoCtx& ctxInfo)
 {
+    //
+    //  The field info gets the field's id once the fields are registered,
+    //  so we can read by id and avoid a name lookup on every evaluation.
+    //
+    TGenProtoSDriver* psdrvSrc = ctxInfo.psdrvThis();
     tCQCKit::EFldTypes eType;
-    const tCIDLib::TBoolean bNew = ctxInfo.psdrvThis()->bReadFieldByName
+    const tCIDLib::TBoolean bNew = psdrvSrc->bReadField
     (
-        m_pfldiSrc->flddInfo().strName()
+        psdrvSrc->c4FieldListId()
+        , m_pfldiSrc->flddInfo().c4Id()
         , m_c4SerialNum
         , m_strValue
         , eType
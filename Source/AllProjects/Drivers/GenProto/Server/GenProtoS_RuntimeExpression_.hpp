@@ -70,8 +70,18 @@ class TGenProtoCheckSumNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -155,8 +165,18 @@ class TGenProtoCRC16Node : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        )  final;
+
         tCIDLib::TBoolean bIsConst() const  final;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        )  final;
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
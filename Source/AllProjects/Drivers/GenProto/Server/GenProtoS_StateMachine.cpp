@@ -157,7 +157,7 @@ tCIDLib::TCard4 TGenProtoStateInfo::c4NextState(TGenProtoCtx& ctxToUse)
         // See if has a transition for the current byte
         try
         {
-            stransCur.pnodeTrans()->Evaluate(ctxToUse);
+            stransCur.pnodeTrans()->Run(ctxToUse);
 
             // If the resulting value is true, then this is our guy
             if (stransCur.pnodeTrans()->evalCur().bValue())
@@ -83,26 +83,45 @@ TGenProtoCatStrNode::operator=(const TGenProtoCatStrNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoCatStrNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TVoid TGenProtoCatStrNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoCatStrNode::Apply(TGenProtoCtx&)
 {
     //
-    //  For each child node in our list, evaluate it, then get its value
-    //  as a string and cat it onto a temp string. At the end, set this temp
-    //  string as our value.
+    //  For each child node in our list, get its (already evaluated) value
+    //  as a string and cat it onto our value. We are always a string so we
+    //  can build it in place and avoid a temp.
     //
-    TString strTmp;
+    TString& strOut = evalCur().strValue();
+    strOut.Clear();
 
     TChildList& colList = colChildren();
     const tCIDLib::TCard4 c4Count = colList.c4ElemCount();
     for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
     {
         TGenProtoExprNode* pnodeCur = colList[c4Index];
-        pnodeCur->Evaluate(ctxThis);
-        strTmp.Append(pnodeCur->evalCur().strValue());
+        strOut.Append(pnodeCur->evalCur().strValue());
     }
+}
+
+
+tCIDLib::TVoid TGenProtoCatStrNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    TChildList& colList = colChildren();
+    const tCIDLib::TCard4 c4Count = colList.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        colList[c4Index]->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
 
-    // Now set our value from the result
-    evalCur().strValue(strTmp);
+tCIDLib::TVoid TGenProtoCatStrNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    TChildList& colList = colChildren();
+    const tCIDLib::TCard4 c4Count = colList.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        colList[c4Index]->Evaluate(ctxThis);
+    Apply(ctxThis);
 }
 
 
@@ -184,6 +203,17 @@ TGenProtoSetCaseNode::operator=(const TGenProtoSetCaseNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoSetCaseNode: Public, inherited methods
 // ---------------------------------------------------------------------------
+tCIDLib::TVoid TGenProtoSetCaseNode::Apply(TGenProtoCtx&)
+{
+    // Get the value of the string node into our value, then adjust the case
+    evalCur().strValue(m_pnodeStr->evalCur().strValue());
+    if (m_bToUpper)
+        evalCur().ToUpper();
+    else
+        evalCur().ToLower();
+}
+
+
 tCIDLib::TBoolean TGenProtoSetCaseNode::bIsConst() const
 {
     // If our child node is const, then we are
@@ -191,17 +221,19 @@ tCIDLib::TBoolean TGenProtoSetCaseNode::bIsConst() const
 }
 
 
+tCIDLib::TVoid TGenProtoSetCaseNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our child goes first, then we calculate our value from it
+    m_pnodeStr->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
 tCIDLib::TVoid TGenProtoSetCaseNode::Evaluate(TGenProtoCtx& ctxThis)
 {
-    // Evaluate the child node to get the value to format
+    // Evaluate our child, then calculate our value from it
     m_pnodeStr->Evaluate(ctxThis);
-
-    // Get the value of the string node into our value, then adjust the case
-    evalCur().strValue(m_pnodeStr->evalCur().strValue());
-    if (m_bToUpper)
-        evalCur().ToUpper();
-    else
-        evalCur().ToLower();
+    Apply(ctxThis);
 }
 
 
@@ -286,6 +318,27 @@ tCIDLib::TBoolean TGenProtoExtractStrBaseNode::bIsConst() const
 }
 
 
+tCIDLib::TVoid TGenProtoExtractStrBaseNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    //
+    //  Our two children go first, then the derived class calculates its value,
+    //  calling GetText() which uses their values.
+    //
+    m_pnodeOfsExpr->Compile(eprogTar);
+    m_pnodeLenExpr->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoExtractStrBaseNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our two children, then let the derived class calculate its value
+    m_pnodeOfsExpr->Evaluate(ctxThis);
+    m_pnodeLenExpr->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoExtractStrBaseNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -314,9 +367,10 @@ tCIDLib::TVoid
 TGenProtoExtractStrBaseNode::GetText(TGenProtoCtx&  ctxThis
                                     , TString&      strToFill)
 {
-    // Evaluate our two nodes, and get out the values for use below
-    m_pnodeOfsExpr->Evaluate(ctxThis);
-    m_pnodeLenExpr->Evaluate(ctxThis);
+    //
+    //  Our two nodes have already been evaluated, by our Evaluate() or by the
+    //  compiled program, so we just use their values below.
+    //
 
     // Get the length of the bufffer we are doing
     const tCIDLib::TCard4 c4SrcLen = (m_eSrcBuf == tGenProtoS::ESpecNodes::ReplyBuf)
@@ -459,7 +513,7 @@ operator=(const TGenProtoExtractASCIIValNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TVoid TGenProtoExtractASCIIValNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoExtractASCIIValNode::Apply(TGenProtoCtx& ctxThis)
 {
     // Get our parent class to extract the value for us
     TString strVal;
@@ -552,12 +606,12 @@ TGenProtoExtractStrNode::operator=(const TGenProtoExtractStrNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TVoid TGenProtoExtractStrNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoExtractStrNode::Apply(TGenProtoCtx& ctxThis)
 {
-    // Get our parent class to extract the value for us
-    TString strVal;
-    GetText(ctxThis, strVal);
-    evalCur().strValue(strVal);
+    // Get our parent class to extract the value for us, directly into our value
+    TString& strOut = evalCur().strValue();
+    strOut.Clear();
+    GetText(ctxThis, strOut);
 }
 
 
@@ -641,25 +695,12 @@ TGenProtoExtractTokNode::operator=(const TGenProtoExtractTokNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoExtractTokNode::bIsConst() const
-{
-    // We are neve constant
-    return kCIDLib::False;
-}
-
-
-tCIDLib::TVoid TGenProtoExtractTokNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoExtractTokNode::Apply(TGenProtoCtx&)
 {
-    // Evaluate our child nodes, and get out the values for use below
-    m_pnodeSepCharExpr->Evaluate(ctxThis);
-    m_pnodeSrcExpr->Evaluate(ctxThis);
-    m_pnodeStripExpr->Evaluate(ctxThis);
-    m_pnodeTokNumExpr->Evaluate(ctxThis);
-
-    // And get the values out
+    // Get the values of our children out
     const tCIDLib::TCard4 c4TokNum = m_pnodeTokNumExpr->evalCur().c4Value();
     const tCIDLib::TCh chSepChar = m_pnodeSepCharExpr->evalCur().strValue()[0];
-    const TString strSrc = m_pnodeSrcExpr->evalCur().strValue();
+    const TString& strSrc = m_pnodeSrcExpr->evalCur().strValue();
 
     // We don't care about the return. If it doesn't extract anything the value will be set to empty
     tCIDLib::IgnoreRet
@@ -675,6 +716,35 @@ tCIDLib::TVoid TGenProtoExtractTokNode::Evaluate(TGenProtoCtx& ctxThis)
 }
 
 
+tCIDLib::TBoolean TGenProtoExtractTokNode::bIsConst() const
+{
+    // We are neve constant
+    return kCIDLib::False;
+}
+
+
+tCIDLib::TVoid TGenProtoExtractTokNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our children go first, then we calculate our value from theirs
+    m_pnodeSepCharExpr->Compile(eprogTar);
+    m_pnodeSrcExpr->Compile(eprogTar);
+    m_pnodeStripExpr->Compile(eprogTar);
+    m_pnodeTokNumExpr->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoExtractTokNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our children, then calculate our value from them
+    m_pnodeSepCharExpr->Evaluate(ctxThis);
+    m_pnodeSrcExpr->Evaluate(ctxThis);
+    m_pnodeStripExpr->Evaluate(ctxThis);
+    m_pnodeTokNumExpr->Evaluate(ctxThis);
+    Apply(ctxThis);
+}
+
+
 tCIDLib::TVoid TGenProtoExtractTokNode::Optimize(TGenProtoCtx& ctxThis)
 {
     //
@@ -768,34 +838,44 @@ TGenProtoFormatNode::operator=(const TGenProtoFormatNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoFormatNode: Public, inherited methods
 // ---------------------------------------------------------------------------
-tCIDLib::TBoolean TGenProtoFormatNode::bIsConst() const
-{
-    // If our child expression is const, then we are
-    return m_pnodeToFormat->bIsConst();
-}
-
-
-tCIDLib::TVoid TGenProtoFormatNode::Evaluate(TGenProtoCtx& ctxThis)
+tCIDLib::TVoid TGenProtoFormatNode::Apply(TGenProtoCtx&)
 {
-    // Evaluate the child node to get the value to format
-    m_pnodeToFormat->Evaluate(ctxThis);
-
     //
-    //  And format it's value into a temp string. We have to do it differently
-    //  according to the type of our child node.
+    //  And format it's value directly into our value, which is always a
+    //  string. We have to do it differently according to the type of our
+    //  child node.
     //
-    TString strTmp;
     m_pnodeToFormat->evalCur().FormatToStr
     (
-        strTmp
+        evalCur().strValue()
         , m_eRadix
         , m_c4Width
         , m_eJustify
         , m_chFill
     );
+}
+
+
+tCIDLib::TBoolean TGenProtoFormatNode::bIsConst() const
+{
+    // If our child expression is const, then we are
+    return m_pnodeToFormat->bIsConst();
+}
+
 
-    // Now set our value from the result
-    evalCur().strValue(strTmp);
+tCIDLib::TVoid TGenProtoFormatNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our child goes first, then we calculate our value from it
+    m_pnodeToFormat->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
+tCIDLib::TVoid TGenProtoFormatNode::Evaluate(TGenProtoCtx& ctxThis)
+{
+    // Evaluate our child, then calculate our value from it
+    m_pnodeToFormat->Evaluate(ctxThis);
+    Apply(ctxThis);
 }
 
 
@@ -879,6 +959,13 @@ TGenProtoIsASCIIXNode::operator=(const TGenProtoIsASCIIXNode& nodeToAssign)
 // ---------------------------------------------------------------------------
 //  TGenProtoIsASCIIXNode: Public, inherited methods
 // ---------------------------------------------------------------------------
+tCIDLib::TVoid TGenProtoIsASCIIXNode::Apply(TGenProtoCtx&)
+{
+    // Check our child's value against the type of char we test for
+    evalCur().bValue(bCheckIt(m_pnodeToCheckExpr->evalCur().c4Value(), m_eType));
+}
+
+
 tCIDLib::TBoolean TGenProtoIsASCIIXNode::bIsConst() const
 {
     // If our child expression is const, then we are
@@ -886,11 +973,19 @@ tCIDLib::TBoolean TGenProtoIsASCIIXNode::bIsConst() const
 }
 
 
+tCIDLib::TVoid TGenProtoIsASCIIXNode::Compile(TGenProtoExprProg& eprogTar)
+{
+    // Our child goes first, then we calculate our value from it
+    m_pnodeToCheckExpr->Compile(eprogTar);
+    eprogTar.c4AddOp(TGenProtoExprProg::EOps::Apply, this);
+}
+
+
 tCIDLib::TVoid TGenProtoIsASCIIXNode::Evaluate(TGenProtoCtx& ctxThis)
 {
-    // Evaluate the expression and get the value to check
+    // Evaluate our child, then calculate our value from it
     m_pnodeToCheckExpr->Evaluate(ctxThis);
-    evalCur().bValue(bCheckIt(m_pnodeToCheckExpr->evalCur().c4Value(), m_eType));
+    Apply(ctxThis);
 }
 
 
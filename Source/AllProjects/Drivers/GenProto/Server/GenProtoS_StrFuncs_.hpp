@@ -61,6 +61,16 @@ class TGenProtoCatStrNode : public TGenProtoArbChildNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        );
+
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        );
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -115,8 +125,18 @@ class TGenProtoSetCaseNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        );
+
         tCIDLib::TBoolean bIsConst() const;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        );
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -169,6 +189,16 @@ class TGenProtoExtractStrBaseNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         tCIDLib::TBoolean bIsConst() const;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        );
+
+        tCIDLib::TVoid Evaluate
+        (
+                    TGenProtoCtx&           ctxThis
+        );
+
         tCIDLib::TVoid Optimize
         (
                     TGenProtoCtx&           ctxThis
@@ -275,7 +305,7 @@ class TGenProtoExtractASCIIValNode : public TGenProtoExtractStrBaseNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
-        tCIDLib::TVoid Evaluate
+        tCIDLib::TVoid Apply
         (
                     TGenProtoCtx&           ctxThis
         );
@@ -338,7 +368,7 @@ class TGenProtoExtractStrNode : public TGenProtoExtractStrBaseNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
-        tCIDLib::TVoid Evaluate
+        tCIDLib::TVoid Apply
         (
                     TGenProtoCtx&           ctxThis
         );
@@ -395,8 +425,18 @@ class TGenProtoExtractTokNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        );
+
         tCIDLib::TBoolean bIsConst() const;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        );
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -476,8 +516,18 @@ class TGenProtoFormatNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        );
+
         tCIDLib::TBoolean bIsConst() const;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        );
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -585,8 +635,18 @@ class TGenProtoIsASCIIXNode : public TGenProtoExprNode
         // -------------------------------------------------------------------
         //  Public, inherited methods
         // -------------------------------------------------------------------
+        tCIDLib::TVoid Apply
+        (
+                    TGenProtoCtx&           ctxThis
+        );
+
         tCIDLib::TBoolean bIsConst() const;
 
+        tCIDLib::TVoid Compile
+        (
+                    TGenProtoExprProg&      eprogTar
+        );
+
         tCIDLib::TVoid Evaluate
         (
                     TGenProtoCtx&           ctxThis
@@ -96,6 +96,7 @@ class TMQTTS;
 #include    "MQTTS_IOEvent.hpp"
 #include    "MQTTS_DrvEvent.hpp"
 #include    "MQTTS_MsgPools.hpp"
+#include    "MQTTS_TopicTrie.hpp"
 
 using TMQTTIOEvPtr = TFixedPoolPtr<TMQTTIOEvent>;
 using TMQTTDrvEvPtr = TFixedPoolPtr<TMQTTDrvEvent>;
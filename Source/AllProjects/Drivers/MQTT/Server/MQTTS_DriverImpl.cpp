@@ -64,13 +64,15 @@ TMQTTS::~TMQTTS()
 
 //
 //  The I/O thread calls us here to queue up I/O events. The queue is thread safe
-//  so we can just drop them in.
+//  so we can just drop them in. We wake up the driver thread so that it gets
+//  processed now, instead of when the next poll comes around.
 //
 tCIDLib::TVoid TMQTTS::QueueIOEvent(TMQTTIOEvPtr& evptrToQ)
 {
     if (!m_colIOEvQ.bIsFull(1024))
     {
         m_colIOEvQ.objAdd(evptrToQ);
+        WakeForPoll();
     }
      else
     {
@@ -319,12 +321,12 @@ TMQTTS::eFloatFldValChanged(const   TString&            strName
 tCQCKit::EDrvInitRes TMQTTS::eInitializeImpl()
 {
     //
-    //  We want to poll quickly, because we get queued up reports from the I/O
-    //  thread that we need to process. The reconnect time isn't really us since
-    //  the I/O thread does that. But we want to report it periodically as we
-    //  try to connect.
+    //  The I/O thread wakes us up when it queues up reports for us to process, so
+    //  the poll time is just a backstop and doesn't need to be fast. The reconnect
+    //  time isn't really us since the I/O thread does that. But we want to report
+    //  it periodically as we try to connect.
     //
-    SetPollTimes(50, 5000);
+    SetPollTimes(250, 5000);
 
     // Start up he I/O thread
     m_thrIO.Start();
@@ -365,11 +367,15 @@ TMQTTS::eIntFldValChanged(  const   TString&        strName
 
 //
 //  We just need to grab any reports from the I/O thread out of the I/O queue,
-//  and process them as needed.
+//  and process them as needed. If there are still some left when our time is
+//  up, we ask to be polled again right away.
 //
 tCQCKit::ECommResults TMQTTS::ePollDevice(TThread& thrThis)
 {
-    return eProcessIOEvents(10);
+    const tCQCKit::ECommResults eRes = eProcessIOEvents(10);
+    if ((eRes == tCQCKit::ECommResults::Success) && !m_colIOEvQ.bIsEmpty())
+        WakeForPoll();
+    return eRes;
 }
 
 
@@ -622,8 +628,11 @@ tCIDLib::TVoid TMQTTS::SendEvTrigger(const TMQTTIOEvent& ioevSrc)
     if ((ioevSrc.m_eSemType == tCQCKit::EFldSTypes::MotionSensor)
     ||  (ioevSrc.m_eSemType == tCQCKit::EFldSTypes::LightSwitch))
     {
-        // We have to convert the value string to a boolean
-        tCIDLib::TBoolean bVal = facCQCKit().bCheckBoolVal(ioevSrc.m_strValue);
+        // If the value didn't come through as binary, convert from text
+        const TMQTTInVal& mqivVal = ioevSrc.m_mqivValue;
+        tCIDLib::TBoolean bVal = mqivVal.m_bValue;
+        if (mqivVal.bIsText())
+            bVal = facCQCKit().bCheckBoolVal(mqivVal.m_strValue);
 
         // Get the two bits that are different between these
         tCQCKit::EStdDrvEvs eEvent;
@@ -752,10 +761,36 @@ tCIDLib::TVoid TMQTTS::StoreFldVal(const TMQTTIOEvPtr& evptrStore)
                         );
                     }
 
-                    WriteField
-                    (
-                        c4FieldListId(), c4FldId, evptrStore->m_strValue, kCIDLib::True
-                    );
+                    //
+                    //  If the value map gave us a binary value, store it directly,
+                    //  else let the base class parse and validate the text.
+                    //
+                    const TMQTTInVal& mqivVal = evptrStore->m_mqivValue;
+                    switch(mqivVal.m_eType)
+                    {
+                        case tCQCKit::EFldTypes::Boolean :
+                            bStoreBoolFld(c4FldId, mqivVal.m_bValue, kCIDLib::True);
+                            break;
+
+                        case tCQCKit::EFldTypes::Card :
+                            bStoreCardFld(c4FldId, mqivVal.m_c4Value, kCIDLib::True);
+                            break;
+
+                        case tCQCKit::EFldTypes::Float :
+                            bStoreFloatFld(c4FldId, mqivVal.m_f8Value, kCIDLib::True);
+                            break;
+
+                        case tCQCKit::EFldTypes::Int :
+                            bStoreIntFld(c4FldId, mqivVal.m_i4Value, kCIDLib::True);
+                            break;
+
+                        default :
+                            WriteField
+                            (
+                                c4FieldListId(), c4FldId, mqivVal.m_strValue, kCIDLib::True
+                            );
+                            break;
+                    };
 
                     if (facMQTTSh().bTraceMode())
                     {
@@ -63,6 +63,7 @@ tCIDLib::TVoid TMQTTIOEvent::Reset()
     m_eFldType  = tCQCKit::EFldTypes::Count;
     m_eIOState  = tMQTTSh::EClStates::Count;
     m_eSemType  = tCQCKit::EFldSTypes::Count;
+    m_mqivValue.Reset();
     m_strValue.Clear();
     m_strFldName.Clear();
 }
@@ -95,7 +96,7 @@ TMQTTIOEvent::SetFldWriteRes(const  TMQTTFldCfg&            mqfldcSrc
 }
 
 tCIDLib::TVoid
-TMQTTIOEvent::SetNewValEvent(const TMQTTFldCfg& mqfldcSrc, const TString& strNewFldVal)
+TMQTTIOEvent::SetNewValEvent(const TMQTTFldCfg& mqfldcSrc, const TMQTTInVal& mqivNewVal)
 {
     Reset();
     m_bV2Compat = mqfldcSrc.bV2Compat();
@@ -105,5 +106,5 @@ TMQTTIOEvent::SetNewValEvent(const TMQTTFldCfg& mqfldcSrc, const TString& strNew
     m_eSemType = mqfldcSrc.eSemType();
     m_strBaseName = mqfldcSrc.strBaseName();
     m_strFldName = mqfldcSrc.strFldName();
-    m_strValue = strNewFldVal;
+    m_mqivValue = mqivNewVal;
 }
@@ -66,7 +66,7 @@ class TMQTTIOEvent : public TObject
         tCIDLib::TVoid SetNewValEvent
         (
             const   TMQTTFldCfg&            mqfldcSrc
-            , const TString&                strNewFldVal
+            , const TMQTTInVal&             mqivNewVal
         );
 
 
@@ -96,6 +96,12 @@ class TMQTTIOEvent : public TObject
         //      If a publish event, we pass along the semantic type, which may be
         //      needed for event trigger sending purposes.
         //
+        //  m_mqivValue
+        //      For new value events, the mapped field value. Where the value map
+        //      could provide it in binary form it is that, so the driver can store
+        //      it directly. Else it is text, and the driver base class handles
+        //      translating it to the target format and validating it.
+        //
         //  m_strBaseName
         //      If a field store event, we pass along the base name so that it can
         //      be put into any outgoing event trigger if one is sent.
@@ -105,11 +111,6 @@ class TMQTTIOEvent : public TObject
         //      event.
         //
         //  m_strValue
-        //      We store all the values as text. The driver base class already
-        //      has all of the code to handle translating to the target format
-        //      and validating the value and all that. So we just save ourselves
-        //      a lot of redundancy.
-        //
         //      For field write failure events, we put an error msg in here.
         // -------------------------------------------------------------------
         tCIDLib::TBoolean       m_bV2Compat;
@@ -118,6 +119,7 @@ class TMQTTIOEvent : public TObject
         tCQCKit::EFldTypes      m_eFldType;
         tMQTTSh::EClStates      m_eIOState;
         tCQCKit::EFldSTypes     m_eSemType;
+        TMQTTInVal              m_mqivValue;
         TString                 m_strBaseName;
         TString                 m_strFldName;
         TString                 m_strValue;
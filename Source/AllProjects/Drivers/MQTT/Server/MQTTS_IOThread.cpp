@@ -426,6 +426,9 @@ tCIDLib::TBoolean TMQTTIOThread::bLoadConfig() noexcept
             TLocker lockrSync(&m_mtxSync);
             m_mqcfgCurrent = mqcfgTest;
 
+            // Rebuild the topic trie, since it points into the config
+            m_trieFlds.Build(m_mqcfgCurrent);
+
             if (facMQTTSh().bTraceMode())
             {
                 facMQTTSh().LogTraceMsg
@@ -1114,76 +1117,70 @@ tCIDLib::TVoid TMQTTIOThread::ProcessPublish(const TMQTTInMsgPtr& mptrSrc) noexc
     //
     //  We need to find any fields with the reported topic path and let them grab
     //  the data out of the payload so that we can pass it on to the main driver
-    //  thread.
+    //  thread. The topic trie gives us the matching fields.
     //
-    tCIDLib::TCard4 c4Matches = 0;
-    TMQTTCfg::TFldCursor cursFlds = m_mqcfgCurrent.cursFldList();
     const TString& strSrcTopic = mptrSrc->strTopicPathAt(0);
-    for (; cursFlds; ++cursFlds)
+    const tCIDLib::TCard4 c4Matches = m_trieFlds.c4FindMatches(strSrcTopic);
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Matches; c4Index++)
     {
-        if (cursFlds->bMatchesInTopic(strSrcTopic))
-        {
-            c4Matches++;
+        const TMQTTFldCfg& mqfldcCur = m_trieFlds.mqfldcMatchAt(c4Index);
 
-            // If this field is write only, ignore any incomng values
-            if (!cursFlds->bReadable())
-            {
-                if (facMQTTSh().bTraceMode())
-                {
-                    facMQTTSh().LogTraceErr
-                    (
-                        tMQTTSh::EMsgSrcs::IOThread
-                        , L"Ignoring new value for write-only field %(1)"
-                        , cursFlds->strFldName()
-                    );
-                }
-            }
-            else if (cursFlds->bRejected())
+        // If this field is write only, ignore any incomng values
+        if (!mqfldcCur.bReadable())
+        {
+            if (facMQTTSh().bTraceMode())
             {
-                //
-                //  This field was rejected by the server, or the sub was never acknowledged.
-                //  so this can't be right.
-                //
-                if (facMQTTSh().bTraceMode())
-                {
-                    facMQTTSh().LogTraceErr
-                    (
-                        tMQTTSh::EMsgSrcs::IOThread
-                        , L"Got new value for rejected topic: %(1)"
-                        , strSrcTopic
-                    );
-                }
+                facMQTTSh().LogTraceErr
+                (
+                    tMQTTSh::EMsgSrcs::IOThread
+                    , L"Ignoring new value for write-only field %(1)"
+                    , mqfldcCur.strFldName()
+                );
             }
-            else
+        }
+        else if (mqfldcCur.bRejected())
+        {
+            //
+            //  This field was rejected by the server, or the sub was never acknowledged.
+            //  so this can't be right.
+            //
+            if (facMQTTSh().bTraceMode())
             {
-                const TString& strFldName = cursFlds->strFldName();
-                TString strVal;
-                const tMQTTSh::EInMapRes eRes = cursFlds->eMapInVal
+                facMQTTSh().LogTraceErr
                 (
-                    mptrSrc->mbufPayload(), mptrSrc->c4PLBytes(), strVal
+                    tMQTTSh::EMsgSrcs::IOThread
+                    , L"Got new value for rejected topic: %(1)"
+                    , strSrcTopic
                 );
+            }
+        }
+        else
+        {
+            const tMQTTSh::EInMapRes eRes = mqfldcCur.eMapInVal
+            (
+                mptrSrc->mbufPayload(), mptrSrc->c4PLBytes(), m_mqivTmp
+            );
 
-                if (eRes == tMQTTSh::EInMapRes::GoodVal)
-                {
-                    TMQTTIOEvPtr evptrNew = m_psdrvMQTT->spptrIOEvent();;
-                    evptrNew->SetNewValEvent(*cursFlds, strVal);
-                    m_psdrvMQTT->QueueIOEvent(evptrNew);
-                }
-                else if ((eRes == tMQTTSh::EInMapRes::NotFound)
-                     ||  (eRes == tMQTTSh::EInMapRes::BadVal))
-                {
-                    TMQTTIOEvPtr evptrNew = m_psdrvMQTT->spptrIOEvent();;
-                    evptrNew->SetBadValEvent(*cursFlds);
-                    m_psdrvMQTT->QueueIOEvent(evptrNew);
-                }
-				 else if (eRes == tMQTTSh::EInMapRes::Ignore)
-				{
-					// Just pretend it didn't happen
-				}
-                 else
-                {
-                    CIDAssert2(L"Unknown input map result");
-                }
+            if (eRes == tMQTTSh::EInMapRes::GoodVal)
+            {
+                TMQTTIOEvPtr evptrNew = m_psdrvMQTT->spptrIOEvent();;
+                evptrNew->SetNewValEvent(mqfldcCur, m_mqivTmp);
+                m_psdrvMQTT->QueueIOEvent(evptrNew);
+            }
+            else if ((eRes == tMQTTSh::EInMapRes::NotFound)
+                 ||  (eRes == tMQTTSh::EInMapRes::BadVal))
+            {
+                TMQTTIOEvPtr evptrNew = m_psdrvMQTT->spptrIOEvent();;
+                evptrNew->SetBadValEvent(mqfldcCur);
+                m_psdrvMQTT->QueueIOEvent(evptrNew);
+            }
+             else if (eRes == tMQTTSh::EInMapRes::Ignore)
+            {
+                // Just pretend it didn't happen
+            }
+             else
+            {
+                CIDAssert2(L"Unknown input map result");
             }
         }
     }
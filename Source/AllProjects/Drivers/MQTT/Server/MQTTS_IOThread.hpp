@@ -228,6 +228,10 @@ class TMQTTIOThread : public TThread
         //      file. We won't continue forward until we successfully load some
         //      config.
         //
+        //  m_mqivTmp
+        //      A temp to map incoming publish values into before they are passed
+        //      on to the driver, reused so that we aren't creating one per msg.
+        //
         //  m_mtxSync
         //      We have some synchronization requirements internally. We need to sync
         //      the out msg queue and related triggering event to avoid race conditions.
@@ -256,6 +260,11 @@ class TMQTTIOThread : public TThread
         //      This is set up over m_mbufRead and reused each time a msg is ready by
         //      just resettings the end of stream position. This is passed to in msgs
         //      to parse from. It is set to big endian of course.
+        //
+        //  m_trieFlds
+        //      A trie of the field topic paths, rebuilt whenever the config is
+        //      loaded, so that we can quickly find the fields an incoming publish
+        //      msg is for.
         // -------------------------------------------------------------------
         tCIDLib::TBoolean           m_bSecureConn;
         tCIDLib::TCard2             m_c2NextPacketId;
@@ -269,10 +278,12 @@ class TMQTTIOThread : public TThread
         TLogLimiter                 m_loglToUse;
         THeapBuf                    m_mbufRead;
         TMQTTCfg                    m_mqcfgCurrent;
+        TMQTTInVal                  m_mqivTmp;
         TMutex                      m_mtxSync;
         TCIDSockStreamBasedDataSrc* m_pcdsMQTT;
         TMQTTS*                     m_psdrvMQTT;
         TString                     m_strCfgFilePath;
         TString                     m_strTmpPL;
         TBinMBufInStream            m_strmReadBuf;
+        TMQTTTopicTrie              m_trieFlds;
 };
@@ -0,0 +1,316 @@
+//
+// FILE NAME: MQTTS_TopicTrie.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the topic trie that the I/O thread uses to map incoming
+//  topics to fields.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+
+// ---------------------------------------------------------------------------
+//  Bring in our own public header
+// ---------------------------------------------------------------------------
+#include    "MQTTS_.hpp"
+
+
+
+// ---------------------------------------------------------------------------
+//  Local data
+// ---------------------------------------------------------------------------
+namespace
+{
+    namespace MQTTS_TopicTrie
+    {
+        // The modulus for the link hash set
+        constexpr tCIDLib::TCard4   c4Modulus = 109;
+    }
+}
+
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TMQTTTopicTrie
+//  PREFIX: trie
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TMQTTTopicTrie: Constructors and Destructor
+// ---------------------------------------------------------------------------
+TMQTTTopicTrie::TMQTTTopicTrie() :
+
+    m_colFlds(tCIDLib::EAdoptOpts::NoAdopt)
+    , m_colLinks
+      (
+        MQTTS_TopicTrie::c4Modulus, TStringKeyOps(kCIDLib::False), &TLink::strKey
+      )
+    , m_fcolAltFlds(8UL)
+    , m_fcolCurNodes(8UL)
+    , m_fcolNextNodes(8UL)
+    , m_fcolMatches(8UL)
+{
+    // Make sure we always have the root node
+    Reset();
+}
+
+TMQTTTopicTrie::~TMQTTTopicTrie()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TMQTTTopicTrie: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+// Reset and build up the trie for the fields in the passed config
+tCIDLib::TVoid TMQTTTopicTrie::Build(const TMQTTCfg& mqcfgSrc)
+{
+    Reset();
+
+    TMQTTCfg::TFldCursor cursFlds = mqcfgSrc.cursFldList();
+    for (; cursFlds; ++cursFlds)
+    {
+        const tCIDLib::TCard4 c4FldIndex = m_colFlds.c4ElemCount();
+        m_colFlds.Add(&cursFlds.objRCur());
+        AddField(*cursFlds, c4FldIndex);
+    }
+}
+
+
+//
+//  Find the fields that match the passed topic. We return the number of them,
+//  and the caller can get them via mqfldcMatchAt().
+//
+tCIDLib::TCard4 TMQTTTopicTrie::c4FindMatches(const TString& strTopic)
+{
+    m_fcolMatches.RemoveAll();
+    m_fcolCurNodes.RemoveAll();
+    m_fcolCurNodes.c4AddElement(0);
+
+    // Wildcards at the first level don't match system topics
+    const tCIDLib::TBoolean bSysTopic = (strTopic.chFirst() == kCIDLib::chDollarSign);
+
+    const tCIDLib::TCard4 c4Len = strTopic.c4Length();
+    tCIDLib::TCard4 c4Start = 0;
+    tCIDLib::TBoolean bFirst = kCIDLib::True;
+    while (!m_fcolCurNodes.bIsEmpty())
+    {
+        // Find the end of this level
+        tCIDLib::TCard4 c4End = c4Start;
+        while ((c4End < c4Len) && (strTopic[c4End] != kCIDLib::chForwardSlash))
+            c4End++;
+
+        m_fcolNextNodes.RemoveAll();
+        const tCIDLib::TCard4 c4CurCnt = m_fcolCurNodes.c4ElemCount();
+        for (tCIDLib::TCard4 c4Index = 0; c4Index < c4CurCnt; c4Index++)
+        {
+            const tCIDLib::TCard4 c4NodeIndex = m_fcolCurNodes[c4Index];
+            const TNode& nodeCur = m_colNodes[c4NodeIndex];
+            const tCIDLib::TBoolean bWildOK = !bFirst || !bSysTopic;
+
+            // A # child matches everything from here down
+            if (bWildOK && (nodeCur.m_c4HashChild != kCIDLib::c4MaxCard))
+                AddMatches(nodeCur.m_c4HashChild);
+
+            if (bWildOK && (nodeCur.m_c4PlusChild != kCIDLib::c4MaxCard))
+                m_fcolNextNodes.c4AddElement(nodeCur.m_c4PlusChild);
+
+            BuildLinkKey(c4NodeIndex, strTopic, c4Start, c4End);
+            const TLink* plinkChild = m_colLinks.pobjFindByKey(m_strKey);
+            if (plinkChild)
+                m_fcolNextNodes.c4AddElement(plinkChild->m_c4Node);
+        }
+
+        //
+        //  If that was the last level, then the fields of the nodes we got to
+        //  are matches, along with any # children of them, since # also matches
+        //  the parent level.
+        //
+        if (c4End >= c4Len)
+        {
+            const tCIDLib::TCard4 c4NextCnt = m_fcolNextNodes.c4ElemCount();
+            for (tCIDLib::TCard4 c4Index = 0; c4Index < c4NextCnt; c4Index++)
+            {
+                const tCIDLib::TCard4 c4NodeIndex = m_fcolNextNodes[c4Index];
+                AddMatches(c4NodeIndex);
+
+                const TNode& nodeCur = m_colNodes[c4NodeIndex];
+                if (nodeCur.m_c4HashChild != kCIDLib::c4MaxCard)
+                    AddMatches(nodeCur.m_c4HashChild);
+            }
+            break;
+        }
+
+        // Move forward to the next level
+        m_fcolCurNodes = m_fcolNextNodes;
+        c4Start = c4End + 1;
+        bFirst = kCIDLib::False;
+    }
+
+    //
+    //  And check any fields with alt topics. If its main topic matches, then
+    //  it was found in the trie above, so skip it or we'd report it twice.
+    //
+    const tCIDLib::TCard4 c4AltCnt = m_fcolAltFlds.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4AltCnt; c4Index++)
+    {
+        const tCIDLib::TCard4 c4FldIndex = m_fcolAltFlds[c4Index];
+        const TMQTTFldCfg& mqfldcCur = *m_colFlds[c4FldIndex];
+        if (!strTopic.bCompareI(mqfldcCur.strTopicPath())
+        &&  mqfldcCur.bMatchesInTopic(strTopic))
+        {
+            m_fcolMatches.c4AddElement(c4FldIndex);
+        }
+    }
+    return m_fcolMatches.c4ElemCount();
+}
+
+
+const TMQTTFldCfg& TMQTTTopicTrie::mqfldcMatchAt(const tCIDLib::TCard4 c4At) const
+{
+    return *m_colFlds[m_fcolMatches[c4At]];
+}
+
+
+tCIDLib::TVoid TMQTTTopicTrie::Reset()
+{
+    m_colFlds.RemoveAll();
+    m_colLinks.RemoveAll();
+    m_colNodes.RemoveAll();
+    m_fcolAltFlds.RemoveAll();
+    m_fcolMatches.RemoveAll();
+
+    // Put back the root node
+    c4AddNode();
+}
+
+
+// ---------------------------------------------------------------------------
+//  TMQTTTopicTrie: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Add the passed field to the trie, creating nodes for its topic levels as
+//  required.
+//
+tCIDLib::TVoid
+TMQTTTopicTrie::AddField(const  TMQTTFldCfg&        mqfldcToAdd
+                        , const tCIDLib::TCard4     c4FldIndex)
+{
+    const TString& strTopic = mqfldcToAdd.strTopicPath();
+    const tCIDLib::TBoolean bWildcards
+    (
+        strTopic.bContainsChar(kCIDLib::chPlusSign)
+        || strTopic.bContainsChar(kCIDLib::chPoundSign)
+    );
+
+    // If an alt topic, it goes into the alt list
+    if (mqfldcToAdd.bHasAltInTopic())
+    {
+        m_fcolAltFlds.c4AddElement(c4FldIndex);
+
+        // If the main topic has wildcards, the regular expression filters it
+        if (bWildcards)
+            return;
+    }
+
+    const tCIDLib::TCard4 c4Len = strTopic.c4Length();
+    tCIDLib::TCard4 c4Start = 0;
+    tCIDLib::TCard4 c4NodeIndex = 0;
+    while (kCIDLib::True)
+    {
+        tCIDLib::TCard4 c4End = c4Start;
+        while ((c4End < c4Len) && (strTopic[c4End] != kCIDLib::chForwardSlash))
+            c4End++;
+
+        const tCIDLib::TBoolean bOneChar = (c4End - c4Start) == 1;
+        if (bOneChar && (strTopic[c4Start] == kCIDLib::chPoundSign))
+        {
+            // A # has to be the last level, so we are done either way
+            if (m_colNodes[c4NodeIndex].m_c4HashChild == kCIDLib::c4MaxCard)
+            {
+                const tCIDLib::TCard4 c4New = c4AddNode();
+                m_colNodes[c4NodeIndex].m_c4HashChild = c4New;
+            }
+            c4NodeIndex = m_colNodes[c4NodeIndex].m_c4HashChild;
+            break;
+        }
+         else if (bOneChar && (strTopic[c4Start] == kCIDLib::chPlusSign))
+        {
+            if (m_colNodes[c4NodeIndex].m_c4PlusChild == kCIDLib::c4MaxCard)
+            {
+                const tCIDLib::TCard4 c4New = c4AddNode();
+                m_colNodes[c4NodeIndex].m_c4PlusChild = c4New;
+            }
+            c4NodeIndex = m_colNodes[c4NodeIndex].m_c4PlusChild;
+        }
+         else
+        {
+            BuildLinkKey(c4NodeIndex, strTopic, c4Start, c4End);
+            const TLink* plinkChild = m_colLinks.pobjFindByKey(m_strKey);
+            if (plinkChild)
+            {
+                c4NodeIndex = plinkChild->m_c4Node;
+            }
+             else
+            {
+                c4NodeIndex = c4AddNode();
+                m_colLinks.objAdd(TLink(m_strKey, c4NodeIndex));
+            }
+        }
+
+        if (c4End >= c4Len)
+            break;
+        c4Start = c4End + 1;
+    }
+    m_colNodes[c4NodeIndex].m_fcolFlds.c4AddElement(c4FldIndex);
+}
+
+
+// Add the fields of the indicated node to the match list
+tCIDLib::TVoid TMQTTTopicTrie::AddMatches(const tCIDLib::TCard4 c4NodeIndex)
+{
+    const TNode& nodeSrc = m_colNodes[c4NodeIndex];
+    const tCIDLib::TCard4 c4Count = nodeSrc.m_fcolFlds.c4ElemCount();
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Count; c4Index++)
+        m_fcolMatches.c4AddElement(nodeSrc.m_fcolFlds[c4Index]);
+}
+
+
+//
+//  Build up the key for a literal child link, which is the parent node index
+//  and the level text, into the m_strKey temp.
+//
+tCIDLib::TVoid
+TMQTTTopicTrie::BuildLinkKey(const  tCIDLib::TCard4 c4Parent
+                            , const TString&        strTopic
+                            , const tCIDLib::TCard4 c4Start
+                            , const tCIDLib::TCard4 c4End)
+{
+    m_strKey.SetFormatted(c4Parent);
+    m_strKey.Append(kCIDLib::chForwardSlash);
+    if (c4End > c4Start)
+        m_strKey.AppendSubStr(strTopic, c4Start, c4End - c4Start);
+}
+
+
+tCIDLib::TCard4 TMQTTTopicTrie::c4AddNode()
+{
+    m_colNodes.objAdd(TNode());
+    return m_colNodes.c4ElemCount() - 1;
+}
@@ -0,0 +1,215 @@
+//
+// FILE NAME: MQTTS_TopicTrie.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  The I/O thread has to find the fields that an incoming publish msg is for.
+//  Rather than checking every field against every msg, we build a trie of
+//  the field topic paths when the config is loaded, one node per topic level.
+//  So finding the fields for a topic just requires walking down its levels.
+//
+//  Topic levels of + and # are handled as MQTT wildcards, i.e. + matches any
+//  single level and # matches any number of levels (including none) at the
+//  end of the topic. As with the MQTT spec, wildcards at the first level
+//  don't match topics that start with $. Literal levels are compared non-
+//  case sensitively, same as the original field topic comparison.
+//
+//  Fields with an AltInTopic regular expression have to be checked against
+//  every topic, so they are kept in a separate list and checked linearly. If
+//  such a field's main topic has wildcards, it isn't put into the trie, since
+//  the regular expression is how the user indicates which of the topics that
+//  the wildcard subscription returns it wants.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1.  We hold pointers to the fields in the config object we were built
+//      from, so we have to be rebuilt any time that config is replaced.
+//
+// LOG:
+//
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TMQTTTopicTrie
+//  PREFIX: trie
+// ---------------------------------------------------------------------------
+class TMQTTTopicTrie
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Constructors and Destructor
+        // -------------------------------------------------------------------
+        TMQTTTopicTrie();
+
+        TMQTTTopicTrie(const TMQTTTopicTrie&) = delete;
+        TMQTTTopicTrie(TMQTTTopicTrie&&) = delete;
+
+        ~TMQTTTopicTrie();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TMQTTTopicTrie& operator=(const TMQTTTopicTrie&) = delete;
+        TMQTTTopicTrie& operator=(TMQTTTopicTrie&&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid Build
+        (
+            const   TMQTTCfg&               mqcfgSrc
+        );
+
+        tCIDLib::TCard4 c4FindMatches
+        (
+            const   TString&                strTopic
+        );
+
+        const TMQTTFldCfg& mqfldcMatchAt
+        (
+            const   tCIDLib::TCard4         c4At
+        )   const;
+
+        tCIDLib::TVoid Reset();
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private types
+        //
+        //  TNode is a level in the trie. It has the indices of the fields that
+        //  end at this level, and the indices of any wildcard children. The
+        //  literal children are in the link list, keyed by the parent node
+        //  index and the level text, so that we don't need a hash set per node.
+        // -------------------------------------------------------------------
+        class TNode
+        {
+            public :
+                TNode() :
+
+                    m_c4HashChild(kCIDLib::c4MaxCard)
+                    , m_c4PlusChild(kCIDLib::c4MaxCard)
+                    , m_fcolFlds(1UL)
+                {
+                }
+
+                TNode(const TNode&) = default;
+                TNode(TNode&&) = default;
+                ~TNode() = default;
+                TNode& operator=(const TNode&) = default;
+                TNode& operator=(TNode&&) = default;
+
+                tCIDLib::TCard4                 m_c4HashChild;
+                tCIDLib::TCard4                 m_c4PlusChild;
+                TFundVector<tCIDLib::TCard4>    m_fcolFlds;
+        };
+
+        class TLink
+        {
+            public :
+                static const TString& strKey(const TLink& linkSrc)
+                {
+                    return linkSrc.m_strKey;
+                }
+
+                TLink(const TString& strKey, const tCIDLib::TCard4 c4Node) :
+
+                    m_c4Node(c4Node)
+                    , m_strKey(strKey)
+                {
+                }
+
+                TLink(const TLink&) = default;
+                TLink(TLink&&) = default;
+                ~TLink() = default;
+                TLink& operator=(const TLink&) = default;
+                TLink& operator=(TLink&&) = default;
+
+                tCIDLib::TCard4     m_c4Node;
+                TString             m_strKey;
+        };
+
+        using TFldList = TRefVector<const TMQTTFldCfg>;
+        using TLinkList = TKeyedHashSet<TLink, TString, TStringKeyOps>;
+        using TNodeList = TVector<TNode>;
+
+
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid AddField
+        (
+            const   TMQTTFldCfg&            mqfldcToAdd
+            , const tCIDLib::TCard4         c4FldIndex
+        );
+
+        tCIDLib::TVoid AddMatches
+        (
+            const   tCIDLib::TCard4         c4NodeIndex
+        );
+
+        tCIDLib::TVoid BuildLinkKey
+        (
+            const   tCIDLib::TCard4         c4Parent
+            , const TString&                strTopic
+            , const tCIDLib::TCard4         c4Start
+            , const tCIDLib::TCard4         c4End
+        );
+
+        tCIDLib::TCard4 c4AddNode();
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_colFlds
+        //      The fields we were built for. The nodes and other lists refer to
+        //      them by index. We don't own them, they are in the config object.
+        //
+        //  m_colLinks
+        //      The literal child links of all of the nodes, keyed by the parent
+        //      node index and the level text, non-case sensitive.
+        //
+        //  m_colNodes
+        //      The trie nodes. The first one is always the root.
+        //
+        //  m_fcolAltFlds
+        //      The indices of the fields that have an alternate input topic and
+        //      so have to be checked against every incoming topic.
+        //
+        //  m_fcolCurNodes
+        //  m_fcolNextNodes
+        //      Used while matching, to hold the nodes matched at the current
+        //      level and to build up those matched at the next level. They are
+        //      members so that we don't allocate them for every msg.
+        //
+        //  m_fcolMatches
+        //      The indices of the fields that matched the last topic we were
+        //      asked to match.
+        //
+        //  m_strKey
+        //      A temp for building up link keys.
+        // -------------------------------------------------------------------
+        TFldList                        m_colFlds;
+        TLinkList                       m_colLinks;
+        TNodeList                       m_colNodes;
+        TFundVector<tCIDLib::TCard4>    m_fcolAltFlds;
+        TFundVector<tCIDLib::TCard4>    m_fcolCurNodes;
+        TFundVector<tCIDLib::TCard4>    m_fcolNextNodes;
+        TFundVector<tCIDLib::TCard4>    m_fcolMatches;
+        TString                         m_strKey;
+};
@@ -366,143 +366,76 @@ TMQTTFldCfg::eMapInVal( const   TMemBuf&        mbufVal
                         , const tCIDLib::TCard4 c4Bytes
                         ,       TString&        strFldVal) const
 {
-    TString strInVal;
-    try
-    {
-        // We have to extract the value based on payload format
-        switch (m_mqplfData.m_eType)
-        {
-            case  tMQTTSh::EPLTypes::Card :
-            {
-                tCIDLib::TCard4 c4Val;
-                if (!bExtractCard(mbufVal, c4Bytes, c4Val))
-                    return tMQTTSh::EInMapRes::BadVal;
-                strInVal.AppendFormatted(c4Val);
-                break;
-            }
-
-            case  tMQTTSh::EPLTypes::Int :
-            {
-                tCIDLib::TInt4 i4Val;
-                if (!bExtractInt(mbufVal, c4Bytes, i4Val))
-                    return tMQTTSh::EInMapRes::BadVal;
-                strInVal.AppendFormatted(i4Val);
-                break;
-            }
+    const tMQTTSh::EInMapRes eRes = eGetMQTTVal(mbufVal, c4Bytes);
+    if (eRes != tMQTTSh::EInMapRes::GoodVal)
+        return eRes;
 
-            case  tMQTTSh::EPLTypes::BinText :
-            case  tMQTTSh::EPLTypes::Text :
-            {
-                if (m_mqplfData.m_eType == tMQTTSh::EPLTypes::Text)
-                {
-                    TMQTTInMsg::ParseMQString(strInVal, mbufVal, c4Bytes);
-                }
-                 else
-                {
-                    // Try to transcode the binary text
-                    if (m_mqplfData.m_c4Offset + m_mqplfData.m_c4Bytes > c4Bytes)
-                    {
-                        // Can't be right
-                        if (facMQTTSh().bTraceMode())
-                        {
-                            facMQTTSh().LogTraceErr
-                            (
-                                tMQTTSh::EMsgSrcs::IOThread
-                                , L"The payload offset+bytes goes beyond the available incoming data"
-                            );
-                        }
-                        return tMQTTSh::EInMapRes::BadVal;
-                    }
+    // And now let the map do the actual mapping of the MQTT value to a field value
+    return m_cptrMap->eMapInVal(m_eType, m_eSemType, m_strTmpMQTT, strFldVal, m_mqplfData);
+}
 
-                    //
-                    //  If the configured byte count is non-zero, we take it as is. Else
-                    //  we go to the end of the buffer from the configured offset.
-                    //
-                    tCIDLib::TCard4 c4TextBytes = c4Bytes;
-                    if (m_mqplfData.m_c4Bytes)
-                        c4TextBytes = m_mqplfData.m_c4Bytes;
 
-                    // Get a pointer to the buffer at the configured offset
-                    const tCIDLib::TCard1* pc1Text = mbufVal.pc1DataAt(m_mqplfData.m_c4Offset);
+//
+//  This one returns the value in binary form where possible, so that the driver
+//  doesn't have to parse it back out of text. The most common scenario is a binary
+//  numeric payload passed straight through to a numeric field, and we handle that
+//  without any formatting at all.
+//
+tMQTTSh::EInMapRes
+TMQTTFldCfg::eMapInVal( const   TMemBuf&        mbufVal
+                        , const tCIDLib::TCard4 c4Bytes
+                        ,       TMQTTInVal&     mqivToFill) const
+{
+    if (((m_mqplfData.m_eType == tMQTTSh::EPLTypes::Card)
+    ||   (m_mqplfData.m_eType == tMQTTSh::EPLTypes::Int))
+    &&  !m_mqplfData.m_c4Precision
+    &&  m_cptrMap->bIsA(TMQTTPassthroughMap::clsThis()))
+    {
+        tCIDLib::TInt8 i8Val;
+        if (m_mqplfData.m_eType == tMQTTSh::EPLTypes::Card)
+        {
+            tCIDLib::TCard4 c4Val;
+            if (!bExtractCard(mbufVal, c4Bytes, c4Val))
+                return tMQTTSh::EInMapRes::BadVal;
+            i8Val = c4Val;
+        }
+         else
+        {
+            tCIDLib::TInt4 i4Val;
+            if (!bExtractInt(mbufVal, c4Bytes, i4Val))
+                return tMQTTSh::EInMapRes::BadVal;
+            i8Val = i4Val;
+        }
 
-                    // And finally we can try to trancode it, which could throw
-                    try
-                    {
-                        m_mqplfData.m_cptrEncode->c4ConvertFrom(pc1Text, c4TextBytes, strInVal);
-                    }
+        switch(m_eType)
+        {
+            case tCQCKit::EFldTypes::Card :
+                if ((i8Val < 0) || (i8Val > tCIDLib::TInt8(kCIDLib::c4MaxCard)))
+                    return tMQTTSh::EInMapRes::BadVal;
+                mqivToFill.SetCard(tCIDLib::TCard4(i8Val));
+                return tMQTTSh::EInMapRes::GoodVal;
 
-                    catch(TError& errToCatch)
-                    {
-                        if (facMQTTSh().eVerbosity() > tCQCKit::EVerboseLvls::Low)
-                        {
-                            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
-                            TModule::LogEventObj(errToCatch);
-                        }
+            case tCQCKit::EFldTypes::Float :
+                mqivToFill.SetFloat(tCIDLib::TFloat8(i8Val));
+                return tMQTTSh::EInMapRes::GoodVal;
 
-                        if (facMQTTSh().bTraceMode())
-                        {
-                            facMQTTSh().LogTraceErr
-                            (
-                                tMQTTSh::EMsgSrcs::IOThread
-                                , L"Could not transcode the incoming binary text. Encoding=%(1)"
-                                , m_mqplfData.m_cptrEncode->strEncodingName()
-                            );
-                        }
-                    }
-                }
-                break;
-            }
+            case tCQCKit::EFldTypes::Int :
+                if ((i8Val < kCIDLib::i4MinInt) || (i8Val > kCIDLib::i4MaxInt))
+                    return tMQTTSh::EInMapRes::BadVal;
+                mqivToFill.SetInt(tCIDLib::TInt4(i8Val));
+                return tMQTTSh::EInMapRes::GoodVal;
 
             default :
-                return tMQTTSh::EInMapRes::BadVal;
+                // Fall through to the text based mapping below
+                break;
         };
     }
 
-    catch(TError& errToCatch)
-    {
-        if (facMQTTSh().eVerbosity() > tCQCKit::EVerboseLvls::Low)
-        {
-            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
-            TModule::LogEventObj(errToCatch);
-        }
-
-        if (facMQTTSh().bTraceMode())
-        {
-            facMQTTSh().LogTraceMsg
-            (
-                tMQTTSh::EMsgSrcs::IOThread
-                , L"Failed to map incoming value for topic '%(1)'"
-                , strTopicPath()
-            );
-        }
-        return tMQTTSh::EInMapRes::BadVal;
-    }
-
-    //
-    //  Do any pre-mapping which handles getting the MQTT value out of any larger
-    //  content it is embedded in.
-    //
-    TString strMQTTVal;
-    const tMQTTSh::EInMapRes eRes = m_cptrMap->ePreMapInVal(strInVal, strMQTTVal);
+    const tMQTTSh::EInMapRes eRes = eGetMQTTVal(mbufVal, c4Bytes);
     if (eRes != tMQTTSh::EInMapRes::GoodVal)
         return eRes;
 
-    //
-    //  If there are precision digits, we need to adjust it for that, and then format
-    //  back out to text. This will only be set for floating point fields.
-    //
-    if (m_mqplfData.m_c4Precision)
-    {
-        tCIDLib::TFloat8 f8Tmp;
-        if (!strMQTTVal.bToFloat8(f8Tmp))
-            return tMQTTSh::EInMapRes::BadVal;
-
-        f8Tmp /= TMathLib::f8Power(10, m_mqplfData.m_c4Precision);
-        strMQTTVal.SetFormatted(f8Tmp, m_mqplfData.m_c4Precision);
-    }
-
-    // And now let the map do the actual mapping of the MQTT value to a field value
-    return m_cptrMap->eMapInVal(m_eType, m_eSemType, strMQTTVal, strFldVal, m_mqplfData);
+    return m_cptrMap->eMapInTypedVal(m_eType, m_eSemType, m_strTmpMQTT, mqivToFill, m_mqplfData);
 }
 
 
@@ -1241,6 +1174,151 @@ TMQTTFldCfg::bExtractInt(const  TMemBuf&        mbufPL
     return kCIDLib::True;
 }
 
+//
+//  Gets the MQTT value out of the payload, based on the payload format, and does
+//  any pre-mapping and precision adjustment. It leaves the result in m_strTmpMQTT
+//  for the caller to pass on to the value map.
+//
+tMQTTSh::EInMapRes
+TMQTTFldCfg::eGetMQTTVal(const  TMemBuf&        mbufVal
+                        , const tCIDLib::TCard4 c4Bytes) const
+{
+    m_strTmpIn.Clear();
+    try
+    {
+        // We have to extract the value based on payload format
+        switch (m_mqplfData.m_eType)
+        {
+            case  tMQTTSh::EPLTypes::Card :
+            {
+                tCIDLib::TCard4 c4Val;
+                if (!bExtractCard(mbufVal, c4Bytes, c4Val))
+                    return tMQTTSh::EInMapRes::BadVal;
+                m_strTmpIn.AppendFormatted(c4Val);
+                break;
+            }
+
+            case  tMQTTSh::EPLTypes::Int :
+            {
+                tCIDLib::TInt4 i4Val;
+                if (!bExtractInt(mbufVal, c4Bytes, i4Val))
+                    return tMQTTSh::EInMapRes::BadVal;
+                m_strTmpIn.AppendFormatted(i4Val);
+                break;
+            }
+
+            case  tMQTTSh::EPLTypes::BinText :
+            case  tMQTTSh::EPLTypes::Text :
+            {
+                if (m_mqplfData.m_eType == tMQTTSh::EPLTypes::Text)
+                {
+                    TMQTTInMsg::ParseMQString(m_strTmpIn, mbufVal, c4Bytes);
+                }
+                 else
+                {
+                    // Try to transcode the binary text
+                    if (m_mqplfData.m_c4Offset + m_mqplfData.m_c4Bytes > c4Bytes)
+                    {
+                        // Can't be right
+                        if (facMQTTSh().bTraceMode())
+                        {
+                            facMQTTSh().LogTraceErr
+                            (
+                                tMQTTSh::EMsgSrcs::IOThread
+                                , L"The payload offset+bytes goes beyond the available incoming data"
+                            );
+                        }
+                        return tMQTTSh::EInMapRes::BadVal;
+                    }
+
+                    //
+                    //  If the configured byte count is non-zero, we take it as is. Else
+                    //  we go to the end of the buffer from the configured offset.
+                    //
+                    tCIDLib::TCard4 c4TextBytes = c4Bytes;
+                    if (m_mqplfData.m_c4Bytes)
+                        c4TextBytes = m_mqplfData.m_c4Bytes;
+
+                    // Get a pointer to the buffer at the configured offset
+                    const tCIDLib::TCard1* pc1Text = mbufVal.pc1DataAt(m_mqplfData.m_c4Offset);
+
+                    // And finally we can try to trancode it, which could throw
+                    try
+                    {
+                        m_mqplfData.m_cptrEncode->c4ConvertFrom(pc1Text, c4TextBytes, m_strTmpIn);
+                    }
+
+                    catch(TError& errToCatch)
+                    {
+                        if (facMQTTSh().eVerbosity() > tCQCKit::EVerboseLvls::Low)
+                        {
+                            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+                            TModule::LogEventObj(errToCatch);
+                        }
+
+                        if (facMQTTSh().bTraceMode())
+                        {
+                            facMQTTSh().LogTraceErr
+                            (
+                                tMQTTSh::EMsgSrcs::IOThread
+                                , L"Could not transcode the incoming binary text. Encoding=%(1)"
+                                , m_mqplfData.m_cptrEncode->strEncodingName()
+                            );
+                        }
+                    }
+                }
+                break;
+            }
+
+            default :
+                return tMQTTSh::EInMapRes::BadVal;
+        };
+    }
+
+    catch(TError& errToCatch)
+    {
+        if (facMQTTSh().eVerbosity() > tCQCKit::EVerboseLvls::Low)
+        {
+            errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+            TModule::LogEventObj(errToCatch);
+        }
+
+        if (facMQTTSh().bTraceMode())
+        {
+            facMQTTSh().LogTraceMsg
+            (
+                tMQTTSh::EMsgSrcs::IOThread
+                , L"Failed to map incoming value for topic '%(1)'"
+                , strTopicPath()
+            );
+        }
+        return tMQTTSh::EInMapRes::BadVal;
+    }
+
+    //
+    //  Do any pre-mapping which handles getting the MQTT value out of any larger
+    //  content it is embedded in.
+    //
+    const tMQTTSh::EInMapRes eRes = m_cptrMap->ePreMapInVal(m_strTmpIn, m_strTmpMQTT);
+    if (eRes != tMQTTSh::EInMapRes::GoodVal)
+        return eRes;
+
+    //
+    //  If there are precision digits, we need to adjust it for that, and then format
+    //  back out to text. This will only be set for floating point fields.
+    //
+    if (m_mqplfData.m_c4Precision)
+    {
+        tCIDLib::TFloat8 f8Tmp;
+        if (!m_strTmpMQTT.bToFloat8(f8Tmp))
+            return tMQTTSh::EInMapRes::BadVal;
+
+        f8Tmp /= TMathLib::f8Power(10, m_mqplfData.m_c4Precision);
+        m_strTmpMQTT.SetFormatted(f8Tmp, m_mqplfData.m_c4Precision);
+    }
+    return tMQTTSh::EInMapRes::GoodVal;
+}
+
 
 
 
@@ -83,6 +83,11 @@ class MQTTSHEXPORT TMQTTFldCfg : public TObject
             return m_bAlwaysWrite;
         }
 
+        tCIDLib::TBoolean bHasAltInTopic() const
+        {
+            return (m_cptrAltInTopic.pobjData() != nullptr);
+        }
+
         tCIDLib::TBoolean bMapOutVal
         (
             const   TString&                strFldVal
@@ -151,6 +156,13 @@ class MQTTSHEXPORT TMQTTFldCfg : public TObject
             ,       TString&                strFldVal
         )   const;
 
+        tMQTTSh::EInMapRes eMapInVal
+        (
+            const   TMemBuf&                mbufVal
+            , const tCIDLib::TCard4         c4Bytes
+            ,       TMQTTInVal&             mqivToFill
+        )   const;
+
         tMQTTSh::EPLTypes ePLType() const
         {
             return m_mqplfData.m_eType;
@@ -230,6 +242,12 @@ class MQTTSHEXPORT TMQTTFldCfg : public TObject
             ,       tCIDLib::TInt4&         i4NewVal
         )   const;
 
+        tMQTTSh::EInMapRes eGetMQTTVal
+        (
+            const   TMemBuf&                mbufVal
+            , const tCIDLib::TCard4         c4Bytes
+        )   const;
+
 
         // -------------------------------------------------------------------
         //  Private data members
@@ -315,6 +333,12 @@ class MQTTSHEXPORT TMQTTFldCfg : public TObject
         //      writable an initial value can be sent, sometimes required to get
         //      the device configured.
         //
+        //  m_strTmpIn
+        //  m_strTmpMQTT
+        //      Temp strings for the incoming value mapping, so that we aren't creating
+        //      and destroying them for every incoming msg. m_strTmpMQTT holds the MQTT
+        //      value after pre-mapping, which is what gets passed on to the map.
+        //
         //  m_strTopicPath
         //      The topic for this field (though we may have an alt in topic as well,
         //      see m_regxAltInTopic.)
@@ -339,6 +363,8 @@ class MQTTSHEXPORT TMQTTFldCfg : public TObject
         TString                 m_strFldName;
         TString                 m_strLimits;
         TString                 m_strOnConnect;
+        mutable TString         m_strTmpIn;
+        mutable TString         m_strTmpMQTT;
         TString                 m_strTopicPath;
 
 
@@ -74,6 +74,23 @@ TMQTTValMap::bPostMapOutVal(const TString& strMQTTVal, TString& strOutVal) const
 }
 
 
+//
+//  By default we just do the text mapping and leave the value as text, so that
+//  the driver will parse it into the field. Maps that naturally produce a value
+//  of the field type override this and return the value directly.
+//
+tMQTTSh::EInMapRes
+TMQTTValMap::eMapInTypedVal(const   tCQCKit::EFldTypes  eType
+                            , const tCQCKit::EFldSTypes eSemType
+                            , const TString&            strMQTTVal
+                            ,       TMQTTInVal&         mqivToFill
+                            , const TMQTTPLFmt&         mqplfVals) const
+{
+    mqivToFill.Reset();
+    return eMapInVal(eType, eSemType, strMQTTVal, mqivToFill.m_strValue, mqplfVals);
+}
+
+
 // ---------------------------------------------------------------------------
 //  TMQTTValMap :  Private, non-virtual methods
 // ---------------------------------------------------------------------------
@@ -390,11 +407,42 @@ TMQTTBoolGenMap::bParseFrom(const   TString&                strFldName
 }
 
 tMQTTSh::EInMapRes
-TMQTTBoolGenMap::eMapInVal(const    tCQCKit::EFldTypes  eType
-                            , const tCQCKit::EFldSTypes eSemType
-                            , const TString&            strMQTTVal
-                            ,       TString&            strFldVal
-                            , const TMQTTPLFmt&         mqplfVals) const
+TMQTTBoolGenMap::eMapInTypedVal(const   tCQCKit::EFldTypes
+                                , const tCQCKit::EFldSTypes
+                                , const TString&            strMQTTVal
+                                ,       TMQTTInVal&         mqivToFill
+                                , const TMQTTPLFmt&         mqplfVals) const
+{
+    tCIDLib::TBoolean bVal;
+    const tMQTTSh::EInMapRes eRes = eMapBool(strMQTTVal, mqplfVals, bVal);
+    if (eRes == tMQTTSh::EInMapRes::GoodVal)
+        mqivToFill.SetBool(bVal);
+    return eRes;
+}
+
+
+tMQTTSh::EInMapRes
+TMQTTBoolGenMap::eMapInVal(const   tCQCKit::EFldTypes
+                           , const tCQCKit::EFldSTypes
+                           , const TString&            strMQTTVal
+                           ,       TString&            strFldVal
+                           , const TMQTTPLFmt&         mqplfVals) const
+{
+    tCIDLib::TBoolean bVal;
+    const tMQTTSh::EInMapRes eRes = eMapBool(strMQTTVal, mqplfVals, bVal);
+    if (eRes == tMQTTSh::EInMapRes::GoodVal)
+        strFldVal = facCQCKit().strBoolVal(bVal);
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TMQTTBoolGenMap: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+tMQTTSh::EInMapRes
+TMQTTBoolGenMap::eMapBool(const   TString&            strMQTTVal
+                          , const TMQTTPLFmt&         mqplfVals
+                          ,       tCIDLib::TBoolean&  bFldVal) const
 {
     //
     //  If the payload is binary, convert to a number, else compare as text.
@@ -407,14 +455,14 @@ TMQTTBoolGenMap::eMapInVal(const    tCQCKit::EFldTypes  eType
         ||  strMQTTVal.bCompareI(facCQCKit().strBoolOffOn(kCIDLib::False))
         ||  strMQTTVal.bCompareI(facCQCKit().strBoolYesNo(kCIDLib::False)))
         {
-            strFldVal = facCQCKit().strBoolVal(kCIDLib::False);
+            bFldVal = kCIDLib::False;
         }
          else if ((strMQTTVal == L"1")
               ||  strMQTTVal.bCompareI(facCQCKit().strBoolVal(kCIDLib::True))
               ||  strMQTTVal.bCompareI(facCQCKit().strBoolOffOn(kCIDLib::True))
               ||  strMQTTVal.bCompareI(facCQCKit().strBoolYesNo(kCIDLib::True)))
         {
-            strFldVal = facCQCKit().strBoolVal(kCIDLib::True);
+            bFldVal = kCIDLib::True;
         }
         else
         {
@@ -426,7 +474,7 @@ TMQTTBoolGenMap::eMapInVal(const    tCQCKit::EFldTypes  eType
         tCIDLib::TInt8 i8Val;
         if (!strMQTTVal.bToInt8(i8Val, tCIDLib::ERadices::Auto))
             return tMQTTSh::EInMapRes::BadVal;
-        strFldVal = facCQCKit().strBoolVal(i8Val != 0);
+        bFldVal = i8Val != 0;
     }
     return tMQTTSh::EInMapRes::GoodVal;
 }
@@ -569,11 +617,53 @@ TMQTTBoolNumMap::bParseFrom(const   TString&                strFldName
 
 
 tMQTTSh::EInMapRes
-TMQTTBoolNumMap::eMapInVal( const   tCQCKit::EFldTypes  eType
-                            , const tCQCKit::EFldSTypes eSemType
-                            , const TString&            strMQTTVal
-                            ,       TString&            strFldVal
-                            , const TMQTTPLFmt&         mqplfVals) const
+TMQTTBoolNumMap::eMapInTypedVal(const   tCQCKit::EFldTypes
+                                , const tCQCKit::EFldSTypes
+                                , const TString&            strMQTTVal
+                                ,       TMQTTInVal&         mqivToFill
+                                , const TMQTTPLFmt&         mqplfVals) const
+{
+    tCIDLib::TBoolean bVal;
+    const tMQTTSh::EInMapRes eRes = eMapBool(strMQTTVal, mqplfVals, bVal);
+    if (eRes == tMQTTSh::EInMapRes::GoodVal)
+        mqivToFill.SetBool(bVal);
+    return eRes;
+}
+
+
+tMQTTSh::EInMapRes
+TMQTTBoolNumMap::eMapInVal(const   tCQCKit::EFldTypes
+                           , const tCQCKit::EFldSTypes
+                           , const TString&            strMQTTVal
+                           ,       TString&            strFldVal
+                           , const TMQTTPLFmt&         mqplfVals) const
+{
+    tCIDLib::TBoolean bVal;
+    const tMQTTSh::EInMapRes eRes = eMapBool(strMQTTVal, mqplfVals, bVal);
+    if (eRes == tMQTTSh::EInMapRes::GoodVal)
+        strFldVal = facCQCKit().strBoolVal(bVal);
+    return eRes;
+}
+
+
+tCIDLib::TVoid
+TMQTTBoolNumMap::Reset( const   tCIDLib::TInt8  i8FalseVal
+                        , const tCIDLib::TInt8  i8TrueVal)
+{
+    m_colMapIn.RemoveAll();
+    m_i8FalseVal = i8FalseVal;
+    m_i8TrueVal = i8TrueVal;
+}
+
+
+
+// ---------------------------------------------------------------------------
+//  TMQTTBoolNumMap: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+tMQTTSh::EInMapRes
+TMQTTBoolNumMap::eMapBool(const   TString&            strMQTTVal
+                          , const TMQTTPLFmt&         mqplfVals
+                          ,       tCIDLib::TBoolean&  bFldVal) const
 {
     // The incoming value number be a number
     tCIDLib::TInt8 i8Val;
@@ -587,7 +677,7 @@ TMQTTBoolNumMap::eMapInVal( const   tCQCKit::EFldTypes  eType
         const TARange& arCur = m_colMapIn[c4Index];
         if ((i8Val >= arCur.m_i8MinVal) && (i8Val <= arCur.m_i8MaxVal))
         {
-            strFldVal = facCQCKit().strBoolVal(arCur.m_bTarVal);
+            bFldVal = arCur.m_bTarVal;
             return tMQTTSh::EInMapRes::GoodVal;
         }
     }
@@ -595,16 +685,6 @@ TMQTTBoolNumMap::eMapInVal( const   tCQCKit::EFldTypes  eType
 }
 
 
-tCIDLib::TVoid
-TMQTTBoolNumMap::Reset( const   tCIDLib::TInt8  i8FalseVal
-                        , const tCIDLib::TInt8  i8TrueVal)
-{
-    m_colMapIn.RemoveAll();
-    m_i8FalseVal = i8FalseVal;
-    m_i8TrueVal = i8TrueVal;
-}
-
-
 
 // ---------------------------------------------------------------------------
 //   CLASS: TMQTTBoolTextMap
@@ -716,20 +796,32 @@ TMQTTBoolTextMap::bParseFrom(const  TString&                strFldName
 
 
 tMQTTSh::EInMapRes
-TMQTTBoolTextMap::eMapInVal(const   tCQCKit::EFldTypes  eType
-                            , const tCQCKit::EFldSTypes eSemType
+TMQTTBoolTextMap::eMapInTypedVal(const   tCQCKit::EFldTypes
+                                 , const tCQCKit::EFldSTypes
+                                 , const TString&            strMQTTVal
+                                 ,       TMQTTInVal&         mqivToFill
+                                 , const TMQTTPLFmt&         mqplfVals) const
+{
+    tCIDLib::TBoolean bVal;
+    const tMQTTSh::EInMapRes eRes = eMapBool(strMQTTVal, mqplfVals, bVal);
+    if (eRes == tMQTTSh::EInMapRes::GoodVal)
+        mqivToFill.SetBool(bVal);
+    return eRes;
+}
+
+
+tMQTTSh::EInMapRes
+TMQTTBoolTextMap::eMapInVal(const   tCQCKit::EFldTypes
+                            , const tCQCKit::EFldSTypes
                             , const TString&            strMQTTVal
                             ,       TString&            strFldVal
                             , const TMQTTPLFmt&         mqplfVals) const
 {
-    if (m_colInFalseMap.bHasElement(strMQTTVal))
-        strFldVal = facCQCKit().strBoolVal(kCIDLib::False);
-    else if (m_colInTrueMap.bHasElement(strMQTTVal))
-        strFldVal = facCQCKit().strBoolVal(kCIDLib::True);
-    else
-        return tMQTTSh::EInMapRes::BadVal;
-
-    return tMQTTSh::EInMapRes::GoodVal;
+    tCIDLib::TBoolean bVal;
+    const tMQTTSh::EInMapRes eRes = eMapBool(strMQTTVal, mqplfVals, bVal);
+    if (eRes == tMQTTSh::EInMapRes::GoodVal)
+        strFldVal = facCQCKit().strBoolVal(bVal);
+    return eRes;
 }
 
 
@@ -745,6 +837,26 @@ TMQTTBoolTextMap::Reset(const TString& strFalseOut, const TString& strTrueOut)
 
 
 
+// ---------------------------------------------------------------------------
+//  TMQTTBoolTextMap: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+tMQTTSh::EInMapRes
+TMQTTBoolTextMap::eMapBool(const   TString&            strMQTTVal
+                           , const TMQTTPLFmt&         mqplfVals
+                           ,       tCIDLib::TBoolean&  bFldVal) const
+{
+    if (m_colInFalseMap.bHasElement(strMQTTVal))
+        bFldVal = kCIDLib::False;
+    else if (m_colInTrueMap.bHasElement(strMQTTVal))
+        bFldVal = kCIDLib::True;
+    else
+        return tMQTTSh::EInMapRes::BadVal;
+
+    return tMQTTSh::EInMapRes::GoodVal;
+}
+
+
+
 // ---------------------------------------------------------------------------
 //   CLASS: TMQTTEnumMap
 //  PREFIX: mqvmp
@@ -1406,6 +1518,31 @@ TMQTTScaleRangeMap::bParseFrom( const   TString&                strFldName
 }
 
 
+tMQTTSh::EInMapRes
+TMQTTScaleRangeMap::eMapInTypedVal( const   tCQCKit::EFldTypes  eType
+                                    , const tCQCKit::EFldSTypes eSemType
+                                    , const TString&            strMQTTVal
+                                    ,       TMQTTInVal&         mqivToFill
+                                    , const TMQTTPLFmt&         mqplfVals) const
+{
+    tCIDLib::TFloat8 f8FldVal;
+    const tMQTTSh::EInMapRes eRes = eScaleVal(eType, strMQTTVal, f8FldVal);
+    if (eRes != tMQTTSh::EInMapRes::GoodVal)
+        return eRes;
+
+    if (eType == tCQCKit::EFldTypes::Card)
+        mqivToFill.SetCard(tCIDLib::TCard4(f8FldVal));
+    else if (eType == tCQCKit::EFldTypes::Int)
+        mqivToFill.SetInt(tCIDLib::TInt4(f8FldVal));
+    else if (eType == tCQCKit::EFldTypes::Float)
+        mqivToFill.SetFloat(f8FldVal);
+    else
+        return tMQTTSh::EInMapRes::BadVal;
+
+    return tMQTTSh::EInMapRes::GoodVal;
+}
+
+
 tMQTTSh::EInMapRes
 TMQTTScaleRangeMap::eMapInVal(  const   tCQCKit::EFldTypes  eType
                                 , const tCQCKit::EFldSTypes eSemType
@@ -1413,12 +1550,47 @@ TMQTTScaleRangeMap::eMapInVal(  const   tCQCKit::EFldTypes  eType
                                 ,       TString&            strFldVal
                                 , const TMQTTPLFmt&         mqplfVals) const
 {
-    // Calc the percentage of incoming value in the MQTT range and transfer to the fld range
+    tCIDLib::TFloat8 f8FldVal;
+    const tMQTTSh::EInMapRes eRes = eScaleVal(eType, strMQTTVal, f8FldVal);
+    if (eRes != tMQTTSh::EInMapRes::GoodVal)
+        return eRes;
+
+    //
+    //  Format out as the actual field type. For floats just format out a
+    //  reasonable number of decimal digits, more than anyone is likely to
+    //  need.
+    //
+    if (eType == tCQCKit::EFldTypes::Card)
+        strFldVal.SetFormatted(tCIDLib::TCard4(f8FldVal));
+    else if (eType == tCQCKit::EFldTypes::Int)
+        strFldVal.SetFormatted(tCIDLib::TInt4(f8FldVal));
+    else if (eType == tCQCKit::EFldTypes::Float)
+        strFldVal.SetFormatted(f8FldVal, 5);
+    else
+        return tMQTTSh::EInMapRes::BadVal;
+
+    return tMQTTSh::EInMapRes::GoodVal;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TMQTTScaleRangeMap: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Calc the percentage of incoming value in the MQTT range and transfer to the
+//  field range. The caller puts it into the form of the actual field type.
+//
+tMQTTSh::EInMapRes
+TMQTTScaleRangeMap::eScaleVal(  const   tCQCKit::EFldTypes  eType
+                                , const TString&            strMQTTVal
+                                ,       tCIDLib::TFloat8&   f8FldVal) const
+{
     tCIDLib::TFloat8 f8Tmp;
     if (!strMQTTVal.bToFloat8(f8Tmp))
         return tMQTTSh::EInMapRes::BadVal;
     f8Tmp -= m_f8MQTTMin;
-    tCIDLib::TFloat8 f8FldVal = m_f8FldRange * (f8Tmp / m_f8MQTTRange);
+    f8FldVal = m_f8FldRange * (f8Tmp / m_f8MQTTRange);
 
     // If an non-float, clip down the integral value it falls into
     if ((eType == tCQCKit::EFldTypes::Card) || (eType == tCQCKit::EFldTypes::Int))
@@ -1428,20 +1600,6 @@ TMQTTScaleRangeMap::eMapInVal(  const   tCQCKit::EFldTypes  eType
     if ((f8FldVal < m_f8FldMin) || (f8FldVal > m_f8FldMax))
         return tMQTTSh::EInMapRes::BadVal;
 
-	//
-    //	Else format out as the actual field type. For floats just format out
-	//	a reasonable number of decimal digits, more than anyone is likely to
-	//	need.
-	//
-    if (eType == tCQCKit::EFldTypes::Card)
-        strFldVal.SetFormatted(tCIDLib::TCard4(f8FldVal));
-    else if (eType == tCQCKit::EFldTypes::Int)
-        strFldVal.SetFormatted(tCIDLib::TCard4(f8FldVal));
-    else if (eType == tCQCKit::EFldTypes::Float)
-        strFldVal.SetFormatted(f8FldVal, 5);
-    else
-        return tMQTTSh::EInMapRes::BadVal;
-
     return tMQTTSh::EInMapRes::GoodVal;
 }
 
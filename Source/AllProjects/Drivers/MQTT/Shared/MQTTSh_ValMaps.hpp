@@ -50,6 +50,13 @@
 //                      this embeds the MQTT value into the larger output text.
 //
 //
+//  eMapInVal() produces the field value as text, which the driver would then
+//  have to parse again to store it. So there is also an eMapInTypedVal(), which
+//  fills in a TMQTTInVal. Maps that naturally come up with a binary value (the
+//  boolean and scaled range maps) override it and provide that directly. The
+//  default just calls eMapInVal() and leaves the value as text, so that it goes
+//  through the usual field value parsing and validation.
+//
 //  To avoid redundancy for the JSON/multi-line type maps, we create a TMQTTComplexMap
 //  class that most of those types of maps will derive from. It will provide some
 //  common functionality for massaging the raw value after it is extracted from the
@@ -64,6 +71,79 @@
 #pragma CIDLIB_PACK(CIDLIBPACK)
 
 
+// ---------------------------------------------------------------------------
+//   CLASS: TMQTTInVal
+//  PREFIX: mqiv
+//
+//  A mapped incoming field value. If m_eType is Count, the value is text in
+//  m_strValue, else it's the indicated field type and the value is in the
+//  respective member. The caller keeps one around and reuses it, so that we
+//  aren't allocating a string for every incoming msg.
+// ---------------------------------------------------------------------------
+class MQTTSHEXPORT TMQTTInVal
+{
+    public :
+        TMQTTInVal() :
+
+            m_bValue(kCIDLib::False)
+            , m_c4Value(0)
+            , m_eType(tCQCKit::EFldTypes::Count)
+            , m_f8Value(0)
+            , m_i4Value(0)
+        {
+        }
+
+        TMQTTInVal(const TMQTTInVal&) = default;
+        TMQTTInVal(TMQTTInVal&&) = default;
+        ~TMQTTInVal() = default;
+        TMQTTInVal& operator=(const TMQTTInVal&) = default;
+        TMQTTInVal& operator=(TMQTTInVal&&) = default;
+
+        tCIDLib::TBoolean bIsText() const
+        {
+            return (m_eType == tCQCKit::EFldTypes::Count);
+        }
+
+        tCIDLib::TVoid Reset()
+        {
+            m_eType = tCQCKit::EFldTypes::Count;
+            m_strValue.Clear();
+        }
+
+        tCIDLib::TVoid SetBool(const tCIDLib::TBoolean bToSet)
+        {
+            m_eType = tCQCKit::EFldTypes::Boolean;
+            m_bValue = bToSet;
+        }
+
+        tCIDLib::TVoid SetCard(const tCIDLib::TCard4 c4ToSet)
+        {
+            m_eType = tCQCKit::EFldTypes::Card;
+            m_c4Value = c4ToSet;
+        }
+
+        tCIDLib::TVoid SetFloat(const tCIDLib::TFloat8 f8ToSet)
+        {
+            m_eType = tCQCKit::EFldTypes::Float;
+            m_f8Value = f8ToSet;
+        }
+
+        tCIDLib::TVoid SetInt(const tCIDLib::TInt4 i4ToSet)
+        {
+            m_eType = tCQCKit::EFldTypes::Int;
+            m_i4Value = i4ToSet;
+        }
+
+        tCIDLib::TBoolean       m_bValue;
+        tCIDLib::TCard4         m_c4Value;
+        tCQCKit::EFldTypes      m_eType;
+        tCIDLib::TFloat8        m_f8Value;
+        tCIDLib::TInt4          m_i4Value;
+        TString                 m_strValue;
+};
+
+
+
 // ---------------------------------------------------------------------------
 //   CLASS: TMQTTValMap
 //  PREFIX: mqvmp
@@ -118,6 +198,15 @@ class MQTTSHEXPORT TMQTTValMap : public TObject
             ,       tCIDLib::TStrCollect&   colErrs
         ) = 0;
 
+        virtual tMQTTSh::EInMapRes eMapInTypedVal
+        (
+            const   tCQCKit::EFldTypes      eType
+            , const tCQCKit::EFldSTypes     eSemType
+            , const TString&                strMQTTVal
+            ,       TMQTTInVal&             mqivToFill
+            , const TMQTTPLFmt&             mqplfVals
+        )   const;
+
         virtual tMQTTSh::EInMapRes eMapInVal
         (
             const   tCQCKit::EFldTypes      eType
@@ -312,6 +401,15 @@ class MQTTSHEXPORT TMQTTBoolGenMap : public TMQTTValMap
             ,       tCIDLib::TStrCollect&   colErrs
         )   override;
 
+        tMQTTSh::EInMapRes eMapInTypedVal
+        (
+            const   tCQCKit::EFldTypes      eType
+            , const tCQCKit::EFldSTypes     eSemType
+            , const TString&                strMQTTVal
+            ,       TMQTTInVal&             mqivToFill
+            , const TMQTTPLFmt&             mqplfVals
+        )   const override;
+
         tMQTTSh::EInMapRes eMapInVal
         (
             const   tCQCKit::EFldTypes      eType
@@ -323,6 +421,17 @@ class MQTTSHEXPORT TMQTTBoolGenMap : public TMQTTValMap
 
 
     private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tMQTTSh::EInMapRes eMapBool
+        (
+            const   TString&                strMQTTVal
+            , const TMQTTPLFmt&             mqplfVals
+            ,       tCIDLib::TBoolean&      bFldVal
+        )   const;
+
+
         // -------------------------------------------------------------------
         //  Private data members
         //
@@ -398,6 +507,15 @@ class MQTTSHEXPORT TMQTTBoolNumMap : public TMQTTValMap
             , const tCIDLib::TInt8          i8TrueVal
         );
 
+        tMQTTSh::EInMapRes eMapInTypedVal
+        (
+            const   tCQCKit::EFldTypes      eType
+            , const tCQCKit::EFldSTypes     eSemType
+            , const TString&                strMQTTVal
+            ,       TMQTTInVal&             mqivToFill
+            , const TMQTTPLFmt&             mqplfVals
+        )   const override;
+
         tMQTTSh::EInMapRes eMapInVal
         (
             const   tCQCKit::EFldTypes      eType
@@ -438,6 +556,17 @@ class MQTTSHEXPORT TMQTTBoolNumMap : public TMQTTValMap
         using TRangeList = TVector<TARange>;
 
 
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tMQTTSh::EInMapRes eMapBool
+        (
+            const   TString&                strMQTTVal
+            , const TMQTTPLFmt&             mqplfVals
+            ,       tCIDLib::TBoolean&      bFldVal
+        )   const;
+
+
         // -------------------------------------------------------------------
         //  Private data members
         //
@@ -519,6 +648,15 @@ class MQTTSHEXPORT TMQTTBoolTextMap : public TMQTTValMap
             , const TString&                strTrueOut
         );
 
+        tMQTTSh::EInMapRes eMapInTypedVal
+        (
+            const   tCQCKit::EFldTypes      eType
+            , const tCQCKit::EFldSTypes     eSemType
+            , const TString&                strMQTTVal
+            ,       TMQTTInVal&             mqivToFill
+            , const TMQTTPLFmt&             mqplfVals
+        )   const override;
+
         tMQTTSh::EInMapRes eMapInVal
         (
             const   tCQCKit::EFldTypes      eType
@@ -530,6 +668,17 @@ class MQTTSHEXPORT TMQTTBoolTextMap : public TMQTTValMap
 
 
     private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tMQTTSh::EInMapRes eMapBool
+        (
+            const   TString&                strMQTTVal
+            , const TMQTTPLFmt&             mqplfVals
+            ,       tCIDLib::TBoolean&      bFldVal
+        )   const;
+
+
         // -------------------------------------------------------------------
         //  Private data members
         //
@@ -968,6 +1117,15 @@ class MQTTSHEXPORT TMQTTScaleRangeMap : public TMQTTValMap
             ,       tCIDLib::TStrCollect&   colErrs
         )   override;
 
+        tMQTTSh::EInMapRes eMapInTypedVal
+        (
+            const   tCQCKit::EFldTypes      eType
+            , const tCQCKit::EFldSTypes     eSemType
+            , const TString&                strMQTTVal
+            ,       TMQTTInVal&             mqivToFill
+            , const TMQTTPLFmt&             mqplfVals
+        )   const override;
+
         tMQTTSh::EInMapRes eMapInVal
         (
             const   tCQCKit::EFldTypes      eType
@@ -986,6 +1144,17 @@ class MQTTSHEXPORT TMQTTScaleRangeMap : public TMQTTValMap
         using TValMap   = THashMap<TMapVals, TString, TStringKeyOps>;
 
 
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tMQTTSh::EInMapRes eScaleVal
+        (
+            const   tCQCKit::EFldTypes      eType
+            , const TString&                strMQTTVal
+            ,       tCIDLib::TFloat8&       f8FldVal
+        )   const;
+
+
         // -------------------------------------------------------------------
         //  Private data members
         //
@@ -94,6 +94,7 @@ namespace tZWaveUSB3S
 #include    "ZWaveUSB3S_ErrorIds.hpp"
 #include    "ZWaveUSB3S_MessageIds.hpp"
 #include    "ZWaveUSB3S_Internal.hpp"
+#include    "ZWaveUSB3S_OutQ.hpp"
 #include    "ZWaveUSB3S_ZStick.hpp"
 #include    "ZWaveUSB3S_DriverImpl.hpp"
 
@@ -0,0 +1,223 @@
+//
+// FILE NAME: ZWaveUSB3S_OutQ.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the outgoing msg queue of the Z-Stick class.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+
+
+// ---------------------------------------------------------------------------
+//  Includes
+// ---------------------------------------------------------------------------
+#include    "ZWaveUSB3S_.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Local types and constants
+// ---------------------------------------------------------------------------
+namespace ZWaveUSB3_OutQ
+{
+    // One list per queue priority level
+    const tCIDLib::TCard4   c4LevelCnt = tCIDLib::c4EnumOrd(tCIDLib::EQPrios::P10) + 1;
+
+    // Unit ids are a byte, so one served stamp per possible id
+    const tCIDLib::TCard4   c4ServedCnt = 256;
+}
+
+
+// ---------------------------------------------------------------------------
+//   CLASS: TZWOutQ
+//  PREFIX: zwoq
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TZWOutQ: Constructors and destructor
+// ---------------------------------------------------------------------------
+TZWOutQ::TZWOutQ(const tCIDLib::TCard4 c4MaxMsgs) :
+
+    m_c4Count(0)
+    , m_c4MaxMsgs(c4MaxMsgs)
+    , m_c4ServeSeq(0)
+    , m_colLevels(ZWaveUSB3_OutQ::c4LevelCnt)
+    , m_evNewMsg(tCIDLib::EEventStates::Reset)
+    , m_fcolServed(ZWaveUSB3_OutQ::c4ServedCnt)
+{
+    m_fcolServed.SetAll(0);
+}
+
+TZWOutQ::~TZWOutQ()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TZWOutQ: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Gets the next msg to send, if any. If none is available right now we will wait up
+//  to the indicated time for one to be queued.
+//
+tCIDLib::TBoolean
+TZWOutQ::bGetNext(TZWOutMsg& zwomToFill, const tCIDLib::TCard4 c4WaitMSs)
+{
+    {
+        TLocker lockrSync(&m_mtxSync);
+        if (bTakeNext(zwomToFill))
+            return kCIDLib::True;
+
+        if (!c4WaitMSs)
+            return kCIDLib::False;
+    }
+
+    // Nothing yet, so wait for one to show up and try again
+    if (!m_evNewMsg.bWaitFor(c4WaitMSs))
+        return kCIDLib::False;
+
+    TLocker lockrSync(&m_mtxSync);
+    return bTakeNext(zwomToFill);
+}
+
+
+tCIDLib::TBoolean TZWOutQ::bIsFull() const
+{
+    TLocker lockrSync(&m_mtxSync);
+    return (m_c4Count >= m_c4MaxMsgs);
+}
+
+
+//
+//  Queues up the passed msg at the indicated priority level. If the caller says it
+//  can be coalesced, and there's already one queued at that level with the same
+//  content, we return true to say we coalesced it.
+//
+//  We can only update the queued one in place if it's the last one queued for that
+//  unit at that level. Otherwise it would go out before later msgs for the same unit
+//  (e.g. on, off, on would end up off.) So in that case we remove the older one and
+//  add the new one at the end, which keeps the unit's msgs in the order queued.
+//
+tCIDLib::TBoolean
+TZWOutQ::bPutMsg(const  TZWOutMsg&          zwomToPut
+                , const tCIDLib::EQPrios    ePriority
+                , const tCIDLib::TBoolean   bCoalesce)
+{
+    TLocker lockrSync(&m_mtxSync);
+
+    TMsgList& colLevel = m_colLevels[tCIDLib::c4EnumOrd(ePriority)];
+    if (bCoalesce && (zwomToPut.c1TarId() != NODE_BROADCAST))
+    {
+        // Work backwards so the first one we see for the unit is its last one
+        tCIDLib::TBoolean bLastForUnit = kCIDLib::True;
+        tCIDLib::TCard4 c4Index = colLevel.c4ElemCount();
+        while (c4Index)
+        {
+            c4Index--;
+            TZWOutMsg& zwomCur = colLevel[c4Index];
+            if (zwomCur.c1TarId() != zwomToPut.c1TarId())
+                continue;
+
+            if (zwomCur.bSameContent(zwomToPut))
+            {
+                if (bLastForUnit)
+                {
+                    zwomCur = zwomToPut;
+                }
+                 else
+                {
+                    colLevel.RemoveAt(c4Index);
+                    colLevel.objAdd(zwomToPut);
+                }
+                return kCIDLib::True;
+            }
+            bLastForUnit = kCIDLib::False;
+        }
+    }
+
+    colLevel.objAdd(zwomToPut);
+    m_c4Count++;
+    m_evNewMsg.Trigger();
+    return kCIDLib::False;
+}
+
+
+tCIDLib::TCard4 TZWOutQ::c4ElemCount() const
+{
+    TLocker lockrSync(&m_mtxSync);
+    return m_c4Count;
+}
+
+
+tCIDLib::TVoid TZWOutQ::RemoveAll()
+{
+    TLocker lockrSync(&m_mtxSync);
+    for (tCIDLib::TCard4 c4Level = 0; c4Level < ZWaveUSB3_OutQ::c4LevelCnt; c4Level++)
+        m_colLevels[c4Level].RemoveAll();
+    m_c4Count = 0;
+    m_evNewMsg.Reset();
+}
+
+
+// ---------------------------------------------------------------------------
+//  TZWOutQ: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Must be called with the lock held. We find the highest level that has any msgs.
+//  Within that level we take the oldest msg for the unit that was least recently
+//  served. Since the msgs are in queued order, the first one we see for a unit is
+//  its oldest, and we only take a later one if its unit was served longer ago.
+//
+tCIDLib::TBoolean TZWOutQ::bTakeNext(TZWOutMsg& zwomToFill)
+{
+    if (!m_c4Count)
+        return kCIDLib::False;
+
+    tCIDLib::TCard4 c4Level = ZWaveUSB3_OutQ::c4LevelCnt;
+    while (c4Level)
+    {
+        c4Level--;
+        TMsgList& colLevel = m_colLevels[c4Level];
+        const tCIDLib::TCard4 c4Count = colLevel.c4ElemCount();
+        if (!c4Count)
+            continue;
+
+        tCIDLib::TCard4 c4BestInd = 0;
+        tCIDLib::TCard4 c4BestSeq = m_fcolServed[colLevel[0].c1TarId()];
+        for (tCIDLib::TCard4 c4Index = 1; c4Index < c4Count; c4Index++)
+        {
+            const tCIDLib::TCard4 c4Seq = m_fcolServed[colLevel[c4Index].c1TarId()];
+            if (c4Seq < c4BestSeq)
+            {
+                c4BestInd = c4Index;
+                c4BestSeq = c4Seq;
+            }
+        }
+
+        zwomToFill = colLevel[c4BestInd];
+        colLevel.RemoveAt(c4BestInd);
+
+        m_fcolServed[zwomToFill.c1TarId()] = ++m_c4ServeSeq;
+        m_c4Count--;
+        if (!m_c4Count)
+            m_evNewMsg.Reset();
+        return kCIDLib::True;
+    }
+    return kCIDLib::False;
+}
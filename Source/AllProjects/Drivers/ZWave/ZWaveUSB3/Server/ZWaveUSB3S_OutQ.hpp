@@ -0,0 +1,155 @@
+//
+// FILE NAME: ZWaveUSB3S_OutQ.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the outgoing msg queue used by the Z-Stick class. It used to just use a
+//  standard priority queue, but that meant that, within a given priority, msgs went
+//  out strictly in the order queued. So if the driver was interrogating or polling a
+//  bunch of units, a unit with a lot of msgs queued could hog the stick and a slow
+//  unit would hold up everything behind it.
+//
+//  So we keep a separate list for each queue priority level. The highest non-empty
+//  level is always served first, as before, so user commands still go out ahead of
+//  queries and async polling. But within a level we pick the unit that was least
+//  recently served, and take the oldest msg for that unit. So each unit gets a turn
+//  in round robin fashion, while the msgs for any one unit still go out in order.
+//
+//  We also coalesce redundant msgs. If the caller indicates the msg can be coalesced,
+//  and there's already a msg queued at the same level with the same content for the
+//  same unit, we don't queue another one. If it's the last one queued for that unit,
+//  we update it to the new msg, which keeps the existing place in line but means that
+//  the new msg's ack id is the one that gets reported, in case the driver is waiting
+//  on it. If other msgs for that unit were queued after it, we remove it and add the
+//  new one at the end instead, so that the unit's msgs still go out in order.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  This guy is thread safe, since the driver thread queues msgs and the Z-Stick
+//      I/O thread pulls them out.
+//
+// LOG:
+//
+#pragma once
+
+
+#pragma CIDLIB_PACK(CIDLIBPACK)
+
+// ---------------------------------------------------------------------------
+//   CLASS: TZWOutQ
+//  PREFIX: zwoq
+// ---------------------------------------------------------------------------
+class TZWOutQ
+{
+    public :
+        // -------------------------------------------------------------------
+        //  Constructors and destructor
+        // -------------------------------------------------------------------
+        TZWOutQ
+        (
+            const   tCIDLib::TCard4         c4MaxMsgs
+        );
+
+        TZWOutQ(const TZWOutQ&) = delete;
+
+        ~TZWOutQ();
+
+
+        // -------------------------------------------------------------------
+        //  Public operators
+        // -------------------------------------------------------------------
+        TZWOutQ& operator=(const TZWOutQ&) = delete;
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bGetNext
+        (
+                    TZWOutMsg&              zwomToFill
+            , const tCIDLib::TCard4         c4WaitMSs
+        );
+
+        tCIDLib::TBoolean bIsFull() const;
+
+        tCIDLib::TBoolean bPutMsg
+        (
+            const   TZWOutMsg&              zwomToPut
+            , const tCIDLib::EQPrios        ePriority
+            , const tCIDLib::TBoolean       bCoalesce
+        );
+
+        tCIDLib::TCard4 c4ElemCount() const;
+
+        tCIDLib::TVoid RemoveAll();
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private types
+        // -------------------------------------------------------------------
+        using TMsgList = TVector<TZWOutMsg>;
+        using TLevelList = TObjArray<TMsgList>;
+        using TServedList = TFundArray<tCIDLib::TCard4>;
+
+
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bTakeNext
+        (
+                    TZWOutMsg&              zwomToFill
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Private data members
+        //
+        //  m_c4Count
+        //      The number of msgs across all of the levels, so we don't have to add
+        //      them up every time.
+        //
+        //  m_c4MaxMsgs
+        //      The max msgs we can hold before we report we are full.
+        //
+        //  m_c4ServeSeq
+        //      Bumped every time we give out a msg, and stored in m_fcolServed for the
+        //      target unit, so that we know which units were least recently served.
+        //
+        //  m_colLevels
+        //      A list of msgs per queue priority level. Within each list the msgs are
+        //      in the order queued.
+        //
+        //  m_evNewMsg
+        //      Triggered when a msg is queued, so that bGetNext() can block for a
+        //      while waiting for one. It's reset when the last msg is taken out.
+        //
+        //  m_fcolServed
+        //      The m_c4ServeSeq value when we last gave out a msg for each unit id. Msgs
+        //      with no target unit are all treated as being for unit zero.
+        //
+        //  m_mtxSync
+        //      To sync access from the driver and I/O threads.
+        // -------------------------------------------------------------------
+        tCIDLib::TCard4         m_c4Count;
+        tCIDLib::TCard4         m_c4MaxMsgs;
+        tCIDLib::TCard4         m_c4ServeSeq;
+        TLevelList              m_colLevels;
+        TEvent                  m_evNewMsg;
+        TServedList             m_fcolServed;
+        TMutex                  m_mtxSync;
+};
+
+#pragma CIDLIB_POPPACK
@@ -88,7 +88,7 @@ TZStick::TZStick(const TString& strMoniker) :
     , m_c8ManIds(0)
     , m_colCANQ(tCIDLib::EMTStates::Unsafe)
     , m_colInQ(tCIDLib::EMTStates::Safe)
-    , m_colOutQ(tCIDLib::EMTStates::Safe)
+    , m_colOutQ(ZWaveUSB3_ZStick::c4OutQSz)
     , m_colInNonces(kZWaveUSB3Sh::c4MaxUnits)
     , m_colOutNonces(kZWaveUSB3Sh::c4MaxUnits)
     , m_enctNextMsg(0)
@@ -487,14 +487,13 @@ tCIDLib::TVoid TZStick::LogTermTrace()
 
 //
 //  Just queues up the passed message to be sent as soon as the I/O thread can get
-//  it sent.
+//  it sent. Normal queries, commands, and async msgs can be coalesced with an
+//  identical msg already queued for the same unit.
 //
 tCIDLib::TVoid TZStick::QueueOutMsg(const TZWOutMsg& zwomToSend)
 {
-    TLocker lockrSync(&m_colOutQ);
-
     // If it's full, then something is wrong and we are backing up badly, so flush it
-    if (m_colOutQ.bIsFull(ZWaveUSB3_ZStick::c4OutQSz))
+    if (m_colOutQ.bIsFull())
     {
         m_colOutQ.RemoveAll();
         facZWaveUSB3Sh().LogTraceErr
@@ -512,7 +511,18 @@ tCIDLib::TVoid TZStick::QueueOutMsg(const TZWOutMsg& zwomToSend)
         );
     }
 
-    m_colOutQ.objPut(zwomToSend, eXlatPriority(zwomToSend.m_ePriority));
+    const tCIDLib::TBoolean bCoalesce
+    (
+        (zwomToSend.m_ePriority == tZWaveUSB3Sh::EMsgPrios::Async)
+        || (zwomToSend.m_ePriority == tZWaveUSB3Sh::EMsgPrios::Query)
+        || (zwomToSend.m_ePriority == tZWaveUSB3Sh::EMsgPrios::Command)
+    );
+
+    if (m_colOutQ.bPutMsg(zwomToSend, eXlatPriority(zwomToSend.m_ePriority), bCoalesce))
+    {
+        if (facZWaveUSB3Sh().bHighTrace())
+            facZWaveUSB3Sh().LogOutMsg(L"Coalesced with an already queued msg:", zwomToSend);
+    }
 }
 
 
@@ -1526,7 +1536,7 @@ tCIDLib::EExitCodes TZStick::eIOThread(TThread& thrThis, tCIDLib::TVoid* pData)
                     //  then call a helper to look at the msg and its flags and
                     //  start the process.
                     //
-                    if (m_colOutQ.bGetHighestPrio(m_zwomCur, 15))
+                    if (m_colOutQ.bGetNext(m_zwomCur, 15))
                         StartNewOutMsg();
                 }
                  else if (m_eIOState == tZWaveUSB3S::EIOStates::WaitPingAck)
@@ -87,6 +87,12 @@
 //  msgs. We convert that to the correct queue priority when we we get the msgs to queue
 //  up.
 //
+//  Within a priority level, the out queue (TZWOutQ) round robins between the target
+//  units, so that a unit with a lot of msgs queued, or that is slow to respond, doesn't
+//  hold up msgs for other units at the same level. And queries, commands and async msgs
+//  that are exact duplicates of one already queued for the same unit are coalesced into
+//  the queued one, so that redundant polling doesn't pile up in front of user commands.
+//
 //  Async Msg Sending
 //
 //  Note that #0 and #2 above indicate that some messages are just queued up and no one
@@ -268,7 +274,6 @@ class TZStick
         // -------------------------------------------------------------------
         using TCANQ = TQueue<TZWInMsg>;
         using TInQ = TQueue<TZWInMsg>;
-        using TOutQ = TQueue<TZWOutMsg>;
 
 
         // -------------------------------------------------------------------
@@ -456,7 +461,8 @@ class TZStick
         //  m_colOutQ
         //      Our input and output queues, managed by the background thread. They are
         //      thread safe for maximum overlapping access. m_mtxSync is not used on
-        //      these since they already handle their own sync.
+        //      these since they already handle their own sync. The output queue is our
+        //      own per-unit scheduling queue, see the Msg Priority comments above.
         //
         //  m_colInNonces
         //      These are the nonces that we have issued to other nodes, which they
@@ -542,7 +548,7 @@ class TZStick
         TInQ                    m_colInQ;
         TNonceList              m_colInNonces;
         TNonceList              m_colOutNonces;
-        TOutQ                   m_colOutQ;
+        TZWOutQ                 m_colOutQ;
         TCommPortCfg            m_cpcfgSerial;
         tCIDLib::TEncodedTime   m_enctNextMsg;
         tZWaveUSB3S::EIOStates  m_eIOState;
@@ -307,6 +307,35 @@ TZWOutMsg::bQueryCCIds(tCIDLib::TCard1& c1ClassId, tCIDLib::TCard1& c1CmdId) con
 }
 
 
+//
+//  Checks whether the passed msg would put the same thing on the wire as we would.
+//  The callback id is ignored, since every msg gets its own. This is used by the
+//  Z-Stick to coalesce redundant queued msgs.
+//
+tCIDLib::TBoolean TZWOutMsg::bSameContent(const TZWOutMsg& zwomToCheck) const
+{
+    if ((m_c1Count != zwomToCheck.m_c1Count)
+    ||  (m_c1CBIdOfs != zwomToCheck.m_c1CBIdOfs)
+    ||  (m_c1TarId != zwomToCheck.m_c1TarId)
+    ||  (m_bSecure != zwomToCheck.m_bSecure)
+    ||  (m_bFreqListener != zwomToCheck.m_bFreqListener)
+    ||  (m_eType != zwomToCheck.m_eType))
+    {
+        return kCIDLib::False;
+    }
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < m_c1Count; c4Index++)
+    {
+        if ((c4Index != m_c1CBIdOfs)
+        &&  (m_mbufData[c4Index] != zwomToCheck.m_mbufData[c4Index]))
+        {
+            return kCIDLib::False;
+        }
+    }
+    return kCIDLib::True;
+}
+
+
 //
 //  This must be a finalized command class msg.
 //
@@ -160,6 +160,11 @@ class ZWUSB3SHEXPORT TZWOutMsg
             return (m_eState == tZWaveUSB3Sh::EOMState_ReadyToSend);
         }
 
+        tCIDLib::TBoolean bSameContent
+        (
+            const   TZWOutMsg&              zwomToCheck
+        )   const;
+
         tCIDLib::TBoolean bSecure() const
         {
             return m_bSecure;
@@ -99,6 +99,12 @@ tCIDLib::TVoid TCQCKitTestApp::LoadTests()
 
     // User account related tests
     AddTest(new TTest_UserAccount);
+
+    // Driver base class field list tests
+    AddTest(new TTest_SemFldIndex);
+
+    // Polling engine tests
+    AddTest(new TTest_PollFldHotCold);
 }
 
 tCIDLib::TVoid TCQCKitTestApp::PostTest(const TTestFWTest&)
@@ -33,6 +33,8 @@
 #include    "CIDXML.hpp"
 #include    "CQCKit.hpp"
 #include    "CQCAct.hpp"
+#include    "CQCDriver.hpp"
+#include    "CQCPollEng.hpp"
 #include    "TestFWLib.hpp"
 
 
@@ -50,6 +52,8 @@
 #include    "TestCQCKit_StdTargets.hpp"
 #include    "TestCQCKit_FldFilter.hpp"
 #include    "TestCQCKit_UserAccount.hpp"
+#include    "TestCQCKit_DrvBase.hpp"
+#include    "TestCQCKit_PollEng.hpp"
 
 
 
@@ -0,0 +1,341 @@
+//
+// FILE NAME: TestCQCKit_DrvBase.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the tests for the server side driver base class'
+//  field lists.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $Log$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCQCKit.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_SemFldIndex,TTestFWTest)
+
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTestFldDriver
+// PREFIX: sdrv
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTestFldDriver: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTestFldDriver::TTestFldDriver(const TCQCDriverObjCfg& cqcdcToLoad) :
+
+    TCQCServerBase(cqcdcToLoad)
+{
+}
+
+TTestFldDriver::~TTestFldDriver()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTestFldDriver: Public, non-virtual methods
+// ---------------------------------------------------------------------------
+tCIDLib::TVoid TTestFldDriver::LoadFields(TSetFieldList& colToSet)
+{
+    SetFields(colToSet);
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTestFldDriver: Protected, inherited methods
+// ---------------------------------------------------------------------------
+tCIDLib::TBoolean TTestFldDriver::bGetCommResource(TThread&)
+{
+    return kCIDLib::True;
+}
+
+tCIDLib::TBoolean TTestFldDriver::bWaitConfig(TThread&)
+{
+    return kCIDLib::True;
+}
+
+tCQCKit::ECommResults TTestFldDriver::eConnectToDevice(TThread&)
+{
+    return tCQCKit::ECommResults::Success;
+}
+
+tCQCKit::EDrvInitRes TTestFldDriver::eInitializeImpl()
+{
+    return tCQCKit::EDrvInitRes::WaitCommRes;
+}
+
+tCQCKit::ECommResults TTestFldDriver::ePollDevice(TThread&)
+{
+    return tCQCKit::ECommResults::Success;
+}
+
+tCIDLib::TVoid TTestFldDriver::ReleaseCommResource()
+{
+}
+
+tCIDLib::TVoid TTestFldDriver::TerminateImpl()
+{
+}
+
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_SemFldIndex
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_SemFldIndex: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_SemFldIndex::TTest_SemFldIndex() :
+
+    TTestFWTest
+    (
+        L"Semantic Field Index", L"Driver semantic field query tests", 3
+    )
+{
+}
+
+TTest_SemFldIndex::~TTest_SemFldIndex()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_SemFldIndex: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_SemFldIndex::eRunTest(TTextStringOutStream&   strmOut
+                            , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    TCQCDriverObjCfg cqcdcTest;
+    cqcdcTest.strMoniker(L"SemTestDrv");
+    TTestFldDriver sdrvTest(cqcdcTest);
+
+    // Load up an initial set of fields, with a couple of each of some types
+    TCQCServerBase::TSetFieldList colFlds(8);
+    colFlds.objAdd
+    (
+        TCQCFldDef
+        (
+            L"Light1"
+            , tCQCKit::EFldTypes::Boolean
+            , tCQCKit::EFldAccess::ReadWrite
+            , tCQCKit::EFldSTypes::LightSwitch
+        )
+    );
+    colFlds.objAdd
+    (
+        TCQCFldDef
+        (
+            L"Dim1"
+            , tCQCKit::EFldTypes::Card
+            , tCQCKit::EFldAccess::ReadWrite
+            , tCQCKit::EFldSTypes::Dimmer
+        )
+    );
+    colFlds.objAdd
+    (
+        TCQCFldDef
+        (
+            L"Temp1"
+            , tCQCKit::EFldTypes::Int
+            , tCQCKit::EFldAccess::Read
+            , tCQCKit::EFldSTypes::CurTemp
+        )
+    );
+    colFlds.objAdd
+    (
+        TCQCFldDef
+        (
+            L"Light2"
+            , tCQCKit::EFldTypes::Boolean
+            , tCQCKit::EFldAccess::Write
+            , tCQCKit::EFldSTypes::LightSwitch
+        )
+    );
+    colFlds.objAdd
+    (
+        TCQCFldDef
+        (
+            L"Dim2"
+            , tCQCKit::EFldTypes::Card
+            , tCQCKit::EFldAccess::Read
+            , tCQCKit::EFldSTypes::Dimmer
+        )
+    );
+    colFlds.objAdd
+    (
+        TCQCFldDef(L"Plain", tCQCKit::EFldTypes::String, tCQCKit::EFldAccess::Read)
+    );
+    sdrvTest.LoadFields(colFlds);
+
+    tCQCKit::TFldSTypeList fcolTypes(4UL);
+
+    // The results are grouped by type, in the order passed, then by field id
+    {
+        fcolTypes.RemoveAll();
+        fcolTypes.c4AddElement(tCQCKit::EFldSTypes::Dimmer);
+        fcolTypes.c4AddElement(tCQCKit::EFldSTypes::LightSwitch);
+
+        const tCIDLib::TCh* const apszExp[] = { L"Dim1", L"Dim2", L"Light1", L"Light2" };
+        if (!bTestQuery(strmOut, TFWCurLn, sdrvTest, fcolTypes
+                        , tCQCKit::EReqAccess::ReadOrWrite
+                        , apszExp, tCIDLib::c4ArrayElems(apszExp)))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // A type passed twice is only done once, and the access has to match
+    {
+        fcolTypes.RemoveAll();
+        fcolTypes.c4AddElement(tCQCKit::EFldSTypes::LightSwitch);
+        fcolTypes.c4AddElement(tCQCKit::EFldSTypes::Dimmer);
+        fcolTypes.c4AddElement(tCQCKit::EFldSTypes::LightSwitch);
+
+        const tCIDLib::TCh* const apszExp[] = { L"Light1", L"Dim1", L"Dim2" };
+        if (!bTestQuery(strmOut, TFWCurLn, sdrvTest, fcolTypes
+                        , tCQCKit::EReqAccess::MReadCWrite
+                        , apszExp, tCIDLib::c4ArrayElems(apszExp)))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Types we don't have any fields of should return nothing
+    {
+        fcolTypes.RemoveAll();
+        fcolTypes.c4AddElement(tCQCKit::EFldSTypes::MotionSensor);
+
+        if (!bTestQuery(strmOut, TFWCurLn, sdrvTest, fcolTypes
+                        , tCQCKit::EReqAccess::ReadOrWrite, nullptr, 0))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // Set a new field list, and make sure the index was rebuilt for it
+    colFlds.RemoveAll();
+    colFlds.objAdd
+    (
+        TCQCFldDef
+        (
+            L"Motion1"
+            , tCQCKit::EFldTypes::Boolean
+            , tCQCKit::EFldAccess::Read
+            , tCQCKit::EFldSTypes::MotionSensor
+        )
+    );
+    colFlds.objAdd
+    (
+        TCQCFldDef
+        (
+            L"Dim3"
+            , tCQCKit::EFldTypes::Card
+            , tCQCKit::EFldAccess::ReadWrite
+            , tCQCKit::EFldSTypes::Dimmer
+        )
+    );
+    sdrvTest.LoadFields(colFlds);
+
+    {
+        fcolTypes.RemoveAll();
+        fcolTypes.c4AddElement(tCQCKit::EFldSTypes::Dimmer);
+        fcolTypes.c4AddElement(tCQCKit::EFldSTypes::LightSwitch);
+        fcolTypes.c4AddElement(tCQCKit::EFldSTypes::MotionSensor);
+
+        const tCIDLib::TCh* const apszExp[] = { L"Dim3", L"Motion1" };
+        if (!bTestQuery(strmOut, TFWCurLn, sdrvTest, fcolTypes
+                        , tCQCKit::EReqAccess::ReadOrWrite
+                        , apszExp, tCIDLib::c4ArrayElems(apszExp)))
+        {
+            eRes = tTestFWLib::ETestRes::Failed;
+        }
+    }
+
+    // And clearing the fields should leave nothing in the index
+    colFlds.RemoveAll();
+    sdrvTest.LoadFields(colFlds);
+    if (!bTestQuery(strmOut, TFWCurLn, sdrvTest, fcolTypes
+                    , tCQCKit::EReqAccess::ReadOrWrite, nullptr, 0))
+    {
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    return eRes;
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_SemFldIndex: Private, non-virtual methods
+// ---------------------------------------------------------------------------
+
+//
+//  Does a semantic field query on the test driver and checks that we got
+//  back the expected fields, in the expected order.
+//
+tCIDLib::TBoolean
+TTest_SemFldIndex::bTestQuery(          TTextStringOutStream&   strmOut
+                                , const TTFWCurLn&              tfwclAt
+                                , const TTestFldDriver&         sdrvTest
+                                , const tCQCKit::TFldSTypeList& fcolTypes
+                                , const tCQCKit::EReqAccess     eReqAccess
+                                , const tCIDLib::TCh* const     apszExpected[]
+                                , const tCIDLib::TCard4         c4ExpCount)
+{
+    tCQCKit::TFldDefList colFound;
+    const tCIDLib::TCard4 c4Found = sdrvTest.c4QuerySemFields
+    (
+        fcolTypes, eReqAccess, colFound
+    );
+
+    if (c4Found != c4ExpCount)
+    {
+        strmOut << tfwclAt << L"Expected " << c4ExpCount << L" semantic fields but got "
+                << c4Found << L"\n\n";
+        return kCIDLib::False;
+    }
+
+    for (tCIDLib::TCard4 c4Index = 0; c4Index < c4Found; c4Index++)
+    {
+        if (colFound[c4Index].strName() != apszExpected[c4Index])
+        {
+            strmOut << tfwclAt << L"Expected semantic field " << apszExpected[c4Index]
+                    << L" at index " << c4Index << L" but got "
+                    << colFound[c4Index].strName() << L"\n\n";
+            return kCIDLib::False;
+        }
+    }
+    return kCIDLib::True;
+}
@@ -0,0 +1,142 @@
+//
+// FILE NAME: TestCQCKit_DrvBase.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header file for tests of the server side driver base class'
+//  field lists. We need a concrete driver to test, so we define a trivial one
+//  here that just lets the tests set its field list. It's never started, so
+//  none of the device oriented callbacks are ever invoked.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $Log$
+//
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTestFldDriver
+// PREFIX: sdrv
+// ---------------------------------------------------------------------------
+class TTestFldDriver : public TCQCServerBase
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTestFldDriver
+        (
+            const   TCQCDriverObjCfg&       cqcdcToLoad
+        );
+
+        TTestFldDriver(const TTestFldDriver&) = delete;
+        TTestFldDriver(TTestFldDriver&&) = delete;
+
+        ~TTestFldDriver();
+
+
+        // -------------------------------------------------------------------
+        //  Public, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TVoid LoadFields
+        (
+                    TSetFieldList&          colToSet
+        );
+
+
+    protected :
+        // -------------------------------------------------------------------
+        //  Protected, inherited methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bGetCommResource
+        (
+                    TThread&                thrThis
+        )   final;
+
+        tCIDLib::TBoolean bWaitConfig
+        (
+                    TThread&                thrThis
+        )   final;
+
+        tCQCKit::ECommResults eConnectToDevice
+        (
+                    TThread&                thrThis
+        )   final;
+
+        tCQCKit::EDrvInitRes eInitializeImpl() final;
+
+        tCQCKit::ECommResults ePollDevice
+        (
+                    TThread&                thrThis
+        )   final;
+
+        tCIDLib::TVoid ReleaseCommResource() final;
+
+        tCIDLib::TVoid TerminateImpl() final;
+};
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_SemFldIndex
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_SemFldIndex : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_SemFldIndex();
+
+        TTest_SemFldIndex(const TTest_SemFldIndex&) = delete;
+        TTest_SemFldIndex(TTest_SemFldIndex&&) = delete;
+
+        ~TTest_SemFldIndex();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Private, non-virtual methods
+        // -------------------------------------------------------------------
+        tCIDLib::TBoolean bTestQuery
+        (
+                    TTextStringOutStream&   strmOut
+            , const TTFWCurLn&              tfwclAt
+            , const TTestFldDriver&         sdrvTest
+            , const tCQCKit::TFldSTypeList& fcolTypes
+            , const tCQCKit::EReqAccess     eReqAccess
+            , const tCIDLib::TCh* const     apszExpected[]
+            , const tCIDLib::TCard4         c4ExpCount
+        );
+
+
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_SemFldIndex,TTestFWTest)
+};
@@ -0,0 +1,152 @@
+//
+// FILE NAME: TestCQCKit_PollEng.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the tests for the polling engine's field items.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $Log$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestCQCKit.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_PollFldHotCold,TTestFWTest)
+
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PollFldHotCold
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_PollFldHotCold: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_PollFldHotCold::TTest_PollFldHotCold() :
+
+    TTestFWTest
+    (
+        L"Poll Hot/Cold Fields", L"Polling engine hot/cold field list tests", 3
+    )
+{
+}
+
+TTest_PollFldHotCold::~TTest_PollFldHotCold()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_PollFldHotCold: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_PollFldHotCold::eRunTest(TTextStringOutStream&    strmOut
+                                , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes eRes = tTestFWLib::ETestRes::Success;
+
+    TCQCFldDef flddTest(L"Temp", tCQCKit::EFldTypes::Int, tCQCKit::EFldAccess::Read);
+    flddTest.c4Id(5);
+    TCQCPollEngine::TFldItem fldiTest
+    (
+        1, flddTest, TCQCPollEngFldLink(1, 1, 1, 1, flddTest.c4Id())
+    );
+
+    // A new field starts out hot, with nothing pending
+    if (fldiTest.bOnColdList() || fldiTest.bPromote())
+    {
+        strmOut << TFWCurLn << L"New field should be on the hot list with no promotion\n\n";
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    // Reads of a hot field don't flag anything
+    fldiTest.SetLastAccessStamp();
+    if (fldiTest.bPromote())
+    {
+        strmOut << TFWCurLn << L"Reading a hot field flagged it for promotion\n\n";
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    // Moving it to the cold list doesn't flag it either
+    fldiTest.bOnColdList(kCIDLib::True);
+    if (!fldiTest.bOnColdList() || fldiTest.bPromote())
+    {
+        strmOut << TFWCurLn << L"Moved field should be cold with no promotion\n\n";
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    // But a client reading it once it's cold should
+    fldiTest.SetLastAccessStamp();
+    if (!fldiTest.bPromote())
+    {
+        strmOut << TFWCurLn << L"Reading a cold field did not flag it for promotion\n\n";
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    // Moving it back to the hot list clears the promotion
+    fldiTest.bOnColdList(kCIDLib::False);
+    if (fldiTest.bOnColdList() || fldiTest.bPromote())
+    {
+        strmOut << TFWCurLn << L"Promoted field should be hot with no promotion\n\n";
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    // And a cold field seeing a new value should be flagged as well
+    fldiTest.bOnColdList(kCIDLib::True);
+    fldiTest.SetLastChangeStamp();
+    if (!fldiTest.bPromote())
+    {
+        strmOut << TFWCurLn << L"Change of a cold field did not flag it for promotion\n\n";
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    //
+    //  It was just read and changed, so it should stay hot until it's neither
+    //  been read for a while nor changed for longer than that.
+    //
+    const tCIDLib::TEncodedTime enctNow = TTime::enctNow();
+    if (fldiTest.bIsCold(enctNow + (kCIDLib::enctOneSecond * 5)))
+    {
+        strmOut << TFWCurLn << L"Recently read field was reported as cold\n\n";
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    if (fldiTest.bIsCold(enctNow + (kCIDLib::enctOneSecond * 30)))
+    {
+        strmOut << TFWCurLn << L"Recently changed field was reported as cold\n\n";
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    if (!fldiTest.bIsCold(enctNow + (kCIDLib::enctOneMinute * 2)))
+    {
+        strmOut << TFWCurLn << L"Unread, unchanged field was not reported as cold\n\n";
+        eRes = tTestFWLib::ETestRes::Failed;
+    }
+
+    return eRes;
+}
@@ -0,0 +1,64 @@
+//
+// FILE NAME: TestCQCKit_PollEng.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header file for tests of the polling engine's field items. The
+//  server items move fields between their hot and cold poll lists based on the
+//  state these keep, so we test that state directly, since the server items
+//  themselves need a live CQCServer.
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $Log$
+//
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_PollFldHotCold
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_PollFldHotCold : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_PollFldHotCold();
+
+        TTest_PollFldHotCold(const TTest_PollFldHotCold&) = delete;
+        TTest_PollFldHotCold(TTest_PollFldHotCold&&) = delete;
+
+        ~TTest_PollFldHotCold();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        )   final;
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_PollFldHotCold,TTestFWTest)
+};
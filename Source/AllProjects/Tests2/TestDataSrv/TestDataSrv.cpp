@@ -90,6 +90,9 @@ tCIDLib::TVoid TDataSrvTestApp::LoadTests()
     AddTest(new TTest_FileSys);
     AddTest(new TTest_BasicIO);
     AddTest(new TTest_MetaInfo);
+
+    // CQCServer driver lookups
+    AddTest(new TTest_DrvMonikers);
 }
 
 tCIDLib::TVoid TDataSrvTestApp::PostTest(const TTestFWTest&)
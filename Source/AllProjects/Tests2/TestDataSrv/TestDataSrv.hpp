@@ -40,6 +40,7 @@
 //  Individual test section headers
 // ---------------------------------------------------------------------------
 #include    "TestDataSrv_Basic.hpp"
+#include    "TestDataSrv_Drivers.hpp"
 
 
 
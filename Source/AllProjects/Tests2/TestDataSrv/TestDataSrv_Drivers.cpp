@@ -0,0 +1,183 @@
+//
+// FILE NAME: TestDataSrv_Drivers.cpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This file implements the CQCServer driver lookup tests
+//
+// CAVEATS/GOTCHAS:
+//
+// LOG:
+//
+//  $Log$
+//
+
+
+// ---------------------------------------------------------------------------
+//  Include underlying headers
+// ---------------------------------------------------------------------------
+#include    "TestDataSrv.hpp"
+
+
+// ---------------------------------------------------------------------------
+//  Magic macros
+// ---------------------------------------------------------------------------
+RTTIDecls(TTest_DrvMonikers,TTestFWTest)
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_DrvMonikers
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+
+// ---------------------------------------------------------------------------
+//  TTest_DrvMonikers: Constructor and Destructor
+// ---------------------------------------------------------------------------
+TTest_DrvMonikers::TTest_DrvMonikers() :
+
+    TTestFWTest
+    (
+        L"Driver Monikers", L"CQCServer driver lookup by moniker tests", 4
+    )
+{
+}
+
+TTest_DrvMonikers::~TTest_DrvMonikers()
+{
+}
+
+
+// ---------------------------------------------------------------------------
+//  TTest_DrvMonikers: Public, inherited methods
+// ---------------------------------------------------------------------------
+tTestFWLib::ETestRes
+TTest_DrvMonikers::eRunTest(TTextStringOutStream&   strmOut
+                            , tCIDLib::TBoolean&    bWarning)
+{
+    tTestFWLib::ETestRes    eRes = tTestFWLib::ETestRes::Success;
+    tCIDLib::TStrList       colMonikers;
+    tCIDLib::TStrList       colSrvMons;
+    tCIDLib::TCardList      fcolIds;
+
+    // Get all of the drivers registered with the name server
+    facCQCKit().bFindAllDrivers(colMonikers);
+    const tCIDLib::TCard4 c4DrvCnt = colMonikers.c4ElemCount();
+    if (!c4DrvCnt)
+    {
+        strmOut << TFWCurLn << L"No drivers are loaded, so nothing could be tested\n\n";
+        bWarning = kCIDLib::True;
+        return eRes;
+    }
+
+    try
+    {
+        TString strCase;
+        for (tCIDLib::TCard4 c4DrvInd = 0; c4DrvInd < c4DrvCnt; c4DrvInd++)
+        {
+            const TString& strMon = colMonikers[c4DrvInd];
+            tCQCKit::TCQCSrvProxy orbcSrv = facCQCKit().orbcCQCSrvAdminProxy(strMon);
+
+            //
+            //  Get the full driver list of the server this driver is on, and find
+            //  this driver in it. That is the id that a lookup by moniker should
+            //  give us back.
+            //
+            const tCIDLib::TCard4 c4ListId = orbcSrv->c4QueryDriverIdList2
+            (
+                colSrvMons, fcolIds, tfwappCQCKit.m_sectToUse
+            );
+
+            const tCIDLib::TCard4 c4SrvCnt = colSrvMons.c4ElemCount();
+            tCIDLib::TCard4 c4SrvInd = 0;
+            while ((c4SrvInd < c4SrvCnt) && !colSrvMons[c4SrvInd].bCompareI(strMon))
+                c4SrvInd++;
+
+            if (c4SrvInd == c4SrvCnt)
+            {
+                strmOut << TFWCurLn << L"Driver '" << strMon
+                        << L"' was not in its server's driver list\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+                continue;
+            }
+            const tCIDLib::TCard4 c4ExpId = fcolIds[c4SrvInd];
+
+            //
+            //  Look it up as is and in upper and lower case, since monikers are
+            //  not case sensitive. If the driver list changed in the meantime,
+            //  the ids can't be compared, so just warn.
+            //
+            for (tCIDLib::TCard4 c4CaseInd = 0; c4CaseInd < 3; c4CaseInd++)
+            {
+                strCase = strMon;
+                if (c4CaseInd == 1)
+                    strCase.ToUpper();
+                else if (c4CaseInd == 2)
+                    strCase.ToLower();
+
+                tCIDLib::TCard4 c4NewListId;
+                const tCIDLib::TCard4 c4GotId = orbcSrv->c4QueryDriverId
+                (
+                    strCase, c4NewListId
+                );
+
+                if (c4NewListId != c4ListId)
+                {
+                    strmOut << TFWCurLn << L"The driver list changed while testing '"
+                            << strMon << L"'\n\n";
+                    bWarning = kCIDLib::True;
+                    break;
+                }
+
+                if (c4GotId != c4ExpId)
+                {
+                    strmOut << TFWCurLn << L"Lookup of '" << strCase << L"' got id "
+                            << c4GotId << L", expected " << c4ExpId << L"\n\n";
+                    eRes = tTestFWLib::ETestRes::Failed;
+                }
+            }
+
+            // And a moniker that isn't there has to be rejected
+            strCase = strMon;
+            strCase.Append(L"_NoSuchDrv");
+            tCIDLib::TBoolean bGotIt = kCIDLib::False;
+            try
+            {
+                tCIDLib::TCard4 c4NewListId;
+                orbcSrv->c4QueryDriverId(strCase, c4NewListId);
+                bGotIt = kCIDLib::True;
+            }
+
+            catch(...)
+            {
+            }
+
+            if (bGotIt)
+            {
+                strmOut << TFWCurLn << L"Lookup of bad moniker '" << strCase
+                        << L"' did not fail\n\n";
+                eRes = tTestFWLib::ETestRes::Failed;
+            }
+        }
+    }
+
+    catch(TError& errToCatch)
+    {
+        errToCatch.AddStackLevel(CID_FILE, CID_LINE);
+        strmOut << TFWCurLn << L"Driver moniker tests failed\n\n";
+        throw;
+    }
+    return eRes;
+}
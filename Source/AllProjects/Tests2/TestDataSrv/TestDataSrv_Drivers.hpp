@@ -0,0 +1,65 @@
+//
+// FILE NAME: TestDataSrv_Drivers.hpp
+//
+// AUTHOR: Dean Roddey
+//
+// CREATED: 10/19/2026
+//
+// COPYRIGHT: Charmed Quark Systems, Ltd @ 2020
+//
+//  This software is copyrighted by 'Charmed Quark Systems, Ltd' and
+//  the author (Dean Roddey.) It is licensed under the MIT Open Source
+//  license:
+//
+//  https://opensource.org/licenses/MIT
+//
+// DESCRIPTION:
+//
+//  This is the header file for tests of the CQCServer driver lookups. These
+//  talk to whatever CQCServers are registered and make sure that looking up
+//  a driver by moniker gets the same driver that the server reports in its
+//  driver list.
+//
+// CAVEATS/GOTCHAS:
+//
+//  1)  If there are no drivers loaded, we can't test anything, so we just
+//      return a warning.
+//
+// LOG:
+//
+//  $Log$
+//
+
+
+
+// ---------------------------------------------------------------------------
+//  CLASS: TTest_DrvMonikers
+// PREFIX: tfwt
+// ---------------------------------------------------------------------------
+class TTest_DrvMonikers : public TTestFWTest
+{
+    public  :
+        // -------------------------------------------------------------------
+        //  Constructor and Destructor
+        // -------------------------------------------------------------------
+        TTest_DrvMonikers();
+
+        ~TTest_DrvMonikers();
+
+
+        // -------------------------------------------------------------------
+        //  Public, inherited methods
+        // -------------------------------------------------------------------
+        tTestFWLib::ETestRes eRunTest
+        (
+                    TTextStringOutStream&   strmOutput
+            ,       tCIDLib::TBoolean&      bWarning
+        );
+
+
+    private :
+        // -------------------------------------------------------------------
+        //  Do any needed magic macros
+        // -------------------------------------------------------------------
+        RTTIDefs(TTest_DrvMonikers,TTestFWTest)
+};